@@ -0,0 +1,18 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: AArch64 color conversion routines.
+*/
+
+#include <exec/types.h>
+#include <hidd/gfx.h>
+
+#include "colorconv/rgbconv_macros.h"
+#include "colorconv/rgbconv_vector.h"
+#include "colorconv/rgbconv_neon.h"
+
+void SetArchRGBConversionFunctions(HIDDT_RGBConversionFunction rgbconvertfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT])
+{
+    /* NEON is always there on AArch64 */
+    SetNEONRGBConversionFunctions(rgbconvertfuncs);
+}
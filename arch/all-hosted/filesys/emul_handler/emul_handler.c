@@ -1,5 +1,5 @@
 /*
- Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+ Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
  Desc: Filesystem that accesses an underlying host OS filesystem.
  */
@@ -1147,6 +1147,140 @@ static void handlePacket(struct emulbase *emulbase, struct filehandle *fhv, stru
     ReplyPkt(dp, Res1, Res2);
 }
 
+#ifdef EMUL_ASYNC_IO
+
+/*
+ * Returns the handle a packet works on, for the packets that must not
+ * overtake host I/O that is still in flight on that handle.
+ */
+static struct filehandle *packet_handle(struct filehandle *fhv, struct DosPacket *dp)
+{
+    switch(dp->dp_Type)
+    {
+    case ACTION_READ:
+    case ACTION_WRITE:
+    case ACTION_SEEK:
+    case ACTION_SET_FILE_SIZE:
+    case ACTION_END:
+    case ACTION_EXAMINE_FH:
+    case ACTION_PARENT_FH:
+    case ACTION_COPY_DIR_FH:
+        return FH_FROM(dp->dp_Arg1);
+
+    case ACTION_EXAMINE_OBJECT:
+    case ACTION_EXAMINE_NEXT:
+    case ACTION_EXAMINE_ALL:
+    case ACTION_EXAMINE_ALL_END:
+    case ACTION_COPY_DIR:
+    case ACTION_FREE_LOCK:
+    case ACTION_PARENT:
+        return FH_FROM_LOCK(dp->dp_Arg1);
+
+    case ACTION_FH_FROM_LOCK:
+        return FH_FROM_LOCK(dp->dp_Arg2);
+    }
+
+    return NULL;
+}
+
+static void runPacket(struct emulbase *emulbase, struct filehandle *fhv, struct AsyncQueue *aq,
+                      struct MsgPort *mp, struct DosPacket *dp, struct DosLibrary *DOSBase)
+{
+    struct filehandle *fh;
+
+    if (dp->dp_Type == ACTION_EMUL_QUEUE_INFO)
+    {
+        struct EmulQueueInfo eqi;
+        ULONG size = (dp->dp_Arg2 < sizeof(eqi)) ? dp->dp_Arg2 : sizeof(eqi);
+
+        DCMD(bug("[emul] %p ACTION_EMUL_QUEUE_INFO: %p, depth %ld\n", fhv, dp->dp_Arg1, dp->dp_Arg3));
+        GetAsyncInfo(emulbase, aq, &eqi, dp->dp_Arg3, dp->dp_Arg4);
+        CopyMem(&eqi, (APTR)dp->dp_Arg1, size);
+        ReplyPkt(dp, DOSTRUE, size);
+        return;
+    }
+
+    fh = packet_handle(fhv, dp);
+    if (fh && SubmitAsync(emulbase, aq, fh, dp))
+        return;
+
+    handlePacket(emulbase, fhv, mp, dp, DOSBase);
+}
+
+/*
+ * Runs the deferred packets whose handles are not busy any more, in the
+ * order they arrived in. Packets behind one that starts host I/O again
+ * stay deferred.
+ */
+static void runDeferred(struct emulbase *emulbase, struct filehandle *fhv, struct AsyncQueue *aq,
+                        struct MsgPort *mp, struct DosLibrary *DOSBase)
+{
+    struct Node *node, *next;
+    struct DosPacket *dp;
+    struct filehandle *fh;
+
+    ForeachNodeSafe(&aq->aq_Deferred, node, next)
+    {
+        dp = (struct DosPacket *)node->ln_Name;
+        fh = packet_handle(fhv, dp);
+        if (fh->aio)
+            continue;
+
+        Remove(node);
+        fh->deferred--;
+        runPacket(emulbase, fhv, aq, mp, dp, DOSBase);
+    }
+}
+
+static void waitPackets(struct emulbase *emulbase, struct filehandle *fhv, struct AsyncQueue *aq,
+                        struct MsgPort *mp, struct DosLibrary *DOSBase)
+{
+    struct AsyncRequest *ar, *next;
+    struct filehandle *fh;
+    struct DosPacket *dp;
+    struct Message *msg;
+    SIPTR Res1, Res2;
+    ULONG sigs;
+
+    sigs = Wait((1L << mp->mp_SigBit) | aq->aq_SigMask);
+
+    if (sigs & aq->aq_SigMask)
+    {
+        for (ar = GetAsyncReplies(emulbase, aq); ar; ar = next)
+        {
+            next = ar->ar_Next;
+            dp   = ar->ar_Packet;
+            fh   = ar->ar_Handle;
+
+            Res1 = FinishAsync(emulbase, aq, ar, &Res2, DOSBase);
+            fh->aio = NULL;
+
+            DCMD(bug("[emul] Replying to async packet with 0x%p, %ld\n", Res1, Res2));
+            ReplyPkt(dp, Res1, Res2);
+        }
+        runDeferred(emulbase, fhv, aq, mp, DOSBase);
+    }
+
+    while (fhv->locks && (msg = GetMsg(mp)))
+    {
+        dp = (struct DosPacket *)msg->mn_Node.ln_Name;
+
+        DB2(bug("[emul] Got command %u\n", dp->dp_Type));
+
+        fh = packet_handle(fhv, dp);
+        if (fh && (fh->aio || fh->deferred))
+        {
+            /* Keep the order of the packets on this handle */
+            fh->deferred++;
+            AddTail((struct List *)&aq->aq_Deferred, &msg->mn_Node);
+            continue;
+        }
+        runPacket(emulbase, fhv, aq, mp, dp, DOSBase);
+    }
+}
+
+#endif
+
 static void EmulHandler_work(struct ExecBase *SysBase)
 {
     struct DosLibrary *DOSBase;
@@ -1158,6 +1292,9 @@ static void EmulHandler_work(struct ExecBase *SysBase)
     struct filehandle *fhv;
     struct emulbase *emulbase;
     const STRPTR hname = "emul-handler";
+#ifdef EMUL_ASYNC_IO
+    struct AsyncQueue *aq;
+#endif
 
     DOSBase = (APTR)OpenLibrary("dos.library", 0);
     if (!DOSBase)
@@ -1212,6 +1349,19 @@ static void EmulHandler_work(struct ExecBase *SysBase)
     ReplyPkt(dp, DOSTRUE, 0);
 
     fhv->locks = 1;
+
+#ifdef EMUL_ASYNC_IO
+    /* Without a queue all I/O is done synchronously below */
+    aq = CreateAsyncQueue(emulbase);
+    if (aq)
+    {
+        while (fhv->locks || aq->aq_Pending)
+            waitPackets(emulbase, fhv, aq, mp, DOSBase);
+
+        DeleteAsyncQueue(emulbase, aq);
+    }
+#endif
+
     while (fhv->locks)
     {
         dp = WaitPkt();
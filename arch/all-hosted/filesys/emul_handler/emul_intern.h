@@ -1,7 +1,7 @@
 #ifndef __EMUL_INTERN_H
 #define __EMUL_INTERN_H
 /*
-    Copyright  1995-2011, The AROS Development Team. All rights reserved.
+    Copyright  1995-2026, The AROS Development Team. All rights reserved.
     $Id$
 
     Desc: Internal header-file for emulation-handler.
@@ -28,6 +28,10 @@ struct filehandle
     struct DosList *dl;		/* Volume node					    */
     unsigned int locks;         /* Number of open locks				    */
     struct PlatformHandle ph;	/* Platform-specific data			    */
+#ifdef EMUL_ASYNC_IO
+    struct AsyncRequest *aio;	/* Host I/O in flight on this handle		    */
+    unsigned int deferred;	/* Packets waiting for it to finish		    */
+#endif
 };
 
 /* type flags */
@@ -97,4 +101,40 @@ char *GetHomeDir(struct emulbase *emulbase, char *user);
 ULONG GetCurrentDir(struct emulbase *emulbase, char *path, ULONG len);
 BOOL CheckDir(struct emulbase *emulbase, char *name);
 
+#ifdef EMUL_ASYNC_IO
+/*
+ * Asynchronous host I/O, for platforms whose emul_host.h defines EMUL_ASYNC_IO.
+ * SubmitAsync() takes over a packet if it can be done by a host thread, its
+ * result comes back through GetAsyncReplies() after aq_SigMask is signalled.
+ */
+struct AsyncQueue *CreateAsyncQueue(struct emulbase *emulbase);
+void DeleteAsyncQueue(struct emulbase *emulbase, struct AsyncQueue *aq);
+BOOL SubmitAsync(struct emulbase *emulbase, struct AsyncQueue *aq, struct filehandle *fh, struct DosPacket *dp);
+struct AsyncRequest *GetAsyncReplies(struct emulbase *emulbase, struct AsyncQueue *aq);
+SIPTR FinishAsync(struct emulbase *emulbase, struct AsyncQueue *aq, struct AsyncRequest *ar, SIPTR *err, struct DosLibrary *DOSBase);
+
+/*
+ * ACTION_EMUL_QUEUE_INFO
+ *
+ * ARG1 = struct EmulQueueInfo * to fill in
+ * ARG2 = size of the struct EmulQueueInfo buffer
+ * ARG3 = new queue depth of the volume, or -1 to keep it
+ * ARG4 = TRUE to reset the latency histogram afterwards
+ * RES1 = success
+ * RES2 = failure code / number of bytes filled in
+ */
+#define ACTION_EMUL_QUEUE_INFO  16100
+
+struct EmulQueueInfo
+{
+    ULONG eqi_Depth;                            /* Requests allowed in flight, 0 = none     */
+    ULONG eqi_MaxDepth;
+    ULONG eqi_Pending;                          /* Requests in flight now                   */
+    ULONG eqi_Latency[AIO_OPS][AIO_BUCKETS];    /* Requests done, by log2 of microseconds   */
+};
+
+void GetAsyncInfo(struct emulbase *emulbase, struct AsyncQueue *aq, struct EmulQueueInfo *eqi,
+                  LONG depth, BOOL reset);
+#endif
+
 #endif /* __EMUL_INTERN_H */
@@ -9,6 +9,8 @@
 
 #define HAVE_PREPAREPLATFORM
 #define SCHEDQUANTUM_VALUE      4
+/* The scheduler keeps ready tasks in exec's run queue */
+#define EXEC_RUNQUEUE
 
 struct Exec_PlatformData
 {
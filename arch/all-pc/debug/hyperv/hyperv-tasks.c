@@ -13,9 +13,7 @@
 #include "etask.h"
 #include "kernel_base.h"
 #include "kernel_intern.h"
-#if defined(__AROSEXEC_SMP__)
 #include "exec_intern.h"
-#endif
 #include "apic.h"
 
 #include "hyperv-cpu.h"
@@ -70,6 +68,42 @@ static int HYDEBUGCompareTaskCtx(APTR ctx, struct Task *curTask)
     return retval;
 }
 
+struct HVDEBUGTaskDumpData
+{
+    struct KernelBase   *KernelBase;
+    APTR                ctx;
+};
+
+static void HVDEBUGDumpReadyTask(struct KernelBase *KernelBase, APTR ctx, struct Task *curTask)
+{
+    int taskMatch;
+
+    HVDEBUGDumpTaskStats(KernelBase, curTask);
+    if (!(taskMatch = HYDEBUGCompareTaskCtx(ctx, curTask)))
+        kprintf("  *  Task Context matches current CPU Context\n");
+    else if (taskMatch == 1)
+        kprintf("  *  Partial Task Context match with current CPU Context\n");
+    if (curTask->tc_SigWait & curTask->tc_SigRecvd)
+        kprintf("  *  Recv Signal %08x\n", curTask->tc_SigWait & curTask->tc_SigRecvd);
+    else if (curTask->tc_SigExcept & curTask->tc_SigRecvd)
+        kprintf("  *  Exception %08x pending\n", curTask->tc_SigExcept & curTask->tc_SigRecvd);
+    kprintf("\n");
+}
+
+#if defined(EXEC_WALKREADYQUEUES)
+static struct Task *HVDEBUGDumpReadyQueue(struct List *readyList, APTR data)
+{
+    struct HVDEBUGTaskDumpData *dumpData = (struct HVDEBUGTaskDumpData *)data;
+    struct Task *curTask;
+
+    ForeachNode(readyList, curTask)
+    {
+        HVDEBUGDumpReadyTask(dumpData->KernelBase, dumpData->ctx, curTask);
+    }
+    return NULL;
+}
+#endif
+
 void HVDEBUGDumpTasks(APTR ctx, struct KernelBase *_KernelBase)
 {
     struct KernelBase *KernelBase = (struct KernelBase *)_KernelBase;
@@ -116,17 +150,15 @@ void HVDEBUGDumpTasks(APTR ctx, struct KernelBase *_KernelBase)
 
     ForeachNode(&SysBase->TaskReady, curTask)
     {
-        HVDEBUGDumpTaskStats(KernelBase, curTask);
-        if (!(taskMatch = HYDEBUGCompareTaskCtx(ctx, curTask)))
-            kprintf("  *  Task Context matches current CPU Context\n");
-        else if (taskMatch == 1)
-            kprintf("  *  Partial Task Context match with current CPU Context\n");
-        if (curTask->tc_SigWait & curTask->tc_SigRecvd)
-            kprintf("  *  Recv Signal %08x\n", curTask->tc_SigWait & curTask->tc_SigRecvd);
-        else if (curTask->tc_SigExcept & curTask->tc_SigRecvd)
-            kprintf("  *  Exception %08x pending\n", curTask->tc_SigExcept & curTask->tc_SigRecvd);
-        kprintf("\n");
+        HVDEBUGDumpReadyTask(KernelBase, ctx, curTask);
     }
+#if defined(EXEC_WALKREADYQUEUES)
+    {
+        struct HVDEBUGTaskDumpData dumpData = { KernelBase, ctx };
+
+        EXEC_WALKREADYQUEUES(HVDEBUGDumpReadyQueue, &dumpData);
+    }
+#endif
     
     kprintf("\nWAIT'ing Task(s):\n");
 
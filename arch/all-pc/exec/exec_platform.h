@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 2017-2026, The AROS Development Team. All rights reserved.
 */
 #ifndef __EXEC_PLATFORM_H
 #define __EXEC_PLATFORM_H
@@ -16,12 +16,22 @@
 #if (__WORDSIZE==64)
 #define EXEC_REMTASK_NEEDSSWITCH
 #endif
+/* Small memory blocks are cached in per-CPU magazines, see memory_magazine.h */
+#define EXEC_MAGAZINES
+/* Small pooled blocks are kept on per-CPU free lists, see memory.h */
+#define EXEC_POOLCACHE
+/* Public system lists are indexed by name, see namehash.h */
+#define EXEC_NAMEHASH
+/* Scheduler, memory and message events can be traced, see exec_trace.h */
+#define EXEC_TRACING
 #if defined (__AROSEXEC_SMP__)
 #define SCHEDQUANTUM_VALUE      10
 #define SCHEDGRAN_VALUE         1
 #else
 #define SCHEDQUANTUM_VALUE      4
 #define SCHEDGRAN_VALUE         1
+/* Ready tasks are kept in exec's run queue (SMP builds use the per-CPU RunQueues instead) */
+#define EXEC_RUNQUEUE
 #endif
 
 #include "kernel_base.h"
@@ -61,6 +71,53 @@ extern spinlock_t *Kernel_52_KrnSpinLock(spinlock_t *, struct Hook *, ULONG, voi
 extern void Kernel_53_KrnSpinUnLock(spinlock_t *, void *);
 #endif
 
+/*
+ * Ready tasks are kept on the kernel schedulers per-CPU RunQueues, so
+ * SysBase->TaskReady alone doesn't show all of them. This calls func
+ * on each RunQueue in turn, until it returns a task.
+ */
+static inline struct Task *Exec_X86WalkReadyQueues(APTR kernelBase, struct Task *(*func)(struct List *, APTR), APTR data)
+{
+    struct PlatformData *pdata = ((struct KernelBase *)kernelBase)->kb_PlatformData;
+
+    if (pdata && pdata->kb_WalkReadyQueues)
+        return pdata->kb_WalkReadyQueues(func, data);
+    return NULL;
+}
+#define EXEC_WALKREADYQUEUES(func, data) \
+    Exec_X86WalkReadyQueues(PrivExecBase(SysBase)->KernelBase, (func), (APTR)(data))
+
+/*
+ * Reschedule IPIs for tasks woken up on other cores while in Forbid() are
+ * deferred by the kernel (see core_ScheduleCPUDeferred()), and sent once
+ * Permit() re-enables task switching.
+ */
+static inline void Exec_X86FlushWakeups(APTR kernelBase)
+{
+    struct PlatformData *pdata = ((struct KernelBase *)kernelBase)->kb_PlatformData;
+    struct X86SchedulerPrivate *schd = TLS_GET(ScheduleData);
+
+    if (schd && schd->WakeupsDeferred && pdata && pdata->kb_FlushWakeups)
+        pdata->kb_FlushWakeups();
+}
+#define EXEC_FLUSHWAKEUPS() \
+    Exec_X86FlushWakeups(PrivExecBase(SysBase)->KernelBase)
+
+/*
+ * Tells if a task is running on the given CPU, without dereferencing the
+ * task - e.g. to spin on a semaphore owner that may release it and exit.
+ */
+static inline BOOL Exec_X86TaskRunningOn(APTR kernelBase, cpuid_t cpuNo, struct Task *task)
+{
+    struct PlatformData *pdata = ((struct KernelBase *)kernelBase)->kb_PlatformData;
+
+    if (pdata && pdata->kb_TaskRunningOn)
+        return pdata->kb_TaskRunningOn(cpuNo, task);
+    return FALSE;
+}
+#define EXEC_TASKRUNNINGON(cpu, task) \
+    Exec_X86TaskRunningOn(PrivExecBase(SysBase)->KernelBase, (cpu), (task))
+
 #define EXEC_SPINLOCK_INIT(a) Kernel_49_KrnSpinInit((a), NULL)
 #define EXEC_SPINLOCK_LOCK(a,b,c) Kernel_52_KrnSpinLock((a), (b), (c), NULL)
 #define EXEC_SPINLOCK_UNLOCK(a) Kernel_53_KrnSpinUnLock((a), NULL)
@@ -283,6 +340,7 @@ extern void Kernel_53_KrnSpinUnLock(spinlock_t *, void *);
         { \
             EXEC_SPINLOCK_LOCK(&PrivExecBase(SysBase)->TaskRunningSpinLock, NULL, SPINLOCK_MODE_WRITE); \
             __schd->RunningTask = (x); \
+            __schd->RunningPri = ((struct Task *)(x))->tc_Node.ln_Pri; \
             AddHead(&PrivExecBase(SysBase)->TaskRunning, (struct Node *)(x)); \
             EXEC_SPINLOCK_UNLOCK(&PrivExecBase(SysBase)->TaskRunningSpinLock);  \
         } \
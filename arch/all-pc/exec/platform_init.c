@@ -207,6 +207,7 @@ struct syscallx86_Handler x86_SCSwitchHandler =
 void X86_SetTaskState(struct Task *changeTask, ULONG newState, BOOL dolock)
 {
 #if defined(__AROSEXEC_SMP__)
+    struct PlatformData *pdata = ((struct KernelBase *)__kernelBase)->kb_PlatformData;
     spinlock_t *task_listlock = NULL;
 #endif
     struct List *task_list = NULL;
@@ -224,7 +225,16 @@ void X86_SetTaskState(struct Task *changeTask, ULONG newState, BOOL dolock)
             break;
         case TS_READY:
 #if defined(__AROSEXEC_SMP__)
+            /* Let the scheduler pick the cpu RunQueue, it does its own locking */
+            if (pdata && pdata->kb_QueueReadyTask)
+            {
+                pdata->kb_QueueReadyTask(changeTask);
+                break;
+            }
             task_listlock = &PrivExecBase(SysBase)->TaskReadySpinLock;
+#elif defined(EXEC_RUNQUEUE)
+            EXEC_READYTASK(changeTask);
+            break;
 #endif
             task_list = &SysBase->TaskReady;
             break;
@@ -248,7 +258,11 @@ void X86_SetTaskState(struct Task *changeTask, ULONG newState, BOOL dolock)
 #if defined(__AROSEXEC_SMP__)
         if (dolock && task_listlock) EXEC_SPINLOCK_LOCK(task_listlock, NULL, SPINLOCK_MODE_WRITE);
 #endif
-        Enqueue(task_list, &changeTask->tc_Node);
+        /* The order of waiting tasks doesn't matter, so don't pay for Enqueue() */
+        if (newState == TS_WAIT)
+            AddTail(task_list, &changeTask->tc_Node);
+        else
+            Enqueue(task_list, &changeTask->tc_Node);
 #if defined(__AROSEXEC_SMP__)
         if (dolock && task_listlock) EXEC_SPINLOCK_UNLOCK(task_listlock);
 #endif
@@ -261,6 +275,7 @@ void X86_HandleReschedTask(struct ExceptionContext *regs)
     struct Task *reschTask = (struct Task *)EXCX_REGB;
     ULONG reschState = (ULONG)EXCX_REGC;
 #if defined(__AROSEXEC_SMP__)
+    struct PlatformData *pdata = ((struct KernelBase *)__kernelBase)->kb_PlatformData;
     spinlock_t *task_listlock = NULL;
 #endif
 
@@ -274,6 +289,9 @@ void X86_HandleReschedTask(struct ExceptionContext *regs)
             task_listlock = &PrivExecBase(SysBase)->TaskRunningSpinLock;
             break;
         case TS_READY:
+            /* Ready tasks live on the cpu RunQueues, the scheduler removes them itself */
+            if (pdata && pdata->kb_UnqueueReadyTask)
+                break;
             task_listlock = &PrivExecBase(SysBase)->TaskReadySpinLock;
             break;
         case TS_WAIT:
@@ -288,7 +306,9 @@ void X86_HandleReschedTask(struct ExceptionContext *regs)
     if (task_listlock)
         EXEC_SPINLOCK_LOCK(task_listlock, NULL, SPINLOCK_MODE_WRITE);
 
-    if ((reschTask->tc_State != TS_INVALID) && (reschTask->tc_State != TS_TOMBSTONED))
+    if ((reschTask->tc_State == TS_READY) && (pdata && pdata->kb_UnqueueReadyTask))
+        pdata->kb_UnqueueReadyTask(reschTask);
+    else if ((reschTask->tc_State != TS_INVALID) && (reschTask->tc_State != TS_TOMBSTONED))
 #else
     if ((reschTask->tc_State != TS_INVALID) && (reschTask->tc_State != TS_RUN))
 #endif
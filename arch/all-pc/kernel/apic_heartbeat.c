@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2017-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 2017-2026, The AROS Development Team. All rights reserved.
 */
 
 #define DEBUG 0
@@ -15,9 +15,36 @@
 #include "exec_intern.h"
 
 #include "kernel_intern.h"
+#include "kernel_scheduler.h"
 
 #include "intservers.h"
 
+#if defined(__AROSEXEC_SMP__)
+struct APICCpuUsageData
+{
+    apicid_t    cpuNum;
+    UQUAD       timeCur;
+};
+
+/* Updates the CPU usage of the ready tasks of a RunQueue level, see core_WalkReadyQueues() */
+static struct Task *APICReadyQueueCpuUsage(struct List *readyList, APTR data)
+{
+    struct APICCpuUsageData *usageData = data;
+    struct Task *t;
+
+    ForeachNode(readyList, t)
+    {
+        if (usageData->cpuNum == IntETask(t->tc_UnionETask.tc_ETask)->iet_CpuNumber)
+        {
+            IntETask(t->tc_UnionETask.tc_ETask)->iet_CpuUsage =
+                (IntETask(t->tc_UnionETask.tc_ETask)->iet_private2 << 32) / usageData->timeCur;
+            IntETask(t->tc_UnionETask.tc_ETask)->iet_private2 = 0;
+        }
+    }
+    return NULL;
+}
+#endif
+
 /*
  * Unlike the VBlankServer, we might not run at a fixed 60Hz.
  */
@@ -56,9 +83,15 @@ int APICHeartbeatServer(struct ExceptionContext *regs, struct KernelBase *Kernel
 #if defined(__AROSEXEC_SMP__)
         if ((now - apicData->cores[cpuNum].cpu_LastCPULoadTime) > apicData->cores[cpuNum].cpu_TSCFreq)
         {
+            struct APICCpuUsageData usageData;
             struct Task *t;
             UQUAD timeCur = now - apicData->cores[cpuNum].cpu_LastCPULoadTime;
-            
+
+            /* Ready tasks are on the per-CPU RunQueues, each walked under its own lock */
+            usageData.cpuNum = cpuNum;
+            usageData.timeCur = timeCur;
+            core_WalkReadyQueues(APICReadyQueueCpuUsage, &usageData);
+
             /* Lock all lists to make sure we catch all the tasks */
             KrnSpinLock(&PrivExecBase(SysBase)->TaskReadySpinLock, NULL, SPINLOCK_MODE_READ);
             ForeachNode(&SysBase->TaskReady, t)
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2023, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <asm/cpu.h>
@@ -318,11 +318,20 @@ void core_IRQHandle(struct ExceptionContext *regs, unsigned long error_code, uns
     else
     {
         UBYTE irq_number = GET_DEVICE_IRQ(int_number);
+#if defined(__AROSEXEC_SMP__)
+        struct X86SchedulerPrivate *schedData = TLS_GET(ScheduleData);
+#endif
 
         DIRQ(
             bug("[Kernel]" DEBUGCOLOR_SET " %s(%u): Device IRQ #$%02X" DEBUGCOLOR_RESET "\n", __func__, int_number, irq_number);
         )
 
+#if defined(__AROSEXEC_SMP__)
+        /* Coalesce the wakeups the handlers cause, see core_ScheduleCPUDeferred() */
+        if (schedData)
+            schedData->WakeupBatch++;
+#endif
+
         if (pdata)
         {
             pdata->kb_PDFlags |= PLATFORMF_INIRQ;
@@ -387,6 +396,10 @@ void core_IRQHandle(struct ExceptionContext *regs, unsigned long error_code, uns
 #endif
             pdata->kb_PDFlags &= ~PLATFORMF_INIRQ;
         }
+#if defined(__AROSEXEC_SMP__)
+        if ((schedData) && (--schedData->WakeupBatch == 0))
+            core_FlushWakeups();
+#endif
         /*
          * Upon exit from the lowest-level device IRQ, if we are returning to user mode,
          * we check if we need to call software interrupts or run the task scheduler.
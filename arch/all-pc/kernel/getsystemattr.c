@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc:
 */
@@ -10,6 +10,7 @@
 
 #include <kernel_base.h>
 #include "kernel_intern.h"
+#include "kernel_scheduler.h"
 
 
 /*****************************************************************************
@@ -33,6 +34,12 @@
 
           KATTR_PeripheralBase [.G] IPTR   - IO Base address for ARM peripherals
 
+          KATTR_Wakeups [.G] IPTR          - Number of times a CPU was asked to reschedule
+                                             by another one (SMP only).
+
+          KATTR_WakeupsCoalesced [.G] IPTR - Number of those requests that were merged
+                                             into one already pending (SMP only).
+
     INPUTS
         id - ID of the attribute to get
 
@@ -72,6 +79,15 @@
     {
         retval = (intptr_t)KernelBase->kb_ClockSource;
     }
+#if defined(__AROSEXEC_SMP__)
+    else if ((id == KATTR_Wakeups) || (id == KATTR_WakeupsCoalesced))
+    {
+        IPTR wakeups, coalesced;
+
+        core_WakeupStats(&wakeups, &coalesced);
+        retval = (intptr_t)((id == KATTR_Wakeups) ? wakeups : coalesced);
+    }
+#endif
     
     return retval;
 
@@ -8,6 +8,7 @@
     Lang: english
 */
 
+#include <aros/config.h>
 #include <exec/nodes.h>
 #include <exec/lists.h>
 #include <aros/types/spinlock_s.h>
@@ -25,6 +26,8 @@
  */
 /*#define EMULATE_SYSBASE*/
 
+struct Task;
+
 /* Platform-specific part of KernelBase */
 struct PlatformData
 {
@@ -52,6 +55,14 @@ struct PlatformData
     };
     struct IntrNode     *kb_LastIntr;   
     UWORD               kb_LastInt;
+#if defined(__AROSEXEC_SMP__)
+    /* Per-CPU RunQueue access for exec (see kernel_scheduler.c) */
+    void                (*kb_QueueReadyTask)(struct Task *);
+    void                (*kb_UnqueueReadyTask)(struct Task *);
+    struct Task         *(*kb_WalkReadyQueues)(struct Task *(*)(struct List *, APTR), APTR);
+    void                (*kb_FlushWakeups)(void);
+    BOOL                (*kb_TaskRunningOn)(cpuid_t, struct Task *);
+#endif
 };
 
 #define PLATFORMB_PRIMED        0
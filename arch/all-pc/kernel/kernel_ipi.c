@@ -22,6 +22,43 @@
 
 #define D(x)
 
+static void core_SendIPICmd(struct APICData *apicPrivate, int cpunum, int target, ULONG cmd)
+{
+    IPTR __APICBase = apicPrivate->lapicBase;
+
+    D(bug("[Kernel:IPI] waiting for DS bit to be clear\n"));
+    while (APIC_REG(__APICBase, APIC_ICRL) & ICR_DS) asm volatile("pause");
+    if (cpunum == target)
+    {
+        D(bug("[Kernel:IPI] sending IPI cmd %08x to destination %08x (self-ipi)\n", cmd, (apicPrivate->cores[target].cpu_LocalID << 24)));
+        APIC_REG(__APICBase, APIC_ICRL) = cmd | ICR_DSH_SELF;
+    }
+    else
+    {
+        D(bug("[Kernel:IPI] sending IPI cmd %08x to destination %08x\n", cmd, (apicPrivate->cores[target].cpu_LocalID << 24)));
+        APIC_REG(__APICBase, APIC_ICRH) = (apicPrivate->cores[target].cpu_LocalID << 24);
+        APIC_REG(__APICBase, APIC_ICRL) = cmd;
+    }
+}
+
+/* Send an IPI to a single CPU, without the need to build a cpu mask */
+void core_DoIPICPU(uint8_t ipi_number, int cpu_number, struct KernelBase *KernelBase)
+{
+    int cpunum = KrnGetCPUNumber();
+    ULONG cmd = APIC_CPU_EXCEPT_TO_VECTOR(APIC_EXCEPT_IPI_NOP + ipi_number) | ICR_INT_ASSERT;
+    struct PlatformData *kernPlatD = (struct PlatformData *)KernelBase->kb_PlatformData;
+    struct APICData *apicPrivate = kernPlatD->kb_APIC;
+
+    D(bug("[Kernel:IPI] Sending IPI %02d from CPU.%03u to CPU.%03u\n", ipi_number, cpunum, cpu_number));
+
+    if ((!apicPrivate) || (cpu_number >= apicPrivate->apic_count))
+        return;
+
+    asm volatile("sfence");
+
+    core_SendIPICmd(apicPrivate, cpunum, cpu_number, cmd);
+}
+
 void core_DoIPI(uint8_t ipi_number, void *cpu_mask, struct KernelBase *KernelBase)
 {
     int cpunum = KrnGetCPUNumber();
@@ -65,21 +102,7 @@ void core_DoIPI(uint8_t ipi_number, void *cpu_mask, struct KernelBase *KernelBas
             for (i=0; i < apicPrivate->apic_count; i++)
             {
                 if (KrnCPUInMask(i, cpu_mask))
-                {
-                    D(bug("[Kernel:IPI] waiting for DS bit to be clear\n"));
-                    while (APIC_REG(__APICBase, APIC_ICRL) & ICR_DS) asm volatile("pause");
-                    if (cpunum == i)
-                    {
-                        D(bug("[Kernel:IPI] sending IPI cmd %08x to destination %08x (self-ipi)\n", cmd, (apicPrivate->cores[i].cpu_LocalID << 24)));
-                        APIC_REG(__APICBase, APIC_ICRL) = cmd | ICR_DSH_SELF;
-                    }
-                    else
-                    {
-                        D(bug("[Kernel:IPI] sending IPI cmd %08x to destination %08x\n", cmd, (apicPrivate->cores[i].cpu_LocalID << 24)));
-                        APIC_REG(__APICBase, APIC_ICRH) = (apicPrivate->cores[i].cpu_LocalID << 24);
-                        APIC_REG(__APICBase, APIC_ICRL) = cmd;
-                    }
-                }
+                    core_SendIPICmd(apicPrivate, cpunum, i, cmd);
             }
         }
     }
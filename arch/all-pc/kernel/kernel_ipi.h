@@ -22,6 +22,7 @@
 
 int core_IPIHandle(struct ExceptionContext *regs, void *data1, struct KernelBase *KernelBase);
 void core_DoIPI(uint8_t ipi_number, void *cpu_mask, struct KernelBase *KernelBase);
+void core_DoIPICPU(uint8_t ipi_number, int cpu_number, struct KernelBase *KernelBase);
 int core_DoCallIPI(struct Hook *hook, void *cpu_mask, int async, int nargs, IPTR *args, APTR _KB);
 
 #define IPI_CALL_HOOK_MAX_ARGS  5
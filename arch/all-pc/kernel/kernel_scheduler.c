@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2017-2023, The AROS Development Team. All rights reserved.
+    Copyright (C) 2017-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <exec/alerts.h>
@@ -25,8 +25,11 @@
 #define __AROS_KERNEL__
 
 #include "exec_intern.h"
+#include "exec_trace.h"
 
 #include "apic.h"
+#include "kernel_intern.h"
+#include "kernel_ipi.h"
 
 #define LOWSTACKWARN
 #define SCHEDULERASCII_DEBUG
@@ -53,12 +56,478 @@
 #endif
 
 #if defined(__AROSEXEC_SMP__)
+/*
+ * Each core owns a RunQueue (see kernel_runqueue.h) of the tasks it will dispatch.
+ * Ready tasks are placed on a core that satisfies their affinity when they
+ * are queued, so dispatching only has to look at the local queue. Cores that
+ * run out of work steal from the queues of other cores.
+ * SysBase->TaskReady is still honoured as a shared queue for tasks that are
+ * readied before the RunQueues are usable, or by code that enqueues
+ * directly onto it.
+ */
+#define SCHED_NOTASKPRI         KRNRQ_NOTASKPRI
+#define SCHED_IDLEPRI           (-128)
+/* A busy core always has its idle task queued, so it needs more than that to be worth stealing from */
+#define SCHED_STEALMIN          1
+
 void core_InitScheduleData(struct X86SchedulerPrivate *schedData)
 {
+    int i;
+
     DSCHED(bug("[Kernel]" DEBUGFUNCCOLOR_SET " %s(0x%p)" DEBUGCOLOR_RESET "\n", __func__, schedData);)
+    krnRunQueueInit(&schedData->RunQueue);
+    KrnSpinInit(&schedData->RunQueueLock);
+    schedData->RunningPri = SCHED_NOTASKPRI;
+    schedData->RunQueueCount = 0;
+    schedData->DispatchCount = 0;
+    schedData->StealCount = 0;
+    schedData->WakeupBatch = 0;
+    schedData->WakeupsDeferred = 0;
+    for (i = 0; i < SCHED_CPUMASKLONGS; i++)
+        schedData->DeferredResched[i] = 0;
+    schedData->WakeupCount = 0;
+    schedData->CoalescedCount = 0;
     schedData->Granularity = SCHEDGRAN_VALUE;
     schedData->Quantum = SCHEDQUANTUM_VALUE;
 }
+
+static inline struct APICData *core_SchedGetAPICData(void)
+{
+    struct PlatformData *pdata = KernelBase->kb_PlatformData;
+
+    if (pdata)
+        return pdata->kb_APIC;
+    return NULL;
+}
+
+static struct X86SchedulerPrivate *core_SchedGetData(struct APICData *apicData, cpuid_t cpuNo)
+{
+    tls_t *apicTLS;
+
+    if (!apicData)
+    {
+        /* Uniprocessor - only our own data is available */
+        if (cpuNo == 0)
+            return TLS_GET(ScheduleData);
+        return NULL;
+    }
+    if ((cpuNo < apicData->apic_count) && ((apicTLS = apicData->cores[cpuNo].cpu_TLS) != NULL))
+        return apicTLS->ScheduleData;
+
+    return NULL;
+}
+
+static inline BOOL core_SchedTaskCanRun(struct Task *task, cpuid_t cpuNo)
+{
+    if (!(PrivExecBase(SysBase)->IntFlags & EXECF_CPUAffinity))
+        return TRUE;
+
+    return (GetIntETask(task) && core_APIC_CPUInMask(cpuNo, GetIntETask(task)->iet_CpuAffinity));
+}
+
+/* Return the priority of the best task in the list that may run on cpuNo */
+static LONG core_SchedListBestPri(struct List *taskList, spinlock_t *listLock, cpuid_t cpuNo)
+{
+    struct Task *task;
+    LONG pri = SCHED_NOTASKPRI;
+
+    if (IsListEmpty(taskList))
+        return pri;
+
+    KrnSpinLock(listLock, NULL, SPINLOCK_MODE_READ);
+    ForeachNode(taskList, task)
+    {
+        if (core_SchedTaskCanRun(task, cpuNo))
+        {
+            pri = task->tc_Node.ln_Pri;
+            break;
+        }
+    }
+    KrnSpinUnLock(listLock);
+
+    return pri;
+}
+
+/* Return the priority of the best task in a cores RunQueue that may run on cpuNo */
+static LONG core_SchedRunQueueBestPri(struct X86SchedulerPrivate *schedData, cpuid_t cpuNo)
+{
+    struct Task *task;
+    LONG level = KRNRQ_LEVELS, pri = SCHED_NOTASKPRI;
+
+    if (!schedData->RunQueueCount)
+        return pri;
+
+    KrnSpinLock(&schedData->RunQueueLock, NULL, SPINLOCK_MODE_READ);
+    while ((pri == SCHED_NOTASKPRI) &&
+           ((level = krnRunQueueNextLevel(&schedData->RunQueue, level)) != KRNRQ_NOLEVEL))
+    {
+        ForeachNode(krnRunQueueList(&schedData->RunQueue, level), task)
+        {
+            if (core_SchedTaskCanRun(task, cpuNo))
+            {
+                pri = KRNRQ_PRI(level);
+                break;
+            }
+        }
+    }
+    KrnSpinUnLock(&schedData->RunQueueLock);
+
+    return pri;
+}
+
+/* Remove the best task of at least minPri from a cores RunQueue that may run on cpuNo */
+static struct Task *core_SchedRunQueueTake(struct X86SchedulerPrivate *schedData, cpuid_t cpuNo, LONG minPri)
+{
+    struct Task *task, *found = NULL;
+    LONG level = KRNRQ_LEVELS;
+
+    if (!schedData->RunQueueCount)
+        return NULL;
+
+    KrnSpinLock(&schedData->RunQueueLock, NULL, SPINLOCK_MODE_WRITE);
+    while ((!found) &&
+           ((level = krnRunQueueNextLevel(&schedData->RunQueue, level)) != KRNRQ_NOLEVEL) &&
+           (KRNRQ_PRI(level) >= minPri))
+    {
+        ForeachNode(krnRunQueueList(&schedData->RunQueue, level), task)
+        {
+            if (core_SchedTaskCanRun(task, cpuNo))
+            {
+                REMOVE(&task->tc_Node);
+                if (IsListEmpty(krnRunQueueList(&schedData->RunQueue, level)))
+                    krnRunQueueClrLevel(&schedData->RunQueue, level);
+                schedData->RunQueueCount--;
+                GetIntETask(task)->iet_RunQueue = NULL;
+                found = task;
+                break;
+            }
+        }
+    }
+    KrnSpinUnLock(&schedData->RunQueueLock);
+
+    return found;
+}
+
+/* Remove the best task from the shared ready list that may run on cpuNo */
+static struct Task *core_SchedSharedTake(cpuid_t cpuNo)
+{
+    struct Task *task, *found = NULL;
+
+    if (IsListEmpty(&SysBase->TaskReady))
+        return NULL;
+
+    KrnSpinLock(&PrivExecBase(SysBase)->TaskReadySpinLock, NULL,
+                SPINLOCK_MODE_WRITE);
+    ForeachNode(&SysBase->TaskReady, task)
+    {
+        if (core_SchedTaskCanRun(task, cpuNo))
+        {
+            REMOVE(&task->tc_Node);
+            found = task;
+            break;
+        }
+    }
+    KrnSpinUnLock(&PrivExecBase(SysBase)->TaskReadySpinLock);
+
+    return found;
+}
+
+/* Take a task of at least minPri, that may run on cpuNo, from another cores RunQueue */
+static struct Task *core_SchedSteal(struct APICData *apicData, cpuid_t cpuNo, LONG minPri)
+{
+    struct X86SchedulerPrivate *victimData;
+    struct Task *task = NULL;
+    cpuid_t victim;
+    ULONG cpuCount, i;
+
+    if (!apicData || ((cpuCount = apicData->apic_count) < 2))
+        return NULL;
+
+    /* start with our neighbour, so that idle cores don't all pick on the same victim */
+    for (i = 1; (i < cpuCount) && (!task); i++)
+    {
+        victim = (cpuNo + i) % cpuCount;
+        if (((victimData = core_SchedGetData(apicData, victim)) != NULL) &&
+            (victimData->RunQueueCount > SCHED_STEALMIN))
+        {
+            task = core_SchedRunQueueTake(victimData, cpuNo, minPri);
+        }
+    }
+
+    return task;
+}
+
+/* Is there queued work on other cores that this core could steal? */
+static BOOL core_SchedCanSteal(struct APICData *apicData, cpuid_t cpuNo)
+{
+    struct X86SchedulerPrivate *victimData;
+    ULONG i;
+
+    if (!apicData)
+        return FALSE;
+
+    for (i = 0; i < apicData->apic_count; i++)
+    {
+        if ((i != cpuNo) &&
+            ((victimData = core_SchedGetData(apicData, i)) != NULL) &&
+            (victimData->RunQueueCount > SCHED_STEALMIN))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/*
+ * Wakeups of tasks on other cores are coalesced while this core is handling
+ * an interrupt, or the running task is in Forbid() - the same windows in which
+ * a reschedule of this core itself is only flagged. The target cores are
+ * collected in DeferredResched, and each receives a single reschedule IPI
+ * once the window closes (interrupt exit, Permit() or the next task switch).
+ */
+void core_ScheduleCPUDeferred(cpuid_t targetCPU)
+{
+    struct X86SchedulerPrivate *schedData = TLS_GET(ScheduleData);
+    ULONG bit, old;
+
+    if ((!schedData) || (targetCPU >= (SCHED_CPUMASKLONGS * 32)))
+    {
+        core_DoIPICPU(IPI_RESCHEDULE, targetCPU, KernelBase);
+        return;
+    }
+
+    schedData->WakeupCount++;
+    if ((schedData->WakeupBatch == 0) && (schedData->TDNestCnt < 0))
+    {
+        core_DoIPICPU(IPI_RESCHEDULE, targetCPU, KernelBase);
+        return;
+    }
+
+    bit = 1 << (targetCPU & 31);
+    old = __atomic_fetch_or(&schedData->DeferredResched[targetCPU >> 5], bit, __ATOMIC_RELAXED);
+    if (old & bit)
+        schedData->CoalescedCount++;
+    else
+        __atomic_store_n(&schedData->WakeupsDeferred, 1, __ATOMIC_RELEASE);
+
+    DSCHED(bug("[Kernel:%03u]" DEBUGCOLOR_SET " %s: Deferred reschedule of CPU #%03u%s" DEBUGCOLOR_RESET "\n", KrnGetCPUNumber(), __func__, targetCPU, (old & bit) ? " (coalesced)" : "");)
+}
+
+/*
+ * Called from Permit() with interrupts enabled, and from IRQs that flush
+ * the wakeups themselves. Interrupts are kept off while sending, as an
+ * IRQ sending its own IPI between the two ICR writes would redirect ours.
+ * Each word of the bitmap is still taken atomically, so every IPI is sent
+ * exactly once.
+ */
+void core_FlushWakeups(void)
+{
+    struct X86SchedulerPrivate *schedData = TLS_GET(ScheduleData);
+    struct APICData *apicData = core_SchedGetAPICData();
+    ULONG cpuCount = apicData ? apicData->apic_count : 1;
+    ULONG i, pending;
+    unsigned long flags;
+
+    if ((!schedData) || (!__atomic_exchange_n(&schedData->WakeupsDeferred, 0, __ATOMIC_ACQ_REL)))
+        return;
+
+    __save_flags(flags);
+    __cli();
+
+    for (i = 0; (i < SCHED_CPUMASKLONGS) && (i * 32 < cpuCount); i++)
+    {
+        pending = __atomic_exchange_n(&schedData->DeferredResched[i], 0, __ATOMIC_ACQ_REL);
+        while (pending)
+        {
+            ULONG bitNo = __builtin_ctz(pending);
+
+            pending &= ~(1 << bitNo);
+            core_DoIPICPU(IPI_RESCHEDULE, (i * 32) + bitNo, KernelBase);
+        }
+    }
+
+    __restore_flags(flags);
+}
+
+void core_WakeupStats(IPTR *wakeups, IPTR *coalesced)
+{
+    struct APICData *apicData = core_SchedGetAPICData();
+    struct X86SchedulerPrivate *schedData;
+    ULONG cpuCount = apicData ? apicData->apic_count : 1;
+    cpuid_t i;
+
+    *wakeups = 0;
+    *coalesced = 0;
+    for (i = 0; i < cpuCount; i++)
+    {
+        if ((schedData = core_SchedGetData(apicData, i)) != NULL)
+        {
+            *wakeups += schedData->WakeupCount;
+            *coalesced += schedData->CoalescedCount;
+        }
+    }
+}
+
+/*
+ * Place a ready task on a RunQueue. We prefer the core it last ran on
+ * (while its caches are still warm) unless this core is allowed to run it
+ * and is less loaded, and otherwise the least loaded core in its affinity.
+ */
+void core_QueueReadyTask(struct Task *task)
+{
+    struct APICData *apicData = core_SchedGetAPICData();
+    struct IntETask *taskIntET = GetIntETask(task);
+    struct X86SchedulerPrivate *schedData = NULL, *cpuSchedData;
+    cpuid_t cpuNo = KrnGetCPUNumber(), targetCPU = cpuNo, lastCPU, i;
+    ULONG cpuCount = apicData ? apicData->apic_count : 1;
+
+    DSCHED(bug("[Kernel:%03u]" DEBUGFUNCCOLOR_SET " %s(0x%p)" DEBUGCOLOR_RESET "\n", cpuNo, __func__, task);)
+
+    if (taskIntET)
+    {
+        lastCPU = (cpuid_t)taskIntET->iet_CpuNumber;
+        if ((lastCPU < cpuCount) && core_SchedTaskCanRun(task, lastCPU) &&
+            ((schedData = core_SchedGetData(apicData, lastCPU)) != NULL))
+            targetCPU = lastCPU;
+
+        if ((targetCPU != cpuNo) && core_SchedTaskCanRun(task, cpuNo) &&
+            ((cpuSchedData = core_SchedGetData(apicData, cpuNo)) != NULL) &&
+            ((!schedData) || (cpuSchedData->RunQueueCount < schedData->RunQueueCount)))
+        {
+            schedData = cpuSchedData;
+            targetCPU = cpuNo;
+        }
+
+        if (!schedData)
+        {
+            for (i = 0; i < cpuCount; i++)
+            {
+                if (core_SchedTaskCanRun(task, i) &&
+                    ((cpuSchedData = core_SchedGetData(apicData, i)) != NULL) &&
+                    ((!schedData) || (cpuSchedData->RunQueueCount < schedData->RunQueueCount)))
+                {
+                    schedData = cpuSchedData;
+                    targetCPU = i;
+                }
+            }
+        }
+    }
+
+    if (!schedData)
+    {
+        /* No usable RunQueue - fall back to the shared ready list */
+        DSCHED(bug("[Kernel:%03u]" DEBUGCOLOR_SET " %s: Queueing '%s' @ 0x%p on the shared list" DEBUGCOLOR_RESET "\n", cpuNo, __func__, task->tc_Node.ln_Name, task);)
+        KrnSpinLock(&PrivExecBase(SysBase)->TaskReadySpinLock, NULL,
+                SPINLOCK_MODE_WRITE);
+        Enqueue(&SysBase->TaskReady, &task->tc_Node);
+        KrnSpinUnLock(&PrivExecBase(SysBase)->TaskReadySpinLock);
+        return;
+    }
+
+    DSCHED(bug("[Kernel:%03u]" DEBUGCOLOR_SET " %s: Queueing '%s' @ 0x%p on CPU #%03u" DEBUGCOLOR_RESET "\n", cpuNo, __func__, task->tc_Node.ln_Name, task, targetCPU);)
+    KrnSpinLock(&schedData->RunQueueLock, NULL, SPINLOCK_MODE_WRITE);
+    krnRunQueueAdd(&schedData->RunQueue, task);
+    schedData->RunQueueCount++;
+    taskIntET->iet_RunQueue = schedData;
+    KrnSpinUnLock(&schedData->RunQueueLock);
+
+    /* Kick the target core if the task should preempt what it is running */
+    if (targetCPU != cpuNo)
+    {
+        /*
+         * Use the priority cached by the target core - its RunningTask may
+         * change or be freed under us, so it must not be dereferenced here.
+         */
+        if (*(volatile LONG *)&schedData->RunningPri < task->tc_Node.ln_Pri)
+            core_ScheduleCPUDeferred(targetCPU);
+    }
+}
+
+/* Remove a ready task from whichever queue it is on */
+void core_UnqueueReadyTask(struct Task *task)
+{
+    struct IntETask *taskIntET = GetIntETask(task);
+    struct X86SchedulerPrivate *schedData;
+
+    DSCHED(bug("[Kernel]" DEBUGFUNCCOLOR_SET " %s(0x%p)" DEBUGCOLOR_RESET "\n", __func__, task);)
+
+    /* The task may be stolen by another core while we wait for the lock, so recheck */
+    while (taskIntET && ((schedData = taskIntET->iet_RunQueue) != NULL))
+    {
+        KrnSpinLock(&schedData->RunQueueLock, NULL, SPINLOCK_MODE_WRITE);
+        if (taskIntET->iet_RunQueue == schedData)
+        {
+            krnRunQueueRemove(&schedData->RunQueue, task);
+            schedData->RunQueueCount--;
+            taskIntET->iet_RunQueue = NULL;
+            KrnSpinUnLock(&schedData->RunQueueLock);
+            return;
+        }
+        KrnSpinUnLock(&schedData->RunQueueLock);
+    }
+
+    if (task->tc_State == TS_READY)
+    {
+        KrnSpinLock(&PrivExecBase(SysBase)->TaskReadySpinLock, NULL,
+                SPINLOCK_MODE_WRITE);
+        REMOVE(&task->tc_Node);
+        KrnSpinUnLock(&PrivExecBase(SysBase)->TaskReadySpinLock);
+    }
+}
+
+/*
+ * Call walkFunc on each cores RunQueue (read locked) until it returns non-NULL.
+ * Used by exec to keep the ready tasks visible when looking them up.
+ */
+struct Task *core_WalkReadyQueues(struct Task *(*walkFunc)(struct List *, APTR), APTR walkData)
+{
+    struct APICData *apicData = core_SchedGetAPICData();
+    struct X86SchedulerPrivate *schedData;
+    struct Task *task = NULL;
+    ULONG cpuCount = apicData ? apicData->apic_count : 1, i;
+
+    for (i = 0; (i < cpuCount) && (!task); i++)
+    {
+        if ((schedData = core_SchedGetData(apicData, i)) != NULL)
+        {
+            KrnSpinLock(&schedData->RunQueueLock, NULL, SPINLOCK_MODE_READ);
+            task = krnRunQueueWalk(&schedData->RunQueue, walkFunc, walkData);
+            KrnSpinUnLock(&schedData->RunQueueLock);
+        }
+    }
+
+    return task;
+}
+
+/*
+ * Is task the one running on core cpuNo right now? Only compares the
+ * pointer, so task may already be gone.
+ */
+BOOL core_TaskRunningOn(cpuid_t cpuNo, struct Task *task)
+{
+    struct X86SchedulerPrivate *schedData = core_SchedGetData(core_SchedGetAPICData(), cpuNo);
+
+    return (schedData && (*(struct Task * volatile *)&schedData->RunningTask == task));
+}
+#endif
+
+#if defined(EXEC_RUNQUEUE)
+/*
+ * Ready tasks are taken from exec's run queue, but somebody may still have
+ * Enqueue()'d a task onto SysBase->TaskReady directly, so look at both.
+ * Returns the task list head to use, or NULL for the run queue.
+ */
+static struct Task *core_ReadyListHead(LONG *bestpri)
+{
+    struct Task *head = (struct Task *)GetHead(&SysBase->TaskReady);
+    LONG pri = krnRunQueueBestPri(&PrivExecBase(SysBase)->TaskReadyQueue);
+
+    if (head && (head->tc_Node.ln_Pri >= pri))
+    {
+        *bestpri = head->tc_Node.ln_Pri;
+        return head;
+    }
+    *bestpri = pri;
+    return NULL;
+}
 #endif
 
 /* Check if the currently running task on this cpu should be rescheduled.. */
@@ -101,44 +570,51 @@ BOOL core_Schedule(void)
         else if (!(task->tc_Flags & TF_EXCEPT))
         {
 #if defined(__AROSEXEC_SMP__)
-            KrnSpinLock(&PrivExecBase(SysBase)->TaskReadySpinLock, NULL,
-                        SPINLOCK_MODE_READ);
-#endif
-            /* Is the TaskReady empty? If yes, then the running task is the only one. Let it work */
-            if (IsListEmpty(&SysBase->TaskReady))
+            struct X86SchedulerPrivate *schedData = TLS_GET(ScheduleData);
+            LONG nextpri, sharedpri;
+
+            /* Pick up priority changes made to the running task since it was dispatched */
+            schedData->RunningPri = task->tc_Node.ln_Pri;
+
+            /* Find the best task ready for this cpu, in our RunQueue or the shared list */
+            nextpri = core_SchedRunQueueBestPri(schedData, cpuNo);
+            sharedpri = core_SchedListBestPri(&SysBase->TaskReady, &PrivExecBase(SysBase)->TaskReadySpinLock, cpuNo);
+            if (sharedpri > nextpri)
+                nextpri = sharedpri;
+
+            if (nextpri == SCHED_NOTASKPRI)
+            {
+                /* Nothing queued for us - but if we are idle, go and help the other cores */
+                if ((task->tc_Node.ln_Pri > SCHED_IDLEPRI) || !core_SchedCanSteal(core_SchedGetAPICData(), cpuNo))
+                    corereschedule = FALSE;
+            }
+            else if ((task->tc_State != TS_SPIN) &&
+                     (nextpri <= task->tc_Node.ln_Pri))
+            {
+                /* If the running task did not used it's whole quantum yet, let it work */
+                if (!FLAG_SCHEDQUANTUM_ISSET)
+                    corereschedule = FALSE;
+            }
+#else
+            LONG nextpri;
+
+            /* Are there no other ready tasks? If yes, then the running task is the only one. Let it work */
+            core_ReadyListHead(&nextpri);
+            if (nextpri == KRNRQ_NOTASKPRI)
                 corereschedule = FALSE;
             else
             {
-                struct Task *nexttask;
                 /*
                         If there are tasks ready for this cpu that have equal or lower priority,
                         and the current task has used its alloted time - reschedule so they can run
                     */
-                for (nexttask = (struct Task *)GetHead(&SysBase->TaskReady); nexttask != NULL; nexttask = (struct Task *)GetSucc(nexttask))
+                if (nextpri <= task->tc_Node.ln_Pri)
                 {
-#if defined(__AROSEXEC_SMP__)
-                    if (!(PrivExecBase(SysBase)->IntFlags & EXECF_CPUAffinity) || (GetIntETask(nexttask) && core_APIC_CPUInMask(cpuNo, GetIntETask(nexttask)->iet_CpuAffinity)))
-                    {
-#endif
-                     if (
-#if defined(__AROSEXEC_SMP__)
-                            (task->tc_State != TS_SPIN) &&
-
-#endif
-                            (nexttask->tc_Node.ln_Pri <= task->tc_Node.ln_Pri))
-                        {
-                            /* If the running task did not used it's whole quantum yet, let it work */
-                            if (!FLAG_SCHEDQUANTUM_ISSET)
-                                corereschedule = FALSE;
-                        }
-                        break;
-#if defined(__AROSEXEC_SMP__)
-                    }
-#endif
+                    /* If the running task did not used it's whole quantum yet, let it work */
+                    if (!FLAG_SCHEDQUANTUM_ISSET)
+                        corereschedule = FALSE;
                 }
             }
-#if defined(__AROSEXEC_SMP__)
-            KrnSpinUnLock(&PrivExecBase(SysBase)->TaskReadySpinLock);
 #endif
         }
 
@@ -211,6 +687,7 @@ void core_Switch(void)
     REMOVE(&task->tc_Node);
 #if defined(__AROSEXEC_SMP__)
     KrnSpinUnLock(&PrivExecBase(SysBase)->TaskRunningSpinLock);
+    ((struct X86SchedulerPrivate *)TLS_GET(ScheduleData))->RunningPri = SCHED_NOTASKPRI;
     if (task->tc_State == TS_REMOVED)
         task->tc_State = TS_TOMBSTONED;
 #endif
@@ -252,12 +729,9 @@ void core_Switch(void)
 
         DSCHED(bug("[Kernel:%03u]" DEBUGCOLOR_SET " %s: Setting '%s' @ 0x%p as ready" DEBUGCOLOR_RESET "\n", cpuNo, __func__, task->tc_Node.ln_Name, task);)
 #if defined(__AROSEXEC_SMP__)
-        KrnSpinLock(&PrivExecBase(SysBase)->TaskReadySpinLock, NULL,
-                SPINLOCK_MODE_WRITE);
-#endif
-        Enqueue(&SysBase->TaskReady, &task->tc_Node);
-#if defined(__AROSEXEC_SMP__)
-        KrnSpinUnLock(&PrivExecBase(SysBase)->TaskReadySpinLock);
+        core_QueueReadyTask(task);
+#else
+        EXEC_READYTASK(task);
 #endif
     }
 #if defined(__AROSEXEC_SMP__)
@@ -281,11 +755,16 @@ void core_Switch(void)
         KrnSpinLock(&PrivExecBase(SysBase)->TaskWaitSpinLock, NULL,
                     SPINLOCK_MODE_WRITE);
 #endif
-        Enqueue(&SysBase->TaskWait, &task->tc_Node);
+        /* TaskWait isn't kept in priority order, so don't pay for Enqueue() */
+        AddTail(&SysBase->TaskWait, &task->tc_Node);
 #if defined(__AROSEXEC_SMP__)
         KrnSpinUnLock(&PrivExecBase(SysBase)->TaskWaitSpinLock);
 #endif
     }
+#if defined(__AROSEXEC_SMP__)
+    /* The task leaving this core may have been signalling from within Forbid() */
+    core_FlushWakeups();
+#endif
     if (showAlert)
         Alert(showAlert);
 }
@@ -302,23 +781,43 @@ struct Task *core_Dispatch(void)
     DSCHED(bug("[Kernel:%03u]" DEBUGFUNCCOLOR_SET " %s()" DEBUGCOLOR_RESET "\n", cpuNo, __func__);)
 
 #if defined(__AROSEXEC_SMP__)
-    KrnSpinLock(&PrivExecBase(SysBase)->TaskReadySpinLock, NULL,
-                SPINLOCK_MODE_WRITE);
-#endif
-    for (newtask = (struct Task *)GetHead(&SysBase->TaskReady); newtask != NULL; newtask = (struct Task *)GetSucc(newtask))
     {
-#if defined(__AROSEXEC_SMP__)
-        if (!(PrivExecBase(SysBase)->IntFlags & EXECF_CPUAffinity) || (GetIntETask(newtask) && core_APIC_CPUInMask(cpuNo, GetIntETask(newtask)->iet_CpuAffinity)))
+        struct X86SchedulerPrivate *schedData = TLS_GET(ScheduleData);
+        LONG localpri, sharedpri, bestpri;
+
+        localpri = core_SchedRunQueueBestPri(schedData, cpuNo);
+        sharedpri = core_SchedListBestPri(&SysBase->TaskReady, &PrivExecBase(SysBase)->TaskReadySpinLock, cpuNo);
+        bestpri = (sharedpri > localpri) ? sharedpri : localpri;
+
+        newtask = NULL;
+
+        /* Only idle work left for this core? Try to take some from a busier one .. */
+        if (bestpri <= SCHED_IDLEPRI)
         {
-#endif
-            REMOVE(&newtask->tc_Node);
-            break;
-#if defined(__AROSEXEC_SMP__)
+            if ((newtask = core_SchedSteal(core_SchedGetAPICData(), cpuNo, SCHED_IDLEPRI + 1)) != NULL)
+            {
+                schedData->StealCount++;
+                DSCHED(bug("[Kernel:%03u]" DEBUGCOLOR_SET " %s: Stole '%s' @ 0x%p" DEBUGCOLOR_RESET "\n", cpuNo, __func__, newtask->tc_Node.ln_Name, newtask);)
+            }
         }
-#endif
+
+        /* Shared list tasks win ties, so they cannot be starved by the RunQueue */
+        if ((!newtask) && (sharedpri != SCHED_NOTASKPRI) && (sharedpri >= localpri))
+            newtask = core_SchedSharedTake(cpuNo);
+        if (!newtask)
+            newtask = core_SchedRunQueueTake(schedData, cpuNo, SCHED_NOTASKPRI);
+        if (!newtask)
+            newtask = core_SchedSharedTake(cpuNo);
+    }
+#else
+    {
+        LONG bestpri;
+
+        if ((newtask = core_ReadyListHead(&bestpri)) != NULL)
+            REMOVE(&newtask->tc_Node);
+        else
+            newtask = krnRunQueueRemHead(&PrivExecBase(SysBase)->TaskReadyQueue);
     }
-#if defined(__AROSEXEC_SMP__)
-    KrnSpinUnLock(&PrivExecBase(SysBase)->TaskReadySpinLock);
 #endif
 
     if ((!newtask) && (task) && (task->tc_State != TS_WAIT))
@@ -390,7 +889,7 @@ bug("----> such unspinning should not take place!" DEBUGCOLOR_RESET "\n");
             KrnSpinLock(&PrivExecBase(SysBase)->TaskWaitSpinLock, NULL,
                         SPINLOCK_MODE_WRITE);
 #endif
-            Enqueue(&SysBase->TaskWait, &newtask->tc_Node);
+            AddTail(&SysBase->TaskWait, &newtask->tc_Node);
 #if defined(__AROSEXEC_SMP__)
             KrnSpinUnLock(&PrivExecBase(SysBase)->TaskWaitSpinLock);
 #endif
@@ -406,11 +905,17 @@ bug("----> such unspinning should not take place!" DEBUGCOLOR_RESET "\n");
         }
         else
         {
+#if defined(__AROSEXEC_SMP__)
+            struct X86SchedulerPrivate *schedData = TLS_GET(ScheduleData);
+
+            schedData->DispatchCount++;
+#endif
 #if defined(AROS_NO_ATOMIC_OPERATIONS)
             SysBase->DispCount++;
 #else
             AROS_ATOMIC_INC(SysBase->DispCount);
 #endif
+            EXEC_TRACE(ETF_SCHED, ETT_DISPATCH, newtask, task);
             DSCHED(bug("[Kernel:%03u]" DEBUGCOLOR_SET " %s: Launching '%s' @ 0x%p (state %08X)" DEBUGCOLOR_RESET "\n", cpuNo, __func__, newtask->tc_Node.ln_Name, newtask, newtask->tc_State);)
         }
     }
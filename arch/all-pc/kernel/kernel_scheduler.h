@@ -1,7 +1,7 @@
 #ifndef KERNEL_SCHEDULER_H
 #define KERNEL_SCHEDULER_H
 /*
-    Copyright  2017, The AROS Development Team. All rights reserved.
+    Copyright  2017-2026, The AROS Development Team. All rights reserved.
     $Id$
 
     Desc:
@@ -11,10 +11,27 @@
 
 #if defined(__AROSEXEC_SMP__)
 #include <exec/tasks.h>
+#include <aros/types/spinlock_s.h>
+#include <kernel_runqueue.h>
+
+/* Enough ULONGs for a bitmap of 256 cores */
+#define SCHED_CPUMASKLONGS      8
 
 struct X86SchedulerPrivate
 {
     struct Task         *RunningTask;   /* Currently running task on this core                  */
+    LONG                RunningPri;     /* Its priority, only written by this core              */
+    struct KrnRunQueue  RunQueue;       /* Tasks ready to run on this core, by priority         */
+    spinlock_t          RunQueueLock;
+    ULONG               RunQueueCount;  /* # of tasks in RunQueue                               */
+    ULONG               DispatchCount;  /* # of tasks dispatched on this core                   */
+    ULONG               StealCount;     /* # of tasks taken from other cores RunQueues          */
+
+    ULONG               WakeupBatch;    /* Nesting count of IRQs deferring reschedule IPIs      */
+    volatile ULONG      WakeupsDeferred;/* Set while DeferredResched has bits set               */
+    ULONG               DeferredResched[SCHED_CPUMASKLONGS]; /* Cores owed a reschedule IPI     */
+    ULONG               WakeupCount;    /* # of reschedule IPIs this core asked for             */
+    ULONG               CoalescedCount; /* # of those merged into one that was already deferred */
 
     ULONG               ScheduleFlags;
     UWORD               Granularity;    /* length of one heartbear tick                         */
@@ -30,5 +47,12 @@ void core_Switch(void);				/* Switch away from the current task     */
 struct Task *core_Dispatch(void);		/* Select the new task for execution     */
 #if defined(__AROSEXEC_SMP__)
 void core_InitScheduleData(struct X86SchedulerPrivate *);
+void core_QueueReadyTask(struct Task *);	/* Place a ready task on a cores RunQueue */
+void core_UnqueueReadyTask(struct Task *);	/* Remove a ready task from its RunQueue  */
+struct Task *core_WalkReadyQueues(struct Task *(*)(struct List *, APTR), APTR);
+BOOL core_TaskRunningOn(cpuid_t, struct Task *);	/* Is the task running on the given core? */
+void core_ScheduleCPUDeferred(cpuid_t);	/* Ask a core to reschedule, batched if possible */
+void core_FlushWakeups(void);			/* Send the reschedule IPIs deferred on this core */
+void core_WakeupStats(IPTR *, IPTR *);		/* Totals of WakeupCount and CoalescedCount */
 #endif
 #endif /* !KERNEL_SCHEDULER_H */
\ No newline at end of file
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2010-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 2010-2026, The AROS Development Team. All rights reserved.
 
     Desc: GetCPUInfo() - Provides information about installed CPUs
 */
@@ -182,6 +182,14 @@ D(bug("[processor.x86] :%s()\n", __func__));
                 *((BOOL *)tag->ti_Data) = (BOOL)FALSE;
             break;
         }
+    case(GCIT_SupportsAVX2):
+        {
+            if ((info->Features2 & (FEATF_XSAVE | FEATF_AVX)) == (FEATF_XSAVE | FEATF_AVX))
+                *((BOOL *)tag->ti_Data) = (BOOL)((info->Features5 & FEATF_AVX2) >> FEATB_AVX2);
+            else
+                *((BOOL *)tag->ti_Data) = (BOOL)FALSE;
+            break;
+        }
     case(GCIT_SupportsMMXEXT):
         *((BOOL *)tag->ti_Data) = (BOOL)((info->Features3 & FEATF_MMXEXT) >> FEATB_MMXEXT); break;
     case(GCIT_Supports3DNOW):
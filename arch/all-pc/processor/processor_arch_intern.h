@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2010-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 2010-2026, The AROS Development Team. All rights reserved.
 */
 
 #ifndef PROCESSOR_ARCH_INTERN_H
@@ -21,6 +21,7 @@ struct X86ProcessorInformation
     ULONG   Features2;  /* From ECX, function 00000001 */
     ULONG   Features3;  /* From EDX, function 80000001 */
     ULONG   Features4;  /* From ECX, function 80000001 */
+    ULONG   Features5;  /* From EBX, function 00000007 */
     
     /* CPUID Information */
     ULONG   CPUIDHighestStandardFunction;
@@ -44,6 +45,9 @@ struct X86ProcessorInformation
 #define cpuid(num) \
     do { asm volatile("cpuid":"=a"(eax),"=b"(ebx),"=c"(ecx),"=d"(edx):"a"(num)); } while(0)
 
+#define cpuid_sub(num, sub) \
+    do { asm volatile("cpuid":"=a"(eax),"=b"(ebx),"=c"(ecx),"=d"(edx):"a"(num),"c"(sub)); } while(0)
+
 static inline void __attribute__((always_inline)) rdmsr(ULONG msr_no, ULONG *ret_lo, ULONG *ret_hi)
 {
     ULONG ret1,ret2;
@@ -162,6 +166,10 @@ VOID ReadMaxFrequencyInformation(struct X86ProcessorInformation * info);
 #define FEATB_SSE4A     6
 #define FEATF_SSE4A     (1 << FEATB_SSE4A)
 
+/* EBX 00000007 Flags */
+#define FEATB_AVX2      5
+#define FEATF_AVX2      (1 << FEATB_AVX2)
+
 /* Per manufacturer feature masks */
 #define FEATURE_MASK_EDX_UNKNOWN    0
 #define FEATURE_MASK_ECX_UNKNOWN    0
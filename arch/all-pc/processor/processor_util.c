@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2010-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 2010-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <aros/debug.h>
@@ -207,6 +207,14 @@ static void ReadFeaturesFlags(struct X86ProcessorInformation * info)
     
     info->Features3 = edx;
     info->Features4 = ecx;
+
+    /* Read structured extended feature flags */
+    info->Features5 = 0;
+    if (info->CPUIDHighestStandardFunction >= 0x00000007)
+    {
+        cpuid_sub(0x00000007, 0);
+        info->Features5 = ebx & FEATF_AVX2;
+    }
     
     /* Calculate the vector unit */
     if (info->Features2 & FEATF_AVX)
@@ -6,6 +6,8 @@
 #endif
 
 #define SCHEDQUANTUM_VALUE      4
+/* The scheduler keeps ready tasks in exec's run queue */
+#define EXEC_RUNQUEUE
 
 #ifdef HOST_OS_android
 /* Android is not a true Linux ;-) */
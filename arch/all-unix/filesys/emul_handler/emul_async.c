@@ -0,0 +1,669 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Host threads that do emul-handler's bulk I/O.
+*/
+
+#include "unix_hints.h"
+
+#ifdef HOST_LONG_ALIGNED
+#pragma pack(4)
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+#pragma pack()
+
+/* This prevents redefinition of struct timeval */
+#define _AROS_TYPES_TIMEVAL_S_H_
+
+#define DEBUG 0
+#define DASYNC(x)
+
+#include <aros/debug.h>
+#include <aros/symbolsets.h>
+#include <dos/dosextens.h>
+#include <dos/exall.h>
+#include <proto/exec.h>
+#include <proto/hostlib.h>
+#include <proto/oop.h>
+
+#include "emul_intern.h"
+#include "emul_unix.h"
+
+/*
+ * The worker threads are host threads, with all signals blocked so that
+ * AROS never runs on them. They may only call host functions, and touch
+ * the requests given to them - no AROS functions at all.
+ *
+ * Requests are queued to the workers under a host mutex. A finished request
+ * is pushed onto the done list of its queue, and a byte is written to the
+ * queue's pipe. UnixIO gets SIGIO for it and calls AsyncInt(), which signals
+ * the handler. Pushing and writing happen under the mutex too, so that once
+ * a handler has seen all its requests finish, no worker touches its queue
+ * any more.
+ *
+ * The number of workers, and the queue depth each volume starts with, come
+ * from the host environment variable AROS_EMUL_QUEUE_DEPTH (default 8, 0
+ * switches the workers off). ACTION_EMUL_QUEUE_INFO returns the depth and
+ * the latency histogram of a volume, and can change its depth.
+ *
+ * The pool is only used on Linux hosts for now. Elsewhere no queues
+ * are created, and the handlers do all I/O themselves like before.
+ */
+
+#define AIO_DEFAULTDEPTH        8
+#define AIO_DEPTHVAR            "AROS_EMUL_QUEUE_DEPTH"
+
+struct PThreadInterface
+{
+    int  (*pthread_create)(pthread_t *thread, const pthread_attr_t *attr, void *(*start)(void *), void *arg);
+    int  (*pthread_join)(pthread_t thread, void **retval);
+    int  (*pthread_sigmask)(int how, const sigset_t *set, sigset_t *oldset);
+    int  (*pthread_mutex_init)(pthread_mutex_t *mutex, const pthread_mutexattr_t *attr);
+    int  (*pthread_mutex_destroy)(pthread_mutex_t *mutex);
+    int  (*pthread_mutex_lock)(pthread_mutex_t *mutex);
+    int  (*pthread_mutex_unlock)(pthread_mutex_t *mutex);
+    int  (*pthread_cond_init)(pthread_cond_t *cond, const pthread_condattr_t *attr);
+    int  (*pthread_cond_destroy)(pthread_cond_t *cond);
+    int  (*pthread_cond_wait)(pthread_cond_t *cond, pthread_mutex_t *mutex);
+    int  (*pthread_cond_signal)(pthread_cond_t *cond);
+    int  (*pthread_cond_broadcast)(pthread_cond_t *cond);
+};
+
+struct AsyncLibCInterface
+{
+    int      (*sigfillset)(sigset_t *set);
+    int      (*pipe2)(int fds[2], int flags);
+    ssize_t  (*pread64)(int fd, void *buf, size_t count, long long offset);
+    ssize_t  (*pwrite64)(int fd, const void *buf, size_t count, long long offset);
+    int      (*clock_gettime)(clockid_t clock, struct timespec *tp);
+    int     *(*__errno_location)(void);
+};
+
+static const char *pthreadSymbols[] =
+{
+    "pthread_create",
+    "pthread_join",
+    "pthread_sigmask",
+    "pthread_mutex_init",
+    "pthread_mutex_destroy",
+    "pthread_mutex_lock",
+    "pthread_mutex_unlock",
+    "pthread_cond_init",
+    "pthread_cond_destroy",
+    "pthread_cond_wait",
+    "pthread_cond_signal",
+    "pthread_cond_broadcast",
+    NULL
+};
+
+static const char *asyncSymbols[] =
+{
+    "sigfillset",
+    "pipe2",
+    "pread64",
+    "pwrite64",
+    "clock_gettime",
+    "__errno_location",
+    NULL
+};
+
+struct AsyncPool
+{
+    struct PThreadInterface   *pt;
+    struct AsyncLibCInterface *lc;
+    struct LibCInterface      *SysIFace;
+    struct ScanInterface      *ScanIFace;
+    APTR                       pthreadHandle;
+    pthread_mutex_t            lock;
+    pthread_cond_t             wake;
+    struct AsyncRequest       *head;    /* Requests waiting for a worker */
+    struct AsyncRequest       *tail;
+    int                        quit;
+    ULONG                      depth;   /* Queue depth of new volumes    */
+    ULONG                      workers;
+    pthread_t                  threads[AIO_MAXDEPTH];
+};
+
+/*********************************************************************************************/
+
+static UQUAD AsyncTime(struct AsyncPool *pool)
+{
+    struct timespec ts;
+
+    pool->lc->clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (UQUAD)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void *AsyncWorker(void *data)
+{
+    struct AsyncPool *pool = data;
+    struct AsyncRequest *ar;
+    struct AsyncQueue *aq;
+    char c = 0;
+
+    pool->pt->pthread_mutex_lock(&pool->lock);
+    while (!pool->quit)
+    {
+        ar = pool->head;
+        if (!ar)
+        {
+            pool->pt->pthread_cond_wait(&pool->wake, &pool->lock);
+            continue;
+        }
+
+        pool->head = ar->ar_Next;
+        if (!pool->head)
+            pool->tail = NULL;
+        pool->pt->pthread_mutex_unlock(&pool->lock);
+
+        switch (ar->ar_Op)
+        {
+        case AIO_READ:
+            ar->ar_Result = pool->lc->pread64(ar->ar_FD, ar->ar_Buffer, ar->ar_Length, ar->ar_Offset);
+            break;
+
+        case AIO_WRITE:
+            ar->ar_Result = pool->lc->pwrite64(ar->ar_FD, ar->ar_Buffer, ar->ar_Length, ar->ar_Offset);
+            break;
+
+        case AIO_SCAN:
+            ar->ar_Errno = ScanDir(pool->SysIFace, pool->ScanIFace, pool->lc->__errno_location(),
+                                   ar->ar_Path, ar->ar_Buffer);
+            ar->ar_Result = ar->ar_Errno ? -1 : 0;
+            break;
+        }
+        if ((ar->ar_Result == -1) && (ar->ar_Op != AIO_SCAN))
+            ar->ar_Errno = *pool->lc->__errno_location();
+        ar->ar_End = AsyncTime(pool);
+
+        pool->pt->pthread_mutex_lock(&pool->lock);
+
+        aq = ar->ar_Queue;
+        ar->ar_Next = __atomic_load_n(&aq->aq_Done, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&aq->aq_Done, &ar->ar_Next, ar, TRUE,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+            ;
+
+        /* SIGIO only comes if the pipe was empty, but then the handler did not drain it yet */
+        pool->SysIFace->write(aq->aq_Pipe[1], &c, 1);
+    }
+    pool->pt->pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+/* Called by UnixIO when the pipe of a queue becomes readable */
+static void AsyncInt(int fd, int mode, void *data)
+{
+    struct AsyncQueue *aq = data;
+
+    Signal(aq->aq_Task, aq->aq_SigMask);
+}
+
+/*********************************************************************************************/
+
+struct AsyncQueue *CreateAsyncQueue(struct emulbase *emulbase)
+{
+    struct AsyncPool *pool = emulbase->pdata.asyncPool;
+    struct AsyncQueue *aq;
+    int res;
+
+    if (!pool)
+        return NULL;
+
+    aq = AllocMem(sizeof(struct AsyncQueue), MEMF_PUBLIC|MEMF_CLEAR);
+    if (!aq)
+        return NULL;
+
+    aq->aq_SigBit = AllocSignal(-1);
+    if (aq->aq_SigBit != -1)
+    {
+        aq->aq_SigMask = 1L << aq->aq_SigBit;
+        aq->aq_Task    = FindTask(NULL);
+        aq->aq_Depth   = pool->depth;
+        NewList((struct List *)&aq->aq_Deferred);
+
+        HostLib_Lock();
+
+        res = pool->lc->pipe2(aq->aq_Pipe, O_NONBLOCK|O_CLOEXEC);
+        AROS_HOST_BARRIER
+
+        HostLib_Unlock();
+
+        if (res == 0)
+        {
+            aq->aq_Interrupt.fd          = aq->aq_Pipe[0];
+            aq->aq_Interrupt.mode        = vHidd_UnixIO_Read;
+            aq->aq_Interrupt.handler     = AsyncInt;
+            aq->aq_Interrupt.handlerData = aq;
+
+            if (!Hidd_UnixIO_AddInterrupt(emulbase->pdata.unixio, &aq->aq_Interrupt))
+            {
+                DASYNC(bug("[emul] Created async queue 0x%p, depth %u\n", aq, aq->aq_Depth));
+                return aq;
+            }
+
+            HostLib_Lock();
+
+            emulbase->pdata.SysIFace->close(aq->aq_Pipe[0]);
+            AROS_HOST_BARRIER
+            emulbase->pdata.SysIFace->close(aq->aq_Pipe[1]);
+            AROS_HOST_BARRIER
+
+            HostLib_Unlock();
+        }
+        FreeSignal(aq->aq_SigBit);
+    }
+    FreeMem(aq, sizeof(struct AsyncQueue));
+
+    D(bug("[emul] Can't create async queue, doing synchronous I/O\n"));
+    return NULL;
+}
+
+/* The queue must have no requests in flight */
+void DeleteAsyncQueue(struct emulbase *emulbase, struct AsyncQueue *aq)
+{
+    struct AsyncPool *pool = emulbase->pdata.asyncPool;
+
+    Hidd_UnixIO_RemInterrupt(emulbase->pdata.unixio, &aq->aq_Interrupt);
+
+    HostLib_Lock();
+
+    /* Wait for the worker that finished the last request to let go of the queue */
+    pool->pt->pthread_mutex_lock(&pool->lock);
+    AROS_HOST_BARRIER
+    pool->pt->pthread_mutex_unlock(&pool->lock);
+    AROS_HOST_BARRIER
+
+    emulbase->pdata.SysIFace->close(aq->aq_Pipe[0]);
+    AROS_HOST_BARRIER
+    emulbase->pdata.SysIFace->close(aq->aq_Pipe[1]);
+    AROS_HOST_BARRIER
+
+    HostLib_Unlock();
+
+    FreeSignal(aq->aq_SigBit);
+    FreeMem(aq, sizeof(struct AsyncQueue));
+}
+
+/*
+ * Hands a packet to the workers if it is a read or write of a plain file, or
+ * the start of an ExAll() scan. Standard handles stay synchronous, they are
+ * waited for with UnixIO instead. Returns FALSE if the caller has to handle
+ * the packet itself.
+ */
+BOOL SubmitAsync(struct emulbase *emulbase, struct AsyncQueue *aq, struct filehandle *fh, struct DosPacket *dp)
+{
+    struct AsyncPool *pool = emulbase->pdata.asyncPool;
+    struct AsyncRequest *ar;
+    struct ExAllControl *eac;
+    ULONG op;
+    off_t pos = 0;
+
+    if (aq->aq_Pending >= aq->aq_Depth)
+        return FALSE;
+
+    switch (dp->dp_Type)
+    {
+    case ACTION_READ:
+    case ACTION_WRITE:
+        if (fh->type != FHD_FILE)
+            return FALSE;
+        op = (dp->dp_Type == ACTION_READ) ? AIO_READ : AIO_WRITE;
+        break;
+
+    case ACTION_EXAMINE_ALL:
+        /* Later calls of the same ExAll() continue with the scan */
+        eac = BADDR(dp->dp_Arg5);
+        if (!emulbase->pdata.ScanIFace || (fh->type != FHD_DIRECTORY) ||
+            eac->eac_LastKey || (dp->dp_Arg4 > ED_OWNER))
+            return FALSE;
+        FreeDirScan(emulbase, fh);
+        op = AIO_SCAN;
+        break;
+
+    default:
+        return FALSE;
+    }
+
+    ar = AllocMem(sizeof(struct AsyncRequest), MEMF_PUBLIC|MEMF_CLEAR);
+    if (!ar)
+        return FALSE;
+
+    ar->ar_Queue  = aq;
+    ar->ar_Packet = dp;
+    ar->ar_Handle = fh;
+    ar->ar_Op     = op;
+
+    if (op == AIO_SCAN)
+    {
+        ar->ar_Buffer = AllocMem(sizeof(struct EmulDirScan), MEMF_PUBLIC|MEMF_CLEAR);
+        if (!ar->ar_Buffer)
+        {
+            FreeMem(ar, sizeof(struct AsyncRequest));
+            return FALSE;
+        }
+        ar->ar_Path = fh->hostname;
+    }
+    else
+    {
+        ar->ar_FD     = (int)(IPTR)fh->fd;
+        ar->ar_Buffer = (APTR)dp->dp_Arg2;
+        ar->ar_Length = dp->dp_Arg3;
+    }
+
+    HostLib_Lock();
+
+    if (op != AIO_SCAN)
+    {
+        /* The workers use the current position, and the handler moves it when they are done */
+        pos = LSeek(ar->ar_FD, 0, SEEK_CUR);
+        AROS_HOST_BARRIER
+        ar->ar_Offset = pos;
+    }
+
+    if (pos != -1)
+    {
+        ar->ar_Start = AsyncTime(pool);
+        AROS_HOST_BARRIER
+
+        pool->pt->pthread_mutex_lock(&pool->lock);
+        AROS_HOST_BARRIER
+
+        if (pool->tail)
+            pool->tail->ar_Next = ar;
+        else
+            pool->head = ar;
+        pool->tail = ar;
+
+        pool->pt->pthread_cond_signal(&pool->wake);
+        AROS_HOST_BARRIER
+        pool->pt->pthread_mutex_unlock(&pool->lock);
+        AROS_HOST_BARRIER
+    }
+
+    HostLib_Unlock();
+
+    if (pos == -1)
+    {
+        /* Let the synchronous code report the error */
+        FreeMem(ar, sizeof(struct AsyncRequest));
+        return FALSE;
+    }
+
+    DASYNC(bug("[emul] Queued %s request 0x%p for 0x%p\n",
+               (op == AIO_READ) ? "read" : ((op == AIO_WRITE) ? "write" : "scan"), ar, fh));
+
+    fh->aio = ar;
+    aq->aq_Pending++;
+
+    return TRUE;
+}
+
+/* Returns the finished requests, oldest first */
+struct AsyncRequest *GetAsyncReplies(struct emulbase *emulbase, struct AsyncQueue *aq)
+{
+    struct AsyncRequest *ar, *next, *done = NULL;
+    char buf[64];
+    int res;
+
+    /*
+     * Empty the pipe before taking the requests, so that
+     * every request pushed after that raises SIGIO again.
+     */
+    HostLib_Lock();
+
+    do
+    {
+        res = emulbase->pdata.SysIFace->read(aq->aq_Pipe[0], buf, sizeof(buf));
+        AROS_HOST_BARRIER
+    } while (res > 0);
+
+    HostLib_Unlock();
+
+    for (ar = __atomic_exchange_n(&aq->aq_Done, NULL, __ATOMIC_ACQUIRE); ar; ar = next)
+    {
+        next = ar->ar_Next;
+        ar->ar_Next = done;
+        done = ar;
+    }
+
+    return done;
+}
+
+/* Produces the result of a finished request, and frees it */
+SIPTR FinishAsync(struct emulbase *emulbase, struct AsyncQueue *aq, struct AsyncRequest *ar, SIPTR *err, struct DosLibrary *DOSBase)
+{
+    struct DosPacket *dp = ar->ar_Packet;
+    struct filehandle *fh = ar->ar_Handle;
+    UQUAD usecs = (ar->ar_End - ar->ar_Start) / 1000;
+    ULONG bucket;
+    SIPTR res;
+
+    DASYNC(bug("[emul] Request 0x%p done, result %d, %llu usecs\n", ar, ar->ar_Result, usecs));
+
+    for (bucket = 0; (usecs >>= 1) && (bucket < AIO_BUCKETS - 1); bucket++)
+        ;
+    aq->aq_Latency[ar->ar_Op][bucket]++;
+    aq->aq_Pending--;
+
+    if (ar->ar_Op == AIO_SCAN)
+    {
+        fh->ph.scan = ar->ar_Buffer;
+
+        if (ar->ar_Result == -1)
+        {
+            FreeDirScan(emulbase, fh);
+            *err = errno_u2a(ar->ar_Errno);
+        }
+        else
+            *err = DoExamineScan(emulbase, fh, (APTR)dp->dp_Arg2, BADDR(dp->dp_Arg5),
+                                 dp->dp_Arg3, dp->dp_Arg4, DOSBase);
+        res = (*err == 0) ? DOSTRUE : DOSFALSE;
+    }
+    else
+    {
+        res = ar->ar_Result;
+        if (res == -1)
+            *err = errno_u2a(ar->ar_Errno);
+        else
+        {
+            /* Move the position like read() and write() would have done */
+            HostLib_Lock();
+
+            LSeek(ar->ar_FD, ar->ar_Offset + res, SEEK_SET);
+            AROS_HOST_BARRIER
+
+            HostLib_Unlock();
+
+            *err = 0;
+        }
+    }
+
+    FreeMem(ar, sizeof(struct AsyncRequest));
+
+    return res;
+}
+
+/*
+ * ACTION_EMUL_QUEUE_INFO: fills in the depth and latency histogram of a queue,
+ * after changing its depth unless that is negative.
+ */
+void GetAsyncInfo(struct emulbase *emulbase, struct AsyncQueue *aq, struct EmulQueueInfo *eqi,
+                  LONG depth, BOOL reset)
+{
+    if (depth >= 0)
+        aq->aq_Depth = (depth > AIO_MAXDEPTH) ? AIO_MAXDEPTH : depth;
+
+    eqi->eqi_Depth    = aq->aq_Depth;
+    eqi->eqi_MaxDepth = AIO_MAXDEPTH;
+    eqi->eqi_Pending  = aq->aq_Pending;
+    CopyMem(aq->aq_Latency, eqi->eqi_Latency, sizeof(eqi->eqi_Latency));
+
+    if (reset)
+        memset(aq->aq_Latency, 0, sizeof(aq->aq_Latency));
+}
+
+/*********************************************************************************************/
+
+static ULONG GetQueueDepth(struct emulbase *emulbase)
+{
+    ULONG depth = AIO_DEFAULTDEPTH;
+    char *var;
+
+    HostLib_Lock();
+
+    var = emulbase->pdata.SysIFace->getenv(AIO_DEPTHVAR);
+    AROS_HOST_BARRIER
+
+    if (var && (*var >= '0') && (*var <= '9'))
+    {
+        for (depth = 0; (*var >= '0') && (*var <= '9') && (depth <= AIO_MAXDEPTH); var++)
+            depth = depth * 10 + *var - '0';
+    }
+
+    HostLib_Unlock();
+
+    return (depth > AIO_MAXDEPTH) ? AIO_MAXDEPTH : depth;
+}
+
+static void StopWorkers(struct emulbase *emulbase, struct AsyncPool *pool)
+{
+    ULONG i;
+
+    HostLib_Lock();
+
+    pool->pt->pthread_mutex_lock(&pool->lock);
+    AROS_HOST_BARRIER
+    pool->quit = 1;
+    pool->pt->pthread_cond_broadcast(&pool->wake);
+    AROS_HOST_BARRIER
+    pool->pt->pthread_mutex_unlock(&pool->lock);
+    AROS_HOST_BARRIER
+
+    for (i = 0; i < pool->workers; i++)
+    {
+        pool->pt->pthread_join(pool->threads[i], NULL);
+        AROS_HOST_BARRIER
+    }
+
+    pool->pt->pthread_cond_destroy(&pool->wake);
+    AROS_HOST_BARRIER
+    pool->pt->pthread_mutex_destroy(&pool->lock);
+    AROS_HOST_BARRIER
+
+    HostLib_Unlock();
+}
+
+static void FreePool(struct emulbase *emulbase, struct AsyncPool *pool)
+{
+    if (pool->lc)
+        HostLib_DropInterface((APTR *)pool->lc);
+    if (pool->pt)
+        HostLib_DropInterface((APTR *)pool->pt);
+    if (pool->pthreadHandle)
+        HostLib_Close(pool->pthreadHandle, NULL);
+
+    FreeMem(pool, sizeof(struct AsyncPool));
+}
+
+static int async_startup(struct emulbase *emulbase)
+{
+#ifdef HOST_OS_linux
+    APTR libc = emulbase->pdata.em_UnixIOBase->uio_LibcHandle;
+    struct AsyncPool *pool;
+    sigset_t all, old;
+    ULONG depth, r = 0;
+
+    /* Zero switches the workers off */
+    depth = GetQueueDepth(emulbase);
+    D(bug("[EmulHandler] Async queue depth %u\n", depth));
+    if (!depth)
+        return TRUE;
+
+    pool = AllocMem(sizeof(struct AsyncPool), MEMF_PUBLIC|MEMF_CLEAR);
+    if (!pool)
+        return TRUE;
+    pool->SysIFace = emulbase->pdata.SysIFace;
+    pool->ScanIFace = emulbase->pdata.ScanIFace;
+    pool->depth = depth;
+
+    /* Since glibc 2.34 libpthread is a stub, and everything is in libc */
+    pool->pthreadHandle = HostLib_Open("libpthread.so.0", NULL);
+    pool->pt = (struct PThreadInterface *)HostLib_GetInterface(pool->pthreadHandle ? pool->pthreadHandle : libc,
+                                                               pthreadSymbols, &r);
+    if (pool->pt && !r)
+        pool->lc = (struct AsyncLibCInterface *)HostLib_GetInterface(libc, asyncSymbols, &r);
+
+    if (!pool->lc || r)
+    {
+        D(bug("[EmulHandler] %lu unresolved host thread symbols, doing synchronous I/O\n", r));
+        FreePool(emulbase, pool);
+        return TRUE;
+    }
+
+    HostLib_Lock();
+
+    pool->pt->pthread_mutex_init(&pool->lock, NULL);
+    AROS_HOST_BARRIER
+    pool->pt->pthread_cond_init(&pool->wake, NULL);
+    AROS_HOST_BARRIER
+
+    /* The workers inherit a signal mask that blocks everything */
+    pool->lc->sigfillset(&all);
+    AROS_HOST_BARRIER
+    pool->pt->pthread_sigmask(SIG_SETMASK, &all, &old);
+    AROS_HOST_BARRIER
+
+    for (pool->workers = 0; pool->workers < depth; pool->workers++)
+    {
+        if (pool->pt->pthread_create(&pool->threads[pool->workers], NULL, AsyncWorker, pool))
+            break;
+        AROS_HOST_BARRIER
+    }
+
+    pool->pt->pthread_sigmask(SIG_SETMASK, &old, NULL);
+    AROS_HOST_BARRIER
+
+    HostLib_Unlock();
+
+    D(bug("[EmulHandler] Started %u host I/O workers\n", pool->workers));
+    if (!pool->workers)
+    {
+        StopWorkers(emulbase, pool);
+        FreePool(emulbase, pool);
+        return TRUE;
+    }
+
+    emulbase->pdata.asyncPool = pool;
+#endif
+
+    return TRUE;
+}
+
+ADD2INITLIB(async_startup, 1);
+
+static int async_cleanup(struct emulbase *emulbase)
+{
+    struct AsyncPool *pool = emulbase->pdata.asyncPool;
+
+    if (pool)
+    {
+        StopWorkers(emulbase, pool);
+        FreePool(emulbase, pool);
+        emulbase->pdata.asyncPool = NULL;
+    }
+
+    return TRUE;
+}
+
+ADD2EXPUNGELIB(async_cleanup, 1);
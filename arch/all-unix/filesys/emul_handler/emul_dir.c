@@ -1,16 +1,24 @@
 /*
-    Copyright (C) 1995-2014, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include "unix_hints.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#ifdef HOST_OS_linux
+#include <sys/syscall.h>
+#endif
 
 /* This prevents redefinition of struct timeval */
 #define _AROS_TYPES_TIMEVAL_S_H_
 
 #include <aros/debug.h>
+#include <proto/exec.h>
+#include <proto/hostlib.h>
 
 #include "emul_intern.h"
 #include "emul_unix.h"
@@ -49,3 +57,169 @@ struct dirent *ReadDir(struct emulbase *emulbase, struct filehandle *fh, IPTR *d
 
     return dir;
 }
+
+#ifdef HOST_OS_linux
+
+#define SCAN_BUFSIZE    65536
+#define AMIGA_EPOCH     252460800       /* 1.1.1978 in unix time */
+
+struct linux_dirent64
+{
+    UQUAD d_ino;
+    QUAD  d_off;
+    UWORD d_reclen;
+    UBYTE d_type;
+    char  d_name[];
+};
+
+/* Like timestamp2datestamp(), but without calls that aren't thread safe */
+static void scan_datestamp(struct ScanInterface *ScanIFace, time_t timestamp, struct DateStamp *datestamp)
+{
+    struct tm tm;
+    QUAD secs = timestamp - AMIGA_EPOCH;
+
+    if (ScanIFace->localtime_r(&timestamp, &tm))
+        secs += tm.tm_gmtoff;
+    if (secs < 0)
+        secs = 0;
+
+    datestamp->ds_Days = secs / (60 * 60 * 24);
+    secs %= (60 * 60 * 24);
+    datestamp->ds_Minute = secs / 60;
+    secs %= 60;
+    datestamp->ds_Tick = secs * TICKS_PER_SECOND;
+}
+
+#endif
+
+/*
+ * Reads a whole directory into eds, in large getdents64() batches, and
+ * stats the entries relative to the directory instead of building their
+ * full paths. This only calls host functions, so that host I/O workers can
+ * do it too - the caller has to take the host call lock if needed.
+ * Returns 0 or the host errno.
+ */
+int ScanDir(struct LibCInterface *SysIFace, struct ScanInterface *ScanIFace, int *errnoPtr,
+            char *path, struct EmulDirScan *eds)
+{
+#ifdef HOST_OS_linux
+    struct EmulDirEntry *entries = NULL, *ede;
+    struct linux_dirent64 *de;
+    char *buf, *names = NULL, *p;
+    ULONG maxEntries = 0, namesSize = 0, maxNames = 0, len;
+    struct stat st;
+    long res, off;
+    int dirfd, err = 0;
+
+    eds->eds_Count = 0;
+
+    dirfd = SysIFace->open(path, O_RDONLY|O_DIRECTORY|O_CLOEXEC);
+    if (dirfd == -1)
+        return *errnoPtr;
+
+    buf = ScanIFace->realloc(NULL, SCAN_BUFSIZE);
+    if (!buf)
+    {
+        SysIFace->close(dirfd);
+        return ENOMEM;
+    }
+
+    while (!err)
+    {
+        res = ScanIFace->syscall(SYS_getdents64, dirfd, buf, SCAN_BUFSIZE);
+        if (res <= 0)
+        {
+            if (res == -1)
+                err = *errnoPtr;
+            break;
+        }
+
+        for (off = 0; off < res; off += de->d_reclen)
+        {
+            de = (struct linux_dirent64 *)(buf + off);
+            if (is_special_dir(de->d_name))
+                continue;
+
+            /* The entry might have been deleted meanwhile */
+            if (ScanIFace->fstatat(dirfd, de->d_name, &st, AT_SYMLINK_NOFOLLOW))
+                continue;
+
+            len = strlen(de->d_name) + 1;
+
+            if (eds->eds_Count == maxEntries)
+            {
+                maxEntries = maxEntries ? maxEntries * 2 : 64;
+                ede = ScanIFace->realloc(entries, maxEntries * sizeof(struct EmulDirEntry));
+                if (!ede)
+                {
+                    err = ENOMEM;
+                    break;
+                }
+                entries = ede;
+            }
+            if (namesSize + len > maxNames)
+            {
+                maxNames = maxNames ? maxNames * 2 : 4096;
+                p = ScanIFace->realloc(names, maxNames);
+                if (!p)
+                {
+                    err = ENOMEM;
+                    break;
+                }
+                names = p;
+            }
+
+            ede = &entries[eds->eds_Count++];
+            ede->ede_Mode = st.st_mode;
+            ede->ede_UID  = st.st_uid;
+            ede->ede_GID  = st.st_gid;
+            ede->ede_Name = namesSize;
+            ede->ede_Size = st.st_size;
+            scan_datestamp(ScanIFace, st.st_mtime, &ede->ede_Date);
+
+            memcpy(names + namesSize, de->d_name, len);
+            namesSize += len;
+        }
+    }
+
+    ScanIFace->free(buf);
+    SysIFace->close(dirfd);
+
+    if (err)
+    {
+        ScanIFace->free(entries);
+        ScanIFace->free(names);
+        eds->eds_Count = 0;
+        return err;
+    }
+
+    eds->eds_Entries = entries;
+    eds->eds_Names   = names;
+
+    return 0;
+#else
+    return ENOSYS;
+#endif
+}
+
+void FreeDirScan(struct emulbase *emulbase, struct filehandle *fh)
+{
+    struct EmulDirScan *eds = fh->ph.scan;
+
+    if (!eds)
+        return;
+
+#ifdef HOST_OS_linux
+    HostLib_Lock();
+
+    emulbase->pdata.ScanIFace->free(eds->eds_Entries);
+    AROS_HOST_BARRIER
+    emulbase->pdata.ScanIFace->free(eds->eds_Names);
+    AROS_HOST_BARRIER
+
+    HostLib_Unlock();
+#endif
+
+    FreeMem(eds, sizeof(struct EmulDirScan));
+    fh->ph.scan = NULL;
+}
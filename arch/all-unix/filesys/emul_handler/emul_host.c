@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2018, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include "unix_hints.h"
@@ -71,7 +71,7 @@ static LONG u2a[][2]=
     { 0           , 0                        }
 };
 
-static LONG errno_u2a(int err)
+LONG errno_u2a(int err)
 {
     ULONG i;
 
@@ -541,6 +541,8 @@ void DoClose(struct emulbase *emulbase, struct filehandle *current)
     }
 
     HostLib_Unlock();
+
+    FreeDirScan(emulbase, current);
 }
 
 LONG DoRead(struct emulbase *emulbase, struct filehandle *fh, APTR buff, ULONG len, SIPTR *err)
@@ -926,6 +928,7 @@ LONG DoRewindDir(struct emulbase *emulbase, struct filehandle *fh)
 
     /* Directory search position has been reset */
     fh->ph.dirpos = 0;
+    FreeDirScan(emulbase, fh);
 
     /* rewinddir() never fails */
     return 0;
@@ -973,14 +976,14 @@ static LONG stat_entry(struct emulbase *emulbase, struct filehandle *fh, STRPTR
     return err;
 }
 
-LONG DoExamineEntry(struct emulbase *emulbase, struct filehandle *fh, char *EntryName,
-                   struct ExAllData *ead, ULONG size, ULONG type)
+/*
+ * Fills in an ExAllData from the stat() information of an object.
+ * date is its st_mtime converted already, or NULL.
+ */
+static LONG fill_entry(struct emulbase *emulbase, struct filehandle *fh, char *EntryName, struct stat *st,
+                       struct DateStamp *date, struct ExAllData *ead, ULONG size, ULONG type)
 {
     STRPTR next, end, last, name;
-    struct stat st;
-    LONG err;
-
-    DEXAM(bug("[emul] DoExamineEntry(0x%p, %s, 0x%p, %u, %u)\n", fh, EntryName, ead, size, type));
 
     /* Return an error, if supplied type is not supported. */
     if(type>ED_OWNER)
@@ -994,11 +997,7 @@ LONG DoExamineEntry(struct emulbase *emulbase, struct filehandle *fh, char *Entr
     if(next>end) /* > is correct. Not >= */
         return ERROR_BUFFER_OVERFLOW;
 
-    err = stat_entry(emulbase, fh, EntryName, &st);
-    if (err)
-        return err;
-
-    DEXAM(KrnPrintf("[emul] File mode %o, size %u\n", st.st_mode, st.st_size));
+    DEXAM(KrnPrintf("[emul] File mode %o, size %u\n", st->st_mode, st->st_size));
     DEXAM(KrnPrintf("[emul] Filling in information\n"));
     DEXAM(KrnPrintf("[emul] ead 0x%p, next 0x%p, end 0x%p, size %u, type %u\n", ead, next, end, size, type));
 
@@ -1006,30 +1005,34 @@ LONG DoExamineEntry(struct emulbase *emulbase, struct filehandle *fh, char *Entr
     {
         default:
         case ED_OWNER:
-            ead->ed_OwnerUID    = st.st_uid;
-            ead->ed_OwnerGID    = st.st_gid;
+            ead->ed_OwnerUID    = st->st_uid;
+            ead->ed_OwnerGID    = st->st_gid;
         case ED_COMMENT:
             ead->ed_Comment=NULL;
         case ED_DATE:
         {
             struct DateStamp stamp;
 
-            timestamp2datestamp(emulbase, &st.st_mtime, &stamp);
-            ead->ed_Days        = stamp.ds_Days;
-            ead->ed_Mins        = stamp.ds_Minute;
-            ead->ed_Ticks       = stamp.ds_Tick;
+            if (!date)
+            {
+                timestamp2datestamp(emulbase, &st->st_mtime, &stamp);
+                date = &stamp;
+            }
+            ead->ed_Days        = date->ds_Days;
+            ead->ed_Mins        = date->ds_Minute;
+            ead->ed_Ticks       = date->ds_Tick;
         }
         case ED_PROTECTION:
-            ead->ed_Prot        = prot_u2a(st.st_mode);
+            ead->ed_Prot        = prot_u2a(st->st_mode);
         case ED_SIZE:
-            ead->ed_Size        = st.st_size;
+            ead->ed_Size        = st->st_size;
         case ED_TYPE:
-            if (S_ISDIR(st.st_mode)) {
+            if (S_ISDIR(st->st_mode)) {
                 if (EntryName || fh->name[0])
                     ead->ed_Type = ST_USERDIR;
                 else
                     ead->ed_Type = ST_ROOT;
-            } else if (S_ISLNK(st.st_mode))
+            } else if (S_ISLNK(st->st_mode))
                 ead->ed_Type = ST_SOFTLINK;
             else
                 ead->ed_Type = ST_FILE;
@@ -1061,63 +1064,134 @@ LONG DoExamineEntry(struct emulbase *emulbase, struct filehandle *fh, char *Entr
     }
 }
 
-/*********************************************************************************************/
-
-LONG DoExamineNext(struct emulbase *emulbase, struct filehandle *fh,
-                  struct FileInfoBlock *FIB)
+LONG DoExamineEntry(struct emulbase *emulbase, struct filehandle *fh, char *EntryName,
+                   struct ExAllData *ead, ULONG size, ULONG type)
 {
-    int i;
     struct stat st;
-    struct dirent *dir;
-    char *src, *dest;
     LONG err;
 
-    /* This operation does not make any sense on a file */
-    if (fh->type != FHD_DIRECTORY)
-        return ERROR_OBJECT_WRONG_TYPE;
+    DEXAM(bug("[emul] DoExamineEntry(0x%p, %s, 0x%p, %u, %u)\n", fh, EntryName, ead, size, type));
+
+    err = stat_entry(emulbase, fh, EntryName, &st);
+    if (err)
+        return err;
+
+    return fill_entry(emulbase, fh, EntryName, &st, NULL, ead, size, type);
+}
+
+/* Reads the whole directory of fh, for an ExAll() or ExNext() that starts */
+static LONG scan_dir(struct emulbase *emulbase, struct filehandle *fh)
+{
+    struct EmulDirScan *eds;
+    int err;
+
+    FreeDirScan(emulbase, fh);
+
+    eds = AllocMem(sizeof(struct EmulDirScan), MEMF_PUBLIC|MEMF_CLEAR);
+    if (!eds)
+        return ERROR_NO_FREE_STORE;
 
     HostLib_Lock();
 
-    /*
-     * First of all we have to go to the position where Examine() or
-     * ExNext() stopped the previous time so we can read the next entry!
-     * On Android this is handled by ReadDir() artificially tracking
-     * current search position in the filehandle.
-     */
-#ifndef HOST_OS_android
-    emulbase->pdata.SysIFace->seekdir(fh->fd, FIB->fib_DiskKey);
+    err = ScanDir(emulbase->pdata.SysIFace, emulbase->pdata.ScanIFace, emulbase->pdata.errnoPtr,
+                  fh->hostname, eds);
     AROS_HOST_BARRIER
-#endif
-
-    /* hm, let's read the data now! */
-    dir = ReadDir(emulbase, fh, &FIB->fib_DiskKey);
 
     HostLib_Unlock();
 
-    if (!dir)
-        return ERROR_NO_MORE_ENTRIES;
+    DEXAM(bug("[emul] Scanned %s: %u entries, error %d\n", fh->hostname, eds->eds_Count, err));
 
-    err = stat_entry(emulbase, fh, dir->d_name, &st);
     if (err)
     {
-        DEXAM(bug("stat_entry() failed for %s\n", dir->d_name));
-        return err;
+        FreeMem(eds, sizeof(struct EmulDirScan));
+        return errno_u2a(err);
     }
 
-    DEXAM(KrnPrintf("[emul] File mode %o, size %u\n", st.st_mode, st.st_size));
+    fh->ph.scan = eds;
+    return 0;
+}
+
+/*
+ * ExAll() from the directory contents read by ScanDir(), which fills
+ * in as many ExAllData as fit without any further host calls.
+ * eac_LastKey is the index of the next entry.
+ */
+LONG DoExamineScan(struct emulbase *emulbase, struct filehandle *fh, struct ExAllData *ead,
+                   struct ExAllControl *eac, ULONG size, ULONG type, struct DosLibrary *DOSBase)
+{
+    struct EmulDirScan *eds = fh->ph.scan;
+    struct EmulDirEntry *ede;
+    struct ExAllData *last=NULL;
+    STRPTR end=(STRPTR)ead+size;
+    struct stat st;
+    char *name;
+    LONG error = 0;
+
+    memset(&st, 0, sizeof(st));
+
+    for (; eac->eac_LastKey < eds->eds_Count; eac->eac_LastKey++)
+    {
+        ede  = &eds->eds_Entries[eac->eac_LastKey];
+        name = eds->eds_Names + ede->ede_Name;
+
+        if (eac->eac_MatchString && !MatchPatternNoCase(eac->eac_MatchString, name))
+            continue;
+
+        st.st_mode  = ede->ede_Mode;
+        st.st_uid   = ede->ede_UID;
+        st.st_gid   = ede->ede_GID;
+        st.st_size  = ede->ede_Size;
+
+        error = fill_entry(emulbase, fh, name, &st, &ede->ede_Date, ead, end-(STRPTR)ead, type);
+        if (error)
+            break;
+
+        if ((eac->eac_MatchFunc) && !CALLHOOKPKT(eac->eac_MatchFunc, ead, &type))
+            continue;
+
+        eac->eac_Entries++;
+        last=ead;
+        ead=ead->ed_Next;
+    }
+    if (last!=NULL)
+        last->ed_Next=NULL;
 
-    FIB->fib_OwnerUID   = st.st_uid;
-    FIB->fib_OwnerGID   = st.st_gid;
+    /* Examination will continue with the entry that did not fit */
+    if ((error==ERROR_BUFFER_OVERFLOW) && last)
+        return 0;
+
+    if(!error)
+        error = ERROR_NO_MORE_ENTRIES;
+    DoRewindDir(emulbase, fh);
+
+    return error;
+}
+
+/*********************************************************************************************/
+
+static void fill_fib(struct emulbase *emulbase, struct FileInfoBlock *FIB, char *name,
+                     struct stat *st, struct DateStamp *date)
+{
+    char *dest;
+    int i;
+
+    DEXAM(KrnPrintf("[emul] File mode %o, size %u\n", st->st_mode, st->st_size));
+
+    FIB->fib_OwnerUID   = st->st_uid;
+    FIB->fib_OwnerGID   = st->st_gid;
     FIB->fib_Comment[0] = '\0'; /* no comments available yet! */
-    timestamp2datestamp(emulbase, &st.st_mtime, &FIB->fib_Date);
-    FIB->fib_Protection = prot_u2a(st.st_mode);
-    FIB->fib_Size       = st.st_size;
+    if (date)
+        FIB->fib_Date   = *date;
+    else
+        timestamp2datestamp(emulbase, &st->st_mtime, &FIB->fib_Date);
+    FIB->fib_Protection = prot_u2a(st->st_mode);
+    FIB->fib_Size       = st->st_size;
 
-    if (S_ISDIR(st.st_mode))
+    if (S_ISDIR(st->st_mode))
     {
-        FIB->fib_DirEntryType = ST_USERDIR; /* S_ISDIR(st.st_mode)?(*fh->name?ST_USERDIR:ST_ROOT):0*/
+        FIB->fib_DirEntryType = ST_USERDIR; /* S_ISDIR(st->st_mode)?(*fh->name?ST_USERDIR:ST_ROOT):0*/
     }
-    else if(S_ISLNK(st.st_mode))
+    else if(S_ISLNK(st->st_mode))
     {
         FIB->fib_DirEntryType = ST_SOFTLINK;
     }
@@ -1129,17 +1203,94 @@ LONG DoExamineNext(struct emulbase *emulbase, struct filehandle *fh,
     DEXAM(bug("[emul] DirentryType %d\n", FIB->fib_DirEntryType));
 
     /* fast copying of the filename */
-    src  = dir->d_name;
     dest = &FIB->fib_FileName[1];
 
     for (i =0; i<MAXFILENAMELENGTH-1;i++)
     {
-        if(! (*dest++=*src++) )
+        if(! (*dest++=*name++) )
         {
             break;
         }
     }
     FIB->fib_FileName[0] = i;
+}
+
+/* ExNext() from the directory contents read by ScanDir(), fib_DiskKey is the index of the next entry */
+static LONG examine_next_scan(struct emulbase *emulbase, struct filehandle *fh, struct FileInfoBlock *FIB)
+{
+    struct EmulDirEntry *ede;
+    struct stat st;
+    LONG err;
+
+    if ((FIB->fib_DiskKey == 0) || !fh->ph.scan)
+    {
+        err = scan_dir(emulbase, fh);
+        if (err)
+            return err;
+    }
+
+    if (FIB->fib_DiskKey >= fh->ph.scan->eds_Count)
+    {
+        DoRewindDir(emulbase, fh);
+        return ERROR_NO_MORE_ENTRIES;
+    }
+
+    ede = &fh->ph.scan->eds_Entries[FIB->fib_DiskKey++];
+
+    memset(&st, 0, sizeof(st));
+    st.st_mode = ede->ede_Mode;
+    st.st_uid  = ede->ede_UID;
+    st.st_gid  = ede->ede_GID;
+    st.st_size = ede->ede_Size;
+
+    fill_fib(emulbase, FIB, fh->ph.scan->eds_Names + ede->ede_Name, &st, &ede->ede_Date);
+
+    return 0;
+}
+
+LONG DoExamineNext(struct emulbase *emulbase, struct filehandle *fh,
+                  struct FileInfoBlock *FIB)
+{
+    struct stat st;
+    struct dirent *dir;
+    LONG err;
+
+    /* This operation does not make any sense on a file */
+    if (fh->type != FHD_DIRECTORY)
+        return ERROR_OBJECT_WRONG_TYPE;
+
+    if (emulbase->pdata.ScanIFace)
+        return examine_next_scan(emulbase, fh, FIB);
+
+    HostLib_Lock();
+
+    /*
+     * First of all we have to go to the position where Examine() or
+     * ExNext() stopped the previous time so we can read the next entry!
+     * On Android this is handled by ReadDir() artificially tracking
+     * current search position in the filehandle.
+     */
+#ifndef HOST_OS_android
+    emulbase->pdata.SysIFace->seekdir(fh->fd, FIB->fib_DiskKey);
+    AROS_HOST_BARRIER
+#endif
+
+    /* hm, let's read the data now! */
+    dir = ReadDir(emulbase, fh, &FIB->fib_DiskKey);
+
+    HostLib_Unlock();
+
+    if (!dir)
+        return ERROR_NO_MORE_ENTRIES;
+
+    err = stat_entry(emulbase, fh, dir->d_name, &st);
+    if (err)
+    {
+        DEXAM(bug("stat_entry() failed for %s\n", dir->d_name));
+        return err;
+    }
+
+    fill_fib(emulbase, FIB, dir->d_name, &st, NULL);
 
     return 0;
 }
@@ -1163,6 +1314,17 @@ LONG DoExamineAll(struct emulbase *emulbase, struct filehandle *fh, struct ExAll
 
     DEXAM(bug("[emul] examine_all()\n"));
 
+    /* Where the host allows it, the whole directory is read at the start */
+    if (emulbase->pdata.ScanIFace)
+    {
+        if ((eac->eac_LastKey == 0) || !fh->ph.scan)
+        {
+            error = scan_dir(emulbase, fh);
+            if (error)
+                return error;
+        }
+        return DoExamineScan(emulbase, fh, ead, eac, size, type, DOSBase);
+    }
 
 #ifndef HOST_OS_android
     HostLib_Lock();
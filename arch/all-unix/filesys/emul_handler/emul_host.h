@@ -2,25 +2,103 @@
 #define RESOURCES_EMUL_HOST_H
 
 #include <exec/libraries.h>
+#include <exec/lists.h>
+#include <exec/tasks.h>
+#include <dos/dos.h>
 #include <hidd/unixio.h>
 #include <oop/oop.h>
 
 struct LibCInterface;
+struct ScanInterface;
+struct AsyncPool;
+
+/*
+ * Directory contents read in one go by ScanDir(), for ExAll() and ExNext().
+ * They are kept until the scan reaches the end, or starts over.
+ */
+struct EmulDirEntry
+{
+    ULONG            ede_Mode;          /* Host st_mode                             */
+    ULONG            ede_UID;
+    ULONG            ede_GID;
+    ULONG            ede_Name;          /* Offset of the name in eds_Names          */
+    UQUAD            ede_Size;
+    struct DateStamp ede_Date;
+};
+
+struct EmulDirScan
+{
+    ULONG                eds_Count;
+    struct EmulDirEntry *eds_Entries;   /* Host memory, see FreeDirScan()           */
+    char                *eds_Names;
+};
 
 struct PlatformHandle
 {
     ULONG dirpos;       /* Directory search position for Android */
     long  dirpos_first; /* Pointing to first dir entry for use by seekdir */
+    struct EmulDirScan *scan;   /* Directory contents of the current ExAll() or ExNext() */
 };
 
 struct Emul_PlatformData
 {
     OOP_Object		 *unixio;	  /* UnixIO object	     */
     struct LibCInterface *SysIFace;	  /* Libc interface	     */
+    struct ScanInterface *ScanIFace;	  /* Batched directory reading, NULL if unsupported */
     int			 *errnoPtr;	  /* Pointer to host's errno */
     struct Library	 *em_OOPBase;	  /* Library bases	     */
     struct UnixIOBase	 *em_UnixIOBase;
     struct Library 	 *em_UtilityBase;
+    struct AsyncPool	 *asyncPool;	  /* Host I/O workers, NULL if none */
+};
+
+/*
+ * Asynchronous host I/O (emul_async.c). Bulk reads, writes and directory
+ * scans are done by a pool of host threads, so that a slow host filesystem
+ * only holds up the processes using it instead of the whole machine.
+ * Each volume's handler has a queue, the workers tell it about finished
+ * requests by writing to a pipe, which UnixIO turns into an interrupt.
+ */
+#define EMUL_ASYNC_IO
+
+#define AIO_READ        0
+#define AIO_WRITE       1
+#define AIO_SCAN        2
+#define AIO_OPS         3
+
+#define AIO_MAXDEPTH    64
+#define AIO_BUCKETS     24      /* Latency histogram, log2 of microseconds */
+
+struct AsyncRequest
+{
+    struct AsyncRequest *ar_Next;
+    struct AsyncQueue   *ar_Queue;
+    struct DosPacket    *ar_Packet;
+    struct filehandle   *ar_Handle;
+    ULONG                ar_Op;         /* AIO_#?                                   */
+    int                  ar_FD;
+    APTR                 ar_Buffer;     /* Data, or struct EmulDirScan for AIO_SCAN */
+    ULONG                ar_Length;
+    UQUAD                ar_Offset;
+    char                *ar_Path;       /* Directory to scan                        */
+    LONG                 ar_Result;
+    int                  ar_Errno;      /* Host errno if ar_Result is -1            */
+    UQUAD                ar_Start;      /* Host monotonic time in nanoseconds       */
+    UQUAD                ar_End;
+};
+
+struct AsyncQueue
+{
+    struct uioInterrupt  aq_Interrupt;
+    struct Task         *aq_Task;
+    ULONG                aq_SigMask;
+    BYTE                 aq_SigBit;
+    int                  aq_Pipe[2];
+    struct AsyncRequest *aq_Done;       /* Pushed by the workers, newest first      */
+    ULONG                aq_Pending;
+    ULONG                aq_Depth;      /* Requests allowed in flight, 0 = none     */
+    struct MinList       aq_Deferred;   /* Packets waiting for their handle         */
+    ULONG                aq_Latency[AIO_OPS][AIO_BUCKETS];
 };
 
 /* Remove this later in the ABIv1 development cycle */
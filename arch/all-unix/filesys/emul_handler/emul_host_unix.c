@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2015, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include "unix_hints.h"
@@ -93,6 +93,22 @@ static const char *libcSymbols[] =
     NULL
 };
 
+#ifdef HOST_OS_linux
+static const char *scanSymbols[] =
+{
+    "syscall",
+    "localtime_r",
+    "realloc",
+    "free",
+#ifdef _STAT_VER
+    "__fxstatat",
+#else
+    "fstatat",
+#endif
+    NULL
+};
+#endif
+
 /*********************************************************************************************/
 
 static inline struct filehandle *CreateStdHandle(int fd)
@@ -146,6 +162,17 @@ static int host_startup(struct emulbase *emulbase)
         return FALSE;
     }
 
+#ifdef HOST_OS_linux
+    /* Without this directories are read entry by entry */
+    emulbase->pdata.ScanIFace = (struct ScanInterface *)HostLib_GetInterface(emulbase->pdata.em_UnixIOBase->uio_LibcHandle, scanSymbols, &r);
+    if (emulbase->pdata.ScanIFace && r)
+    {
+        D(bug("[EmulHandler] %lu unresolved directory scan symbols\n", r));
+        HostLib_DropInterface((APTR *)emulbase->pdata.ScanIFace);
+        emulbase->pdata.ScanIFace = NULL;
+    }
+#endif
+
     /* Cache errno pointer for faster access */
     emulbase->pdata.errnoPtr = emulbase->pdata.em_UnixIOBase->uio_ErrnoPtr;
 
@@ -163,6 +190,8 @@ static int host_cleanup(struct emulbase *emulbase)
 {
     D(bug("[EmulHandler] Expunge\n"));
 
+    if (emulbase->pdata.ScanIFace)
+        HostLib_DropInterface((APTR *)emulbase->pdata.ScanIFace);
     if (emulbase->pdata.SysIFace)
         HostLib_DropInterface((APTR *)emulbase->pdata.SysIFace);
 
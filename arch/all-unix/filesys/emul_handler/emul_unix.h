@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2019, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #ifdef HOST_LONG_ALIGNED
@@ -100,3 +100,35 @@ struct LibCInterface
 #define LSeek(fildes, offset, whence) emulbase->pdata.SysIFace->lseek(fildes, offset, whence)
 #define FTruncate(fildes, length)     emulbase->pdata.SysIFace->ftruncate(fildes, length)
 #endif
+
+#ifdef HOST_OS_linux
+/*
+ * Host functions for reading whole directories in batches (emul_dir.c).
+ * Only used on Linux, where getdents64() is available.
+ */
+struct ScanInterface
+{
+    long	   (*syscall)(long number, ...);
+    struct tm     *(*localtime_r)(const time_t *clock, struct tm *result);
+    void	  *(*realloc)(void *ptr, size_t size);
+    void	   (*free)(void *ptr);
+#ifdef _STAT_VER
+    int		   (*__fxstatat)(int ver, int dirfd, const char *path, struct stat *buf, int flags);
+    #define fstatat(dirfd, path, buf, flags) __fxstatat(_STAT_VER, dirfd, path, buf, flags)
+#else
+    int		   (*fstatat)(int dirfd, const char *path, struct stat *buf, int flags);
+#endif
+};
+#else
+struct ScanInterface;
+#endif
+
+/* Make an AROS error-code (<dos/dos.h>) out of a unix error-code (emul_host.c) */
+LONG errno_u2a(int err);
+
+/* Directory scans (emul_dir.c) */
+int ScanDir(struct LibCInterface *SysIFace, struct ScanInterface *ScanIFace, int *errnoPtr,
+            char *path, struct EmulDirScan *eds);
+void FreeDirScan(struct emulbase *emulbase, struct filehandle *fh);
+LONG DoExamineScan(struct emulbase *emulbase, struct filehandle *fh, struct ExAllData *ead,
+                   struct ExAllControl *eac, ULONG size, ULONG type, struct DosLibrary *DOSBase);
@@ -0,0 +1,35 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: ARM color conversion routines.
+*/
+
+#include <aros/debug.h>
+#include <exec/types.h>
+#include <hidd/gfx.h>
+#include <resources/processor.h>
+#include <proto/exec.h>
+#include <proto/processor.h>
+
+#include "colorconv/rgbconv_macros.h"
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include "colorconv/rgbconv_vector.h"
+#include "colorconv/rgbconv_neon.h"
+#endif
+
+void SetArchRGBConversionFunctions(HIDDT_RGBConversionFunction rgbconvertfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT])
+{
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+    APTR ProcessorBase = OpenResource(PROCESSORNAME);
+    BOOL neon = FALSE;
+
+    if (ProcessorBase)
+        GetCPUInfoTags(GCIT_SupportsNeon, &neon, TAG_DONE);
+
+    D(bug("[GFX:arm] NEON color conversion: %d\n", neon));
+
+    if (neon)
+        SetNEONRGBConversionFunctions(rgbconvertfuncs);
+#endif
+}
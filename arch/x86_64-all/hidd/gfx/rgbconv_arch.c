@@ -0,0 +1,283 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: SSE2 and AVX2 color conversion routines.
+*/
+
+#include <aros/debug.h>
+#include <exec/types.h>
+#include <hidd/gfx.h>
+#include <resources/processor.h>
+#include <proto/exec.h>
+#include <proto/processor.h>
+
+#include <immintrin.h>
+
+#include "colorconv/rgbconv_macros.h"
+#include "colorconv/rgbconv_vector.h"
+
+/* SSE2 is always there on x86_64, so these need no check. They handle
+   16 and 32 bit pixels, 8 at a time */
+
+static inline __m128i rgbconv_terms_sse2(__m128i v, const __m128i *left, const __m128i *right,
+    const __m128i *mask, UBYTE count)
+{
+    __m128i d = _mm_setzero_si128();
+
+#define TERM(i) d = _mm_or_si128(d, _mm_and_si128(_mm_srl_epi32(_mm_sll_epi32(v, left[i]), right[i]), mask[i]))
+    switch (count)
+    {
+    case 4: TERM(3);
+    case 3: TERM(2);
+    case 2: TERM(1);
+    default: TERM(0);
+    }
+#undef TERM
+
+    return d;
+}
+
+/* Converts the first width & ~7 pixels of a row. Always inlined, so the
+   compiler makes a separate loop for each pixel size */
+static inline __attribute__((always_inline)) void rgbconv_row_sse2(UBYTE *s, UBYTE *d, ULONG width,
+    UBYTE srcbpp, UBYTE dstbpp, const __m128i *left, const __m128i *right,
+    const __m128i *mask, UBYTE count)
+{
+    __m128i zero = _mm_setzero_si128();
+    ULONG x;
+
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        __m128i lo, hi;
+
+        if (srcbpp == 2)
+        {
+            hi = _mm_loadu_si128((__m128i *)s);
+            lo = _mm_unpacklo_epi16(hi, zero);
+            hi = _mm_unpackhi_epi16(hi, zero);
+        }
+        else
+        {
+            lo = _mm_loadu_si128((__m128i *)s);
+            hi = _mm_loadu_si128((__m128i *)(s + 16));
+        }
+
+        lo = rgbconv_terms_sse2(lo, left, right, mask, count);
+        hi = rgbconv_terms_sse2(hi, left, right, mask, count);
+
+        if (dstbpp == 2)
+        {
+            /* Sign extend the 16 bit results, so packing doesn't saturate */
+            lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+            hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+            _mm_storeu_si128((__m128i *)d, _mm_packs_epi32(lo, hi));
+        }
+        else
+        {
+            _mm_storeu_si128((__m128i *)d, lo);
+            _mm_storeu_si128((__m128i *)(d + 16), hi);
+        }
+
+        s += 8 * srcbpp;
+        d += 8 * dstbpp;
+    }
+}
+
+static ULONG convert_terms_sse2(APTR srcPixels, ULONG srcMod, HIDDT_StdPixFmt srcPixFmt,
+    APTR dstPixels, ULONG dstMod, HIDDT_StdPixFmt dstPixFmt,
+    UWORD width, UWORD height)
+{
+    const struct RGBConvTerms *t = RGBCONV_TERMS(srcPixFmt, dstPixFmt);
+    __m128i left[RGBCONV_MAXTERMS], right[RGBCONV_MAXTERMS], mask[RGBCONV_MAXTERMS];
+    UBYTE *src = srcPixels, *dst = dstPixels;
+    ULONG y, done = width & ~7;
+    UBYTE i;
+
+    if (t->count == 0)
+        return 0;
+
+    for (i = 0; i < t->count; i++)
+    {
+        left[i] = _mm_cvtsi32_si128(t->shift[i] > 0 ? t->shift[i] : 0);
+        right[i] = _mm_cvtsi32_si128(t->shift[i] < 0 ? -t->shift[i] : 0);
+        mask[i] = _mm_set1_epi32(t->mask[i]);
+    }
+
+    for (y = 0; y < height; y++)
+    {
+        switch ((t->srcbpp << 4) | t->dstbpp)
+        {
+        case 0x22:
+            rgbconv_row_sse2(src, dst, width, 2, 2, left, right, mask, t->count);
+            break;
+        case 0x24:
+            rgbconv_row_sse2(src, dst, width, 2, 4, left, right, mask, t->count);
+            break;
+        case 0x42:
+            rgbconv_row_sse2(src, dst, width, 4, 2, left, right, mask, t->count);
+            break;
+        default:
+            rgbconv_row_sse2(src, dst, width, 4, 4, left, right, mask, t->count);
+            break;
+        }
+        rgbconv_convertrow(t, src + done * t->srcbpp, dst + done * t->dstbpp, width - done);
+
+        src += srcMod;
+        dst += dstMod;
+    }
+
+    return 1;
+}
+
+/* AVX2 routines handle 24 bit pixels too, and 16 pixels at a time */
+
+#define AVX2_FUNC __attribute__((target("avx2")))
+
+static inline AVX2_FUNC __m256i rgbconv_terms_avx2(__m256i v, const __m128i *left, const __m128i *right,
+    const __m256i *mask, UBYTE count)
+{
+    __m256i d = _mm256_setzero_si256();
+
+#define TERM(i) d = _mm256_or_si256(d, _mm256_and_si256(_mm256_srl_epi32(_mm256_sll_epi32(v, left[i]), right[i]), mask[i]))
+    switch (count)
+    {
+    case 4: TERM(3);
+    case 3: TERM(2);
+    case 2: TERM(1);
+    default: TERM(0);
+    }
+#undef TERM
+
+    return d;
+}
+
+/* Loads 8 pixels into 32 bit lanes */
+static inline AVX2_FUNC __m256i rgbconv_load_avx2(UBYTE *s, UBYTE bpp, __m256i expand24)
+{
+    switch (bpp)
+    {
+    case 2:
+        return _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i *)s));
+    case 3:
+        /* Reads 4 bytes beyond the 8 pixels */
+        return _mm256_shuffle_epi8(
+            _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)s)),
+                                    _mm_loadu_si128((__m128i *)(s + 12)), 1),
+            expand24);
+    default:
+        return _mm256_loadu_si256((__m256i *)s);
+    }
+}
+
+/* Stores 8 pixels of 24 or 32 bits */
+static inline AVX2_FUNC void rgbconv_store_avx2(UBYTE *d, UBYTE bpp, __m256i v, __m256i pack24)
+{
+    if (bpp == 3)
+    {
+        /* Writes 4 bytes beyond the 8 pixels */
+        v = _mm256_shuffle_epi8(v, pack24);
+        _mm_storeu_si128((__m128i *)d, _mm256_castsi256_si128(v));
+        _mm_storeu_si128((__m128i *)(d + 12), _mm256_extracti128_si256(v, 1));
+    }
+    else
+        _mm256_storeu_si256((__m256i *)d, v);
+}
+
+static AVX2_FUNC ULONG convert_terms_avx2(APTR srcPixels, ULONG srcMod, HIDDT_StdPixFmt srcPixFmt,
+    APTR dstPixels, ULONG dstMod, HIDDT_StdPixFmt dstPixFmt,
+    UWORD width, UWORD height)
+{
+    const struct RGBConvTerms *t = RGBCONV_TERMS(srcPixFmt, dstPixFmt);
+    __m128i left[RGBCONV_MAXTERMS], right[RGBCONV_MAXTERMS];
+    __m256i mask[RGBCONV_MAXTERMS];
+    __m256i expand24 = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                        0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    __m256i pack24 = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                      0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    UBYTE *src = srcPixels, *dst = dstPixels;
+    ULONG x, y, slack;
+    UBYTE i;
+
+    if (t->count == 0)
+        return 0;
+
+    for (i = 0; i < t->count; i++)
+    {
+        left[i] = _mm_cvtsi32_si128(t->shift[i] > 0 ? t->shift[i] : 0);
+        right[i] = _mm_cvtsi32_si128(t->shift[i] < 0 ? -t->shift[i] : 0);
+        mask[i] = _mm256_set1_epi32(t->mask[i]);
+    }
+
+    /* 24 bit pixels are read and written 4 bytes too far, keep that within
+       the pixels the row still has */
+    slack = (t->srcbpp == 3 || t->dstbpp == 3) ? 2 : 0;
+
+    for (y = 0; y < height; y++)
+    {
+        UBYTE *s = src, *d = dst;
+
+        for (x = 0; x + 16 + slack <= width; x += 16)
+        {
+            __m256i lo, hi;
+
+            lo = rgbconv_load_avx2(s, t->srcbpp, expand24);
+            hi = rgbconv_load_avx2(s + 8 * t->srcbpp, t->srcbpp, expand24);
+
+            lo = rgbconv_terms_avx2(lo, left, right, mask, t->count);
+            hi = rgbconv_terms_avx2(hi, left, right, mask, t->count);
+
+            if (t->dstbpp == 2)
+            {
+                lo = _mm256_srai_epi32(_mm256_slli_epi32(lo, 16), 16);
+                hi = _mm256_srai_epi32(_mm256_slli_epi32(hi, 16), 16);
+                /* Packing works per 128 bit lane, put the quarters back in order */
+                _mm256_storeu_si256((__m256i *)d, _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8));
+            }
+            else
+            {
+                rgbconv_store_avx2(d, t->dstbpp, lo, pack24);
+                rgbconv_store_avx2(d + 8 * t->dstbpp, t->dstbpp, hi, pack24);
+            }
+
+            s += 16 * t->srcbpp;
+            d += 16 * t->dstbpp;
+        }
+        rgbconv_convertrow(t, s, d, width - x);
+
+        src += srcMod;
+        dst += dstMod;
+    }
+
+    return 1;
+}
+
+void SetArchRGBConversionFunctions(HIDDT_RGBConversionFunction rgbconvertfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT])
+{
+    APTR ProcessorBase = OpenResource(PROCESSORNAME);
+    struct Task *me = FindTask(NULL);
+    struct ExceptionContext *ctx = me->tc_UnionETask.tc_ETask->et_RegFrame;
+    HIDDT_StdPixFmt src, dst;
+    BOOL avx2 = FALSE;
+
+    /* AVX2 needs the task switches to save the AVX registers */
+    if (ProcessorBase && (ctx->Flags & ECF_FPXS))
+        GetCPUInfoTags(GCIT_SupportsAVX2, &avx2, TAG_DONE);
+
+    D(bug("[GFX:x86_64] Using %s color conversion\n", avx2 ? "AVX2" : "SSE2"));
+
+    for (src = FIRST_RGB_STDPIXFMT; src <= LAST_RGB_STDPIXFMT; src++)
+    {
+        for (dst = FIRST_RGB_STDPIXFMT; dst <= LAST_RGB_STDPIXFMT; dst++)
+        {
+            HIDDT_RGBConversionFunction *f = &rgbconvertfuncs[src - FIRST_RGB_STDPIXFMT][dst - FIRST_RGB_STDPIXFMT];
+
+            if (!rgbconv_getterms(*f, src, dst))
+                continue;
+
+            if (avx2)
+                *f = convert_terms_avx2;
+            else if (rgbconv_bpp(src) != 3 && rgbconv_bpp(dst) != 3)
+                *f = convert_terms_sse2;
+        }
+    }
+}
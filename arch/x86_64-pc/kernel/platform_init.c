@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2023, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #define __KERNEL_NOLIBBASE__
@@ -236,6 +236,17 @@ static int Platform_Init(struct KernelBase *LIBBASE)
      */
     NEWLIST(&pdata->kb_SysCallHandlers);
 
+#if defined(__AROSEXEC_SMP__)
+    /*
+     * Let exec place ready tasks on the per-CPU RunQueues ...
+     */
+    pdata->kb_QueueReadyTask = core_QueueReadyTask;
+    pdata->kb_UnqueueReadyTask = core_UnqueueReadyTask;
+    pdata->kb_WalkReadyQueues = core_WalkReadyQueues;
+    pdata->kb_FlushWakeups = core_FlushWakeups;
+    pdata->kb_TaskRunningOn = core_TaskRunningOn;
+#endif
+
     /*
      * Setup the BSP's exception, spurious, heartbeat and syscall gates early
     */
@@ -2,7 +2,7 @@
 #define AROS_KERNEL_H
 
 /*
-    Copyright  1995-2020, The AROS Development Team. All rights reserved.
+    Copyright  1995-2026, The AROS Development Team. All rights reserved.
     $Id$
 
     Desc: TagItems for the kernel.resource
@@ -86,6 +86,8 @@ typedef void (*irqhandler_t)(void *data, void *data2);
 #define KATTR_CPULoad           (TAG_USER + 0x03F00004)
 #define KATTR_CPULoad_END       (KATTR_CPULoad + 32)
 #define KATTR_ClockSource	(KATTR_CPULoad_END + 1) /* [.G] (APTR)    - Kernel ClockSource resource                                  */
+#define KATTR_Wakeups           (KATTR_CPULoad_END + 2) /* [.G] (IPTR)    - # of reschedule requests sent to other CPUs                 */
+#define KATTR_WakeupsCoalesced  (KATTR_CPULoad_END + 3) /* [.G] (IPTR)    - # of those merged into one that was already pending         */
 
 /* Tag IDs for KrnStatMemory() */
 #define KMS_Free		(TAG_USER + 0x04000000)
@@ -7,6 +7,7 @@
 
 #include <aros/libcall.h>
 
+#include <exec/semaphores.h>
 #include <resources/execlock.h>
 
 __BEGIN_DECLS
@@ -64,6 +65,24 @@ AROS_LP2(void, ReleaseLock,
 
 #endif /* !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__) */
 
+#if !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__)
+AROS_LP2(BOOL, SetSemaphoreFlags,
+         AROS_LPA(struct SignalSemaphore *, sigSem, A0),
+         AROS_LPA(ULONG, flags, D0),
+         LIBBASETYPEPTR, ExecLockBase, 7, ExecLock
+);
+
+#endif /* !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__) */
+
+#if !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__)
+AROS_LP2(BOOL, GetSemaphoreStats,
+         AROS_LPA(struct SignalSemaphore *, sigSem, A0),
+         AROS_LPA(struct SemaphoreStats *, stats, A1),
+         LIBBASETYPEPTR, ExecLockBase, 8, ExecLock
+);
+
+#endif /* !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__) */
+
 __END_DECLS
 
 #endif /* CLIB_EXECLOCK_PROTOS_H */
@@ -0,0 +1,44 @@
+#ifndef CLIB_EXECTRACE_PROTOS_H
+#define CLIB_EXECTRACE_PROTOS_H
+
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+#include <aros/libcall.h>
+
+#include <resources/exectrace.h>
+
+__BEGIN_DECLS
+
+#if !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__)
+AROS_LP2(ULONG, SetTraceFlags,
+         AROS_LPA(ULONG, flags, D0),
+         AROS_LPA(ULONG, mask, D1),
+         LIBBASETYPEPTR, ExecTraceBase, 1, ExecTrace
+);
+
+#endif /* !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__) */
+
+#if !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__)
+AROS_LP4(ULONG, ReadTrace,
+         AROS_LPA(ULONG, cpu, D0),
+         AROS_LPA(ULONG *, position, A0),
+         AROS_LPA(struct ExecTraceRecord *, buffer, A1),
+         AROS_LPA(ULONG, count, D1),
+         LIBBASETYPEPTR, ExecTraceBase, 2, ExecTrace
+);
+
+#endif /* !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__) */
+
+#if !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__)
+AROS_LP1(IPTR, GetTraceAttr,
+         AROS_LPA(ULONG, attr, D0),
+         LIBBASETYPEPTR, ExecTraceBase, 3, ExecTrace
+);
+
+#endif /* !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__) */
+
+__END_DECLS
+
+#endif /* CLIB_EXECTRACE_PROTOS_H */
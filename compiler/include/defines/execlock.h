@@ -106,6 +106,36 @@ __BEGIN_DECLS
 
 #endif /* !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__) */
 
+#if !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__)
+
+#define __SetSemaphoreFlags_WB(__ExecLockBase, __arg1, __arg2) ({\
+        AROS_LIBREQ(ExecLockBase,36)\
+        AROS_LC2(BOOL, SetSemaphoreFlags, \
+                  AROS_LCA(struct SignalSemaphore *,(__arg1),A0), \
+                  AROS_LCA(ULONG,(__arg2),D0), \
+        struct Library *, (__ExecLockBase), 7, ExecLock);\
+})
+
+#define SetSemaphoreFlags(arg1, arg2) \
+    __SetSemaphoreFlags_WB(__aros_getbase_ExecLockBase(), (arg1), (arg2))
+
+#endif /* !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__) */
+
+#if !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__)
+
+#define __GetSemaphoreStats_WB(__ExecLockBase, __arg1, __arg2) ({\
+        AROS_LIBREQ(ExecLockBase,36)\
+        AROS_LC2(BOOL, GetSemaphoreStats, \
+                  AROS_LCA(struct SignalSemaphore *,(__arg1),A0), \
+                  AROS_LCA(struct SemaphoreStats *,(__arg2),A1), \
+        struct Library *, (__ExecLockBase), 8, ExecLock);\
+})
+
+#define GetSemaphoreStats(arg1, arg2) \
+    __GetSemaphoreStats_WB(__aros_getbase_ExecLockBase(), (arg1), (arg2))
+
+#endif /* !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__) */
+
 __END_DECLS
 
 #endif /* DEFINES_EXECLOCK_H*/
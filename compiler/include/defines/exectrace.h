@@ -0,0 +1,68 @@
+#ifndef DEFINES_EXECTRACE_H
+#define DEFINES_EXECTRACE_H
+
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+    Desc: Defines for exectrace
+*/
+
+#include <aros/libcall.h>
+#include <exec/types.h>
+#include <aros/symbolsets.h>
+#include <aros/preprocessor/variadic/cast2iptr.hpp>
+
+__BEGIN_DECLS
+
+
+#if !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__)
+
+#define __SetTraceFlags_WB(__ExecTraceBase, __arg1, __arg2) ({\
+        AROS_LIBREQ(ExecTraceBase,36)\
+        AROS_LC2(ULONG, SetTraceFlags, \
+                  AROS_LCA(ULONG,(__arg1),D0), \
+                  AROS_LCA(ULONG,(__arg2),D1), \
+        struct Library *, (__ExecTraceBase), 1, ExecTrace);\
+})
+
+#define SetTraceFlags(arg1, arg2) \
+    __SetTraceFlags_WB(__aros_getbase_ExecTraceBase(), (arg1), (arg2))
+
+#endif /* !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__) */
+
+#if !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__)
+
+#define __ReadTrace_WB(__ExecTraceBase, __arg1, __arg2, __arg3, __arg4) ({\
+        AROS_LIBREQ(ExecTraceBase,36)\
+        AROS_LC4(ULONG, ReadTrace, \
+                  AROS_LCA(ULONG,(__arg1),D0), \
+                  AROS_LCA(ULONG *,(__arg2),A0), \
+                  AROS_LCA(struct ExecTraceRecord *,(__arg3),A1), \
+                  AROS_LCA(ULONG,(__arg4),D1), \
+        struct Library *, (__ExecTraceBase), 2, ExecTrace);\
+})
+
+#define ReadTrace(arg1, arg2, arg3, arg4) \
+    __ReadTrace_WB(__aros_getbase_ExecTraceBase(), (arg1), (arg2), (arg3), (arg4))
+
+#endif /* !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__) */
+
+#if !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__)
+
+#define __GetTraceAttr_WB(__ExecTraceBase, __arg1) ({\
+        AROS_LIBREQ(ExecTraceBase,36)\
+        AROS_LC1(IPTR, GetTraceAttr, \
+                  AROS_LCA(ULONG,(__arg1),D0), \
+        struct Library *, (__ExecTraceBase), 3, ExecTrace);\
+})
+
+#define GetTraceAttr(arg1) \
+    __GetTraceAttr_WB(__aros_getbase_ExecTraceBase(), (arg1))
+
+#endif /* !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__) */
+
+__END_DECLS
+
+#endif /* DEFINES_EXECTRACE_H*/
@@ -32,5 +32,7 @@
 #define BUF_LINE 0 /* Flush at the end of lines '\n'. */
 #define BUF_FULL 1 /* Flush only when buffer is full. */
 #define BUF_NONE 2 /* Do not buffer, read and write immediatly. */
+#define BUF_PREFETCH 3 /* Like BUF_FULL, and read the next buffer while the
+                          current one is used (AROS extension). */
 
 #endif /* DOS_STDIO_H */
@@ -2,7 +2,7 @@
 #define EXEC_LISTS_H
 
 /*
-    Copyright  1995-2021, The AROS Development Team. All rights reserved.
+    Copyright  1995-2026, The AROS Development Team. All rights reserved.
     $Id$
         
     Structures and macros for exec lists.
@@ -77,9 +77,14 @@ struct MinList
 #define IsMinListEmpty(l) \
 	( (((struct MinList *)l)->mlh_TailPred) == (struct MinNode *)(l) )
 
+/* PF_MPSC ports are empty when the next message to get is their stub */
 #define IsMsgPortEmpty(mp) \
-      ( (((struct MsgPort *)(mp))->mp_MsgList.lh_TailPred) \
-	    == (struct Node *)(&(((struct MsgPort *)(mp))->mp_MsgList)) )
+      ( (((struct MsgPort *)(mp))->mp_Flags & PF_MPSC) \
+	? ( ((((struct MsgPort *)(mp))->mp_MsgList.lh_Tail) \
+		== (struct Node *)(&(((struct MsgPort *)(mp))->mp_MsgList))) \
+	    && !(((struct MsgPort *)(mp))->mp_MsgList.lh_Head) ) \
+	: ( (((struct MsgPort *)(mp))->mp_MsgList.lh_TailPred) \
+	    == (struct Node *)(&(((struct MsgPort *)(mp))->mp_MsgList)) ) )
 
 #ifndef __GNUC__
 #define NEWLIST(_l)                                     \
@@ -2,7 +2,7 @@
 #define EXEC_PORTS_H
 
 /*
-    Copyright  1995-2017, The AROS Development Team. All rights reserved.
+    Copyright  1995-2026, The AROS Development Team. All rights reserved.
     $Id$
 
     Desc: Message ports and messages
@@ -51,6 +51,33 @@ struct MsgPort
                                    documented on AmigaOS and was never defined
                                    but would work for mp_Flags == 3 */
 
+/* mp_Flags: mp_MsgList is a lock-free queue, see NEWMPSCPORT() */
+#define PF_MPSC         (1 << 3)
+
+/*
+ * Turns an empty port that is not in use yet into a lock-free
+ * multi-producer/single-consumer port. PutMsg() and ReplyMsg() to such a
+ * port don't lock it, and only trigger the arrival action when the port
+ * goes from empty to non-empty. Only the task owning the port may
+ * GetMsg() or WaitPort() on it, and mp_MsgList must not be walked or
+ * changed directly - IsMsgPortEmpty() may still be used.
+ *
+ * Such a port can't be the reply port of I/O requests, as WaitIO() has to
+ * take the request out of the middle of the list. CreateIORequest() and
+ * OpenDevice() refuse it.
+ */
+#define NEWMPSCPORT(_mp)                                        \
+do                                                              \
+{                                                               \
+    struct MsgPort *__aros_port_tmp = (struct MsgPort *)(_mp);  \
+    struct List *l = &__aros_port_tmp->mp_MsgList;              \
+                                                                \
+    l->lh_Head     = 0;                                         \
+    l->lh_Tail     = (struct Node *)l;                          \
+    l->lh_TailPred = (struct Node *)l;                          \
+    __aros_port_tmp->mp_Flags |= PF_MPSC;                       \
+} while (0)
+
 /* Message */
 struct Message
 {
@@ -110,4 +110,36 @@ static inline void __inline_ExecLock_ReleaseLock(APTR __arg1, ULONG __arg2, APTR
 
 #endif /* !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__) */
 
+#if !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__)
+
+static inline BOOL __inline_ExecLock_SetSemaphoreFlags(struct SignalSemaphore * __arg1, ULONG __arg2, APTR __ExecLockBase)
+{
+    AROS_LIBREQ(ExecLockBase, 36)
+    return AROS_LC2(BOOL, SetSemaphoreFlags,
+        AROS_LCA(struct SignalSemaphore *,(__arg1),A0),
+        AROS_LCA(ULONG,(__arg2),D0),
+        struct Library *, (__ExecLockBase), 7, ExecLock    );
+}
+
+#define SetSemaphoreFlags(arg1, arg2) \
+    __inline_ExecLock_SetSemaphoreFlags((arg1), (arg2), __aros_getbase_ExecLockBase())
+
+#endif /* !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__) */
+
+#if !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__)
+
+static inline BOOL __inline_ExecLock_GetSemaphoreStats(struct SignalSemaphore * __arg1, struct SemaphoreStats * __arg2, APTR __ExecLockBase)
+{
+    AROS_LIBREQ(ExecLockBase, 36)
+    return AROS_LC2(BOOL, GetSemaphoreStats,
+        AROS_LCA(struct SignalSemaphore *,(__arg1),A0),
+        AROS_LCA(struct SemaphoreStats *,(__arg2),A1),
+        struct Library *, (__ExecLockBase), 8, ExecLock    );
+}
+
+#define GetSemaphoreStats(arg1, arg2) \
+    __inline_ExecLock_GetSemaphoreStats((arg1), (arg2), __aros_getbase_ExecLockBase())
+
+#endif /* !defined(__EXECLOCK_LIBAPI__) || (36 <= __EXECLOCK_LIBAPI__) */
+
 #endif /* INLINE_EXECLOCK_H*/
@@ -0,0 +1,67 @@
+#ifndef INLINE_EXECTRACE_H
+#define INLINE_EXECTRACE_H
+
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+    Desc: Inline function(s) for exectrace
+*/
+
+#include <aros/libcall.h>
+#include <exec/types.h>
+#include <aros/symbolsets.h>
+#include <aros/preprocessor/variadic/cast2iptr.hpp>
+
+
+#if !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__)
+
+static inline ULONG __inline_ExecTrace_SetTraceFlags(ULONG __arg1, ULONG __arg2, APTR __ExecTraceBase)
+{
+    AROS_LIBREQ(ExecTraceBase, 36)
+    return AROS_LC2(ULONG, SetTraceFlags,
+        AROS_LCA(ULONG,(__arg1),D0),
+        AROS_LCA(ULONG,(__arg2),D1),
+        struct Library *, (__ExecTraceBase), 1, ExecTrace    );
+}
+
+#define SetTraceFlags(arg1, arg2) \
+    __inline_ExecTrace_SetTraceFlags((arg1), (arg2), __aros_getbase_ExecTraceBase())
+
+#endif /* !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__) */
+
+#if !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__)
+
+static inline ULONG __inline_ExecTrace_ReadTrace(ULONG __arg1, ULONG * __arg2, struct ExecTraceRecord * __arg3, ULONG __arg4, APTR __ExecTraceBase)
+{
+    AROS_LIBREQ(ExecTraceBase, 36)
+    return AROS_LC4(ULONG, ReadTrace,
+        AROS_LCA(ULONG,(__arg1),D0),
+        AROS_LCA(ULONG *,(__arg2),A0),
+        AROS_LCA(struct ExecTraceRecord *,(__arg3),A1),
+        AROS_LCA(ULONG,(__arg4),D1),
+        struct Library *, (__ExecTraceBase), 2, ExecTrace    );
+}
+
+#define ReadTrace(arg1, arg2, arg3, arg4) \
+    __inline_ExecTrace_ReadTrace((arg1), (arg2), (arg3), (arg4), __aros_getbase_ExecTraceBase())
+
+#endif /* !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__) */
+
+#if !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__)
+
+static inline IPTR __inline_ExecTrace_GetTraceAttr(ULONG __arg1, APTR __ExecTraceBase)
+{
+    AROS_LIBREQ(ExecTraceBase, 36)
+    return AROS_LC1(IPTR, GetTraceAttr,
+        AROS_LCA(ULONG,(__arg1),D0),
+        struct Library *, (__ExecTraceBase), 3, ExecTrace    );
+}
+
+#define GetTraceAttr(arg1) \
+    __inline_ExecTrace_GetTraceAttr((arg1), __aros_getbase_ExecTraceBase())
+
+#endif /* !defined(__EXECTRACE_LIBAPI__) || (36 <= __EXECTRACE_LIBAPI__) */
+
+#endif /* INLINE_EXECTRACE_H*/
@@ -0,0 +1,44 @@
+#ifndef PROTO_EXECTRACE_H
+#define PROTO_EXECTRACE_H
+
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+#include <exec/types.h>
+#include <aros/system.h>
+
+#include <clib/exectrace_protos.h>
+
+#ifndef __EXECTRACE_RELLIBBASE__
+ #if !defined(__NOLIBBASE__) && !defined(__EXECTRACE_NOLIBBASE__)
+  #if !defined(ExecTraceBase)
+   #ifdef __EXECTRACE_STDLIBBASE__
+    extern struct Library *ExecTraceBase;
+   #else
+    extern struct Library *ExecTraceBase;
+   #endif
+  #endif
+ #endif
+ #ifndef __aros_getbase_ExecTraceBase
+  #define __aros_getbase_ExecTraceBase() (ExecTraceBase)
+ #endif
+#else /* __EXECTRACE_RELLIBASE__ */
+ extern const IPTR __aros_rellib_offset_ExecTraceBase;
+ #define AROS_RELLIB_OFFSET_EXECTRACE __aros_rellib_offset_ExecTraceBase
+ #define AROS_RELLIB_BASE_EXECTRACE __aros_rellib_base_ExecTraceBase
+ #ifndef __aros_getbase_ExecTraceBase
+  #ifndef __aros_getoffsettable
+   char *__aros_getoffsettable(void);
+  #endif
+  #define __aros_getbase_ExecTraceBase() (*(struct Library **)(__aros_getoffsettable()+__aros_rellib_offset_ExecTraceBase))
+ #endif
+#endif
+
+#if !defined(NOLIBINLINE) && !defined(EXECTRACE_NOLIBINLINE) && !defined(__EXECTRACE_RELLIBBASE__)
+#   include <inline/exectrace.h>
+#elif !defined(NOLIBDEFINES) && !defined(EXECTRACE_NOLIBDEFINES)
+#   include <defines/exectrace.h>
+#endif
+
+#endif /* PROTO_EXECTRACE_H */
@@ -1,13 +1,33 @@
 /*
-    Copyright (C) 2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 2017-2026, The AROS Development Team. All rights reserved.
 */
 
 #ifndef RESOURCES_EXECLOCK_H
 #define RESOURCES_EXECLOCK_H
 
+#ifndef EXEC_TYPES_H
+#   include <exec/types.h>
+#endif
+
 #define LOCKB_DISABLE   0
 #define LOCKB_FORBID    1
 #define LOCKF_DISABLE   (1 << LOCKB_DISABLE)
 #define LOCKF_FORBID    (1 << LOCKB_FORBID)
 
-#endif /* !RESOURCES_EXECLOCK_H */
\ No newline at end of file
+/* Flags for SetSemaphoreFlags() */
+#define SEMB_STATS              0       /* Keep statistics for the semaphore    */
+#define SEMB_PERCPUREADERS      1       /* Count shared holders per CPU         */
+#define SEMF_STATS              (1 << SEMB_STATS)
+#define SEMF_PERCPUREADERS      (1 << SEMB_PERCPUREADERS)
+
+/* Filled in by GetSemaphoreStats(). Times are in KrnTimeStamp() units. */
+struct SemaphoreStats
+{
+    UQUAD       sst_Contended;          /* Obtains that had to wait for another task    */
+    UQUAD       sst_SpinAcquired;       /* Contended obtains that got it by spinning    */
+    UQUAD       sst_SpinTime;           /* Time spent spinning                          */
+    UQUAD       sst_Sleeps;             /* Contended obtains that had to Wait()         */
+    UQUAD       sst_SleepTime;          /* Time spent in Wait()                         */
+};
+
+#endif /* !RESOURCES_EXECLOCK_H */
@@ -0,0 +1,52 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+#ifndef RESOURCES_EXECTRACE_H
+#define RESOURCES_EXECTRACE_H
+
+#ifndef EXEC_TYPES_H
+#   include <exec/types.h>
+#endif
+
+#define EXECTRACENAME   "exectrace.resource"
+
+/* Event categories, for SetTraceFlags() */
+#define ETB_SCHED       0       /* Task dispatches, Wait() and Signal() */
+#define ETB_MEMORY      1       /* AllocMem() and FreeMem()             */
+#define ETB_MESSAGE     2       /* PutMsg() and GetMsg()                */
+#define ETF_SCHED       (1 << ETB_SCHED)
+#define ETF_MEMORY      (1 << ETB_MEMORY)
+#define ETF_MESSAGE     (1 << ETB_MESSAGE)
+#define ETF_ALL         (ETF_SCHED | ETF_MEMORY | ETF_MESSAGE)
+
+/* Record types, and what etr_Arg[] holds for them */
+#define ETT_DISPATCH    1       /* Task now running, task that ran before       */
+#define ETT_WAIT        2       /* Signals waited for, signals already received */
+#define ETT_SIGNAL      3       /* Task signalled, signals sent                 */
+#define ETT_ALLOCMEM    4       /* Size requested, memory returned              */
+#define ETT_FREEMEM     5       /* Memory freed, size                           */
+#define ETT_PUTMSG      6       /* Port, message                                */
+#define ETT_GETMSG      7       /* Port, message (NULL if the port was empty)   */
+
+/*
+ * One traced event. etr_Time is in KrnTimeStamp() units, etr_Sequence
+ * counts the events of the CPU that recorded it, so gaps show where
+ * records were lost.
+ */
+struct ExecTraceRecord
+{
+    UQUAD       etr_Time;
+    ULONG       etr_Sequence;
+    UWORD       etr_Type;               /* ETT_#?                               */
+    UWORD       etr_CPU;
+    IPTR        etr_Task;               /* Task that was running                */
+    IPTR        etr_Arg[2];
+};
+
+/* Attributes for GetTraceAttr() */
+#define ETA_Flags       0       /* Categories being traced              */
+#define ETA_CPUCount    1       /* Number of per-CPU trace buffers      */
+#define ETA_Records     2       /* Records each buffer holds            */
+
+#endif /* !RESOURCES_EXECTRACE_H */
@@ -2,7 +2,7 @@
 #define RESOURCES_PROCESSOR_H
 
 /*
-    Copyright  2010-2020, The AROS Development Team. All rights reserved.
+    Copyright  2010-2026, The AROS Development Team. All rights reserved.
         
     Tags and defines for processors information queries
 */
@@ -92,6 +92,7 @@
 #define GCIT_SupportsAMMX           (GCIT_FeaturesBase +  40)
 #define GCIT_SupportsAVX            (GCIT_FeaturesBase +  41)
 #define GCIT_SupportsAES            (GCIT_FeaturesBase +  42)
+#define GCIT_SupportsAVX2           (GCIT_FeaturesBase +  43)
 #define GCIT_Virtualized            (GCIT_FeaturesBase +  100)
 #define GCIT_FeaturesLast           (TAG_USER + 499)
 
@@ -0,0 +1,31 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Helpers shared by the dos.library benchmarks.
+*/
+
+#include <sys/time.h>
+#include <stdio.h>
+
+#include <exec/types.h>
+
+#define TIMER(name) \
+    struct timeval name ## _start; \
+    struct timeval name ## _stop
+
+#define START(name) gettimeofday(& name ## _start, NULL)
+
+#define STOP(name) gettimeofday(& name ## _stop, NULL)
+
+#define ELAPSED(name) ((double)(((name ## _stop.tv_sec * 1000000) + name ## _stop.tv_usec) - ((name ## _start.tv_sec * 1000000) + name ## _start.tv_usec))/1000000.0)
+
+/* Operations per second, and MB per second */
+#define RATE(count, elapsed) ((elapsed) > 0. ? (double)(count) / (elapsed) : 0.)
+#define MBRATE(bytes, elapsed) (RATE(bytes, elapsed) / (1024. * 1024.))
+
+/* Simple LCG, so runs are repeatable. Returns 24 bits */
+static inline ULONG NextRandom(ULONG *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
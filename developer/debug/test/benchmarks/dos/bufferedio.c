@@ -0,0 +1,180 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Buffered I/O benchmark. Writes a text file with FPuts(), then reads it
+    back with FGetC(), FGets() and FRead() of small and large blocks, and
+    reports the rate of each phase. With PREFETCH the reads use the
+    BUF_PREFETCH mode of SetVBuf(), with BUFSIZE the buffers get a fixed
+    size, otherwise they start small and grow.
+*/
+
+#include <stdio.h>
+
+#include <exec/memory.h>
+#include <dos/stdio.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "benchmark.h"
+
+#define ARG_TEMPLATE "FILE/K,SIZE/N,BUFSIZE/N,PREFETCH/S,KEEP/S"
+#define ARG_FILE        0
+#define ARG_SIZE        1
+#define ARG_BUFSIZE     2
+#define ARG_PREFETCH    3
+#define ARG_KEEP        4
+#define NUM_ARGS        5
+
+#define LINE_LENGTH     64
+#define BLOCK_SIZE      65536
+
+static void Report(const char *phase, UQUAD bytes, double elapsed)
+{
+    printf("%-14s %.2f\n", phase, MBRATE(bytes, elapsed));
+}
+
+static BPTR OpenBuffered(CONST_STRPTR fileName, LONG mode, LONG type, LONG bufSize)
+{
+    BPTR file = Open(fileName, mode);
+
+    if (file && (SetVBuf(file, NULL, type, bufSize) != 0))
+    {
+        Close(file);
+        file = BNULL;
+    }
+
+    return file;
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    TIMER(phase);
+    CONST_STRPTR fileName = "RAM:bufferedio.dat";
+    ULONG size, lines, i, failed = 0;
+    LONG bufSize = -1, readType = BUF_FULL, res;
+    UQUAD bytes;
+    char line[LINE_LENGTH + 1];
+    UBYTE *block;
+    BOOL keep = FALSE;
+    BPTR file;
+
+    size = 16384;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (rda)
+    {
+        if (args[ARG_FILE])
+            fileName = (CONST_STRPTR)args[ARG_FILE];
+        if (args[ARG_SIZE])
+            size = *(LONG *)args[ARG_SIZE];
+        if (args[ARG_BUFSIZE])
+            bufSize = *(LONG *)args[ARG_BUFSIZE];
+        if (args[ARG_PREFETCH])
+            readType = BUF_PREFETCH;
+        keep = args[ARG_KEEP] ? TRUE : FALSE;
+    }
+    if (size < 1)
+        size = 1;
+
+    /* SIZE is in KiB */
+    lines = size * 1024 / LINE_LENGTH;
+
+    block = AllocVec(BLOCK_SIZE, MEMF_ANY);
+    file = OpenBuffered(fileName, MODE_NEWFILE, BUF_FULL, bufSize);
+    if (!block || !file)
+    {
+        PrintFault(IoErr(), "BufferedIO");
+        if (file)
+            Close(file);
+        FreeVec(block);
+        if (rda)
+            FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+
+    for (i = 0; i < LINE_LENGTH - 1; i++)
+        line[i] = 'a' + (i % 26);
+    line[LINE_LENGTH - 1] = '\n';
+    line[LINE_LENGTH] = '\0';
+
+    printf("File: %s, size: %u bytes, buffer: %s%s\n\n",
+        fileName, (unsigned)(lines * LINE_LENGTH),
+        bufSize < 0 ? "adaptive" : "fixed",
+        readType == BUF_PREFETCH ? ", prefetch" : "");
+    printf("Phase          MiB/s\n");
+
+    START(phase);
+    for (i = 0; i < lines; i++)
+    {
+        if (FPuts(file, line) != 0)
+            failed++;
+    }
+    Close(file);
+    STOP(phase);
+    Report("FPuts", (UQUAD)lines * LINE_LENGTH, ELAPSED(phase));
+
+    if ((file = OpenBuffered(fileName, MODE_OLDFILE, readType, bufSize)))
+    {
+        bytes = 0;
+        START(phase);
+        while (FGetC(file) != EOF)
+            bytes++;
+        STOP(phase);
+        Report("FGetC", bytes, ELAPSED(phase));
+        Close(file);
+    }
+    else
+        failed++;
+
+    if ((file = OpenBuffered(fileName, MODE_OLDFILE, readType, bufSize)))
+    {
+        bytes = 0;
+        START(phase);
+        while (FGets(file, line, sizeof(line)) != NULL)
+            bytes += LINE_LENGTH;
+        STOP(phase);
+        Report("FGets", bytes, ELAPSED(phase));
+        Close(file);
+    }
+    else
+        failed++;
+
+    if ((file = OpenBuffered(fileName, MODE_OLDFILE, readType, bufSize)))
+    {
+        bytes = 0;
+        START(phase);
+        while ((res = FRead(file, block, 1, 256)) > 0)
+            bytes += res;
+        STOP(phase);
+        Report("FRead 256", bytes, ELAPSED(phase));
+        Close(file);
+    }
+    else
+        failed++;
+
+    if ((file = OpenBuffered(fileName, MODE_OLDFILE, readType, bufSize)))
+    {
+        bytes = 0;
+        START(phase);
+        while ((res = FRead(file, block, 1, BLOCK_SIZE)) > 0)
+            bytes += res;
+        STOP(phase);
+        Report("FRead 64K", bytes, ELAPSED(phase));
+        Close(file);
+    }
+    else
+        failed++;
+
+    if (!keep)
+        DeleteFile(fileName);
+    FreeVec(block);
+    if (rda)
+        FreeArgs(rda);
+
+    if (failed)
+        printf("\n%u operations failed\n", (unsigned)failed);
+
+    return failed ? RETURN_WARN : RETURN_OK;
+}
@@ -0,0 +1,160 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Directory name lookup benchmark. Creates many empty files in one
+    directory, locks them by name in random order, lists the directory
+    with ExNext(), and deletes them again. Reports the rate of each phase,
+    which shows how a handler's lookups scale with the number of entries
+    (RAM: by default). The listing is also checked to be in creation order,
+    which is the order RAM: keeps.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <exec/memory.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "benchmark.h"
+
+#define ARG_TEMPLATE "DIR/K,NAMES/N"
+#define ARG_DIR         0
+#define ARG_NAMES       1
+#define NUM_ARGS        2
+
+#define NAME_SIZE       32
+
+static void Report(const char *phase, ULONG ops, double elapsed)
+{
+    printf("%-10s %-10u %-10.3f %.0f\n", phase, (unsigned)ops, elapsed, RATE(ops, elapsed));
+}
+
+static void MakeName(char *buffer, ULONG i)
+{
+    /* Mix the case, lookups use another one */
+    snprintf(buffer, NAME_SIZE, (i & 1) ? "Entry%06lu.o" : "ENTRY%06lu.O", (unsigned long)i);
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    TIMER(phase);
+    struct FileInfoBlock *fib;
+    CONST_STRPTR dirName = "RAM:dirnames";
+    char name[NAME_SIZE];
+    ULONG count, i, seed = 1, failed = 0, listed = 0, misordered = 0;
+    BPTR dir, olddir, file, lock;
+
+    count = 100000;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (rda)
+    {
+        if (args[ARG_DIR])
+            dirName = (CONST_STRPTR)args[ARG_DIR];
+        if (args[ARG_NAMES])
+            count = *(LONG *)args[ARG_NAMES];
+    }
+    if (count < 1)
+        count = 1;
+
+    fib = AllocDosObject(DOS_FIB, NULL);
+    dir = CreateDir(dirName);
+    if (!fib || !dir)
+    {
+        PrintFault(IoErr(), "DirNames");
+        if (fib)
+            FreeDosObject(DOS_FIB, fib);
+        if (rda)
+            FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+    olddir = CurrentDir(dir);
+
+    printf("Directory: %s, names: %u\n\n", dirName, (unsigned)count);
+    printf("Phase      ops        seconds    ops/s\n");
+
+    START(phase);
+    for (i = 0; i < count; i++)
+    {
+        MakeName(name, i);
+        file = Open(name, MODE_NEWFILE);
+        if (file)
+            Close(file);
+        else
+            failed++;
+    }
+    STOP(phase);
+    Report("create", count, ELAPSED(phase));
+
+    START(phase);
+    for (i = 0; i < count; i++)
+    {
+        MakeName(name, NextRandom(&seed) % count);
+        name[0] ^= 0x20;
+        name[1] ^= 0x20;
+        lock = Lock(name, SHARED_LOCK);
+        if (lock)
+            UnLock(lock);
+        else
+            failed++;
+    }
+    STOP(phase);
+    Report("lookup", count, ELAPSED(phase));
+
+    START(phase);
+    for (i = 0; i < count; i++)
+    {
+        MakeName(name, count + i);
+        lock = Lock(name, SHARED_LOCK);
+        if (lock)
+        {
+            UnLock(lock);
+            failed++;
+        }
+    }
+    STOP(phase);
+    Report("miss", count, ELAPSED(phase));
+
+    START(phase);
+    if (Examine(dir, fib))
+    {
+        while (ExNext(dir, fib))
+        {
+            MakeName(name, listed);
+            if (strcmp(name, fib->fib_FileName) != 0)
+                misordered++;
+            listed++;
+        }
+    }
+    STOP(phase);
+    Report("list", listed, ELAPSED(phase));
+
+    START(phase);
+    for (i = 0; i < count; i++)
+    {
+        MakeName(name, i);
+        if (!DeleteFile(name))
+            failed++;
+    }
+    STOP(phase);
+    Report("delete", count, ELAPSED(phase));
+
+    CurrentDir(olddir);
+    UnLock(dir);
+    DeleteFile(dirName);
+    FreeDosObject(DOS_FIB, fib);
+    if (rda)
+        FreeArgs(rda);
+
+    if (listed != count)
+        printf("\n%u entries listed instead of %u\n", (unsigned)listed, (unsigned)count);
+    if (misordered)
+        printf("\n%u entries listed out of creation order\n", (unsigned)misordered);
+    if (failed)
+        printf("\n%u operations failed\n", (unsigned)failed);
+
+    return (failed || misordered || listed != count) ? RETURN_WARN : RETURN_OK;
+}
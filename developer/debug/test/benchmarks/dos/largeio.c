@@ -0,0 +1,189 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Large transfer benchmark. Writes a file with Write() calls of CHUNK
+    bytes, then reads it back with Read() calls of the same size, and
+    reports the rate and the CPU load of each phase. Block filesystems
+    transfer large chunks directly between the disk and the caller's
+    buffer, so comparing a large CHUNK with a small one (or with a build
+    without that path) shows what copying through the cache costs. With
+    MISALIGN the buffer starts at an odd address, which devices with a
+    restrictive Mask can't transfer to directly.
+
+    The CPU load is measured with a task at the lowest priority, that
+    counts while nothing else wants the CPU. Its rate is calibrated while
+    the system is idle first, so don't run anything else meanwhile.
+*/
+
+#include <stdio.h>
+
+#include <exec/memory.h>
+#include <exec/tasks.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <clib/alib_protos.h>
+
+#include "benchmark.h"
+
+#define LARGEIO_STACKSIZE       (AROS_STACKSIZE)
+
+#define SIGF_STOP               SIGBREAKF_CTRL_E
+
+#define ARG_TEMPLATE "FILE/A,SIZE/N,CHUNK/N,MISALIGN/S,KEEP/S"
+#define ARG_FILE        0
+#define ARG_SIZE        1
+#define ARG_CHUNK       2
+#define ARG_MISALIGN    3
+#define ARG_KEEP        4
+#define NUM_ARGS        5
+
+static volatile ULONG idleCount;
+static volatile BOOL idleDone;
+
+static void IdleEntry(void)
+{
+    while (!(SetSignal(0, 0) & SIGF_STOP))
+        idleCount++;
+
+    idleDone = TRUE;
+}
+
+static void Report(const char *phase, UQUAD bytes, double elapsed,
+    ULONG idle, double idleRate)
+{
+    double load = 0.;
+
+    if (elapsed > 0. && idleRate > 0.)
+    {
+        load = 100. * (1. - (double)idle / elapsed / idleRate);
+        if (load < 0.)
+            load = 0.;
+    }
+
+    printf("%-10s %-10.2f %.1f\n", phase, MBRATE(bytes, elapsed), load);
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    TIMER(phase);
+    struct Task *idleTask;
+    CONST_STRPTR fileName;
+    ULONG size, chunk, pos, i, startIdle, failed = 0;
+    double elapsed, idleRate;
+    UBYTE *memory, *buffer;
+    BPTR file;
+
+    size = 65536;
+    chunk = 1048576;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (!rda)
+    {
+        PrintFault(IoErr(), "LargeIO");
+        return RETURN_FAIL;
+    }
+
+    fileName = (CONST_STRPTR)args[ARG_FILE];
+    if (args[ARG_SIZE])
+        size = *(LONG *)args[ARG_SIZE];
+    if (args[ARG_CHUNK])
+        chunk = *(LONG *)args[ARG_CHUNK];
+    if (size < 1)
+        size = 1;
+    if (chunk < 1)
+        chunk = 1;
+    if (chunk > size * 1024)
+        chunk = size * 1024;
+
+    /* SIZE is in KiB */
+    size *= 1024;
+    size -= size % chunk;
+
+    memory = AllocVec(chunk + 1, MEMF_ANY);
+    if (!memory)
+    {
+        PrintFault(ERROR_NO_FREE_STORE, "LargeIO");
+        FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+    buffer = args[ARG_MISALIGN] ? memory + 1 : memory;
+
+    for (i = 0; i < chunk; i++)
+        buffer[i] = i * 7;
+
+    idleTask = CreateTask("LargeIO Idle", -127, IdleEntry, LARGEIO_STACKSIZE);
+    if (!idleTask)
+    {
+        PrintFault(ERROR_NO_FREE_STORE, "LargeIO");
+        FreeVec(memory);
+        FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+
+    /* Calibrate the idle task */
+    START(phase);
+    startIdle = idleCount;
+    Delay(100);
+    STOP(phase);
+    idleRate = (double)(idleCount - startIdle) / ELAPSED(phase);
+
+    printf("File: %s, size: %u bytes, chunk: %u bytes%s\n\n",
+        fileName, (unsigned)size, (unsigned)chunk,
+        args[ARG_MISALIGN] ? ", misaligned buffer" : "");
+    printf("Phase      MiB/s      CPU %%\n");
+
+    file = Open(fileName, MODE_NEWFILE);
+    if (file)
+    {
+        START(phase);
+        startIdle = idleCount;
+        for (pos = 0; pos < size; pos += chunk)
+        {
+            if (Write(file, buffer, chunk) != chunk)
+                failed++;
+        }
+        Close(file);
+        STOP(phase);
+        elapsed = ELAPSED(phase);
+        Report("write", size, elapsed, idleCount - startIdle, idleRate);
+    }
+
+    /* Reopen the file, so the write is complete before reading starts */
+    file = file ? Open(fileName, MODE_OLDFILE) : BNULL;
+    if (file)
+    {
+        START(phase);
+        startIdle = idleCount;
+        for (pos = 0; pos < size; pos += chunk)
+        {
+            if (Read(file, buffer, chunk) != chunk)
+                failed++;
+        }
+        STOP(phase);
+        elapsed = ELAPSED(phase);
+        Report("read", size, elapsed, idleCount - startIdle, idleRate);
+        Close(file);
+
+        if (!args[ARG_KEEP])
+            DeleteFile(fileName);
+    }
+    else
+    {
+        PrintFault(IoErr(), "LargeIO");
+        failed++;
+    }
+
+    Signal(idleTask, SIGF_STOP);
+    while (!idleDone)
+        Delay(1);
+
+    FreeVec(memory);
+    FreeArgs(rda);
+
+    if (failed)
+        printf("\n%u operations failed\n", (unsigned)failed);
+
+    return failed ? RETURN_WARN : RETURN_OK;
+}
@@ -0,0 +1,162 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Random access file benchmark. Writes a file in small sequential chunks,
+    then does random Seek()+Read() and Seek()+Write() pairs all over it,
+    and finally reads it back sequentially. Reports the rate of each phase,
+    so the cost of seeking in large files can be compared between
+    handlers (RAM: by default).
+*/
+
+#include <stdio.h>
+
+#include <exec/memory.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "benchmark.h"
+
+#define ARG_TEMPLATE "FILE/K,SIZE/N,CHUNK/N,OPS/N,KEEP/S"
+#define ARG_FILE        0
+#define ARG_SIZE        1
+#define ARG_CHUNK       2
+#define ARG_OPS         3
+#define ARG_KEEP        4
+#define NUM_ARGS        5
+
+/* NextRandom() only gives 24 bits, files may be larger than that */
+static ULONG RandomPos(ULONG *seed, ULONG range)
+{
+    ULONG r = NextRandom(seed) << 8;
+
+    return (r ^ NextRandom(seed)) % range;
+}
+
+static void Report(const char *phase, ULONG ops, UQUAD bytes, double elapsed)
+{
+    printf("%-14s %-10u %-14.0f %.2f\n", phase, (unsigned)ops,
+        RATE(ops, elapsed), MBRATE(bytes, elapsed));
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    TIMER(phase);
+    CONST_STRPTR fileName = "RAM:randomio.dat";
+    ULONG size, chunk, ops, pos, i, seed = 1, failed = 0;
+    BOOL keep = FALSE;
+    UBYTE *buffer;
+    BPTR file;
+
+    size = 16384;
+    chunk = 512;
+    ops = 100000;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (rda)
+    {
+        if (args[ARG_FILE])
+            fileName = (CONST_STRPTR)args[ARG_FILE];
+        if (args[ARG_SIZE])
+            size = *(LONG *)args[ARG_SIZE];
+        if (args[ARG_CHUNK])
+            chunk = *(LONG *)args[ARG_CHUNK];
+        if (args[ARG_OPS])
+            ops = *(LONG *)args[ARG_OPS];
+        keep = args[ARG_KEEP] ? TRUE : FALSE;
+    }
+    if (size < 1)
+        size = 1;
+    if (chunk < 1)
+        chunk = 1;
+    if (chunk > size * 1024)
+        chunk = size * 1024;
+
+    /* SIZE is in KiB */
+    size *= 1024;
+    size -= size % chunk;
+
+    buffer = AllocVec(chunk, MEMF_ANY);
+    file = Open(fileName, MODE_NEWFILE);
+    if (!buffer || !file)
+    {
+        PrintFault(IoErr(), "RandomIO");
+        if (file)
+            Close(file);
+        FreeVec(buffer);
+        if (rda)
+            FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+
+    for (i = 0; i < chunk; i++)
+        buffer[i] = NextRandom(&seed);
+
+    printf("File: %s, size: %u bytes, chunk: %u bytes, random ops: %u\n\n",
+        fileName, (unsigned)size, (unsigned)chunk, (unsigned)ops);
+    printf("Phase          ops        ops/s          MiB/s\n");
+
+    /* Create the file through many small appends */
+    START(phase);
+    for (pos = 0; pos < size; pos += chunk)
+    {
+        if (Write(file, buffer, chunk) != chunk)
+            failed++;
+    }
+    STOP(phase);
+    Report("append", size / chunk, size, ELAPSED(phase));
+
+    START(phase);
+    for (i = 0; i < ops; i++)
+    {
+        pos = RandomPos(&seed, size - chunk + 1);
+        if ((Seek(file, pos, OFFSET_BEGINNING) == -1) || (Read(file, buffer, chunk) != chunk))
+            failed++;
+    }
+    STOP(phase);
+    Report("random read", ops, (UQUAD)ops * chunk, ELAPSED(phase));
+
+    START(phase);
+    for (i = 0; i < ops; i++)
+    {
+        pos = RandomPos(&seed, size - chunk + 1);
+        if ((Seek(file, pos, OFFSET_BEGINNING) == -1) || (Write(file, buffer, chunk) != chunk))
+            failed++;
+    }
+    STOP(phase);
+    Report("random write", ops, (UQUAD)ops * chunk, ELAPSED(phase));
+
+    /* Short relative seeks back and forth, like a parser would do */
+    START(phase);
+    Seek(file, size / 2, OFFSET_BEGINNING);
+    for (i = 0; i < ops; i++)
+    {
+        if (Seek(file, (i & 1) ? chunk : -(LONG)chunk, OFFSET_CURRENT) == -1)
+            failed++;
+    }
+    STOP(phase);
+    Report("relative seek", ops, 0, ELAPSED(phase));
+
+    START(phase);
+    Seek(file, 0, OFFSET_BEGINNING);
+    for (pos = 0; pos < size; pos += chunk)
+    {
+        if (Read(file, buffer, chunk) != chunk)
+            failed++;
+    }
+    STOP(phase);
+    Report("read back", size / chunk, size, ELAPSED(phase));
+
+    Close(file);
+    if (!keep)
+        DeleteFile(fileName);
+    FreeVec(buffer);
+    if (rda)
+        FreeArgs(rda);
+
+    if (failed)
+        printf("\n%u operations failed\n", (unsigned)failed);
+
+    return failed ? RETURN_WARN : RETURN_OK;
+}
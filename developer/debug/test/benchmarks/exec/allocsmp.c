@@ -0,0 +1,184 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Measures small block AllocMem()/FreeMem() throughput as the number
+    of tasks allocating at the same time grows from 1 to the number of
+    cores (or TASKS).
+*/
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <exec/memory.h>
+#include <exec/tasks.h>
+#include <resources/processor.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/processor.h>
+#include <clib/alib_protos.h>
+
+#define ALLOCSMP_MAXTASKS       64
+#define ALLOCSMP_STACKSIZE      (AROS_STACKSIZE)
+#define ALLOCSMP_BATCH          16
+
+#define SIGF_START              SIGBREAKF_CTRL_F
+
+#define ARG_TEMPLATE "TASKS/N,SECONDS/N,VEC/S"
+#define ARG_TASKS       0
+#define ARG_SECONDS     1
+#define ARG_VEC         2
+
+struct WorkerData
+{
+    struct Task         *wd_Task;
+    ULONG               wd_Ops;
+    volatile BOOL       wd_Done;
+};
+
+static volatile BOOL stopTest;
+static BOOL useVec;
+static struct WorkerData workers[ALLOCSMP_MAXTASKS];
+
+static const ULONG blockSizes[] =
+{
+    16, 24, 40, 48, 64, 96, 100, 128, 200, 256, 384, 512, 1000, 32, 56, 72
+};
+
+static void AllocEntry(void)
+{
+    struct Task *thisTask = FindTask(NULL);
+    struct WorkerData *wd;
+    APTR blocks[ALLOCSMP_BATCH];
+    ULONG i, count = 0, offset = 0;
+
+    /* tc_UserData is only valid once we are told to start */
+    Wait(SIGF_START);
+    wd = thisTask->tc_UserData;
+
+    while (!stopTest)
+    {
+        for (i = 0; i < ALLOCSMP_BATCH; i++)
+        {
+            ULONG size = blockSizes[(i + offset) % ALLOCSMP_BATCH];
+
+            if (useVec)
+                blocks[i] = AllocVec(size, MEMF_ANY);
+            else
+                blocks[i] = AllocMem(size, MEMF_ANY);
+        }
+        for (i = 0; i < ALLOCSMP_BATCH; i++)
+        {
+            ULONG size = blockSizes[(i + offset) % ALLOCSMP_BATCH];
+
+            if (useVec)
+                FreeVec(blocks[i]);
+            else if (blocks[i])
+                FreeMem(blocks[i], size);
+        }
+        count += ALLOCSMP_BATCH;
+        offset++;
+    }
+
+    wd->wd_Ops = count;
+    wd->wd_Done = TRUE;
+}
+
+int main(void)
+{
+    IPTR args[3] = { 0, 0, 0 };
+    struct RDArgs *rda;
+    struct timeval start_tv, end_tv;
+    APTR ProcessorBase;
+    IPTR coreCount = 1;
+    struct TagItem tags [] =
+    {
+        { GCIT_NumberOfProcessors,      (IPTR)&coreCount },
+        { TAG_DONE,                     0               }
+    };
+    ULONG maxTasks, seconds, taskCount, i;
+    IPTR availBefore, availAfter;
+    double elapsed, total, single = 0.;
+
+    ProcessorBase = OpenResource(PROCESSORNAME);
+    if (ProcessorBase)
+        GetCPUInfo(tags);
+
+    maxTasks = coreCount;
+    seconds = 2;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (rda)
+    {
+        if (args[ARG_TASKS])
+            maxTasks = *(LONG *)args[ARG_TASKS];
+        if (args[ARG_SECONDS])
+            seconds = *(LONG *)args[ARG_SECONDS];
+        useVec = args[ARG_VEC] ? TRUE : FALSE;
+        FreeArgs(rda);
+    }
+    if (maxTasks < 1)
+        maxTasks = 1;
+    if (maxTasks > ALLOCSMP_MAXTASKS)
+        maxTasks = ALLOCSMP_MAXTASKS;
+    if (seconds < 1)
+        seconds = 1;
+
+    printf("CPUs: %u, max. tasks: %u, duration: %us per run, using %s\n\n",
+        (unsigned)coreCount, (unsigned)maxTasks, (unsigned)seconds,
+        useVec ? "AllocVec/FreeVec" : "AllocMem/FreeMem");
+
+    availBefore = AvailMem(MEMF_ANY);
+
+    printf("Tasks  ops/s          ops/s/task     scaling\n");
+    for (taskCount = 1; taskCount <= maxTasks; taskCount++)
+    {
+        stopTest = FALSE;
+
+        for (i = 0; i < taskCount; i++)
+        {
+            workers[i].wd_Ops = 0;
+            workers[i].wd_Done = FALSE;
+            workers[i].wd_Task = CreateTask("AllocSMP Worker", 0, AllocEntry, ALLOCSMP_STACKSIZE);
+            if (workers[i].wd_Task)
+                workers[i].wd_Task->tc_UserData = &workers[i];
+            else
+                workers[i].wd_Done = TRUE;
+        }
+
+        gettimeofday(&start_tv, NULL);
+        for (i = 0; i < taskCount; i++)
+        {
+            if (workers[i].wd_Task)
+                Signal(workers[i].wd_Task, SIGF_START);
+        }
+
+        Delay(seconds * 50);
+
+        stopTest = TRUE;
+        gettimeofday(&end_tv, NULL);
+
+        /* Wait for all of the workers to report */
+        for (i = 0; i < taskCount; i++)
+        {
+            while (!workers[i].wd_Done)
+                Delay(1);
+        }
+
+        elapsed =  ((double)(((end_tv.tv_sec * 1000000) + end_tv.tv_usec) - ((start_tv.tv_sec * 1000000) + start_tv.tv_usec)))/1000000.;
+
+        total = 0.;
+        for (i = 0; i < taskCount; i++)
+            total += (double)workers[i].wd_Ops;
+        total /= elapsed;
+        if (taskCount == 1)
+            single = total;
+
+        printf("%-6u %-14.0f %-14.0f %.2fx\n", (unsigned)taskCount, total,
+            total / taskCount, single ? total / single : 0.);
+    }
+
+    availAfter = AvailMem(MEMF_ANY);
+    printf("\nAvailMem before: %lu, after: %lu\n", (unsigned long)availBefore, (unsigned long)availAfter);
+
+    return RETURN_OK;
+}
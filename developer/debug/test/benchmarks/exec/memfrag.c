@@ -0,0 +1,162 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Memory fragmentation benchmark. Keeps a set of blocks of random size
+    allocated, and in each round replaces a random part of them. Reports
+    AllocMem()/FreeMem() pairs per second together with the number of free
+    chunks and the largest free block, so the allocation speed can be seen
+    while the free lists get more and more fragmented.
+*/
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <exec/memheaderext.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#define MEMFRAG_MAXBLOCKS       100000
+
+#define ARG_TEMPLATE "BLOCKS/N,ROUNDS/N,MINSIZE/N,MAXSIZE/N"
+#define ARG_BLOCKS      0
+#define ARG_ROUNDS      1
+#define ARG_MINSIZE     2
+#define ARG_MAXSIZE     3
+
+struct FragBlock
+{
+    APTR                fb_Memory;
+    ULONG               fb_Size;
+};
+
+static ULONG NextRandom(ULONG *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+/* Walks the free lists of all plain MemHeaders, like the memory tools do */
+static void CountChunks(IPTR *chunks, IPTR *largest, IPTR *freeBytes)
+{
+    struct MemHeader *mh;
+    struct MemChunk *mc;
+
+    *chunks = *largest = *freeBytes = 0;
+
+    Forbid();
+    ForeachNode(&SysBase->MemList, mh)
+    {
+        if (mh->mh_Attributes & MEMF_MANAGED)
+            continue;
+
+        for (mc = mh->mh_First; mc; mc = mc->mc_Next)
+        {
+            (*chunks)++;
+            if (mc->mc_Bytes > *largest)
+                *largest = mc->mc_Bytes;
+        }
+        *freeBytes += mh->mh_Free;
+    }
+    Permit();
+}
+
+int main(void)
+{
+    IPTR args[4] = { 0, 0, 0, 0 };
+    struct RDArgs *rda;
+    struct timeval start_tv, end_tv;
+    struct FragBlock *blocks;
+    ULONG blockCount, rounds, minSize, maxSize, round, i, seed = 1;
+    ULONG ops, failed = 0;
+    IPTR chunks, largest, freeBytes;
+    double elapsed;
+
+    blockCount = 10000;
+    rounds = 10;
+    minSize = 16;
+    maxSize = 4096;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (rda)
+    {
+        if (args[ARG_BLOCKS])
+            blockCount = *(LONG *)args[ARG_BLOCKS];
+        if (args[ARG_ROUNDS])
+            rounds = *(LONG *)args[ARG_ROUNDS];
+        if (args[ARG_MINSIZE])
+            minSize = *(LONG *)args[ARG_MINSIZE];
+        if (args[ARG_MAXSIZE])
+            maxSize = *(LONG *)args[ARG_MAXSIZE];
+        FreeArgs(rda);
+    }
+    if (blockCount < 1)
+        blockCount = 1;
+    if (blockCount > MEMFRAG_MAXBLOCKS)
+        blockCount = MEMFRAG_MAXBLOCKS;
+    if (minSize < 1)
+        minSize = 1;
+    if (maxSize < minSize)
+        maxSize = minSize;
+
+    blocks = AllocVec(blockCount * sizeof(struct FragBlock), MEMF_ANY | MEMF_CLEAR);
+    if (!blocks)
+        return RETURN_FAIL;
+
+    printf("Blocks: %u, rounds: %u, block size: %u..%u\n\n",
+        (unsigned)blockCount, (unsigned)rounds, (unsigned)minSize, (unsigned)maxSize);
+
+    CountChunks(&chunks, &largest, &freeBytes);
+    printf("Round  ops/s          free chunks    largest        free\n");
+    printf("-      -              %-14lu %-14lu %lu\n",
+        (unsigned long)chunks, (unsigned long)largest, (unsigned long)freeBytes);
+
+    /* Round 0 only fills the set, the others replace half of it */
+    for (round = 0; round <= rounds; round++)
+    {
+        ops = 0;
+
+        gettimeofday(&start_tv, NULL);
+        for (i = 0; i < blockCount; i++)
+        {
+            struct FragBlock *fb = &blocks[(round == 0) ? i : NextRandom(&seed) % blockCount];
+
+            if (round > 0 && (NextRandom(&seed) & 1))
+                continue;
+
+            if (fb->fb_Memory)
+                FreeMem(fb->fb_Memory, fb->fb_Size);
+
+            fb->fb_Size = minSize + NextRandom(&seed) % (maxSize - minSize + 1);
+            fb->fb_Memory = AllocMem(fb->fb_Size, MEMF_ANY);
+            if (!fb->fb_Memory)
+                failed++;
+            ops++;
+        }
+        gettimeofday(&end_tv, NULL);
+
+        elapsed =  ((double)(((end_tv.tv_sec * 1000000) + end_tv.tv_usec) - ((start_tv.tv_sec * 1000000) + start_tv.tv_usec)))/1000000.;
+
+        CountChunks(&chunks, &largest, &freeBytes);
+        printf("%-6u %-14.0f %-14lu %-14lu %lu\n", (unsigned)round,
+            elapsed > 0. ? (double)ops / elapsed : 0.,
+            (unsigned long)chunks, (unsigned long)largest, (unsigned long)freeBytes);
+    }
+
+    for (i = 0; i < blockCount; i++)
+    {
+        if (blocks[i].fb_Memory)
+            FreeMem(blocks[i].fb_Memory, blocks[i].fb_Size);
+    }
+    FreeVec(blocks);
+
+    CountChunks(&chunks, &largest, &freeBytes);
+    printf("done   -              %-14lu %-14lu %lu\n",
+        (unsigned long)chunks, (unsigned long)largest, (unsigned long)freeBytes);
+
+    if (failed)
+        printf("\n%u allocations failed\n", (unsigned)failed);
+
+    return RETURN_OK;
+}
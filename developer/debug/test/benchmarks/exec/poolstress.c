@@ -0,0 +1,231 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Pool stress test. A number of tasks keep a set of blocks allocated
+    from memory pools, and replace random blocks with new ones of random
+    size. Each task uses its own pool, or with SHARED all of them use one
+    MEMF_SEM_PROTECTED pool. Reports AllocPooled()/FreePooled() pairs per
+    second, and checks that blocks are not handed out twice.
+*/
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <exec/memory.h>
+#include <exec/tasks.h>
+#include <resources/processor.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/processor.h>
+#include <clib/alib_protos.h>
+
+#define POOLSTRESS_MAXTASKS     64
+#define POOLSTRESS_STACKSIZE    (AROS_STACKSIZE)
+#define POOLSTRESS_LIVEBLOCKS   256
+#define POOLSTRESS_PUDDLESIZE   16384
+
+#define SIGF_START              SIGBREAKF_CTRL_F
+
+#define ARG_TEMPLATE "TASKS/N,SECONDS/N,MAXSIZE/N,SHARED/S"
+#define ARG_TASKS       0
+#define ARG_SECONDS     1
+#define ARG_MAXSIZE     2
+#define ARG_SHARED      3
+
+struct StressBlock
+{
+    ULONG               *sb_Memory;
+    ULONG               sb_Size;
+};
+
+struct WorkerData
+{
+    struct Task         *wd_Task;
+    APTR                wd_Pool;
+    ULONG               wd_Seed;
+    ULONG               wd_Ops;
+    ULONG               wd_Errors;
+    volatile BOOL       wd_Done;
+};
+
+static volatile BOOL stopTest;
+static ULONG maxSize;
+static struct WorkerData workers[POOLSTRESS_MAXTASKS];
+
+static ULONG NextRandom(ULONG *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static void StressEntry(void)
+{
+    struct Task *thisTask = FindTask(NULL);
+    struct StressBlock blocks[POOLSTRESS_LIVEBLOCKS];
+    struct WorkerData *wd;
+    ULONG i, count = 0, errors = 0;
+
+    /* tc_UserData is only valid once we are told to start */
+    Wait(SIGF_START);
+    wd = thisTask->tc_UserData;
+
+    for (i = 0; i < POOLSTRESS_LIVEBLOCKS; i++)
+        blocks[i].sb_Memory = NULL;
+
+    while (!stopTest)
+    {
+        struct StressBlock *sb = &blocks[NextRandom(&wd->wd_Seed) % POOLSTRESS_LIVEBLOCKS];
+
+        if (sb->sb_Memory)
+        {
+            /* The tag must have survived - otherwise the block was handed out twice */
+            if (sb->sb_Memory[0] != (ULONG)(IPTR)sb)
+                errors++;
+            FreePooled(wd->wd_Pool, sb->sb_Memory, sb->sb_Size);
+        }
+
+        sb->sb_Size = sizeof(ULONG) + NextRandom(&wd->wd_Seed) % maxSize;
+        sb->sb_Memory = AllocPooled(wd->wd_Pool, sb->sb_Size);
+        if (sb->sb_Memory)
+            sb->sb_Memory[0] = (ULONG)(IPTR)sb;
+        count++;
+    }
+
+    for (i = 0; i < POOLSTRESS_LIVEBLOCKS; i++)
+    {
+        if (blocks[i].sb_Memory)
+            FreePooled(wd->wd_Pool, blocks[i].sb_Memory, blocks[i].sb_Size);
+    }
+
+    wd->wd_Ops = count;
+    wd->wd_Errors = errors;
+    wd->wd_Done = TRUE;
+}
+
+int main(void)
+{
+    IPTR args[4] = { 0, 0, 0, 0 };
+    struct RDArgs *rda;
+    struct timeval start_tv, end_tv;
+    APTR ProcessorBase, sharedPool = NULL;
+    IPTR coreCount = 1;
+    struct TagItem tags [] =
+    {
+        { GCIT_NumberOfProcessors,      (IPTR)&coreCount },
+        { TAG_DONE,                     0               }
+    };
+    ULONG maxTasks, seconds, taskCount, i, errors = 0;
+    BOOL shared;
+    double elapsed, total, single = 0.;
+
+    ProcessorBase = OpenResource(PROCESSORNAME);
+    if (ProcessorBase)
+        GetCPUInfo(tags);
+
+    maxTasks = coreCount;
+    seconds = 2;
+    maxSize = 256;
+    shared = FALSE;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (rda)
+    {
+        if (args[ARG_TASKS])
+            maxTasks = *(LONG *)args[ARG_TASKS];
+        if (args[ARG_SECONDS])
+            seconds = *(LONG *)args[ARG_SECONDS];
+        if (args[ARG_MAXSIZE])
+            maxSize = *(LONG *)args[ARG_MAXSIZE];
+        shared = args[ARG_SHARED] ? TRUE : FALSE;
+        FreeArgs(rda);
+    }
+    if (maxTasks < 1)
+        maxTasks = 1;
+    if (maxTasks > POOLSTRESS_MAXTASKS)
+        maxTasks = POOLSTRESS_MAXTASKS;
+    if (seconds < 1)
+        seconds = 1;
+    if (maxSize < 1)
+        maxSize = 1;
+
+    printf("CPUs: %u, max. tasks: %u, duration: %us per run, block size: %u..%u, %s pool\n\n",
+        (unsigned)coreCount, (unsigned)maxTasks, (unsigned)seconds,
+        (unsigned)sizeof(ULONG), (unsigned)(sizeof(ULONG) + maxSize - 1),
+        shared ? "one shared" : "private");
+
+    if (shared)
+    {
+        sharedPool = CreatePool(MEMF_ANY | MEMF_SEM_PROTECTED, POOLSTRESS_PUDDLESIZE, POOLSTRESS_PUDDLESIZE / 2);
+        if (!sharedPool)
+            return RETURN_FAIL;
+    }
+
+    printf("Tasks  ops/s          ops/s/task     scaling\n");
+    for (taskCount = 1; taskCount <= maxTasks; taskCount++)
+    {
+        stopTest = FALSE;
+
+        for (i = 0; i < taskCount; i++)
+        {
+            workers[i].wd_Ops = 0;
+            workers[i].wd_Errors = 0;
+            workers[i].wd_Seed = taskCount * POOLSTRESS_MAXTASKS + i;
+            workers[i].wd_Done = FALSE;
+            workers[i].wd_Task = NULL;
+            workers[i].wd_Pool = shared ? sharedPool : CreatePool(MEMF_ANY, POOLSTRESS_PUDDLESIZE, POOLSTRESS_PUDDLESIZE / 2);
+            if (workers[i].wd_Pool)
+                workers[i].wd_Task = CreateTask("PoolStress Worker", 0, StressEntry, POOLSTRESS_STACKSIZE);
+            if (workers[i].wd_Task)
+                workers[i].wd_Task->tc_UserData = &workers[i];
+            else
+                workers[i].wd_Done = TRUE;
+        }
+
+        gettimeofday(&start_tv, NULL);
+        for (i = 0; i < taskCount; i++)
+        {
+            if (workers[i].wd_Task)
+                Signal(workers[i].wd_Task, SIGF_START);
+        }
+
+        Delay(seconds * 50);
+
+        stopTest = TRUE;
+        gettimeofday(&end_tv, NULL);
+
+        /* Wait for all of the workers to report */
+        for (i = 0; i < taskCount; i++)
+        {
+            while (!workers[i].wd_Done)
+                Delay(1);
+            if (!shared && workers[i].wd_Pool)
+                DeletePool(workers[i].wd_Pool);
+        }
+
+        elapsed =  ((double)(((end_tv.tv_sec * 1000000) + end_tv.tv_usec) - ((start_tv.tv_sec * 1000000) + start_tv.tv_usec)))/1000000.;
+
+        total = 0.;
+        for (i = 0; i < taskCount; i++)
+        {
+            total += (double)workers[i].wd_Ops;
+            errors += workers[i].wd_Errors;
+        }
+        total /= elapsed;
+        if (taskCount == 1)
+            single = total;
+
+        printf("%-6u %-14.0f %-14.0f %.2fx\n", (unsigned)taskCount, total,
+            total / taskCount, single ? total / single : 0.);
+    }
+
+    if (sharedPool)
+        DeletePool(sharedPool);
+
+    if (errors)
+    {
+        printf("\n%u corrupted blocks found!\n", (unsigned)errors);
+        return RETURN_ERROR;
+    }
+
+    return RETURN_OK;
+}
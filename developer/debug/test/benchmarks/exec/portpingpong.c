@@ -0,0 +1,333 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Compares classic message ports with lock-free (PF_MPSC) ones. The
+    latency test bounces a single message between two tasks, the
+    throughput test has PRODUCERS tasks keep WINDOW messages each in
+    flight to a single port that replies to them.
+*/
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <exec/ports.h>
+#include <exec/tasks.h>
+#include <resources/processor.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/processor.h>
+#include <clib/alib_protos.h>
+
+#define PINGPONG_MAXPRODUCERS   64
+#define PINGPONG_MAXWINDOW      64
+#define PINGPONG_STACKSIZE      (AROS_STACKSIZE)
+
+#define SIGF_START              SIGBREAKF_CTRL_F
+
+#define ARG_TEMPLATE "PRODUCERS/N,WINDOW/N,SECONDS/N"
+#define ARG_PRODUCERS   0
+#define ARG_WINDOW      1
+#define ARG_SECONDS     2
+
+struct TestMsg
+{
+    struct Message      tm_Message;
+    BOOL                tm_Quit;
+};
+
+struct WorkerData
+{
+    struct Task         *wd_Task;
+    struct MsgPort      *wd_Port;               /* Port the worker sends to */
+    BOOL                wd_MPSC;
+    ULONG               wd_Ops;
+    volatile BOOL       wd_Done;
+};
+
+static struct Task *mainTask;
+static volatile BOOL stopTest;
+static ULONG window;
+static struct WorkerData workers[PINGPONG_MAXPRODUCERS];
+
+static struct MsgPort *CreateTestPort(BOOL mpsc)
+{
+    struct MsgPort *port = CreateMsgPort();
+
+    if (port && mpsc)
+        NEWMPSCPORT(port);
+
+    return port;
+}
+
+static double Elapsed(struct timeval *start_tv)
+{
+    struct timeval end_tv;
+
+    gettimeofday(&end_tv, NULL);
+    return ((double)(((end_tv.tv_sec * 1000000) + end_tv.tv_usec) - ((start_tv->tv_sec * 1000000) + start_tv->tv_usec)))/1000000.;
+}
+
+/* Replies to everything it gets, until it gets a message with tm_Quit set */
+static void PongEntry(void)
+{
+    struct Task *thisTask = FindTask(NULL);
+    struct WorkerData *wd;
+    struct TestMsg *msg;
+    BOOL quit = FALSE;
+
+    Wait(SIGF_START);
+    wd = thisTask->tc_UserData;
+
+    wd->wd_Port = CreateTestPort(wd->wd_MPSC);
+    Signal(mainTask, SIGF_START);
+
+    if (wd->wd_Port)
+    {
+        while (!quit)
+        {
+            WaitPort(wd->wd_Port);
+            while ((msg = (struct TestMsg *)GetMsg(wd->wd_Port)))
+            {
+                if (msg->tm_Quit)
+                    quit = TRUE;
+                ReplyMsg(&msg->tm_Message);
+            }
+        }
+        DeleteMsgPort(wd->wd_Port);
+    }
+    wd->wd_Done = TRUE;
+}
+
+/* Keeps window messages in flight to wd_Port, and counts the replies */
+static void ProducerEntry(void)
+{
+    struct Task *thisTask = FindTask(NULL);
+    struct WorkerData *wd;
+    struct TestMsg msgs[PINGPONG_MAXWINDOW];
+    struct TestMsg *msg;
+    struct MsgPort *replyPort;
+    ULONG i, inFlight = 0, count = 0;
+
+    Wait(SIGF_START);
+    wd = thisTask->tc_UserData;
+
+    replyPort = CreateTestPort(wd->wd_MPSC);
+    if (replyPort)
+    {
+        for (i = 0; i < window; i++)
+        {
+            msgs[i].tm_Message.mn_ReplyPort = replyPort;
+            msgs[i].tm_Message.mn_Length = sizeof(struct TestMsg);
+            msgs[i].tm_Quit = FALSE;
+            PutMsg(wd->wd_Port, &msgs[i].tm_Message);
+            inFlight++;
+        }
+
+        while (inFlight)
+        {
+            WaitPort(replyPort);
+            while ((msg = (struct TestMsg *)GetMsg(replyPort)))
+            {
+                count++;
+                if (stopTest)
+                    inFlight--;
+                else
+                    PutMsg(wd->wd_Port, &msg->tm_Message);
+            }
+        }
+        DeleteMsgPort(replyPort);
+    }
+
+    wd->wd_Ops = count;
+    wd->wd_Done = TRUE;
+}
+
+static double TestLatency(BOOL mpsc, ULONG seconds)
+{
+    struct WorkerData *wd = &workers[0];
+    struct TestMsg msg;
+    struct MsgPort *replyPort;
+    struct timeval start_tv;
+    double elapsed = 0.;
+    ULONG count = 0;
+
+    wd->wd_MPSC = mpsc;
+    wd->wd_Port = NULL;
+    wd->wd_Done = FALSE;
+
+    replyPort = CreateTestPort(mpsc);
+    if (!replyPort)
+        return 0.;
+
+    wd->wd_Task = CreateTask("PingPong Worker", 0, PongEntry, PINGPONG_STACKSIZE);
+    if (!wd->wd_Task)
+    {
+        DeleteMsgPort(replyPort);
+        return 0.;
+    }
+    wd->wd_Task->tc_UserData = wd;
+    SetSignal(0, SIGF_START);
+    Signal(wd->wd_Task, SIGF_START);
+
+    /* Wait for the worker's port */
+    Wait(SIGF_START);
+    if (wd->wd_Port)
+    {
+        msg.tm_Message.mn_ReplyPort = replyPort;
+        msg.tm_Message.mn_Length = sizeof(struct TestMsg);
+        msg.tm_Quit = FALSE;
+
+        gettimeofday(&start_tv, NULL);
+        do
+        {
+            PutMsg(wd->wd_Port, &msg.tm_Message);
+            WaitPort(replyPort);
+            GetMsg(replyPort);
+
+            /* Don't look at the clock too often */
+            if ((++count & 1023) == 0)
+                elapsed = Elapsed(&start_tv);
+        } while (elapsed < (double)seconds);
+
+        msg.tm_Quit = TRUE;
+        PutMsg(wd->wd_Port, &msg.tm_Message);
+        WaitPort(replyPort);
+        GetMsg(replyPort);
+    }
+
+    while (!wd->wd_Done)
+        Delay(1);
+    DeleteMsgPort(replyPort);
+
+    return elapsed ? (elapsed * 1000000.) / (double)count : 0.;
+}
+
+static double TestThroughput(BOOL mpsc, ULONG producers, ULONG seconds)
+{
+    struct MsgPort *port;
+    struct TestMsg *msg;
+    struct timeval start_tv;
+    double elapsed, total;
+    ULONG i;
+
+    port = CreateTestPort(mpsc);
+    if (!port)
+        return 0.;
+
+    stopTest = FALSE;
+    for (i = 0; i < producers; i++)
+    {
+        workers[i].wd_Port = port;
+        workers[i].wd_MPSC = mpsc;
+        workers[i].wd_Ops = 0;
+        workers[i].wd_Done = FALSE;
+        workers[i].wd_Task = CreateTask("PingPong Producer", 0, ProducerEntry, PINGPONG_STACKSIZE);
+        if (workers[i].wd_Task)
+            workers[i].wd_Task->tc_UserData = &workers[i];
+        else
+            workers[i].wd_Done = TRUE;
+    }
+
+    gettimeofday(&start_tv, NULL);
+    for (i = 0; i < producers; i++)
+    {
+        if (workers[i].wd_Task)
+            Signal(workers[i].wd_Task, SIGF_START);
+    }
+
+    do
+    {
+        WaitPort(port);
+        while ((msg = (struct TestMsg *)GetMsg(port)))
+            ReplyMsg(&msg->tm_Message);
+    } while ((elapsed = Elapsed(&start_tv)) < (double)seconds);
+
+    /* Keep replying until all of the producers got their messages back */
+    stopTest = TRUE;
+    for (;;)
+    {
+        while ((msg = (struct TestMsg *)GetMsg(port)))
+            ReplyMsg(&msg->tm_Message);
+
+        for (i = 0; i < producers; i++)
+        {
+            if (!workers[i].wd_Done)
+                break;
+        }
+        if (i == producers)
+            break;
+        Delay(1);
+    }
+    DeleteMsgPort(port);
+
+    total = 0.;
+    for (i = 0; i < producers; i++)
+        total += (double)workers[i].wd_Ops;
+
+    return total / elapsed;
+}
+
+int main(void)
+{
+    IPTR args[3] = { 0, 0, 0 };
+    struct RDArgs *rda;
+    APTR ProcessorBase;
+    IPTR coreCount = 1;
+    struct TagItem tags [] =
+    {
+        { GCIT_NumberOfProcessors,      (IPTR)&coreCount },
+        { TAG_DONE,                     0               }
+    };
+    ULONG producers, seconds, i;
+    double latency[2], throughput[2];
+
+    ProcessorBase = OpenResource(PROCESSORNAME);
+    if (ProcessorBase)
+        GetCPUInfo(tags);
+
+    producers = coreCount > 1 ? coreCount - 1 : 1;
+    window = 8;
+    seconds = 2;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (rda)
+    {
+        if (args[ARG_PRODUCERS])
+            producers = *(LONG *)args[ARG_PRODUCERS];
+        if (args[ARG_WINDOW])
+            window = *(LONG *)args[ARG_WINDOW];
+        if (args[ARG_SECONDS])
+            seconds = *(LONG *)args[ARG_SECONDS];
+        FreeArgs(rda);
+    }
+    if (producers < 1)
+        producers = 1;
+    if (producers > PINGPONG_MAXPRODUCERS)
+        producers = PINGPONG_MAXPRODUCERS;
+    if (window < 1)
+        window = 1;
+    if (window > PINGPONG_MAXWINDOW)
+        window = PINGPONG_MAXWINDOW;
+    if (seconds < 1)
+        seconds = 1;
+
+    /* The pong worker signals us once its port is ready */
+    mainTask = FindTask(NULL);
+
+    printf("CPUs: %u, producers: %u, window: %u, duration: %us per run\n\n",
+        (unsigned)coreCount, (unsigned)producers, (unsigned)window, (unsigned)seconds);
+
+    for (i = 0; i < 2; i++)
+    {
+        latency[i] = TestLatency(i ? TRUE : FALSE, seconds);
+        throughput[i] = TestThroughput(i ? TRUE : FALSE, producers, seconds);
+    }
+
+    printf("Port       round trip (us)   msgs/s\n");
+    printf("classic    %-17.2f %.0f\n", latency[0], throughput[0]);
+    printf("mpsc       %-17.2f %.0f\n", latency[1], throughput[1]);
+    if (throughput[0])
+        printf("\nmpsc/classic throughput: %.2f\n", throughput[1] / throughput[0]);
+
+    return RETURN_OK;
+}
@@ -0,0 +1,208 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Measures scheduler throughput on SMP systems. A number of CPU bound
+    tasks and signal ping-pong task pairs are started, and the number of
+    context switches per second is reported for each core.
+*/
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <exec/tasks.h>
+#include <resources/processor.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/kernel.h>
+#include <proto/processor.h>
+#include <clib/alib_protos.h>
+
+#define SCHEDSMP_MAXCPU         64
+#define SCHEDSMP_STACKSIZE      (AROS_STACKSIZE)
+
+#define SIGF_PING               SIGBREAKF_CTRL_D
+#define SIGF_STOP               SIGBREAKF_CTRL_E
+
+#define ARG_TEMPLATE "BUSY/N,PAIRS/N,SECONDS/N"
+#define ARG_BUSY        0
+#define ARG_PAIRS       1
+#define ARG_SECONDS     2
+
+APTR KernelBase;
+
+static volatile BOOL stopTest;
+static volatile ULONG cpuSwitches[SCHEDSMP_MAXCPU];
+static volatile ULONG cpuBusy[SCHEDSMP_MAXCPU];
+
+static void BusyEntry(void)
+{
+    while (!stopTest)
+    {
+        cpuBusy[KrnGetCPUNumber() % SCHEDSMP_MAXCPU]++;
+    }
+}
+
+/*
+ * Each pair bounces a signal between its two tasks. tc_UserData holds
+ * the partner task - the first task of a pair starts the exchange.
+ */
+static void PingEntry(void)
+{
+    struct Task *thisTask = FindTask(NULL);
+    struct Task *partner;
+
+    if (Wait(SIGF_PING | SIGF_STOP) & SIGF_STOP)
+        return;
+    partner = thisTask->tc_UserData;
+
+    for (;;)
+    {
+        Signal(partner, SIGF_PING);
+        if (Wait(SIGF_PING | SIGF_STOP) & SIGF_STOP)
+            break;
+        cpuSwitches[KrnGetCPUNumber() % SCHEDSMP_MAXCPU]++;
+    }
+    Signal(partner, SIGF_STOP);
+}
+
+static void PongEntry(void)
+{
+    struct Task *thisTask = FindTask(NULL);
+    struct Task *partner;
+
+    for (;;)
+    {
+        if (Wait(SIGF_PING | SIGF_STOP) & SIGF_STOP)
+            break;
+        partner = thisTask->tc_UserData;
+        cpuSwitches[KrnGetCPUNumber() % SCHEDSMP_MAXCPU]++;
+        Signal(partner, SIGF_PING);
+    }
+}
+
+int main(void)
+{
+    IPTR args[3] = { 0, 0, 0 };
+    struct RDArgs *rda;
+    struct Task **pingTasks, **pongTasks;
+    struct timeval start_tv, end_tv;
+    APTR ProcessorBase;
+    IPTR coreCount = 1;
+    struct TagItem tags [] =
+    {
+        { GCIT_NumberOfProcessors,      (IPTR)&coreCount },
+        { TAG_DONE,                     0               }
+    };
+    ULONG busyCount, pairCount, seconds, cpu, i, running = 0;
+    ULONG startDisp, totalSwitches = 0;
+    double elapsed;
+
+    ProcessorBase = OpenResource(PROCESSORNAME);
+    KernelBase = OpenResource("kernel.resource");
+    if (!ProcessorBase || !KernelBase)
+        return RETURN_FAIL;
+
+    GetCPUInfo(tags);
+    if (coreCount > SCHEDSMP_MAXCPU)
+        coreCount = SCHEDSMP_MAXCPU;
+
+    busyCount = coreCount;
+    pairCount = coreCount;
+    seconds = 5;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (rda)
+    {
+        if (args[ARG_BUSY])
+            busyCount = *(LONG *)args[ARG_BUSY];
+        if (args[ARG_PAIRS])
+            pairCount = *(LONG *)args[ARG_PAIRS];
+        if (args[ARG_SECONDS])
+            seconds = *(LONG *)args[ARG_SECONDS];
+        FreeArgs(rda);
+    }
+    if (seconds < 1)
+        seconds = 1;
+
+    pingTasks = AllocVec(sizeof(struct Task *) * (pairCount + 1), MEMF_CLEAR);
+    pongTasks = AllocVec(sizeof(struct Task *) * (pairCount + 1), MEMF_CLEAR);
+    if (!pingTasks || !pongTasks)
+    {
+        FreeVec(pingTasks);
+        FreeVec(pongTasks);
+        return RETURN_FAIL;
+    }
+
+    printf("CPUs: %u, busy tasks: %u, ping-pong pairs: %u, duration: %us\n",
+        (unsigned)coreCount, (unsigned)busyCount, (unsigned)pairCount, (unsigned)seconds);
+
+    for (i = 0; i < busyCount; i++)
+    {
+        if (CreateTask("SchedSMP Busy", -1, BusyEntry, SCHEDSMP_STACKSIZE))
+            running++;
+    }
+
+    Forbid();
+    for (i = 0; i < pairCount; i++)
+    {
+        pingTasks[i] = CreateTask("SchedSMP Ping", 0, PingEntry, SCHEDSMP_STACKSIZE);
+        pongTasks[i] = CreateTask("SchedSMP Pong", 0, PongEntry, SCHEDSMP_STACKSIZE);
+        if (pingTasks[i] && pongTasks[i])
+        {
+            pingTasks[i]->tc_UserData = pongTasks[i];
+            pongTasks[i]->tc_UserData = pingTasks[i];
+        }
+        if (pingTasks[i])
+            running++;
+        if (pongTasks[i])
+            running++;
+    }
+    Permit();
+
+    startDisp = SysBase->DispCount;
+    gettimeofday(&start_tv, NULL);
+
+    for (i = 0; i < pairCount; i++)
+    {
+        if (pingTasks[i] && pongTasks[i])
+            Signal(pingTasks[i], SIGF_PING);
+    }
+
+    Delay(seconds * 50);
+
+    gettimeofday(&end_tv, NULL);
+    stopTest = TRUE;
+    for (i = 0; i < pairCount; i++)
+    {
+        if (pingTasks[i])
+            Signal(pingTasks[i], SIGF_STOP);
+    }
+
+    elapsed =  ((double)(((end_tv.tv_sec * 1000000) + end_tv.tv_usec) - ((start_tv.tv_sec * 1000000) + start_tv.tv_usec)))/1000000.;
+
+    /* Wait for all of the test tasks to finish */
+    while (running)
+    {
+        Delay(5);
+        Forbid();
+        running = (FindTask("SchedSMP Ping") || FindTask("SchedSMP Pong") || FindTask("SchedSMP Busy"));
+        Permit();
+    }
+
+    printf("Elapsed time:          %f seconds\n", elapsed);
+    printf("Dispatches (DispCount): %lu\n\n", (unsigned long)(SysBase->DispCount - startDisp));
+    printf("CPU  switches/s      busy loops/s\n");
+    for (cpu = 0; cpu < coreCount; cpu++)
+    {
+        totalSwitches += cpuSwitches[cpu];
+        printf("%03u  %-14.0f %.0f\n", (unsigned)cpu,
+            (double)cpuSwitches[cpu] / elapsed,
+            (double)cpuBusy[cpu] / elapsed);
+    }
+    printf("\nTotal context switches/s: %.0f\n", (double)totalSwitches / elapsed);
+
+    FreeVec(pingTasks);
+    FreeVec(pongTasks);
+
+    return RETURN_OK;
+}
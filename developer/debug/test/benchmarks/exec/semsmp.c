@@ -0,0 +1,209 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Measures ObtainSemaphore()/ObtainSemaphoreShared() throughput on one
+    semaphore as the number of tasks using it grows from 1 to the number
+    of cores (or TASKS). WRITES sets how many of 100 obtains are exclusive,
+    PERCPU switches the semaphore to per-CPU reader counts. The contention
+    statistics of each run are printed from execlock.resource.
+*/
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <exec/semaphores.h>
+#include <exec/tasks.h>
+#include <resources/execlock.h>
+#include <resources/processor.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/execlock.h>
+#include <proto/processor.h>
+#include <clib/alib_protos.h>
+
+#define SEMSMP_MAXTASKS         64
+#define SEMSMP_STACKSIZE        (AROS_STACKSIZE)
+#define SEMSMP_HOLD             32
+
+#define SIGF_START              SIGBREAKF_CTRL_F
+
+#define ARG_TEMPLATE "TASKS/N,SECONDS/N,WRITES/N,PERCPU/S"
+#define ARG_TASKS       0
+#define ARG_SECONDS     1
+#define ARG_WRITES      2
+#define ARG_PERCPU      3
+
+struct WorkerData
+{
+    struct Task         *wd_Task;
+    ULONG               wd_Seed;
+    ULONG               wd_Ops;
+    volatile BOOL       wd_Done;
+};
+
+struct Library *ExecLockBase;
+
+static volatile BOOL stopTest;
+static ULONG writeRatio;
+static struct SignalSemaphore testSem;
+static volatile ULONG sharedData[SEMSMP_HOLD];
+static struct WorkerData workers[SEMSMP_MAXTASKS];
+
+static void SemEntry(void)
+{
+    struct Task *thisTask = FindTask(NULL);
+    struct WorkerData *wd;
+    ULONG i, sum, count = 0;
+
+    /* tc_UserData is only valid once we are told to start */
+    Wait(SIGF_START);
+    wd = thisTask->tc_UserData;
+
+    while (!stopTest)
+    {
+        wd->wd_Seed = wd->wd_Seed * 1103515245 + 12345;
+
+        /* Hold the semaphore for a short while, like the dos and layers lists are */
+        if ((wd->wd_Seed >> 8) % 100 < writeRatio)
+        {
+            ObtainSemaphore(&testSem);
+            for (i = 0; i < SEMSMP_HOLD; i++)
+                sharedData[i]++;
+        }
+        else
+        {
+            ObtainSemaphoreShared(&testSem);
+            for (i = 0, sum = 0; i < SEMSMP_HOLD; i++)
+                sum += sharedData[i];
+        }
+        ReleaseSemaphore(&testSem);
+        count++;
+    }
+
+    wd->wd_Ops = count;
+    wd->wd_Done = TRUE;
+}
+
+int main(void)
+{
+    IPTR args[4] = { 0, 0, 0, 0 };
+    struct RDArgs *rda;
+    struct timeval start_tv, end_tv;
+    struct SemaphoreStats stats;
+    APTR ProcessorBase;
+    IPTR coreCount = 1;
+    struct TagItem tags [] =
+    {
+        { GCIT_NumberOfProcessors,      (IPTR)&coreCount },
+        { TAG_DONE,                     0               }
+    };
+    ULONG maxTasks, seconds, taskCount, i, flags;
+    BOOL perCPU;
+    double elapsed, total, single = 0.;
+
+    ProcessorBase = OpenResource(PROCESSORNAME);
+    if (ProcessorBase)
+        GetCPUInfo(tags);
+
+    maxTasks = coreCount;
+    seconds = 2;
+    writeRatio = 5;
+    perCPU = FALSE;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (rda)
+    {
+        if (args[ARG_TASKS])
+            maxTasks = *(LONG *)args[ARG_TASKS];
+        if (args[ARG_SECONDS])
+            seconds = *(LONG *)args[ARG_SECONDS];
+        if (args[ARG_WRITES])
+            writeRatio = *(LONG *)args[ARG_WRITES];
+        perCPU = args[ARG_PERCPU] ? TRUE : FALSE;
+        FreeArgs(rda);
+    }
+    if (maxTasks < 1)
+        maxTasks = 1;
+    if (maxTasks > SEMSMP_MAXTASKS)
+        maxTasks = SEMSMP_MAXTASKS;
+    if (seconds < 1)
+        seconds = 1;
+    if (writeRatio > 100)
+        writeRatio = 100;
+
+    /* Only SMP builds have execlock.resource */
+    ExecLockBase = OpenResource("execlock.resource");
+
+    printf("CPUs: %u, max. tasks: %u, duration: %us per run, %u%% exclusive obtains%s\n\n",
+        (unsigned)coreCount, (unsigned)maxTasks, (unsigned)seconds, (unsigned)writeRatio,
+        perCPU ? ", per-CPU readers" : "");
+    if (!ExecLockBase)
+        printf("execlock.resource not found, no statistics available\n\n");
+
+    InitSemaphore(&testSem);
+
+    flags = SEMF_STATS | (perCPU ? SEMF_PERCPUREADERS : 0);
+
+    printf("Tasks  ops/s          scaling   contended      by spinning    sleeps\n");
+    for (taskCount = 1; taskCount <= maxTasks; taskCount++)
+    {
+        stopTest = FALSE;
+
+        /* Also resets the statistics */
+        if (ExecLockBase)
+            SetSemaphoreFlags(&testSem, flags);
+
+        for (i = 0; i < taskCount; i++)
+        {
+            workers[i].wd_Ops = 0;
+            workers[i].wd_Seed = taskCount * SEMSMP_MAXTASKS + i;
+            workers[i].wd_Done = FALSE;
+            workers[i].wd_Task = CreateTask("SemSMP Worker", 0, SemEntry, SEMSMP_STACKSIZE);
+            if (workers[i].wd_Task)
+                workers[i].wd_Task->tc_UserData = &workers[i];
+            else
+                workers[i].wd_Done = TRUE;
+        }
+
+        gettimeofday(&start_tv, NULL);
+        for (i = 0; i < taskCount; i++)
+        {
+            if (workers[i].wd_Task)
+                Signal(workers[i].wd_Task, SIGF_START);
+        }
+
+        Delay(seconds * 50);
+
+        stopTest = TRUE;
+        gettimeofday(&end_tv, NULL);
+
+        /* Wait for all of the workers to report */
+        for (i = 0; i < taskCount; i++)
+        {
+            while (!workers[i].wd_Done)
+                Delay(1);
+        }
+
+        elapsed =  ((double)(((end_tv.tv_sec * 1000000) + end_tv.tv_usec) - ((start_tv.tv_sec * 1000000) + start_tv.tv_usec)))/1000000.;
+
+        total = 0.;
+        for (i = 0; i < taskCount; i++)
+            total += (double)workers[i].wd_Ops;
+        total /= elapsed;
+        if (taskCount == 1)
+            single = total;
+
+        printf("%-6u %-14.0f %-9.2f", (unsigned)taskCount, total, single ? total / single : 0.);
+        if (ExecLockBase && GetSemaphoreStats(&testSem, &stats))
+        {
+            printf(" %-14llu %-14llu %llu", (unsigned long long)stats.sst_Contended,
+                (unsigned long long)stats.sst_SpinAcquired, (unsigned long long)stats.sst_Sleeps);
+        }
+        printf("\n");
+    }
+
+    if (ExecLockBase)
+        SetSemaphoreFlags(&testSem, 0);
+
+    return RETURN_OK;
+}
@@ -0,0 +1,203 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Has PRODUCERS tasks signal a single consumer task in bursts of BURST
+    signals, like a driver signalling its client for every packet. With
+    BATCH each burst is sent from within Forbid()/Permit(), which lets exec
+    coalesce the wakeups. Reports the number of signals, consumer wakeups
+    and task dispatches per second, and on SMP builds the wakeups of other
+    CPUs requested and coalesced by the kernel.
+*/
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <aros/kernel.h>
+#include <exec/tasks.h>
+#include <resources/processor.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/kernel.h>
+#include <proto/processor.h>
+#include <clib/alib_protos.h>
+
+#define SIGNALSTORM_MAXPRODUCERS        64
+#define SIGNALSTORM_STACKSIZE           (AROS_STACKSIZE)
+
+#define SIGF_START              SIGBREAKF_CTRL_F
+#define SIGF_DATA               SIGBREAKF_CTRL_D
+#define SIGF_STOP               SIGBREAKF_CTRL_E
+
+#define ARG_TEMPLATE "PRODUCERS/N,BURST/N,SECONDS/N,BATCH/S"
+#define ARG_PRODUCERS   0
+#define ARG_BURST       1
+#define ARG_SECONDS     2
+#define ARG_BATCH       3
+
+struct ProducerData
+{
+    struct Task         *pd_Task;
+    ULONG               pd_Signals;
+    volatile BOOL       pd_Done;
+};
+
+APTR KernelBase;
+
+static volatile BOOL stopTest;
+static ULONG burstSize;
+static BOOL batchSignals;
+static struct Task *consumerTask;
+static volatile ULONG consumerWakeups;
+static volatile BOOL consumerDone;
+static struct ProducerData producers[SIGNALSTORM_MAXPRODUCERS];
+
+static void ConsumerEntry(void)
+{
+    ULONG count = 0;
+
+    while (!(Wait(SIGF_DATA | SIGF_STOP) & SIGF_STOP))
+        count++;
+
+    consumerWakeups = count;
+    consumerDone = TRUE;
+}
+
+static void ProducerEntry(void)
+{
+    struct Task *thisTask = FindTask(NULL);
+    struct ProducerData *pd;
+    ULONG i, count = 0;
+
+    Wait(SIGF_START);
+    pd = thisTask->tc_UserData;
+
+    while (!stopTest)
+    {
+        if (batchSignals)
+            Forbid();
+        for (i = 0; i < burstSize; i++)
+            Signal(consumerTask, SIGF_DATA);
+        if (batchSignals)
+            Permit();
+        count += burstSize;
+    }
+
+    pd->pd_Signals = count;
+    pd->pd_Done = TRUE;
+}
+
+int main(void)
+{
+    IPTR args[4] = { 0, 0, 0, 0 };
+    struct RDArgs *rda;
+    struct timeval start_tv, end_tv;
+    APTR ProcessorBase;
+    IPTR coreCount = 1;
+    struct TagItem tags [] =
+    {
+        { GCIT_NumberOfProcessors,      (IPTR)&coreCount },
+        { TAG_DONE,                     0               }
+    };
+    ULONG producerCount, seconds, i, startDisp, dispatches;
+    intptr_t startWakeups, startCoalesced, wakeups, coalesced;
+    double elapsed, total;
+
+    ProcessorBase = OpenResource(PROCESSORNAME);
+    KernelBase = OpenResource("kernel.resource");
+    if (!KernelBase)
+        return RETURN_FAIL;
+    if (ProcessorBase)
+        GetCPUInfo(tags);
+
+    producerCount = coreCount > 1 ? coreCount - 1 : 1;
+    burstSize = 16;
+    seconds = 2;
+    batchSignals = FALSE;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (rda)
+    {
+        if (args[ARG_PRODUCERS])
+            producerCount = *(LONG *)args[ARG_PRODUCERS];
+        if (args[ARG_BURST])
+            burstSize = *(LONG *)args[ARG_BURST];
+        if (args[ARG_SECONDS])
+            seconds = *(LONG *)args[ARG_SECONDS];
+        batchSignals = args[ARG_BATCH] ? TRUE : FALSE;
+        FreeArgs(rda);
+    }
+    if (producerCount < 1)
+        producerCount = 1;
+    if (producerCount > SIGNALSTORM_MAXPRODUCERS)
+        producerCount = SIGNALSTORM_MAXPRODUCERS;
+    if (burstSize < 1)
+        burstSize = 1;
+    if (seconds < 1)
+        seconds = 1;
+
+    printf("CPUs: %u, producers: %u, burst: %u%s, duration: %us\n\n",
+        (unsigned)coreCount, (unsigned)producerCount, (unsigned)burstSize,
+        batchSignals ? " (batched)" : "", (unsigned)seconds);
+
+    /* The consumer runs above the producers, so every wakeup preempts them */
+    consumerTask = CreateTask("SignalStorm Consumer", 1, ConsumerEntry, SIGNALSTORM_STACKSIZE);
+    if (!consumerTask)
+        return RETURN_FAIL;
+
+    for (i = 0; i < producerCount; i++)
+    {
+        producers[i].pd_Signals = 0;
+        producers[i].pd_Done = FALSE;
+        producers[i].pd_Task = CreateTask("SignalStorm Producer", 0, ProducerEntry, SIGNALSTORM_STACKSIZE);
+        if (producers[i].pd_Task)
+            producers[i].pd_Task->tc_UserData = &producers[i];
+        else
+            producers[i].pd_Done = TRUE;
+    }
+
+    startWakeups = KrnGetSystemAttr(KATTR_Wakeups);
+    startCoalesced = KrnGetSystemAttr(KATTR_WakeupsCoalesced);
+    startDisp = SysBase->DispCount;
+    gettimeofday(&start_tv, NULL);
+    for (i = 0; i < producerCount; i++)
+    {
+        if (producers[i].pd_Task)
+            Signal(producers[i].pd_Task, SIGF_START);
+    }
+
+    Delay(seconds * 50);
+
+    stopTest = TRUE;
+    gettimeofday(&end_tv, NULL);
+    dispatches = SysBase->DispCount - startDisp;
+    wakeups = KrnGetSystemAttr(KATTR_Wakeups);
+    coalesced = KrnGetSystemAttr(KATTR_WakeupsCoalesced);
+
+    for (i = 0; i < producerCount; i++)
+    {
+        while (!producers[i].pd_Done)
+            Delay(1);
+    }
+    Signal(consumerTask, SIGF_STOP);
+    while (!consumerDone)
+        Delay(1);
+
+    elapsed =  ((double)(((end_tv.tv_sec * 1000000) + end_tv.tv_usec) - ((start_tv.tv_sec * 1000000) + start_tv.tv_usec)))/1000000.;
+
+    total = 0.;
+    for (i = 0; i < producerCount; i++)
+        total += (double)producers[i].pd_Signals;
+
+    printf("Signals/s:              %.0f\n", total / elapsed);
+    printf("Consumer wakeups/s:     %.0f\n", (double)consumerWakeups / elapsed);
+    printf("Dispatches/s:           %.0f\n", (double)dispatches / elapsed);
+
+    /* Only SMP kernels know these */
+    if ((startWakeups != -1) && (wakeups != -1))
+    {
+        printf("Remote wakeups/s:       %.0f\n", (double)(wakeups - startWakeups) / elapsed);
+        printf("  coalesced/s:          %.0f\n", (double)(coalesced - startCoalesced) / elapsed);
+    }
+
+    return RETURN_OK;
+}
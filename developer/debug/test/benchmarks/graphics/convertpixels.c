@@ -0,0 +1,233 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Benchmark for the pixel format conversions of the graphics HIDD
+*/
+/*****************************************************************************
+
+    NAME
+
+        convertpixels
+
+    SYNOPSIS
+
+        WIDTH=W/N/K,HEIGHT=H/N/K,SRCFMT=S/K,DSTFMT=D/K
+
+    LOCATION
+
+    FUNCTION
+        Measures how fast HIDD_BM_ConvertPixels() converts between the
+        true color pixel formats. Every pair of formats is measured for
+        about 0.2 seconds, unless SRCFMT or DSTFMT select some of them.
+
+    RESULT
+
+    NOTES
+        Uses the conversion routines of the driver of an 1x1 bitmap, which
+        are those of the graphics HIDD unless the driver replaces them.
+
+    BUGS
+
+    INTERNALS
+
+******************************************************************************/
+
+#define __OOP_NOATTRBASES__
+
+#include <devices/timer.h>
+#include <exec/memory.h>
+#include <hidd/gfx.h>
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/graphics.h>
+#include <proto/intuition.h>
+#include <proto/oop.h>
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/****************************************************************************************/
+
+#define ARG_TEMPLATE    "WIDTH=W/N/K,HEIGHT=H/N/K,SRCFMT=S/K,DSTFMT=D/K"
+#define ARG_W           0
+#define ARG_H           1
+#define ARG_SRCFMT      2
+#define ARG_DSTFMT      3
+#define NUM_ARGS        4
+
+#define RUNTIME         200000  /* us per pair of formats */
+
+/****************************************************************************************/
+
+static const char *pixfmt_names[NUM_RGB_STDPIXFMT] =
+{
+    "RGB24",    "BGR24",
+    "RGB16",    "RGB16_LE", "BGR16",    "BGR16_LE",
+    "RGB15",    "RGB15_LE", "BGR15",    "BGR15_LE",
+    "ARGB32",   "BGRA32",   "RGBA32",   "ABGR32",
+    "0RGB32",   "BGR032",   "RGB032",   "0BGR32"
+};
+
+static OOP_AttrBase HiddBitMapAttrBase;
+
+struct RDArgs   *myargs;
+IPTR            args[NUM_ARGS];
+UBYTE           s[256];
+LONG            width = 1280;
+LONG            height = 720;
+LONG            srcfmt = -1;
+LONG            dstfmt = -1;
+struct BitMap   *bitmap;
+APTR            srcbuf, dstbuf;
+
+/****************************************************************************************/
+
+static void cleanup(STRPTR msg, ULONG retcode)
+{
+    if (msg)
+    {
+        fprintf(stderr, "convertpixels: %s\n", msg);
+    }
+
+    if (srcbuf) FreeVec(srcbuf);
+    if (dstbuf) FreeVec(dstbuf);
+    if (bitmap) FreeBitMap(bitmap);
+    if (HiddBitMapAttrBase) OOP_ReleaseAttrBase(IID_Hidd_BitMap);
+    if (myargs) FreeArgs(myargs);
+
+    exit(retcode);
+}
+
+/****************************************************************************************/
+
+static LONG findpixfmt(STRPTR name)
+{
+    LONG i;
+
+    for (i = 0; i < NUM_RGB_STDPIXFMT; i++)
+    {
+        if (strcasecmp(name, pixfmt_names[i]) == 0)
+            return i;
+    }
+
+    fprintf(stderr, "convertpixels: Bad pixel format! Valid ones are:\n\n");
+    for (i = 0; i < NUM_RGB_STDPIXFMT; i++)
+        printf("%s\n", pixfmt_names[i]);
+
+    cleanup(NULL, RETURN_WARN);
+    return -1;
+}
+
+static void getarguments(void)
+{
+    if (!(myargs = ReadArgs(ARG_TEMPLATE, args, 0)))
+    {
+        Fault(IoErr(), 0, s, 255);
+        cleanup(s, RETURN_FAIL);
+    }
+
+    if (args[ARG_W]) width = *(LONG *)args[ARG_W];
+
+    if (args[ARG_H]) height = *(LONG *)args[ARG_H];
+
+    if (width < 1 || height < 1)
+        cleanup("Bad size!", RETURN_FAIL);
+
+    if (args[ARG_SRCFMT]) srcfmt = findpixfmt((STRPTR)args[ARG_SRCFMT]);
+
+    if (args[ARG_DSTFMT]) dstfmt = findpixfmt((STRPTR)args[ARG_DSTFMT]);
+}
+
+/****************************************************************************************/
+
+static LONG elapsed(struct timeval *start)
+{
+    struct timeval now;
+
+    CurrentTime(&now.tv_secs, &now.tv_micro);
+    return (now.tv_secs - start->tv_secs) * 1000000 + now.tv_micro - start->tv_micro;
+}
+
+static void action_convertpixels(void)
+{
+    OOP_Object *bm, *gfxhidd = NULL;
+    struct timeval tv_start;
+    ULONG mod = width * 4;
+    LONG src, dst, t, i;
+
+    bitmap = AllocBitMap(1, 1, 16, 0, NULL);
+    if (!bitmap)
+        cleanup("Can't allocate bitmap!", RETURN_FAIL);
+
+    bm = HIDD_BM_OBJ(bitmap);
+    OOP_GetAttr(bm, aHidd_BitMap_GfxHidd, (IPTR *)&gfxhidd);
+    if (!gfxhidd)
+        cleanup("Can't obtain graphics driver!", RETURN_FAIL);
+
+    /* Room for the largest pixels, filled with something that isn't all zeroes */
+    srcbuf = AllocVec(mod * height, MEMF_ANY);
+    dstbuf = AllocVec(mod * height, MEMF_ANY);
+    if (!srcbuf || !dstbuf)
+        cleanup("Out of memory!", RETURN_FAIL);
+
+    for (i = 0; i < width * height; i++)
+        ((ULONG *)srcbuf)[i] = i * 0x9E3779B1;
+
+    printf("Width: %d   Height: %d\n\n", (int)width, (int)height);
+    printf("%-10s %-10s %12s %12s\n", "Source", "Dest", "Mpixels/sec", "MB/sec read");
+
+    for (src = 0; src < NUM_RGB_STDPIXFMT; src++)
+    {
+        if (srcfmt != -1 && src != srcfmt)
+            continue;
+
+        for (dst = 0; dst < NUM_RGB_STDPIXFMT; dst++)
+        {
+            HIDDT_PixelFormat *srcpf, *dstpf;
+            double pixels;
+
+            if (dst == src || (dstfmt != -1 && dst != dstfmt))
+                continue;
+
+            srcpf = (HIDDT_PixelFormat *)HIDD_Gfx_GetPixFmt(gfxhidd, FIRST_RGB_STDPIXFMT + src);
+            dstpf = (HIDDT_PixelFormat *)HIDD_Gfx_GetPixFmt(gfxhidd, FIRST_RGB_STDPIXFMT + dst);
+            if (!srcpf || !dstpf)
+                continue;
+
+            CurrentTime(&tv_start.tv_secs, &tv_start.tv_micro);
+
+            for (i = 0; (t = elapsed(&tv_start)) < RUNTIME; i++)
+            {
+                APTR srcpix = srcbuf, dstpix = dstbuf;
+
+                HIDD_BM_ConvertPixels(bm, &srcpix, srcpf, mod, &dstpix, dstpf, mod,
+                                      width, height, NULL);
+            }
+
+            pixels = (double)width * height * i * 1000000.0 / t;
+            printf("%-10s %-10s %12.1f %12.1f\n", pixfmt_names[src], pixfmt_names[dst],
+                pixels / 1000000.0, pixels * srcpf->bytes_per_pixel / 1048576.0);
+        }
+    }
+}
+
+/****************************************************************************************/
+
+int main(void)
+{
+    getarguments();
+
+    HiddBitMapAttrBase = OOP_ObtainAttrBase(IID_Hidd_BitMap);
+    if (!HiddBitMapAttrBase)
+        cleanup("Can't obtain bitmap attribute base!", RETURN_FAIL);
+
+    action_convertpixels();
+
+    cleanup(NULL, 0);
+
+    return 0;
+}
+
+/****************************************************************************************/
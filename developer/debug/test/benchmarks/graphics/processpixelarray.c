@@ -0,0 +1,213 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Benchmark for cybergraphics.library/ProcessPixelArray
+*/
+/*****************************************************************************
+
+    NAME
+
+        processpixelarray
+
+    SYNOPSIS
+
+        WIDTH=W/N/K,HEIGHT=H/N/K,OPERATION=O/K,VALUE=V/N/K
+
+    LOCATION
+
+    FUNCTION
+        Measures how fast ProcessPixelArray() processes a 32 bit offscreen
+        bitmap. Every implemented operation is measured for about 0.5
+        seconds, unless OPERATION selects one of them. VALUE is passed to
+        the operations, it defaults to 32 (4 for the blur radius).
+
+    RESULT
+
+    NOTES
+        The operations which are not implemented yet are left out.
+
+    BUGS
+
+    INTERNALS
+
+******************************************************************************/
+
+#include <cybergraphx/cybergraphics.h>
+#include <devices/timer.h>
+#include <graphics/rastport.h>
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/graphics.h>
+#include <proto/intuition.h>
+#include <proto/cybergraphics.h>
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/****************************************************************************************/
+
+#define ARG_TEMPLATE    "WIDTH=W/N/K,HEIGHT=H/N/K,OPERATION=O/K,VALUE=V/N/K"
+#define ARG_W           0
+#define ARG_H           1
+#define ARG_OPERATION   2
+#define ARG_VALUE       3
+#define NUM_ARGS        4
+
+#define RUNTIME         500000  /* us per operation */
+
+/****************************************************************************************/
+
+#define P(x, v) {#x, x, v}
+
+static const struct
+{
+    STRPTR name;
+    LONG id;
+    LONG value;
+}
+operation_table[] =
+{
+    P(POP_BRIGHTEN,     32),
+    P(POP_DARKEN,       32),
+    P(POP_BLUR,         4),
+    {0, 0, 0}
+};
+
+struct RDArgs   *myargs;
+IPTR            args[NUM_ARGS];
+UBYTE           s[256];
+LONG            width = 1280;
+LONG            height = 720;
+LONG            operation = -1;
+LONG            value;
+BOOL            havevalue;
+struct BitMap   *bitmap;
+
+/****************************************************************************************/
+
+static void cleanup(STRPTR msg, ULONG retcode)
+{
+    if (msg)
+    {
+        fprintf(stderr, "processpixelarray: %s\n", msg);
+    }
+
+    if (bitmap) FreeBitMap(bitmap);
+    if (myargs) FreeArgs(myargs);
+
+    exit(retcode);
+}
+
+/****************************************************************************************/
+
+static LONG findoperation(STRPTR name)
+{
+    LONG i;
+
+    for (i = 0; operation_table[i].name; i++)
+    {
+        if (strcasecmp(name, operation_table[i].name) == 0 ||
+            strcasecmp(name, operation_table[i].name + 4) == 0)
+        {
+            return i;
+        }
+    }
+
+    fprintf(stderr, "processpixelarray: Bad operation! Valid ones are:\n\n");
+    for (i = 0; operation_table[i].name; i++)
+        printf("%s\n", operation_table[i].name + 4);
+
+    cleanup(NULL, RETURN_WARN);
+    return -1;
+}
+
+static void getarguments(void)
+{
+    if (!(myargs = ReadArgs(ARG_TEMPLATE, args, 0)))
+    {
+        Fault(IoErr(), 0, s, 255);
+        cleanup(s, RETURN_FAIL);
+    }
+
+    if (args[ARG_W]) width = *(LONG *)args[ARG_W];
+
+    if (args[ARG_H]) height = *(LONG *)args[ARG_H];
+
+    if (width < 1 || height < 1)
+        cleanup("Bad size!", RETURN_FAIL);
+
+    if (args[ARG_OPERATION]) operation = findoperation((STRPTR)args[ARG_OPERATION]);
+
+    if (args[ARG_VALUE])
+    {
+        value = *(LONG *)args[ARG_VALUE];
+        havevalue = TRUE;
+    }
+}
+
+/****************************************************************************************/
+
+static LONG elapsed(struct timeval *start)
+{
+    struct timeval now;
+
+    CurrentTime(&now.tv_secs, &now.tv_micro);
+    return (now.tv_secs - start->tv_secs) * 1000000 + now.tv_micro - start->tv_micro;
+}
+
+static void action_processpixelarray(void)
+{
+    struct RastPort rp;
+    struct timeval tv_start;
+    LONG op, t, i;
+
+    bitmap = AllocBitMap(width, height, 32, BMF_MINPLANES | BMF_SPECIALFMT | SHIFT_PIXFMT(PIXFMT_ARGB32), NULL);
+    if (!bitmap)
+        cleanup("Can't allocate bitmap!", RETURN_FAIL);
+
+    InitRastPort(&rp);
+    rp.BitMap = bitmap;
+
+    /* Something that isn't a single color, so the blur has work to do */
+    for (i = 0; i < height; i++)
+        FillPixelArray(&rp, 0, i, width, 1, (i * 0x9E3779B1) | 0xFF000000);
+
+    printf("Width: %d   Height: %d\n\n", (int)width, (int)height);
+    printf("%-16s %12s %12s\n", "Operation", "Value", "Mpixels/sec");
+
+    for (op = 0; operation_table[op].name; op++)
+    {
+        LONG opvalue = havevalue ? value : operation_table[op].value;
+        double pixels;
+
+        if (operation != -1 && op != operation)
+            continue;
+
+        CurrentTime(&tv_start.tv_secs, &tv_start.tv_micro);
+
+        for (i = 0; (t = elapsed(&tv_start)) < RUNTIME; i++)
+        {
+            ProcessPixelArray(&rp, 0, 0, width, height, operation_table[op].id, opvalue, NULL);
+        }
+
+        pixels = (double)width * height * i * 1000000.0 / t;
+        printf("%-16s %12d %12.1f\n", operation_table[op].name, (int)opvalue, pixels / 1000000.0);
+    }
+}
+
+/****************************************************************************************/
+
+int main(void)
+{
+    getarguments();
+
+    action_processpixelarray();
+
+    cleanup(NULL, 0);
+
+    return 0;
+}
+
+/****************************************************************************************/
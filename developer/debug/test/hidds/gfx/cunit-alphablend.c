@@ -0,0 +1,337 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Compares the alpha blending methods of the graphics HIDD with
+          a plain implementation, for every 16 and 32 bit pixel format.
+*/
+
+#define __OOP_NOATTRBASES__
+
+#include <exec/memory.h>
+#include <hidd/gfx.h>
+#include <proto/exec.h>
+#include <proto/graphics.h>
+#include <proto/oop.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <CUnit/Basic.h>
+#include <CUnit/Automated.h>
+
+#define RUNS            50
+#define MAXWIDTH        200
+#define MAXHEIGHT       8
+#define BMWIDTH         (MAXWIDTH + 32)
+#define BMHEIGHT        (MAXHEIGHT + 4)
+#define BUFMOD          (BMWIDTH * 4)
+#define BUFSIZE         (BUFMOD * BMHEIGHT)
+#define SRCMOD          (MAXWIDTH * 4 + 12)
+
+static OOP_AttrBase HiddBitMapAttrBase;
+static OOP_AttrBase HiddGCAttrBase;
+
+static struct BitMap *bitmap;
+static OOP_Object *gfxhidd, *gc;
+static UBYTE *init, *result, *expected, *src;
+static ULONG seed = 1;
+
+/* The suite initialization function.
+  * Returns zero on success, non-zero otherwise.
+ */
+int init_suite(void)
+{
+    HiddBitMapAttrBase = OOP_ObtainAttrBase(IID_Hidd_BitMap);
+    HiddGCAttrBase = OOP_ObtainAttrBase(IID_Hidd_GC);
+    if (!HiddBitMapAttrBase || !HiddGCAttrBase)
+        return -1;
+
+    bitmap = AllocBitMap(1, 1, 16, 0, NULL);
+    if (!bitmap)
+        return -1;
+
+    OOP_GetAttr(HIDD_BM_OBJ(bitmap), aHidd_BitMap_GfxHidd, (IPTR *)&gfxhidd);
+    if (!gfxhidd)
+        return -1;
+
+    gc = HIDD_Gfx_CreateObject(gfxhidd, OOP_FindClass(CLID_Hidd_GC), NULL);
+    init = AllocVec(BUFSIZE, MEMF_ANY);
+    result = AllocVec(BUFSIZE, MEMF_ANY);
+    expected = AllocVec(BUFSIZE, MEMF_ANY);
+    src = AllocVec(SRCMOD * MAXHEIGHT, MEMF_ANY);
+    if (!gc || !init || !result || !expected || !src)
+        return -1;
+
+    return 0;
+}
+
+/* The suite cleanup function.
+  * Returns zero on success, non-zero otherwise.
+ */
+int clean_suite(void)
+{
+    FreeVec(src);
+    FreeVec(expected);
+    FreeVec(result);
+    FreeVec(init);
+    if (gc)
+        OOP_DisposeObject(gc);
+    if (bitmap)
+        FreeBitMap(bitmap);
+    if (HiddGCAttrBase)
+        OOP_ReleaseAttrBase(IID_Hidd_GC);
+    if (HiddBitMapAttrBase)
+        OOP_ReleaseAttrBase(IID_Hidd_BitMap);
+    return 0;
+}
+
+/****************************************************************************************/
+
+static ULONG rnd(ULONG n)
+{
+    seed = seed * 1103515245 + 12345;
+    return ((seed >> 8) ^ (seed << 5)) % n;
+}
+
+/* Random bitmap contents, and source alpha values that are mostly fully
+   transparent or opaque like in real images */
+static void randomize(void)
+{
+    ULONG i;
+
+    for (i = 0; i < BUFSIZE; i++)
+        init[i] = rnd(256);
+
+    for (i = 0; i < SRCMOD * MAXHEIGHT; i++)
+        src[i] = ((i & 3) == 0 && rnd(3)) ? (rnd(2) ? 0xFF : 0) : rnd(256);
+
+    CopyMem(init, expected, BUFSIZE);
+}
+
+static ULONG getpixel(HIDDT_PixelFormat *pf, LONG x, LONG y)
+{
+    UBYTE *p = expected + y * BUFMOD + x * pf->bytes_per_pixel;
+    UWORD pix;
+
+    if (pf->bytes_per_pixel == 4)
+        return *(ULONG *)p;
+
+    pix = *(UWORD *)p;
+    return HIDD_PF_SWAPPIXELBYTES(pf) ? (UWORD)((pix << 8) | (pix >> 8)) : pix;
+}
+
+static void putpixel(HIDDT_PixelFormat *pf, LONG x, LONG y, ULONG pixel)
+{
+    UBYTE *p = expected + y * BUFMOD + x * pf->bytes_per_pixel;
+
+    if (pf->bytes_per_pixel == 4)
+        *(ULONG *)p = pixel;
+    else if (HIDD_PF_SWAPPIXELBYTES(pf))
+        *(UWORD *)p = (pixel << 8) | ((pixel >> 8) & 0xFF);
+    else
+        *(UWORD *)p = pixel;
+}
+
+static UBYTE countbits(HIDDT_Pixel mask)
+{
+    UBYTE bits = 0;
+
+    for (; mask; mask >>= 1)
+        bits += mask & 1;
+
+    return bits;
+}
+
+/* A color component widened to 8 bits, by repeating its upper bits */
+static UBYTE getcomponent(ULONG pixel, HIDDT_Pixel mask, UBYTE shift)
+{
+    UBYTE bits = countbits(mask);
+    ULONG c = ((pixel & mask) << shift) >> (32 - bits);
+
+    return (c << (8 - bits)) | (c >> (2 * bits - 8));
+}
+
+static ULONG putcomponent(UBYTE c, HIDDT_Pixel mask, UBYTE shift)
+{
+    UBYTE bits = countbits(mask);
+
+    return (((ULONG)c >> (8 - bits)) << (32 - bits)) >> shift;
+}
+
+/* s * a + d * (1 - a), rounded to the nearest value */
+static UBYTE blend(UBYTE s, UBYTE d, UBYTE a)
+{
+    return (2 * (s * a + d * (255 - a)) + 255) / 510;
+}
+
+/* Blends a color over a pixel of the expected result. The alpha or pad
+   byte and unused bits are kept */
+static void blendpixel(HIDDT_PixelFormat *pf, LONG x, LONG y, UBYTE a, UBYTE r, UBYTE g, UBYTE b)
+{
+    ULONG pix = getpixel(pf, x, y);
+
+    if (a == 0)
+        return;
+
+    pix = (pix & ~(pf->red_mask | pf->green_mask | pf->blue_mask)) |
+          putcomponent(blend(r, getcomponent(pix, pf->red_mask, pf->red_shift), a),
+                       pf->red_mask, pf->red_shift) |
+          putcomponent(blend(g, getcomponent(pix, pf->green_mask, pf->green_shift), a),
+                       pf->green_mask, pf->green_shift) |
+          putcomponent(blend(b, getcomponent(pix, pf->blue_mask, pf->blue_shift), a),
+                       pf->blue_mask, pf->blue_shift);
+
+    putpixel(pf, x, y, pix);
+}
+
+static void check(OOP_Object *bm, CONST_STRPTR what, HIDDT_StdPixFmt stdpf)
+{
+    BOOL same;
+
+    HIDD_BM_GetImage(bm, result, BUFMOD, 0, 0, BMWIDTH, BMHEIGHT, vHidd_StdPixFmt_Native);
+    same = memcmp(result, expected, BUFSIZE) == 0;
+
+    if (!same)
+        printf("%s differs for pixel format %d\n", what, (int)stdpf);
+    CU_ASSERT(same);
+}
+
+/* Runs a test for a bitmap of each 16 and 32 bit pixel format */
+static void testformats(void (*test)(OOP_Object *bm, HIDDT_PixelFormat *pf))
+{
+    HIDDT_StdPixFmt stdpf;
+
+    for (stdpf = vHidd_StdPixFmt_RGB16; stdpf <= LAST_RGB_STDPIXFMT; stdpf++)
+    {
+        struct TagItem bmtags[] =
+        {
+            { aHidd_BitMap_Width,       BMWIDTH },
+            { aHidd_BitMap_Height,      BMHEIGHT },
+            { aHidd_BitMap_StdPixFmt,   stdpf },
+            { TAG_DONE,                 0 }
+        };
+        HIDDT_PixelFormat *pf = (HIDDT_PixelFormat *)HIDD_Gfx_GetPixFmt(gfxhidd, stdpf);
+        OOP_Object *bm = HIDD_Gfx_CreateObject(gfxhidd, OOP_FindClass(CLID_Hidd_BitMap), bmtags);
+        ULONG run;
+
+        CU_ASSERT_FATAL(pf != NULL && bm != NULL);
+
+        for (run = 0; run < RUNS; run++)
+        {
+            randomize();
+            HIDD_BM_PutImage(bm, gc, init, BUFMOD, 0, 0, BMWIDTH, BMHEIGHT, vHidd_StdPixFmt_Native);
+            test(bm, pf);
+        }
+
+        OOP_DisposeObject(bm);
+    }
+}
+
+/****************************************************************************************/
+
+static void putalphaimage(OOP_Object *bm, HIDDT_PixelFormat *pf)
+{
+    LONG x = rnd(32), y = rnd(4), w = 1 + rnd(MAXWIDTH), h = 1 + rnd(MAXHEIGHT), i, j;
+
+    for (j = 0; j < h; j++)
+    {
+        for (i = 0; i < w; i++)
+        {
+            UBYTE *s = src + j * SRCMOD + i * 4;
+
+            blendpixel(pf, x + i, y + j, s[0], s[1], s[2], s[3]);
+        }
+    }
+
+    HIDD_BM_PutAlphaImage(bm, gc, src, SRCMOD, x, y, w, h);
+    check(bm, "PutAlphaImage", pf->stdpixfmt);
+}
+
+/* JAM1 blends the foreground color over the bitmap, JAM2 over the
+   background color */
+static void putalphatemplate(OOP_Object *bm, HIDDT_PixelFormat *pf)
+{
+    LONG x = rnd(32), y = rnd(4), w = 1 + rnd(MAXWIDTH), h = 1 + rnd(MAXHEIGHT), i, j;
+    HIDDT_Pixel fgpix = rnd(0x7FFFFFFF) << 1 | rnd(2), bgpix = rnd(0x7FFFFFFF) << 1 | rnd(2);
+    BOOL jam2 = rnd(2), invert = rnd(2);
+    HIDDT_Color fg, bg;
+
+    OOP_SetAttrsTags(gc,
+                     aHidd_GC_Foreground, fgpix,
+                     aHidd_GC_Background, bgpix,
+                     aHidd_GC_DrawMode, vHidd_GC_DrawMode_Copy,
+                     aHidd_GC_ColorExpansionMode, jam2 ? vHidd_GC_ColExp_Opaque : vHidd_GC_ColExp_Transparent,
+                     TAG_DONE);
+
+    HIDD_BM_UnmapPixel(bm, fgpix, &fg);
+    HIDD_BM_UnmapPixel(bm, bgpix, &bg);
+
+    for (j = 0; j < h; j++)
+    {
+        for (i = 0; i < w; i++)
+        {
+            UBYTE a = src[j * SRCMOD + i] ^ (invert ? 0xFF : 0);
+
+            if (jam2)
+            {
+                blendpixel(pf, x + i, y + j, 0xFF,
+                           blend(fg.red >> 8, bg.red >> 8, a),
+                           blend(fg.green >> 8, bg.green >> 8, a),
+                           blend(fg.blue >> 8, bg.blue >> 8, a));
+            }
+            else
+            {
+                blendpixel(pf, x + i, y + j, a, fg.red >> 8, fg.green >> 8, fg.blue >> 8);
+            }
+        }
+    }
+
+    HIDD_BM_PutAlphaTemplate(bm, gc, src, SRCMOD, x, y, w, h, invert);
+    check(bm, jam2 ? "PutAlphaTemplate (JAM2)" : "PutAlphaTemplate (JAM1)", pf->stdpixfmt);
+}
+
+void testPUTALPHAIMAGE(void)
+{
+    testformats(putalphaimage);
+}
+
+void testPUTALPHATEMPLATE(void)
+{
+    testformats(putalphatemplate);
+}
+
+int main(void)
+{
+    CU_pSuite pSuite = NULL;
+
+    /* initialize the CUnit test registry */
+    if (CUE_SUCCESS != CU_initialize_registry())
+        return CU_get_error();
+
+    /* add a suite to the registry */
+    pSuite = CU_add_suite("AlphaBlend_Suite", init_suite, clean_suite);
+    if (NULL == pSuite) {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* add the tests to the suite */
+    if ((NULL == CU_add_test(pSuite, "test of PutAlphaImage()", testPUTALPHAIMAGE)) ||
+        (NULL == CU_add_test(pSuite, "test of PutAlphaTemplate()", testPUTALPHATEMPLATE)))
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Run all tests using the CUnit Basic & Automated interfaces */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+    CU_basic_set_mode(CU_BRM_SILENT);
+    CU_automated_package_name_set("GfxHiddUnitTests");
+    CU_set_output_filename("GfxHidd-AlphaBlend");
+    CU_automated_enable_junit_xml(CU_TRUE);
+    CU_automated_run_tests();
+    CU_cleanup_registry();
+
+    return CU_get_error();
+}
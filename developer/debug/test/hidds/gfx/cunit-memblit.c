@@ -0,0 +1,417 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Compares the memory blit methods of the graphics HIDD with
+          plain implementations, pixel by pixel.
+*/
+
+#define __OOP_NOATTRBASES__
+
+#include <exec/memory.h>
+#include <hidd/gfx.h>
+#include <proto/exec.h>
+#include <proto/graphics.h>
+#include <proto/oop.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <CUnit/Basic.h>
+#include <CUnit/Automated.h>
+
+#define RUNS            500
+#define MAXWIDTH        300
+#define MAXHEIGHT       12
+#define BUFMOD          ((MAXWIDTH + 64) * 4)
+#define BUFSIZE         (BUFMOD * (MAXHEIGHT + 16))
+#define BITSSIZE        4096
+
+static OOP_AttrBase HiddBitMapAttrBase;
+static OOP_AttrBase HiddGCAttrBase;
+
+static struct BitMap *bitmap;
+static OOP_Object *bm, *gc;
+static UBYTE *init, *result, *expected;
+static UBYTE bits[BITSSIZE], mask[BITSSIZE];
+static ULONG seed = 1;
+
+/* The suite initialization function.
+  * Returns zero on success, non-zero otherwise.
+ */
+int init_suite(void)
+{
+    OOP_Object *gfxhidd = NULL;
+
+    HiddBitMapAttrBase = OOP_ObtainAttrBase(IID_Hidd_BitMap);
+    HiddGCAttrBase = OOP_ObtainAttrBase(IID_Hidd_GC);
+    if (!HiddBitMapAttrBase || !HiddGCAttrBase)
+        return -1;
+
+    bitmap = AllocBitMap(1, 1, 16, 0, NULL);
+    if (!bitmap)
+        return -1;
+
+    bm = HIDD_BM_OBJ(bitmap);
+    OOP_GetAttr(bm, aHidd_BitMap_GfxHidd, (IPTR *)&gfxhidd);
+    if (!gfxhidd)
+        return -1;
+
+    gc = HIDD_Gfx_CreateObject(gfxhidd, OOP_FindClass(CLID_Hidd_GC), NULL);
+    init = AllocVec(BUFSIZE, MEMF_ANY);
+    result = AllocVec(BUFSIZE, MEMF_ANY);
+    expected = AllocVec(BUFSIZE, MEMF_ANY);
+    if (!gc || !init || !result || !expected)
+        return -1;
+
+    return 0;
+}
+
+/* The suite cleanup function.
+  * Returns zero on success, non-zero otherwise.
+ */
+int clean_suite(void)
+{
+    FreeVec(expected);
+    FreeVec(result);
+    FreeVec(init);
+    if (gc)
+        OOP_DisposeObject(gc);
+    if (bitmap)
+        FreeBitMap(bitmap);
+    if (HiddGCAttrBase)
+        OOP_ReleaseAttrBase(IID_Hidd_GC);
+    if (HiddBitMapAttrBase)
+        OOP_ReleaseAttrBase(IID_Hidd_BitMap);
+    return 0;
+}
+
+/****************************************************************************************/
+
+static ULONG rnd(ULONG n)
+{
+    seed = seed * 1103515245 + 12345;
+    return ((seed >> 8) ^ (seed << 5)) % n;
+}
+
+/* Random contents for the buffers, with long runs of set and clear bits like
+   in text and patterns */
+static void randomize(void)
+{
+    ULONG i;
+
+    for (i = 0; i < BUFSIZE; i++)
+        init[i] = rnd(256);
+
+    for (i = 0; i < BITSSIZE; i++)
+    {
+        bits[i] = rnd(3) ? (rnd(2) ? 0xFF : 0) : rnd(256);
+        mask[i] = rnd(3) ? (rnd(2) ? 0xFF : 0) : rnd(256);
+    }
+
+    CopyMem(init, result, BUFSIZE);
+    CopyMem(init, expected, BUFSIZE);
+}
+
+static ULONG getpixel(UBYTE *buf, ULONG bpp, LONG x, LONG y)
+{
+    UBYTE *p = buf + y * BUFMOD + x * bpp;
+
+    switch (bpp)
+    {
+    case 2:
+        return *(UWORD *)p;
+    case 3:
+#if AROS_BIG_ENDIAN
+        return (p[0] << 16) | (p[1] << 8) | p[2];
+#else
+        return p[0] | (p[1] << 8) | (p[2] << 16);
+#endif
+    default:
+        return *(ULONG *)p;
+    }
+}
+
+static void putpixel(UBYTE *buf, ULONG bpp, LONG x, LONG y, ULONG pixel)
+{
+    UBYTE *p = buf + y * BUFMOD + x * bpp;
+
+    switch (bpp)
+    {
+    case 2:
+        *(UWORD *)p = pixel;
+        break;
+    case 3:
+#if AROS_BIG_ENDIAN
+        p[0] = pixel >> 16;
+        p[1] = pixel >> 8;
+        p[2] = pixel;
+#else
+        p[0] = pixel;
+        p[1] = pixel >> 8;
+        p[2] = pixel >> 16;
+#endif
+        break;
+    default:
+        *(ULONG *)p = pixel;
+        break;
+    }
+}
+
+static BOOL getbit(UBYTE *array, ULONG pos)
+{
+    return (array[pos >> 3] & (0x80 >> (pos & 7))) != 0;
+}
+
+/* Sets up the GC like the drawing modes of graphics.library do */
+static WORD setgc(ULONG fg, ULONG bg)
+{
+    WORD type = rnd(3);
+
+    OOP_SetAttrsTags(gc,
+                     aHidd_GC_Foreground, fg,
+                     aHidd_GC_Background, bg,
+                     aHidd_GC_DrawMode, (type == 1) ? vHidd_GC_DrawMode_Invert : vHidd_GC_DrawMode_Copy,
+                     aHidd_GC_ColorExpansionMode, (type == 0) ? vHidd_GC_ColExp_Transparent : vHidd_GC_ColExp_Opaque,
+                     TAG_DONE);
+
+    return type;
+}
+
+/* Draws a pixel of a template or pattern as the methods should */
+static void drawpixel(UBYTE *buf, ULONG bpp, LONG x, LONG y, WORD type, BOOL set, ULONG fg, ULONG bg)
+{
+    switch (type)
+    {
+    case 0:     /* JAM1 */
+        if (set) putpixel(buf, bpp, x, y, fg);
+        break;
+    case 1:     /* COMPLEMENT */
+        if (set) putpixel(buf, bpp, x, y, ~getpixel(buf, bpp, x, y));
+        break;
+    default:    /* JAM2 */
+        putpixel(buf, bpp, x, y, set ? fg : bg);
+        break;
+    }
+}
+
+static void check(ULONG bpp, CONST_STRPTR what)
+{
+    BOOL same = memcmp(result, expected, BUFSIZE) == 0;
+
+    if (!same)
+        printf("%s%u differs\n", what, (unsigned)bpp * 8);
+    CU_ASSERT(same);
+}
+
+/****************************************************************************************/
+
+void testFILLMEMRECT(void)
+{
+    ULONG run, bpp;
+
+    for (run = 0; run < RUNS; run++)
+    {
+        for (bpp = 2; bpp <= 4; bpp++)
+        {
+            LONG x = rnd(32), y = rnd(4), w = 1 + rnd(MAXWIDTH), h = 1 + rnd(MAXHEIGHT), i, j;
+            ULONG fill = rnd(0x7FFFFFFF) << 1 | rnd(2);
+
+            randomize();
+            for (j = y; j < y + h; j++)
+                for (i = x; i < x + w; i++)
+                    putpixel(expected, bpp, i, j, fill);
+
+            switch (bpp)
+            {
+            case 2:
+                HIDD_BM_FillMemRect16(bm, result, x, y, x + w - 1, y + h - 1, BUFMOD, fill);
+                break;
+            case 3:
+                HIDD_BM_FillMemRect24(bm, result, x, y, x + w - 1, y + h - 1, BUFMOD, fill);
+                break;
+            default:
+                HIDD_BM_FillMemRect32(bm, result, x, y, x + w - 1, y + h - 1, BUFMOD, fill);
+                break;
+            }
+            check(bpp, "FillMemRect");
+        }
+    }
+}
+
+/* Copies within the same buffer, so the boxes may overlap */
+void testCOPYMEMBOX(void)
+{
+    ULONG run, bpp;
+
+    for (run = 0; run < RUNS; run++)
+    {
+        for (bpp = 2; bpp <= 4; bpp++)
+        {
+            LONG srcx = rnd(32), srcy = rnd(4), dstx = rnd(32), dsty = rnd(4);
+            LONG w = 1 + rnd(MAXWIDTH), h = 1 + rnd(MAXHEIGHT), i, j;
+
+            randomize();
+            for (j = 0; j < h; j++)
+                for (i = 0; i < w; i++)
+                    putpixel(expected, bpp, dstx + i, dsty + j, getpixel(init, bpp, srcx + i, srcy + j));
+
+            switch (bpp)
+            {
+            case 2:
+                HIDD_BM_CopyMemBox16(bm, result, srcx, srcy, result, dstx, dsty, w, h, BUFMOD, BUFMOD);
+                break;
+            case 3:
+                HIDD_BM_CopyMemBox24(bm, result, srcx, srcy, result, dstx, dsty, w, h, BUFMOD, BUFMOD);
+                break;
+            default:
+                HIDD_BM_CopyMemBox32(bm, result, srcx, srcy, result, dstx, dsty, w, h, BUFMOD, BUFMOD);
+                break;
+            }
+            check(bpp, "CopyMemBox");
+        }
+    }
+}
+
+void testPUTMEMTEMPLATE(void)
+{
+    ULONG run, bpp;
+
+    for (run = 0; run < RUNS; run++)
+    {
+        for (bpp = 2; bpp <= 4; bpp++)
+        {
+            LONG x = rnd(32), y = rnd(4), w = 1 + rnd(MAXWIDTH), h = 1 + rnd(MAXHEIGHT), i, j;
+            LONG srcx = rnd(64);
+            ULONG modulo = 2 * rnd(8) + (srcx + w + 15) / 16 * 2;
+            ULONG fg = rnd(0x7FFFFFFF) << 1, bg = rnd(0x7FFFFFFF) << 1;
+            BOOL invert = rnd(2);
+            WORD type;
+
+            randomize();
+            type = setgc(fg, bg);
+
+            for (j = 0; j < h; j++)
+                for (i = 0; i < w; i++)
+                    drawpixel(expected, bpp, x + i, y + j, type,
+                              getbit(bits + j * modulo, srcx + i) != invert, fg, bg);
+
+            switch (bpp)
+            {
+            case 2:
+                HIDD_BM_PutMemTemplate16(bm, gc, bits, modulo, srcx, result, BUFMOD, x, y, w, h, invert);
+                break;
+            case 3:
+                HIDD_BM_PutMemTemplate24(bm, gc, bits, modulo, srcx, result, BUFMOD, x, y, w, h, invert);
+                break;
+            default:
+                HIDD_BM_PutMemTemplate32(bm, gc, bits, modulo, srcx, result, BUFMOD, x, y, w, h, invert);
+                break;
+            }
+            check(bpp, "PutMemTemplate");
+        }
+    }
+}
+
+void testPUTMEMPATTERN(void)
+{
+    ULONG run, bpp;
+
+    for (run = 0; run < RUNS; run++)
+    {
+        for (bpp = 2; bpp <= 4; bpp++)
+        {
+            LONG x = rnd(32), y = rnd(4), w = 1 + rnd(MAXWIDTH), h = 1 + rnd(MAXHEIGHT), i, j;
+            LONG patsrcx = rnd(32), patsrcy = rnd(8), patheight = 1 + rnd(16);
+            LONG depth = rnd(4) ? 1 : 2;
+            LONG masksrcx = rnd(64);
+            ULONG maskmodulo = 2 * rnd(8) + (masksrcx + w + 15) / 16 * 2;
+            ULONG fg = rnd(0x7FFFFFFF) << 1, bg = rnd(0x7FFFFFFF) << 1;
+            UBYTE *usemask = rnd(2) ? mask : NULL;
+            BOOL invert = rnd(2);
+            WORD type;
+
+            randomize();
+            type = setgc(fg, bg);
+
+            for (j = 0; j < h; j++)
+            {
+                UBYTE *row = bits + ((j + patsrcy) % patheight) * 2;
+
+                for (i = 0; i < w; i++)
+                {
+                    ULONG bit = (patsrcx + i) & 0xF;
+
+                    if (usemask && !getbit(usemask + j * maskmodulo, masksrcx + i))
+                        continue;
+
+                    if (depth > 1)
+                    {
+                        /* Without a LUT the planes give the pixel value */
+                        ULONG pixel = getbit(row, bit) | (getbit(row + patheight * 2, bit) << 1);
+
+                        putpixel(expected, bpp, x + i, y + j, pixel);
+                    }
+                    else
+                    {
+                        drawpixel(expected, bpp, x + i, y + j, type, getbit(row, bit) != invert, fg, bg);
+                    }
+                }
+            }
+
+            switch (bpp)
+            {
+            case 2:
+                HIDD_BM_PutMemPattern16(bm, gc, bits, patsrcx, patsrcy, patheight, depth, NULL, invert,
+                                        usemask, maskmodulo, masksrcx, result, BUFMOD, x, y, w, h);
+                break;
+            case 3:
+                HIDD_BM_PutMemPattern24(bm, gc, bits, patsrcx, patsrcy, patheight, depth, NULL, invert,
+                                        usemask, maskmodulo, masksrcx, result, BUFMOD, x, y, w, h);
+                break;
+            default:
+                HIDD_BM_PutMemPattern32(bm, gc, bits, patsrcx, patsrcy, patheight, depth, NULL, invert,
+                                        usemask, maskmodulo, masksrcx, result, BUFMOD, x, y, w, h);
+                break;
+            }
+            check(bpp, "PutMemPattern");
+        }
+    }
+}
+
+int main(void)
+{
+    CU_pSuite pSuite = NULL;
+
+    /* initialize the CUnit test registry */
+    if (CUE_SUCCESS != CU_initialize_registry())
+        return CU_get_error();
+
+    /* add a suite to the registry */
+    pSuite = CU_add_suite("MemBlit_Suite", init_suite, clean_suite);
+    if (NULL == pSuite) {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* add the tests to the suite */
+    if ((NULL == CU_add_test(pSuite, "test of FillMemRect16/24/32()", testFILLMEMRECT)) ||
+        (NULL == CU_add_test(pSuite, "test of CopyMemBox16/24/32()", testCOPYMEMBOX)) ||
+        (NULL == CU_add_test(pSuite, "test of PutMemTemplate16/24/32()", testPUTMEMTEMPLATE)) ||
+        (NULL == CU_add_test(pSuite, "test of PutMemPattern16/24/32()", testPUTMEMPATTERN)))
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Run all tests using the CUnit Basic & Automated interfaces */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+    CU_basic_set_mode(CU_BRM_SILENT);
+    CU_automated_package_name_set("GfxHiddUnitTests");
+    CU_set_output_filename("GfxHidd-MemBlit");
+    CU_automated_enable_junit_xml(CU_TRUE);
+    CU_automated_run_tests();
+    CU_cleanup_registry();
+
+    return CU_get_error();
+}
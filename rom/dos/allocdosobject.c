@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2013 The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026 The AROS Development Team. All rights reserved.
 
     Desc:
 */
@@ -56,7 +56,7 @@
     switch(type)
     {
     case DOS_FILEHANDLE:
-        mem = AllocVec(sizeof(struct FileHandle), MEMF_CLEAR);
+        mem = AllocVec(sizeof(struct FileHandle) + sizeof(struct FileHandlePrivate), MEMF_CLEAR);
 
         if (mem != NULL)
         {
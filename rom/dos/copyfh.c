@@ -0,0 +1,256 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Copy the rest of a file to another one, overlapping reads and
+          writes.
+*/
+
+#include <aros/debug.h>
+#include <exec/memory.h>
+#include <dos/dosextens.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+#define COPYFH_MAXBUFFERS       16
+
+#define CP_IDLE                 0
+#define CP_READING              1
+#define CP_FULL                 2
+#define CP_WRITING              3
+
+struct CopyPiece
+{
+    struct DosPacket *cp_Packet;
+    UBYTE            *cp_Buffer;
+    LONG              cp_Length;        /* bytes read into cp_Buffer */
+    ULONG             cp_Sequence;      /* number of the read */
+    UBYTE             cp_State;
+};
+
+static LONG CopySync(BPTR from, BPTR to, UBYTE *buffer, ULONG size, struct DosLibrary *DOSBase);
+
+/*****************************************************************************
+
+    NAME */
+#include <proto/dos.h>
+
+        AROS_LH5(BOOL, CopyFH,
+
+/*  SYNOPSIS */
+        AROS_LHA(BPTR , from, D1),
+        AROS_LHA(BPTR , to, D2),
+        AROS_LHA(APTR , buffer, D3),
+        AROS_LHA(ULONG, size, D4),
+        AROS_LHA(ULONG, count, D5),
+
+/*  LOCATION */
+        struct DosLibrary *, DOSBase, 229, Dos)
+
+/*  FUNCTION
+        Copies the data from the current position of one file to its end
+        into another file. The buffer is split into count parts, and while
+        the data of one part is written, the next ones are read already, so
+        both handlers and their devices can work at the same time.
+
+    INPUTS
+        from   - file to read from
+        to     - file to write to
+        buffer - memory for the buffers, or NULL to allocate it
+        size   - size of buffer in bytes
+        count  - number of buffers to split it into, at most 16. With 1,
+                 or when either file is interactive, the file is copied
+                 with Read() and Write() alternately.
+
+    RESULT
+        DOSTRUE if the file was copied, otherwise DOSFALSE and IoErr()
+        gives the reason. It is ERROR_BREAK if the copy was stopped by
+        Ctrl-C, which remains set.
+
+    NOTES
+        Each buffer is at least 512 bytes, count is reduced if size is too
+        small for that.
+
+    EXAMPLE
+
+    BUGS
+
+    SEE ALSO
+        SendFilePkt(), GetPkt(), Read(), Write()
+
+    INTERNALS
+        Reads are sent with SendFilePkt() in the order of the file, and the
+        buffers are written in that same order as their reads complete.
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct CopyPiece pieces[COPYFH_MAXBUFFERS], *cp;
+    struct DosPacket *dp;
+    struct MsgPort *port = NULL;
+    ULONG piecesize, readseq = 0, writeseq = 0, pending = 0, i;
+    UBYTE *mem = buffer;
+    BOOL eof = FALSE, found;
+    LONG error = 0;
+
+    D(bug("[DOS] CopyFH(0x%p, 0x%p, 0x%p, %u, %u)\n", from, to, buffer, size, count));
+
+    if (from == BNULL || to == BNULL || size == 0)
+    {
+        SetIoErr(ERROR_REQUIRED_ARG_MISSING);
+        return DOSFALSE;
+    }
+
+    if (mem == NULL && (mem = AllocMem(size, MEMF_ANY)) == NULL)
+    {
+        SetIoErr(ERROR_NO_FREE_STORE);
+        return DOSFALSE;
+    }
+
+    if (count > COPYFH_MAXBUFFERS)
+        count = COPYFH_MAXBUFFERS;
+    if (count > size / 512)
+        count = size / 512;
+
+    if (count < 2 || IsInteractive(from) || IsInteractive(to))
+    {
+        error = CopySync(from, to, mem, size, DOSBase);
+        count = 0;
+    }
+    else
+    {
+        piecesize = (size / count) & ~511;
+
+        port = CreateMsgPort();
+        if (port == NULL)
+            error = ERROR_NO_FREE_STORE;
+
+        for (i = 0; i < count; i++)
+        {
+            cp = &pieces[i];
+            cp->cp_Packet = allocdospacket();
+            cp->cp_Buffer = mem + i * piecesize;
+            cp->cp_State = CP_IDLE;
+            if (cp->cp_Packet == NULL)
+                error = ERROR_NO_FREE_STORE;
+        }
+
+        if (error == 0)
+        {
+            do
+            {
+                /* Read into the idle buffers */
+                for (i = 0; i < count && !eof && error == 0; i++)
+                {
+                    cp = &pieces[i];
+                    if (cp->cp_State != CP_IDLE)
+                        continue;
+
+                    cp->cp_Packet->dp_Type = ACTION_READ;
+                    cp->cp_Packet->dp_Arg2 = (SIPTR)cp->cp_Buffer;
+                    cp->cp_Packet->dp_Arg3 = piecesize;
+                    cp->cp_Sequence = readseq++;
+                    cp->cp_State = CP_READING;
+                    SendFilePkt(from, cp->cp_Packet, port);
+                    pending++;
+                }
+
+                /* Write the buffers that have been read, in order. Those
+                 * that got nothing are skipped */
+                do
+                {
+                    found = FALSE;
+                    for (i = 0; i < count; i++)
+                    {
+                        cp = &pieces[i];
+                        if (cp->cp_State != CP_FULL || cp->cp_Sequence != writeseq)
+                            continue;
+
+                        found = TRUE;
+                        writeseq++;
+                        if (cp->cp_Length == 0 || error != 0)
+                        {
+                            cp->cp_State = CP_IDLE;
+                            continue;
+                        }
+
+                        cp->cp_Packet->dp_Type = ACTION_WRITE;
+                        cp->cp_Packet->dp_Arg2 = (SIPTR)cp->cp_Buffer;
+                        cp->cp_Packet->dp_Arg3 = cp->cp_Length;
+                        cp->cp_State = CP_WRITING;
+                        SendFilePkt(to, cp->cp_Packet, port);
+                        pending++;
+                    }
+                } while (found);
+
+                if (pending == 0)
+                    break;
+
+                /* Wait for any request to complete */
+                dp = GetPkt(port, TRUE);
+                pending--;
+                for (i = 0; pieces[i].cp_Packet != dp; i++);
+                cp = &pieces[i];
+
+                if (cp->cp_State == CP_READING)
+                {
+                    cp->cp_Length = dp->dp_Res1 > 0 ? dp->dp_Res1 : 0;
+                    cp->cp_State = CP_FULL;
+                    if (dp->dp_Res1 < 0)
+                        error = dp->dp_Res2 ? dp->dp_Res2 : ERROR_SEEK_ERROR;
+                    else if (dp->dp_Res1 == 0)
+                        eof = TRUE;
+                }
+                else
+                {
+                    if (dp->dp_Res1 != cp->cp_Length)
+                        error = dp->dp_Res2 ? dp->dp_Res2 : ERROR_DISK_FULL;
+                    cp->cp_State = CP_IDLE;
+                }
+
+                if (error == 0 && (SetSignal(0, 0) & SIGBREAKF_CTRL_C))
+                    error = ERROR_BREAK;
+            } while (TRUE);
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (pieces[i].cp_Packet)
+            freedospacket(pieces[i].cp_Packet);
+    }
+    DeleteMsgPort(port);
+    if (buffer == NULL)
+        FreeMem(mem, size);
+
+    D(bug("[DOS] CopyFH: error %d\n", error));
+
+    SetIoErr(error);
+    return error == 0 ? DOSTRUE : DOSFALSE;
+
+    AROS_LIBFUNC_EXIT
+} /* CopyFH */
+
+static LONG CopySync(BPTR from, BPTR to, UBYTE *buffer, ULONG size, struct DosLibrary *DOSBase)
+{
+    LONG len;
+
+    Flush(to);
+
+    do
+    {
+        if (SetSignal(0, 0) & SIGBREAKF_CTRL_C)
+            return ERROR_BREAK;
+
+        /* Lines typed ahead into a console may be buffered */
+        Flush(from);
+
+        if ((len = Read(from, buffer, size)) < 0)
+            return IoErr();
+        if (len > 0 && Write(to, buffer, len) != len)
+            return IoErr() ? IoErr() : ERROR_DISK_FULL;
+    } while (len > 0);
+
+    return 0;
+}
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Internal types and stuff for dos
 */
@@ -68,6 +68,10 @@ struct DAList
 #ifndef IOBUFSIZE
 #define IOBUFSIZE 4096
 #endif
+/* Buffers allocated with the default size grow up to this on sequential I/O */
+#ifndef IOBUFMAXSIZE
+#define IOBUFMAXSIZE 65536
+#endif
 
 struct vfp
 {
@@ -84,6 +88,19 @@ struct vfp
 #define FHF_NOBUF    0x00000008
 #define FHF_OWNBUF   0x00000010
 #define FHF_FLUSHING 0x00000020
+#define FHF_FIXEDBUF 0x00000040 /* buffer size was chosen with SetVBuf() */
+#define FHF_PREFETCH 0x00000080 /* BUF_PREFETCH, see struct FileHandlePrivate */
+
+/* File handles allocated by AllocDosObject() are followed by this */
+struct FileHandlePrivate
+{
+    struct MsgPort   *fhp_Port;     /* reply port of fhp_Packet           */
+    struct DosPacket *fhp_Packet;   /* ACTION_READ into fhp_Buffer        */
+    UBYTE            *fhp_Buffer;   /* second buffer, of fh_BufSize bytes */
+    BOOL              fhp_Pending;  /* fhp_Packet hasn't been waited for  */
+};
+
+#define FH_PRIVATE(fh) ((struct FileHandlePrivate *)((struct FileHandle *)(fh) + 1))
 
 #define FPUTC(f,c) \
 (((struct FileHandle *)BADDR(f))->fh_Flags&FHF_WRITE&& \
@@ -270,6 +287,11 @@ void vbuf_free(FileHandlePtr fh);
 APTR vbuf_alloc(FileHandlePtr fh, STRPTR buf, ULONG size);
 BOOL vbuf_inject(BPTR fh, CONST_STRPTR argptr, ULONG argsize);
 LONG vbuf_fetch(BPTR file, UBYTE * buffer, ULONG fetchsize, struct DosLibrary *DOSBase);
+void vbuf_grow(FileHandlePtr fh);
+BOOL vbuf_prefetch_alloc(FileHandlePtr fh, struct DosLibrary *DOSBase);
+void vbuf_prefetch_free(FileHandlePtr fh);
+LONG vbuf_prefetch_fill(FileHandlePtr fh, struct DosLibrary *DOSBase);
+void vbuf_prefetch_cancel(FileHandlePtr fh, struct DosLibrary *DOSBase);
 
 LONG FWriteChars(BPTR file, CONST UBYTE* buffer, ULONG length, struct DosLibrary *DOSBase);
 
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2013, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <aros/debug.h>
@@ -70,7 +70,11 @@
         
         return InternalFlush( fh, DOSBase );
     }
-    else if( fh->fh_Pos < fh->fh_End )
+
+    /* Read mode. Undo reading ahead asynchronously. */
+    vbuf_prefetch_cancel( fh, DOSBase );
+
+    if( fh->fh_Pos < fh->fh_End )
     {
         int offset = fh->fh_Pos - fh->fh_End;
         
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2014, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc:
 */
@@ -9,6 +9,8 @@
 
 #define FETCHERR    (-2)
 
+static BOOL vbuf_direct(struct FileHandle *fh, ULONG fetchsize);
+
 /*****************************************************************************
 
     NAME */
@@ -41,13 +43,15 @@
         IoErr() gives additional information in case of an error.
 
     NOTES
+        Once the buffer is empty, large requests are read directly into
+        block.
 
     EXAMPLE
 
     BUGS
 
     SEE ALSO
-        Open(), FWrite(), FPutc(), Close()
+        Open(), FWrite(), FPutc(), Close(), SetVBuf()
 
     INTERNALS
 
@@ -55,6 +59,7 @@
 {
     AROS_LIBFUNC_INIT
 
+    struct FileHandle *handle = (struct FileHandle *)BADDR(fh);
     UBYTE  *ptr;
     LONG    res = 0;
     ULONG   fetchsize = number * blocklen;
@@ -69,6 +74,29 @@
 
     while(fetchsize > 0)
     {
+        if (vbuf_direct(handle, fetchsize))
+        {
+            res = Read(fh, ptr, fetchsize);
+            if (res < 0)
+                res = FETCHERR;
+            if (res <= 0)
+            {
+                if (res == 0)
+                    res = EOF;
+                break;
+            }
+            ptr += res;
+            fetchsize -= res;
+
+            /* Keep the last byte in the buffer, for UnGetC() */
+            if (handle->fh_Buf != BNULL && handle->fh_Buf == handle->fh_OrigBuf)
+            {
+                *(UBYTE *)BADDR(handle->fh_Buf) = ptr[-1];
+                handle->fh_Pos = handle->fh_End = 1;
+            }
+            continue;
+        }
+
         res = vbuf_fetch(fh, ptr, fetchsize, DOSBase);
         if (res < 0)
             break;
@@ -88,6 +116,20 @@
     AROS_LIBFUNC_EXIT
 } /* FRead */
 
+/* Large reads bypass the buffer, if it's empty and nothing is being read
+ * ahead into the other one */
+static BOOL vbuf_direct(struct FileHandle *fh, ULONG fetchsize)
+{
+    ULONG bufsize = fh->fh_BufSize > IOBUFSIZE ? fh->fh_BufSize : IOBUFSIZE;
+
+    if (fh->fh_Flags & FHF_WRITE || fh->fh_Pos != fh->fh_End)
+        return FALSE;
+    if (fh->fh_Flags & FHF_PREFETCH && FH_PRIVATE(fh)->fhp_Pending)
+        return FALSE;
+
+    return fetchsize >= bufsize;
+}
+
 static LONG handle_write_mode(BPTR file, struct DosLibrary * DOSBase)
 {
     struct FileHandle *fh = (struct FileHandle *)BADDR(file);
@@ -165,13 +207,21 @@ LONG vbuf_fetch(BPTR file, UBYTE * buffer, ULONG fetchsize, struct DosLibrary *D
         }
 
         /* Fill the buffer. */
-        if (fh->fh_Buf != fh->fh_OrigBuf) {
-            D(bug("FGetC: Can't trust fh_BufSize. Using 208 as the buffer size.\n"));
-            bufsize = 208;
-        } else {
+        if (fh->fh_Flags & FHF_PREFETCH) {
             bufsize = fh->fh_BufSize;
+            size = vbuf_prefetch_fill(fh, DOSBase);
+        } else {
+            if (fh->fh_Buf != fh->fh_OrigBuf) {
+                D(bug("FGetC: Can't trust fh_BufSize. Using 208 as the buffer size.\n"));
+                bufsize = 208;
+            } else {
+                /* Use a larger buffer while the file is read sequentially */
+                if (fh->fh_End == (LONG)fh->fh_BufSize)
+                    vbuf_grow(fh);
+                bufsize = fh->fh_BufSize;
+            }
+            size = Read(file, BADDR(fh->fh_Buf), bufsize);
         }
-        size = Read(file, BADDR(fh->fh_Buf), bufsize);
 
         /* Prepare filehandle for data. */
         if(size <= 0)
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2011, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc:
 */
@@ -55,6 +55,8 @@
         case DOS_FILEHANDLE:
         {
             struct FileHandle *fh=(struct FileHandle *)ptr;
+            if (fh->fh_Flags & FHF_PREFETCH)
+                vbuf_prefetch_free(fh);
             if (fh->fh_Flags & FHF_OWNBUF)
                 FreeMem(BADDR(fh->fh_OrigBuf),fh->fh_BufSize);
             FreeVec(fh);
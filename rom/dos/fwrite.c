@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2013, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
 */
 #include "dos_intern.h"
@@ -100,6 +100,8 @@ FWriteChars(BPTR file, CONST UBYTE* buffer, ULONG length, struct DosLibrary *DOS
     /* Check if file is in write mode */
     if (!(fh->fh_Flags & FHF_WRITE))
     {
+        vbuf_prefetch_cancel(fh, DOSBase);
+
         if (fh->fh_Pos < fh->fh_End)
         {
             /* Read mode. Try to seek back to the current position. */
@@ -157,6 +159,23 @@ FWriteChars(BPTR file, CONST UBYTE* buffer, ULONG length, struct DosLibrary *DOS
                     written = -1;
                     break;
                 }
+
+                /* Use a larger buffer while the file is written sequentially */
+                if (fh->fh_Pos == 0)
+                    vbuf_grow(fh);
+                fh->fh_End = fh->fh_BufSize;
+            }
+
+            /* Write what's left of large requests directly, once the
+               buffer is empty */
+            if (fh->fh_Pos == 0 && length - written >= fh->fh_End
+                && !(fh->fh_Flags & FHF_LINEBUF))
+            {
+                if (Write(file, buffer + written, length - written) != length - written)
+                    written = -1;
+                else
+                    written = length;
+                break;
             }
 
             /* Write data */
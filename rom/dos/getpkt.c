@@ -0,0 +1,64 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Get a replied packet from a message port.
+*/
+
+#include <aros/debug.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <proto/dos.h>
+
+        AROS_LH2(struct DosPacket *, GetPkt,
+
+/*  SYNOPSIS */
+        AROS_LHA(struct MsgPort *, port, D1),
+        AROS_LHA(BOOL            , wait, D2),
+
+/*  LOCATION */
+        struct DosLibrary *, DOSBase, 228, Dos)
+
+/*  FUNCTION
+        Removes the next packet from a message port, that packets sent with
+        SendFilePkt() or SendPkt() are replied to.
+
+    INPUTS
+        port - the reply port of the packets
+        wait - wait for a packet if there is none yet
+
+    RESULT
+        The packet, or NULL if wait is FALSE and no packet has arrived.
+
+    NOTES
+        Packets are not necessarily replied in the order they were sent,
+        if they were sent to different handlers.
+
+    EXAMPLE
+
+    BUGS
+
+    SEE ALSO
+        SendFilePkt(), SendPkt(), WaitPkt()
+
+    INTERNALS
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct Message *msg;
+
+    while ((msg = GetMsg(port)) == NULL && wait)
+        WaitPort(port);
+
+    D(bug("[DOS] GetPkt(0x%p, %d): message 0x%p\n", port, wait, msg));
+
+    return msg ? (struct DosPacket *)msg->mn_Node.ln_Name : NULL;
+
+    AROS_LIBFUNC_EXIT
+} /* GetPkt */
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2007, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Change the current read/write position in a file.
 */
@@ -75,7 +75,10 @@
     }
     else
     {
-        /* Read mode. Adjust the offset so that buffering is
+        /* Read mode. Undo reading ahead asynchronously. */
+        vbuf_prefetch_cancel( fh, DOSBase );
+
+        /* Adjust the offset so that buffering is
            taken into account. */
         if (fh->fh_Pos < fh->fh_End && mode == OFFSET_CURRENT)
             offset = (LONG)(fh->fh_Pos - fh->fh_End);
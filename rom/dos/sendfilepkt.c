@@ -0,0 +1,109 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Send a packet for a file handle asynchronously.
+*/
+
+#include <aros/debug.h>
+#include <dos/dosextens.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <proto/dos.h>
+
+        AROS_LH3(BOOL, SendFilePkt,
+
+/*  SYNOPSIS */
+        AROS_LHA(BPTR              , file, D1),
+        AROS_LHA(struct DosPacket *, dp, D2),
+        AROS_LHA(struct MsgPort   *, replyport, D3),
+
+/*  LOCATION */
+        struct DosLibrary *, DOSBase, 227, Dos)
+
+/*  FUNCTION
+        Sends a packet for an open file to its handler without waiting for
+        the result, e.g. ACTION_READ, ACTION_WRITE, ACTION_SEEK or
+        ACTION_EXAMINE_FH. The packet will be returned to 'replyport', with
+        dp_Res1 and dp_Res2 set like the synchronous function would return
+        them and IoErr().
+
+        Several packets may be outstanding for the same file, or for
+        different files, at a time. Handlers process the packets of a file
+        in the order they were sent.
+
+    INPUTS
+        file      - the file handle the packet is for
+        dp        - a packet, e.g. from AllocDosObject(DOS_STDPKT). dp_Type
+                    and dp_Arg2 to dp_Arg7 must be set, dp_Arg1 is set to
+                    the handler's identifier of the file.
+        replyport - the MsgPort to which the packet will be replied
+
+    RESULT
+        DOSTRUE if the packet was sent. It is always replied then.
+
+    NOTES
+        Any buffered data of the file is flushed first, so the packet
+        starts at the position FRead() or FWrite() would use.
+
+        The packet must not be used or freed until it has been replied,
+        see GetPkt().
+
+    EXAMPLE
+        dp->dp_Type = ACTION_READ;
+        dp->dp_Arg2 = (SIPTR)buffer;
+        dp->dp_Arg3 = length;
+        if (SendFilePkt(file, dp, port))
+        {
+            ...
+            dp = GetPkt(port, TRUE);
+            actual = dp->dp_Res1;
+        }
+
+    BUGS
+
+    SEE ALSO
+        GetPkt(), SendPkt(), CopyFH(), AllocDosObject()
+
+    INTERNALS
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct FileHandle *fh = BADDR(file);
+
+    D(bug("[DOS] SendFilePkt(0x%p, 0x%p, 0x%p) action %d\n", fh, dp, replyport, dp ? dp->dp_Type : 0));
+
+    if (fh == NULL || dp == NULL || replyport == NULL)
+    {
+        SetIoErr(ERROR_REQUIRED_ARG_MISSING);
+        return DOSFALSE;
+    }
+
+    if ((fh->fh_Flags & (FHF_WRITE | FHF_PREFETCH)) || (fh->fh_Pos < fh->fh_End))
+        Flush(file);
+
+    dp->dp_Arg1 = fh->fh_Arg1;
+
+    if (fh->fh_Type == BNULL)
+    {
+        /* NIL: has no handler, so reply right away */
+        dp->dp_Res1 = (dp->dp_Type == ACTION_READ) ? 0 :
+            handleNIL(dp->dp_Type, dp->dp_Arg1, dp->dp_Arg2, dp->dp_Arg3);
+        dp->dp_Res2 = 0;
+        dp->dp_Port = replyport;
+        dp->dp_Link->mn_ReplyPort = replyport;
+        PutMsg(replyport, dp->dp_Link);
+    }
+    else
+        internal_SendPkt(dp, fh->fh_Type, replyport);
+
+    return DOSTRUE;
+
+    AROS_LIBFUNC_EXIT
+} /* SendFilePkt */
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2011, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <aros/debug.h>
@@ -46,6 +46,16 @@
     RESULT
         0 if operation succeeded.
 
+    NOTES
+        Buffers that were not given a size with SetVBuf() start small, and
+        grow while the file is read or written sequentially.
+
+        BUF_PREFETCH is an AROS extension. It works like BUF_FULL, but when
+        reading, a second buffer of the same size is filled asynchronously
+        while the current one is used. buff must be NULL for it. Only the
+        task that called SetVBuf() may use the file handle afterwards.
+        Interactive files are just fully buffered.
+
 *****************************************************************************/
 {
     AROS_LIBFUNC_INIT
@@ -64,6 +74,13 @@
     if (buff != BADDR(MKBADDR(buff)))
         return EOF;
 
+    /* Undo reading ahead, the buffer may change */
+    if (fh->fh_Flags & FHF_PREFETCH)
+    {
+        vbuf_prefetch_cancel(fh, DOSBase);
+        vbuf_prefetch_free(fh);
+    }
+
     switch (type)
     {
         case BUF_LINE:
@@ -77,6 +94,13 @@
         case BUF_NONE:
             fh->fh_Flags = (fh->fh_Flags | FHF_NOBUF) & ~FHF_LINEBUF;
             break;
+
+        case BUF_PREFETCH:
+            /* Both buffers must be our own */
+            if (buff != NULL || !ISFILEHANDLE(file))
+                return EOF;
+            fh->fh_Flags = fh->fh_Flags & ~(FHF_NOBUF | FHF_LINEBUF);
+            break;
         
         default:
             return EOF;
@@ -91,8 +115,12 @@
         }
         if (!vbuf_alloc(fh, buff, size))
             return EOF;
+        fh->fh_Flags |= FHF_FIXEDBUF;
     }
 
+    if (type == BUF_PREFETCH && !vbuf_prefetch_alloc(fh, DOSBase))
+        return EOF;
+
     return 0;
     
     AROS_LIBFUNC_EXIT
@@ -102,6 +130,9 @@
 void
 vbuf_free(FileHandlePtr fh)
 {
+    if (fh->fh_Flags & FHF_PREFETCH)
+        vbuf_prefetch_free(fh);
+
     if (fh->fh_Flags & FHF_BUF)
     {
         /* free buffer allocated by system */
@@ -114,7 +145,7 @@ vbuf_free(FileHandlePtr fh)
         fh->fh_OrigBuf = BNULL;
     }
 
-    fh->fh_Flags &= ~(FHF_BUF | FHF_OWNBUF);
+    fh->fh_Flags &= ~(FHF_BUF | FHF_OWNBUF | FHF_FIXEDBUF);
 }
 
 APTR vbuf_alloc(FileHandlePtr fh, STRPTR buf, ULONG size)
@@ -202,3 +233,148 @@ BOOL vbuf_inject(BPTR fh, CONST_STRPTR argptr, ULONG size)
 
     return TRUE;
 }
+
+/* Doubles the size of a buffer that has been used up completely. Only
+ * buffers allocated here, with a size nobody asked for, grow, and not on
+ * interactive files */
+void vbuf_grow(FileHandlePtr fh)
+{
+    ULONG size = fh->fh_BufSize * 2;
+    UBYTE *buf;
+
+    if ((fh->fh_Flags & (FHF_OWNBUF | FHF_FIXEDBUF | FHF_LINEBUF | FHF_PREFETCH)) != FHF_OWNBUF
+        || fh->fh_Buf != fh->fh_OrigBuf || fh->fh_Interactive || size > IOBUFMAXSIZE)
+        return;
+
+    buf = AllocMem(size, MEMF_ANY);
+    if (buf)
+    {
+        D(bug("[vbuf_grow] Handle 0x%p, buffer grows to %u bytes\n", fh, size));
+
+        FreeMem(BADDR(fh->fh_OrigBuf), fh->fh_BufSize);
+        fh->fh_Buf     = MKBADDR(buf);
+        fh->fh_OrigBuf = fh->fh_Buf;
+        fh->fh_BufSize = size;
+    }
+}
+
+BOOL vbuf_prefetch_alloc(FileHandlePtr fh, struct DosLibrary *DOSBase)
+{
+    struct FileHandlePrivate *fhp = FH_PRIVATE(fh);
+
+    /* Interactive files and NIL: are just fully buffered */
+    if (fh->fh_Interactive || fh->fh_Type == BNULL)
+        return TRUE;
+
+    if (fh->fh_Buf == BNULL && !vbuf_alloc(fh, NULL, IOBUFSIZE))
+        return FALSE;
+    if (!(fh->fh_Flags & FHF_OWNBUF) || fh->fh_Buf != fh->fh_OrigBuf)
+        return FALSE;
+
+    fhp->fhp_Port    = CreateMsgPort();
+    fhp->fhp_Packet  = allocdospacket();
+    fhp->fhp_Buffer  = AllocMem(fh->fh_BufSize, MEMF_ANY);
+    fhp->fhp_Pending = FALSE;
+    if (!fhp->fhp_Port || !fhp->fhp_Packet || !fhp->fhp_Buffer)
+    {
+        vbuf_prefetch_free(fh);
+        return FALSE;
+    }
+
+    fh->fh_Flags |= FHF_PREFETCH;
+
+    return TRUE;
+}
+
+void vbuf_prefetch_free(FileHandlePtr fh)
+{
+    struct FileHandlePrivate *fhp = FH_PRIVATE(fh);
+
+    if (fhp->fhp_Pending)
+    {
+        WaitPort(fhp->fhp_Port);
+        GetMsg(fhp->fhp_Port);
+        fhp->fhp_Pending = FALSE;
+    }
+
+    if (fhp->fhp_Buffer)
+        FreeMem(fhp->fhp_Buffer, fh->fh_BufSize);
+    if (fhp->fhp_Packet)
+        freedospacket(fhp->fhp_Packet);
+    if (fhp->fhp_Port)
+        DeleteMsgPort(fhp->fhp_Port);
+
+    fhp->fhp_Buffer = NULL;
+    fhp->fhp_Packet = NULL;
+    fhp->fhp_Port   = NULL;
+
+    fh->fh_Flags &= ~FHF_PREFETCH;
+}
+
+static LONG vbuf_prefetch_wait(FileHandlePtr fh, struct DosLibrary *DOSBase)
+{
+    struct FileHandlePrivate *fhp = FH_PRIVATE(fh);
+
+    WaitPort(fhp->fhp_Port);
+    GetMsg(fhp->fhp_Port);
+    fhp->fhp_Pending = FALSE;
+
+    SetIoErr(fhp->fhp_Packet->dp_Res2);
+
+    return fhp->fhp_Packet->dp_Res1;
+}
+
+/* Fills the buffer of a BUF_PREFETCH file handle, and starts reading the
+ * next one. Returns what Read() would */
+LONG vbuf_prefetch_fill(FileHandlePtr fh, struct DosLibrary *DOSBase)
+{
+    struct FileHandlePrivate *fhp = FH_PRIVATE(fh);
+    struct DosPacket *dp = fhp->fhp_Packet;
+    UBYTE *buf;
+    LONG size;
+
+    /* Take the buffer that was read ahead, or read one now */
+    if (fhp->fhp_Pending)
+    {
+        size = vbuf_prefetch_wait(fh, DOSBase);
+
+        buf = fhp->fhp_Buffer;
+        fhp->fhp_Buffer = BADDR(fh->fh_Buf);
+        fh->fh_Buf     = MKBADDR(buf);
+        fh->fh_OrigBuf = fh->fh_Buf;
+    }
+    else
+        size = Read(MKBADDR(fh), BADDR(fh->fh_Buf), fh->fh_BufSize);
+
+    /* Unless the end of the file was reached, read the next buffer while
+     * this one is used */
+    if (size == (LONG)fh->fh_BufSize)
+    {
+        D(bug("[vbuf_prefetch_fill] Handle 0x%p, reading %u bytes ahead\n", fh, fh->fh_BufSize));
+
+        dp->dp_Type = ACTION_READ;
+        dp->dp_Arg1 = fh->fh_Arg1;
+        dp->dp_Arg2 = (SIPTR)fhp->fhp_Buffer;
+        dp->dp_Arg3 = fh->fh_BufSize;
+        dp->dp_Res1 = 0;
+        dp->dp_Res2 = 0;
+        internal_SendPkt(dp, fh->fh_Type, fhp->fhp_Port);
+        fhp->fhp_Pending = TRUE;
+    }
+
+    return size;
+}
+
+/* Waits for the buffer being read ahead, and moves the file position back
+ * to where it was before, right after the current buffer */
+void vbuf_prefetch_cancel(FileHandlePtr fh, struct DosLibrary *DOSBase)
+{
+    LONG size;
+
+    if ((fh->fh_Flags & FHF_PREFETCH) && FH_PRIVATE(fh)->fhp_Pending)
+    {
+        size = vbuf_prefetch_wait(fh, DOSBase);
+        if (size > 0)
+            InternalSeek(fh, -size, OFFSET_CURRENT, DOSBase);
+    }
+}
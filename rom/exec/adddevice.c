@@ -66,7 +66,9 @@
     Enqueue(&SysBase->DeviceList,&device->dd_Library.lib_Node);
 
     /* All done. */
-    EXEC_UNLOCK_LIST_AND_PERMIT(&SysBase->DeviceList);
+    EXEC_UNLOCK_LIST(&SysBase->DeviceList);
+    NameHashAdd(&SysBase->DeviceList, &device->dd_Library.lib_Node, SysBase);
+    Permit();
 
     AROS_LIBFUNC_EXIT
 } /* AddDevice */
@@ -69,7 +69,9 @@
     /* And add the library */
     Enqueue(&SysBase->LibList,&library->lib_Node);
     /* We're done with midifying the LibList */
-    EXEC_UNLOCK_LIST_AND_PERMIT(&SysBase->LibList);
+    EXEC_UNLOCK_LIST(&SysBase->LibList);
+    NameHashAdd(&SysBase->LibList, &library->lib_Node, SysBase);
+    Permit();
     /*
      * When debug.library is added, open it and cache its base instantly.
      * We do it because symbol lookup routines can be called in a system crash
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Add a port to the public list of ports.
 */
@@ -58,7 +58,10 @@
 #if defined(__AROSEXEC_SMP__)
     EXEC_SPINLOCK_INIT(&port->mp_SpinLock);
 #endif
-    NEWLIST(&port->mp_MsgList);
+    if (port->mp_Flags & PF_MPSC)
+        NEWMPSCPORT(port);
+    else
+        NEWLIST(&port->mp_MsgList);
 #if defined(__AROSEXEC_SMP__)
     EXEC_SPINLOCK_LOCK(&PrivExecBase(SysBase)->PortListSpinLock, NULL, SPINLOCK_MODE_WRITE);
 #endif
@@ -67,6 +70,7 @@
 #if defined(__AROSEXEC_SMP__)
     EXEC_SPINLOCK_UNLOCK(&PrivExecBase(SysBase)->PortListSpinLock);
 #endif
+    NameHashAdd(&SysBase->PortList, &port->mp_Node, SysBase);
 
     /* All done */
     Permit();
@@ -66,7 +66,9 @@
     Enqueue(&SysBase->ResourceList,(struct Node *)resource);
 
     /* All done. */
-    EXEC_UNLOCK_LIST_AND_PERMIT(&SysBase->ResourceList);
+    EXEC_UNLOCK_LIST(&SysBase->ResourceList);
+    NameHashAdd(&SysBase->ResourceList, (struct Node *)resource, SysBase);
+    Permit();
     
     /*
      * A tricky part.
@@ -61,6 +61,7 @@
 #if defined(__AROSEXEC_SMP__)
     EXEC_SPINLOCK_UNLOCK(&PrivExecBase(SysBase)->SemListSpinLock);
 #endif
+    NameHashAdd(&SysBase->SemaphoreList, &sigSem->ss_Link, SysBase);
     /* All done. */
     Permit();
 
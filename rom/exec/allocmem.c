@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2015, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Allocate some memory
 */
@@ -28,6 +28,7 @@
 #endif
 
 #include "exec_intern.h"
+#include "exec_trace.h"
 #include "exec_util.h"
 #include "memory.h"
 #include "mungwall.h"
@@ -125,6 +126,8 @@
             process->pr_Result2 = ERROR_NO_FREE_STORE;
     }
 
+    EXEC_TRACE(ETF_MEMORY, ETT_ALLOCMEM, origSize, res);
+
     D(
         if (SysBase->DebugAROSBase)
         {
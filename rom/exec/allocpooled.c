@@ -68,11 +68,28 @@
     AROS_LIBFUNC_INIT
 
     struct MemHeaderExt *mhe = (struct MemHeaderExt *)poolHeader;
+#if defined(EXEC_POOLCACHE)
+    struct Pool *cachePool;
+#endif
 
     /* 0-sized allocation results in returning NULL (API guarantee) */
     if(!memSize)
         return NULL;
 
+#if defined(EXEC_POOLCACHE)
+    /* Small blocks come from the pool's free lists when possible */
+    cachePool = GetPool(poolHeader);
+    if (cachePool && cachePool->Cache && (memSize <= POOLCACHE_MAXSIZE))
+    {
+        APTR ret;
+
+        memSize = POOLCACHE_ROUNDSIZE(memSize);
+        ret = PoolCacheAlloc(cachePool, memSize, SysBase);
+        if (ret)
+            return ret;
+    }
+#endif
+
     if (IsManagedMem(mhe))
     {
         ULONG poolrequirements = (ULONG)(IPTR)mhe->mhe_MemHeader.mh_First;
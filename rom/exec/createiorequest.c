@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2009, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Create an I/O request.
 */
@@ -31,7 +31,8 @@
     INPUTS
         ioReplyPort - Pointer to that one of your messageports where
                       the messages are replied to. A NULL port is legal
-                      but then the function fails always.
+                      but then the function fails always, and so does a
+                      PF_MPSC port (see NEWMPSCPORT()).
         size        - Size of the message structure including the struct
                       IORequest header. The minimal allowable size is that
                       of a struct Message.
@@ -60,6 +61,10 @@
     if(ioReplyPort==NULL)
         return NULL;
 
+    /* WaitIO() can't take a request out of a lock-free port */
+    if(ioReplyPort->mp_Flags&PF_MPSC)
+        return NULL;
+
     /* Allocate the memory */
     ret=(struct IORequest *)AllocMem(size,MEMF_PUBLIC|MEMF_CLEAR);
 
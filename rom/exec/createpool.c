@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2014, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Create a memory pool.
 */
@@ -127,12 +127,18 @@
         pool->pool.Requirements = requirements;
         pool->pool.PuddleSize   = puddleSize;
         pool->pool.PoolMagic   = POOL_MAGIC;
+        pool->pool.Cache       = NULL;
 
         if (requirements & MEMF_SEM_PROTECTED)
         {
             InitSemaphore(&pool->sem);
         }
 
+#if defined(EXEC_POOLCACHE)
+        /* The low memory handler may lock the pool as soon as this registers it */
+        PoolCacheCreate(firstPuddle, &pool->pool, SysBase);
+#endif
+
         /*
          * If the pool is in managed memory, don't bother any further setup. The
          * pool should do the rest self.
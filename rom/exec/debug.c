@@ -33,6 +33,19 @@ int     get_irq_list(char *buf);
 
 /****************************************************************************************/
 
+#if defined(EXEC_WALKREADYQUEUES)
+static struct Task *SAD_ShowReadyQueue(struct List *readyList, APTR data)
+{
+    struct Node *node;
+
+    ForeachNode(readyList, node)
+    {
+        kprintf("0x%p R %d %s\n", node, node->ln_Pri, node->ln_Name);
+    }
+    return NULL;
+}
+#endif
+
 static char *NextWord(char *s)
 {
     /* Skip to first space or EOL */
@@ -290,6 +303,9 @@ static char *NextWord(char *s)
             {
                 kprintf("0x%p R %d %s\n", node, node->ln_Pri, node->ln_Name);
             }
+#if defined(EXEC_WALKREADYQUEUES)
+            EXEC_WALKREADYQUEUES(SAD_ShowReadyQueue, NULL);
+#endif
 
             for (node = GetHead(&SysBase->TaskWait); node; node = GetSucc(node))
             {
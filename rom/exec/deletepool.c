@@ -61,7 +61,13 @@
 
         if (IsManagedMem(poolHeader))
         {
-            /* Do nothing, everything is handled in FreeMemHeader */
+#if defined(EXEC_POOLCACHE)
+            struct Pool *pool = GetPool(poolHeader);
+
+            if (pool)
+                PoolCacheDelete(pool, SysBase);
+#endif
+            /* Everything else is handled in FreeMemHeader */
         }
         else
         {
@@ -77,6 +83,9 @@
             {
                 D(bug("[DeletePool] Pool header 0x%p\n", pool));
                 pool->PoolMagic = 0x0;
+#if defined(EXEC_POOLCACHE)
+                PoolCacheDelete(pool, SysBase);
+#endif
 
                 /*
                  * We are going to deallocate the whole pool.
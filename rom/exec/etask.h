@@ -62,6 +62,7 @@ struct IntETask
     IPTR                iet_CpuNumber;          /* core this task is currently running on  */
     cpumask_t           *iet_CpuAffinity;        /* bitmap of cores this task can run on    */
     spinlock_t          *iet_SpinLock;          /* pointer to spinlock task is spinning on */
+    void                *iet_RunQueue;          /* scheduler run queue holding the task    */
 #endif
 #ifdef DEBUG_ETASK
     STRPTR              iet_Me;
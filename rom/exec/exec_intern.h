@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2023, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Private data belonging to exec.library
 */
@@ -19,6 +19,11 @@
 #if defined(__AROSEXEC_SMP__)
 #include <aros/types/spinlock_s.h>
 #endif
+#if defined(EXEC_RUNQUEUE)
+#include <kernel_runqueue.h>
+#endif
+#include "namehash.h"
+#include "semaphores.h"
 
 #ifndef __KERNEL_NOLIBBASE__
 #define __KERNEL_NOLIBBASE__
@@ -75,6 +80,23 @@ struct IntExecBase
     ULONG                       SupervisorDeadEndCnt;           /* Counter of reaching AT_DeadEnd under Supervisor mode         */
     char                        AlertBuffer[ALERT_BUFFER_SIZE]; /* Buffer for alert text                                        */
     void                       *ExecLogBase;
+#if defined(EXEC_RUNQUEUE)
+    struct KrnRunQueue          TaskReadyQueue;                 /* Priority run queue of ready tasks, see below                 */
+#endif
+#if defined(EXEC_MAGAZINES)
+    struct MemMagazineBase      *MagazineBase;                  /* Per-CPU caches of small memory blocks                        */
+#endif
+#if defined(EXEC_POOLCACHE)
+    struct PoolCacheBase        *PoolCacheBase;                 /* Registered free lists of pooled blocks                       */
+#endif
+#if defined(EXEC_NAMEHASH)
+    struct NameHash             SysListNames[NAMEHASH_COUNT];   /* Name indexes of the public system lists                      */
+#endif
+#if defined(EXEC_TRACING)
+    ULONG                       TraceFlags;                     /* Event categories being traced, see exec_trace.h              */
+    ULONG                       TraceCPUCount;
+    struct ExecTraceBuffer      **TraceBuffers;                 /* Trace buffer of each CPU                                     */
+#endif
 #if defined(__AROSEXEC_BROKENMEMLOCK__)
     struct SignalSemaphore      MemListSem;                     /* Memory list protection semaphore                             */
 #elif defined(__AROSEXEC_SMP__)
@@ -88,6 +110,9 @@ struct IntExecBase
     spinlock_t                  LibListSpinLock;
     spinlock_t                  PortListSpinLock;
     spinlock_t                  SemListSpinLock;
+    spinlock_t                  SemaphoreExtLock;
+    struct SemaphoreExt         *SemaphoreExt[SEMAPHOREEXT_BUCKETS]; /* Semaphores set up with SetSemaphoreFlags()         */
+    struct SemaphoreStats       SemaphoreStats;                 /* Contention statistics of all semaphores                      */
 
     /* .. and then scheduling related locks ... */
     spinlock_t                  TaskRunningSpinLock;
@@ -110,6 +135,21 @@ struct IntExecBase
 #define DebugBase               PrivExecBase(SysBase)->DebugBase
 #endif
 
+/*
+ * Platforms whose scheduler supports it define EXEC_RUNQUEUE in exec_platform.h.
+ * Ready tasks are then kept in TaskReadyQueue instead of SysBase->TaskReady, which
+ * remains a (priority ordered) queue for code that still enqueues tasks there itself.
+ */
+#if defined(EXEC_RUNQUEUE)
+#define EXEC_READYTASK(task)            krnRunQueueAdd(&PrivExecBase(SysBase)->TaskReadyQueue, (task))
+#if !defined(EXEC_WALKREADYQUEUES)
+#define EXEC_WALKREADYQUEUES(func, data) \
+    krnRunQueueWalk(&PrivExecBase(SysBase)->TaskReadyQueue, (func), (APTR)(data))
+#endif
+#else
+#define EXEC_READYTASK(task)            Enqueue(&SysBase->TaskReady, &(task)->tc_Node)
+#endif
+
 /* IntFlags */
 #define EXECB_MungWall          0                                /* This flag can't be changed at runtime                        */
 #define EXECF_MungWall          (1 << EXECB_MungWall)
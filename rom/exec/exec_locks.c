@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 2017-2026, The AROS Development Team. All rights reserved.
 */
 
 /*
@@ -27,6 +27,7 @@
 #include "exec_debug.h"
 #include "exec_intern.h"
 #include "exec_locks.h"
+#include "semaphores.h"
 
 int ExecLock__InternObtainSystemLock(struct List *systemList, ULONG mode, ULONG flags)
 {
@@ -83,9 +84,9 @@ int ExecLock__InternObtainSystemLock(struct List *systemList, ULONG mode, ULONG
     D(bug("[Exec:Lock] %s(), List='%s' (%p), mode=%s, flags=%d\n", __func__, name, systemList, mode == SPINLOCK_MODE_WRITE ? "write":"read", flags));
     if (sysListLock)
     {
-        if (flags && LOCKF_DISABLE)
+        if (flags & LOCKF_DISABLE)
             Disable();
-        if (flags && LOCKF_FORBID)
+        if (flags & LOCKF_FORBID)
             Forbid();
 
         EXEC_SPINLOCK_LOCK(sysListLock, NULL, mode);
@@ -179,9 +180,9 @@ int ExecLock__ObtainLock(void * lock, ULONG mode, ULONG flags)
 
     if (lock)
     {
-        if (flags && LOCKF_DISABLE)
+        if (flags & LOCKF_DISABLE)
             Disable();
-        if (flags && LOCKF_FORBID)
+        if (flags & LOCKF_FORBID)
             Forbid();
 
         EXEC_SPINLOCK_LOCK(lock, NULL, mode);
@@ -304,6 +305,52 @@ AROS_LH2 (void, ReleaseLock,
     AROS_LIBFUNC_EXIT
 }
 
+/*
+ * Semaphore tuning and statistics, which only SMP builds have.
+ *
+ * SetSemaphoreFlags() sets up a semaphore for SEMF_STATS (keep statistics for
+ * GetSemaphoreStats()) and/or SEMF_PERCPUREADERS (shared obtains only touch
+ * a per-CPU count, exclusive ones have to wait for all of them), or with 0
+ * drops its setup again. The semaphore must not be in use while this is
+ * done, and has to be reset to 0 before it is freed.
+ *
+ * SEMF_PERCPUREADERS semaphores can't be used with Procure(), Vacate() or
+ * ObtainSemaphoreList(), must be released by the task that obtained them,
+ * and a task holding one shared must not obtain it shared again.
+ *
+ * GetSemaphoreStats() with a NULL semaphore returns the totals of all
+ * SEMF_STATS semaphores.
+ */
+AROS_LH2 (BOOL, SetSemaphoreFlags,
+    AROS_LHA(struct SignalSemaphore *, sigSem, A0),
+    AROS_LHA(ULONG, flags, D0),
+    struct ExecLockBase *, ExecLockBase, 7, ExecLock
+)
+{
+    AROS_LIBFUNC_INIT
+
+    D(bug("[Exec:Lock] %s(0x%p, 0x%08x)\n", __func__, sigSem, flags));
+
+    return InternalSetSemaphoreFlags(sigSem, flags, SysBase);
+
+    AROS_LIBFUNC_EXIT
+}
+
+AROS_LH2 (BOOL, GetSemaphoreStats,
+    AROS_LHA(struct SignalSemaphore *, sigSem, A0),
+    AROS_LHA(struct SemaphoreStats *, stats, A1),
+    struct ExecLockBase *, ExecLockBase, 8, ExecLock
+)
+{
+    AROS_LIBFUNC_INIT
+
+    D(bug("[Exec:Lock] %s(0x%p)\n", __func__, sigSem));
+
+    return InternalGetSemaphoreStats(sigSem, stats, SysBase);
+
+    AROS_LIBFUNC_EXIT
+}
+
 const APTR ExecLock__FuncTable[]=
 {
     &AROS_SLIB_ENTRY(ObtainSystemLock,ExecLock,1),
@@ -312,6 +359,8 @@ const APTR ExecLock__FuncTable[]=
     &AROS_SLIB_ENTRY(FreeLock,ExecLock,4),
     &AROS_SLIB_ENTRY(ObtainLock,ExecLock,5),
     &AROS_SLIB_ENTRY(ReleaseLock,ExecLock,6),
+    &AROS_SLIB_ENTRY(SetSemaphoreFlags,ExecLock,7),
+    &AROS_SLIB_ENTRY(GetSemaphoreStats,ExecLock,8),
     (void *)-1
 };
 
@@ -0,0 +1,218 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+    Desc:
+
+        Exposes a public resource on platforms with EXEC_TRACING, that lets
+        user space code switch exec's event tracing on and off and read
+        back the per-CPU trace buffers (see exec_trace.h).
+
+        e.g. C:ExecTrace uses this to dump the events to a file, that
+        can be converted for trace viewers on the host.
+
+    Lang: english
+*/
+
+#include <aros/config.h>
+#include <exec/memory.h>
+
+#define DEBUG 0
+
+#include <aros/debug.h>
+#include <proto/exec.h>
+
+#include "exec_debug.h"
+#include "exec_intern.h"
+#include "exec_trace.h"
+
+#if defined(EXEC_TRACING)
+
+struct ExecTraceBase
+{
+    struct Node et_Node;
+};
+
+static BOOL ExecTrace__AllocBuffers(struct ExecBase *SysBase)
+{
+    struct ExecTraceBuffer **buffers;
+    ULONG cpuCount = 1, cpu, i;
+
+#if defined(__AROSEXEC_SMP__)
+    cpuCount = KrnGetCPUCount();
+#endif
+
+    buffers = AllocMem(cpuCount * sizeof(struct ExecTraceBuffer *), MEMF_PUBLIC | MEMF_CLEAR);
+    if (!buffers)
+        return FALSE;
+
+    for (cpu = 0; cpu < cpuCount; cpu++)
+    {
+        buffers[cpu] = AllocMem(sizeof(struct ExecTraceBuffer), MEMF_PUBLIC | MEMF_CLEAR);
+        if (!buffers[cpu])
+        {
+            while (cpu-- > 0)
+                FreeMem(buffers[cpu], sizeof(struct ExecTraceBuffer));
+            FreeMem(buffers, cpuCount * sizeof(struct ExecTraceBuffer *));
+            return FALSE;
+        }
+
+        /* Mark all records as not written yet */
+        for (i = 0; i < EXECTRACE_RECORDS; i++)
+            buffers[cpu]->etb_Records[i].etr_Sequence = i - 1;
+    }
+
+    PrivExecBase(SysBase)->TraceCPUCount = cpuCount;
+    __atomic_store_n(&PrivExecBase(SysBase)->TraceBuffers, buffers, __ATOMIC_RELEASE);
+
+    return TRUE;
+}
+
+/*
+ * SetTraceFlags() changes the event categories (ETF_#?) in mask to the
+ * state given in flags, and returns the categories that were traced before.
+ * The trace buffers are allocated the first time any category is enabled,
+ * if this fails tracing stays off.
+ */
+AROS_LH2 (ULONG, SetTraceFlags,
+    AROS_LHA(ULONG, flags, D0),
+    AROS_LHA(ULONG, mask, D1),
+    struct ExecTraceBase *, ExecTraceBase, 1, ExecTrace
+)
+{
+    AROS_LIBFUNC_INIT
+
+    ULONG oldFlags, newFlags;
+
+    D(bug("[Exec:Trace] %s(0x%08x, 0x%08x)\n", __func__, flags, mask));
+
+    Forbid();
+    oldFlags = PrivExecBase(SysBase)->TraceFlags;
+    newFlags = ((oldFlags & ~mask) | (flags & mask)) & ETF_ALL;
+
+    if (newFlags && !PrivExecBase(SysBase)->TraceBuffers &&
+        !ExecTrace__AllocBuffers(SysBase))
+        newFlags = 0;
+
+    __atomic_store_n(&PrivExecBase(SysBase)->TraceFlags, newFlags, __ATOMIC_RELEASE);
+    Permit();
+
+    return oldFlags;
+
+    AROS_LIBFUNC_EXIT
+}
+
+/*
+ * ReadTrace() copies up to count records of the given CPU, starting with
+ * sequence number *position, to buffer. *position is advanced past the
+ * records copied, and past records that were overwritten before they could
+ * be read, or are still being written by a task that got preempted while
+ * doing so - those are lost. Start with *position 0 to get the oldest
+ * records that are still there. Returns the number of records copied.
+ */
+AROS_LH4 (ULONG, ReadTrace,
+    AROS_LHA(ULONG, cpu, D0),
+    AROS_LHA(ULONG *, position, A0),
+    AROS_LHA(struct ExecTraceRecord *, buffer, A1),
+    AROS_LHA(ULONG, count, D1),
+    struct ExecTraceBase *, ExecTraceBase, 2, ExecTrace
+)
+{
+    AROS_LIBFUNC_INIT
+
+    struct ExecTraceBuffer *etb;
+    struct ExecTraceRecord *etr;
+    ULONG pos = *position, head, seq, copied = 0;
+
+    D(bug("[Exec:Trace] %s(%u, %u)\n", __func__, cpu, pos));
+
+    if (!PrivExecBase(SysBase)->TraceBuffers || (cpu >= PrivExecBase(SysBase)->TraceCPUCount))
+        return 0;
+    etb = PrivExecBase(SysBase)->TraceBuffers[cpu];
+
+    while (copied < count)
+    {
+        head = __atomic_load_n(&etb->etb_Head, __ATOMIC_ACQUIRE);
+        if (pos == head)
+            break;
+        if (head - pos > EXECTRACE_RECORDS)
+            pos = head - EXECTRACE_RECORDS;
+
+        etr = &etb->etb_Records[pos & (EXECTRACE_RECORDS - 1)];
+        seq = __atomic_load_n(&etr->etr_Sequence, __ATOMIC_ACQUIRE);
+        if (seq == pos)
+        {
+            buffer[copied] = *etr;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&etr->etr_Sequence, __ATOMIC_RELAXED) == pos)
+                copied++;
+        }
+        pos++;
+    }
+    *position = pos;
+
+    return copied;
+
+    AROS_LIBFUNC_EXIT
+}
+
+AROS_LH1 (IPTR, GetTraceAttr,
+    AROS_LHA(ULONG, attr, D0),
+    struct ExecTraceBase *, ExecTraceBase, 3, ExecTrace
+)
+{
+    AROS_LIBFUNC_INIT
+
+    D(bug("[Exec:Trace] %s(%u)\n", __func__, attr));
+
+    switch (attr)
+    {
+    case ETA_Flags:
+        return PrivExecBase(SysBase)->TraceFlags;
+
+    case ETA_CPUCount:
+        return PrivExecBase(SysBase)->TraceCPUCount;
+
+    case ETA_Records:
+        return EXECTRACE_RECORDS;
+    }
+
+    return 0;
+
+    AROS_LIBFUNC_EXIT
+}
+
+const APTR ExecTrace__FuncTable[]=
+{
+    &AROS_SLIB_ENTRY(SetTraceFlags,ExecTrace,1),
+    &AROS_SLIB_ENTRY(ReadTrace,ExecTrace,2),
+    &AROS_SLIB_ENTRY(GetTraceAttr,ExecTrace,3),
+    (void *)-1
+};
+
+APTR ExecTrace__PrepareBase(struct MemHeader *mh)
+{
+    APTR ExecTraceResBase;
+    struct ExecTraceBase *ExecTraceBase;
+
+    D(bug("[Exec:Trace] %s()\n", __func__));
+
+    PrivExecBase(SysBase)->TraceFlags = 0;
+    PrivExecBase(SysBase)->TraceCPUCount = 0;
+    PrivExecBase(SysBase)->TraceBuffers = NULL;
+
+    ExecTraceResBase = Allocate(mh, sizeof(struct ExecTraceBase) + sizeof(ExecTrace__FuncTable));
+    ExecTraceBase = (struct ExecTraceBase *)((IPTR)ExecTraceResBase + sizeof(ExecTrace__FuncTable));
+
+    MakeFunctions(ExecTraceBase, ExecTrace__FuncTable, NULL);
+
+    ExecTraceBase->et_Node.ln_Name = EXECTRACENAME;
+    ExecTraceBase->et_Node.ln_Type = NT_RESOURCE;
+
+    AddResource(ExecTraceBase);
+
+    return ExecTraceBase;
+}
+
+#endif
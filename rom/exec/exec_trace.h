@@ -0,0 +1,84 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Per-CPU event trace buffers of exectrace.resource.
+*/
+#ifndef _EXEC_TRACE_H
+#define _EXEC_TRACE_H
+
+#include <aros/config.h>
+#include <resources/exectrace.h>
+
+#include "exec_intern.h"
+
+/*
+ * Platforms that have a usable KrnTimeStamp() define EXEC_TRACING in
+ * exec_platform.h. Exec and the kernel then record the events of the
+ * categories enabled with SetTraceFlags() in a ring buffer of each CPU.
+ *
+ * Writers never block: a record is reserved by atomically incrementing the
+ * buffer's head, which also makes writers on the same CPU (interrupts) safe.
+ * While a record is written its etr_Sequence holds the previous sequence
+ * number, and the final one is stored last, so readers can tell records that
+ * are complete from ones that are being written or were overwritten. Nothing
+ * ever waits for readers, old records simply get overwritten.
+ *
+ * The buffers are allocated when tracing is enabled for the first time,
+ * and then kept, since other CPUs might still be writing to them.
+ */
+#if defined(EXEC_TRACING)
+
+#define EXECTRACE_RECORDS       8192                            /* Per CPU, must be a power of 2        */
+
+struct ExecTraceBuffer
+{
+    ULONG                       etb_Head;                       /* Sequence number of the next record   */
+    ULONG                       etb_Pad[15];                    /* Keep the records off its cache line  */
+    struct ExecTraceRecord      etb_Records[EXECTRACE_RECORDS];
+};
+
+static inline void ExecTraceWrite(struct ExecBase *SysBase, UWORD type, IPTR arg0, IPTR arg1)
+{
+#if defined(__AROS_KERNEL__)
+    struct KernelBase *KernelBase = __kernelBase;
+#endif
+    struct ExecTraceBuffer *etb;
+    struct ExecTraceRecord *etr;
+    ULONG cpu = 0, seq;
+
+#if defined(__AROSEXEC_SMP__)
+    cpu = KrnGetCPUNumber();
+    if (cpu >= PrivExecBase(SysBase)->TraceCPUCount)
+        return;
+#endif
+    etb = PrivExecBase(SysBase)->TraceBuffers[cpu];
+
+    seq = __atomic_fetch_add(&etb->etb_Head, 1, __ATOMIC_RELAXED);
+    etr = &etb->etb_Records[seq & (EXECTRACE_RECORDS - 1)];
+
+    __atomic_store_n(&etr->etr_Sequence, seq - 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    etr->etr_Time = KrnTimeStamp();
+    etr->etr_Type = type;
+    etr->etr_CPU = cpu;
+    etr->etr_Task = (IPTR)GET_THIS_TASK;
+    etr->etr_Arg[0] = arg0;
+    etr->etr_Arg[1] = arg1;
+
+    __atomic_store_n(&etr->etr_Sequence, seq, __ATOMIC_RELEASE);
+}
+
+#define EXEC_TRACE(category, type, arg0, arg1)                                  \
+    do {                                                                        \
+        if (PrivExecBase(SysBase)->TraceFlags & (category))                     \
+            ExecTraceWrite(SysBase, (type), (IPTR)(arg0), (IPTR)(arg1));        \
+    } while (0)
+
+#else
+
+#define EXEC_TRACE(category, type, arg0, arg1)
+
+#endif /* EXEC_TRACING */
+
+#endif /* !_EXEC_TRACE_H */
@@ -15,6 +15,8 @@
 
 #include <proto/exec.h>
 
+#include <string.h>
+
 #include "etask.h"
 #include "exec_intern.h"
 #include "exec_util.h"
@@ -318,6 +320,47 @@ Exec_ExpungeETask(struct ETask *et, struct ExecBase *SysBase)
     FreeMem(et, sizeof(struct IntETask));
 }
 
+#if defined(EXEC_WALKREADYQUEUES)
+/* Callbacks used to search the schedulers RunQueues, see EXEC_WALKREADYQUEUES */
+struct Task *Exec_ReadyQueueFindName(struct List *readyList, APTR name)
+{
+    struct Task *t;
+
+    ForeachNode(readyList, t)
+    {
+        if (t->tc_Node.ln_Name && !strcmp(t->tc_Node.ln_Name, (CONST_STRPTR)name))
+            return t;
+    }
+    return NULL;
+}
+
+struct Task *Exec_ReadyQueueFindID(struct List *readyList, APTR id)
+{
+    struct Task *t;
+    struct ETask *et;
+
+    ForeachNode(readyList, t)
+    {
+        et = GetETask(t);
+        if (et != NULL && et->et_UniqueID == (ULONG)(IPTR)id)
+            return t;
+    }
+    return NULL;
+}
+
+struct Task *Exec_ReadyQueueFindTask(struct List *readyList, APTR task)
+{
+    struct Task *t;
+
+    ForeachNode(readyList, t)
+    {
+        if (t == (struct Task *)task)
+            return t;
+    }
+    return NULL;
+}
+#endif
+
 BOOL Exec_CheckTask(struct Task *task, struct ExecBase *SysBase)
 {
     struct Task *t;
@@ -373,6 +416,14 @@ BOOL Exec_CheckTask(struct Task *task, struct ExecBase *SysBase)
             return TRUE;
         }
     }
+#if defined(EXEC_WALKREADYQUEUES)
+    if (EXEC_WALKREADYQUEUES(Exec_ReadyQueueFindTask, task))
+    {
+        EXEC_SPINLOCK_UNLOCK(&PrivExecBase(SysBase)->TaskReadySpinLock);
+        Permit();
+        return TRUE;
+    }
+#endif
 #if defined(__AROSEXEC_SMP__)
     EXEC_SPINLOCK_UNLOCK(&PrivExecBase(SysBase)->TaskReadySpinLock);
     Permit();
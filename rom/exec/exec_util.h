@@ -106,6 +106,11 @@ struct ETask *Exec_FindChild(ULONG id, struct ExecBase *SysBase);
 struct IntETask *FindETask(struct List *, ULONG id, struct ExecBase *SysBase);
 
 BOOL Exec_CheckTask(struct Task *task, struct ExecBase *SysBase);
+#if defined(EXEC_WALKREADYQUEUES)
+struct Task *Exec_ReadyQueueFindName(struct List *readyList, APTR name);
+struct Task *Exec_ReadyQueueFindID(struct List *readyList, APTR id);
+struct Task *Exec_ReadyQueueFindTask(struct List *readyList, APTR task);
+#endif
 
 STRPTR Alert_AddString(STRPTR dest, CONST_STRPTR src);
 STRPTR Alert_GetTitle(ULONG alertNum);
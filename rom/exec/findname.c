@@ -73,6 +73,11 @@
 /*    ASSERT(list != NULL); */
     ASSERT(name);
 
+    /* The public system lists are indexed by name */
+    node = NameHashFind(list, name, SysBase);
+    if (node)
+        return node;
+
     /* Look through the list */
     for (node=GetHead(list); node; node=GetSucc(node))
     {
@@ -49,6 +49,11 @@
 
     struct MsgPort *retVal;
 
+    /* Try the name index first, it needs no lock */
+    retVal = (struct MsgPort *)NameHashFind(&SysBase->PortList, name, SysBase);
+    if (retVal)
+        return retVal;
+
     /* Nothing spectacular - just look for that name. */
 #if defined(__AROSEXEC_SMP__)
     EXEC_SPINLOCK_LOCK(&PrivExecBase(SysBase)->PortListSpinLock, NULL, SPINLOCK_MODE_READ);
@@ -50,6 +50,11 @@
 
     struct SignalSemaphore *retVal;
 
+    /* Try the name index first, it needs no lock */
+    retVal = (struct SignalSemaphore *)NameHashFind(&SysBase->SemaphoreList, name, SysBase);
+    if (retVal)
+        return retVal;
+
     /* Nothing spectacular - just look into the list */
 #if defined(__AROSEXEC_SMP__)
     EXEC_SPINLOCK_LOCK(&PrivExecBase(SysBase)->SemListSpinLock, NULL, SPINLOCK_MODE_READ);
@@ -11,6 +11,7 @@
 #include <proto/exec.h>
 
 #include "exec_intern.h"
+#include "exec_util.h"
 #include "exec_locks.h"
 
 /*****************************************************************************
@@ -71,6 +72,11 @@
 
     /* First look into the ready list. */
     ret = (struct Task *)FindName(&SysBase->TaskReady, name);
+#if defined(EXEC_WALKREADYQUEUES)
+    /* .. and the per-cpu ready queues */
+    if (ret == NULL)
+        ret = EXEC_WALKREADYQUEUES(Exec_ReadyQueueFindName, name);
+#endif
     if (ret == NULL)
     {
 #if defined(__AROSEXEC_SMP__)
@@ -8,6 +8,7 @@
 #include <exec/tasks.h>
 
 #include "exec_intern.h"
+#include "exec_util.h"
 #include "exec_locks.h"
 
 /*****************************************************************************
@@ -114,6 +115,14 @@
             return t;
         }
     }
+#if defined(EXEC_WALKREADYQUEUES)
+    /* .. and the per-cpu ready queues */
+    if ((t = EXEC_WALKREADYQUEUES(Exec_ReadyQueueFindID, (IPTR)id)) != NULL)
+    {
+        EXEC_UNLOCK_AND_ENABLE(&PrivExecBase(SysBase)->TaskReadySpinLock);
+        return t;
+    }
+#endif
 #if defined(__AROSEXEC_SMP__)
     EXEC_UNLOCK_AND_ENABLE(&PrivExecBase(SysBase)->TaskReadySpinLock);
 
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2012, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Free memory allocated by AllocMem()
 */
@@ -14,6 +14,7 @@
 #include <proto/exec.h>
 
 #include "exec_intern.h"
+#include "exec_trace.h"
 #include "exec_util.h"
 #include "memory.h"
 #include "mungwall.h"
@@ -65,6 +66,8 @@
     if(!byteSize || !memoryBlock)
         ReturnVoid ("FreeMem");
 
+    EXEC_TRACE(ETF_MEMORY, ETT_FREEMEM, memoryBlock, byteSize);
+
     memoryBlock = MungWall_Check(memoryBlock, byteSize, &tp, SysBase);
 
     if (PrivExecBase(SysBase)->IntFlags & EXECF_MungWall)
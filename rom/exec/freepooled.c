@@ -13,6 +13,23 @@
 #include "exec_util.h"
 #include "memory.h"
 
+static inline __attribute__((always_inline)) void FreePooledBlock(APTR poolHeader, APTR memory, IPTR memSize, struct ExecBase *SysBase)
+{
+    struct MemHeaderExt *mhe = (struct MemHeaderExt *)poolHeader;
+
+    if (IsManagedMem(mhe))
+    {
+        if (mhe->mhe_Free)
+            mhe->mhe_Free(mhe, memory, memSize);
+    }
+    else
+    {
+        struct TraceLocation tp = CURRENT_LOCATION("FreePooled");
+
+        InternalFreePooled(poolHeader, memory, memSize, &tp, SysBase);
+    }
+}
+
 /*****************************************************************************
 
     NAME */
@@ -53,23 +70,33 @@
 {
     AROS_LIBFUNC_INIT
 
-    struct MemHeaderExt *mhe = (struct MemHeaderExt *)poolHeader;
+#if defined(EXEC_POOLCACHE)
+    struct Pool *cachePool;
+#endif
 
     /* If there is nothing to free do nothing. */
     if(!memSize || !memory)
         return;
 
-    if (IsManagedMem(mhe))
+#if defined(EXEC_POOLCACHE)
+    cachePool = GetPool(poolHeader);
+    if (cachePool && cachePool->Cache && (memSize <= POOLCACHE_MAXSIZE))
     {
-        if (mhe->mhe_Free)
-            mhe->mhe_Free(mhe, memory, memSize);
-    }
-    else
-    {
-        struct TraceLocation tp = CURRENT_LOCATION("FreePooled");
+        APTR next;
 
-        InternalFreePooled(poolHeader, memory, memSize, &tp, SysBase);
+        memSize = POOLCACHE_ROUNDSIZE(memSize);
+
+        /* Blocks that don't fit on the free list go back to the puddles */
+        for (memory = PoolCacheFree(cachePool, memory, memSize, SysBase); memory; memory = next)
+        {
+            next = *(APTR *)memory;
+            FreePooledBlock(poolHeader, memory, memSize, SysBase);
+        }
+        return;
     }
+#endif
+
+    FreePooledBlock(poolHeader, memory, memSize, SysBase);
 
     AROS_LIBFUNC_EXIT
 } /* FreePooled */
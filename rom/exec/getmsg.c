@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Get a message from a message port.
 */
@@ -13,6 +13,8 @@
 #include <proto/exec.h>
 
 #include "exec_intern.h"
+#include "exec_trace.h"
+#include "mpscport.h"
 
 /*****************************************************************************
 
@@ -58,18 +60,28 @@
 
     ASSERT_VALID_PTR(port);
 
-    /*
-     * Protect the message list, and get the first node.
-     */
-    Disable();
+    if (port->mp_Flags & PF_MPSC)
+    {
+        /* Only the port owner dequeues, so no protection is needed */
+        msg = MPSCPortGet(port);
+    }
+    else
+    {
+        /*
+         * Protect the message list, and get the first node.
+         */
+        Disable();
 #if defined(__AROSEXEC_SMP__)
-    EXEC_SPINLOCK_LOCK(&port->mp_SpinLock, NULL, SPINLOCK_MODE_WRITE);
+        EXEC_SPINLOCK_LOCK(&port->mp_SpinLock, NULL, SPINLOCK_MODE_WRITE);
 #endif
-    msg=(struct Message *)RemHead(&port->mp_MsgList);
+        msg=(struct Message *)RemHead(&port->mp_MsgList);
 #if defined(__AROSEXEC_SMP__)
-    EXEC_SPINLOCK_UNLOCK(&port->mp_SpinLock);
+        EXEC_SPINLOCK_UNLOCK(&port->mp_SpinLock);
 #endif
-    Enable();
+        Enable();
+    }
+
+    EXEC_TRACE(ETF_MESSAGE, ETT_GETMSG, port, msg);
 
     /* All done. */
     ASSERT_VALID_PTR_OR_NULL(msg);
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <aros/debug.h>
@@ -123,11 +123,11 @@ void mhac_ClearSysCtx(struct MemHeader * mh, struct ExecBase * SysBase)
 {
 }
 
+#define MCN_MINSIZE                         (0)     /* Nothing is indexed */
+#define mhac_CheckIndex(a, b)
 #define mhac_MemChunkClaimed(a, b)
-#define mhac_IsIndexEmpty(a)                (TRUE)
-#define mhac_ClearIndex(a)
-#define mhac_MemChunkCreated(a, b, c)       { (void)b; }
-#define mhac_GetBetterPrevMemChunk(a, b, c) (a)
+#define mhac_MemChunkCreated(a, b)
+#define mhac_GetFitMemChunk(a, b, c)        (NULL)
 #define mhac_GetCloserPrevMemChunk(a, b, c) (a)
 #define mhac_PoolMemHeaderGetCtx(a)         (NULL)
 #define mhac_PoolMemHeaderGetPool(a)        (a->mh_Node.ln_Name)
@@ -136,24 +136,34 @@ void mhac_ClearSysCtx(struct MemHeader * mh, struct ExecBase * SysBase)
 /* Allocator optimization support */
 
 /*
- * The array contains pointers to chunk previous to first chunk of at least size N
+ * The free chunks of a MemHeader are indexed with an AVL tree, ordered by
+ * address. Each node also knows the size of the largest chunk in its subtree,
+ * so both the first (lowest address) and the last chunk that fits a request
+ * are found in O(log n), and so is the chunk preceding a freed block.
  *
- * N = 1 << (FIRSTPOTBIT + (i * POTSTEP)), where i is index in array
- * first is defined as MemChunk with lowest address
- *
- * Each chunk in array locates the place where search should start, not necesarly
- * where allocation should happen.
+ * The tree nodes are stored in the free chunks themselves, behind the
+ * MemChunk. Chunks too small to hold a node are not indexed; they stay in the
+ * MemChunk list only, which remains the authoritative free list. AllocAbs()
+ * and anything else walking the list keeps working, but code modifying the
+ * list without passing the context has to invalidate the index, which is
+ * then rebuilt on next use.
  *
  * If chunk is taken from MemHeader and is present in the index, it must be removed
  * from index.
  *
- * If chunk is returned to MemHeader it may be registered with index.
+ * If chunk is returned to MemHeader it must be registered with index.
  */
 
-#define FIRSTPOTBIT             (5)
-#define FIRSTPOT                (1 << FIRSTPOTBIT)
-#define POTSTEP                 (1)     /* Distance between each level */
-#define ALLOCATORCTXINDEXSIZE   (10)    /* Number of levels in index */
+struct MemChunkNode
+{
+    struct MemChunk         mcn_Chunk;
+    struct MemChunkNode     *mcn_Parent;
+    struct MemChunkNode     *mcn_Link[2];       /* Lower and higher addresses   */
+    IPTR                    mcn_MaxBytes;       /* Largest chunk in subtree     */
+    LONG                    mcn_Height;
+};
+
+#define MCN_MINSIZE             (AROS_ROUNDUP2(sizeof(struct MemChunkNode), MEMCHUNK_TOTAL))
 
 struct MemHeaderAllocatorCtx
 {
@@ -161,8 +171,8 @@ struct MemHeaderAllocatorCtx
     struct MemHeader        *mhac_MemHeader;
     APTR                    mhac_Data1;
 
-    ULONG                   mhac_IndexSize;
-    struct MemChunk         *mhac_PrevChunks[ALLOCATORCTXINDEXSIZE];
+    struct MemChunkNode     *mhac_Root;
+    BOOL                    mhac_Valid;         /* Index matches the MemChunk list */
 };
 
 ULONG mhac_GetCtxSize()
@@ -170,49 +180,187 @@ ULONG mhac_GetCtxSize()
     return (AROS_ROUNDUP2(sizeof(struct MemHeaderAllocatorCtx), MEMCHUNK_TOTAL));
 }
 
-static BOOL mhac_IsIndexEmpty(struct MemHeaderAllocatorCtx * mhac)
+static inline LONG mhac_NodeHeight(struct MemChunkNode * n)
 {
-    LONG i;
-    if (!mhac)
-        return TRUE;
+    return n ? n->mcn_Height : 0;
+}
 
-    for (i = 0; i < mhac->mhac_IndexSize; i++)
-        if (mhac->mhac_PrevChunks[i] != NULL)
-            return FALSE;
+static inline IPTR mhac_NodeMaxBytes(struct MemChunkNode * n)
+{
+    return n ? n->mcn_MaxBytes : 0;
+}
 
-    return TRUE;
+static void mhac_NodeUpdate(struct MemChunkNode * n)
+{
+    LONG hl = mhac_NodeHeight(n->mcn_Link[0]), hr = mhac_NodeHeight(n->mcn_Link[1]);
+    IPTR ml = mhac_NodeMaxBytes(n->mcn_Link[0]), mr = mhac_NodeMaxBytes(n->mcn_Link[1]);
+
+    n->mcn_Height = 1 + ((hl > hr) ? hl : hr);
+    n->mcn_MaxBytes = n->mcn_Chunk.mc_Bytes;
+    if (ml > n->mcn_MaxBytes) n->mcn_MaxBytes = ml;
+    if (mr > n->mcn_MaxBytes) n->mcn_MaxBytes = mr;
+}
+
+static void mhac_ReplaceChild(struct MemHeaderAllocatorCtx * mhac, struct MemChunkNode * parent,
+        struct MemChunkNode * old, struct MemChunkNode * new)
+{
+    if (!parent)
+        mhac->mhac_Root = new;
+    else if (parent->mcn_Link[0] == old)
+        parent->mcn_Link[0] = new;
+    else
+        parent->mcn_Link[1] = new;
 }
 
-static void mhac_ClearIndex(struct MemHeaderAllocatorCtx * mhac)
+/* Rotate n down to the side given by dir (0 = left). Returns the new subtree root. */
+static struct MemChunkNode * mhac_Rotate(struct MemHeaderAllocatorCtx * mhac, struct MemChunkNode * n, LONG dir)
 {
-    LONG i;
+    struct MemChunkNode * c = n->mcn_Link[!dir];
 
-    if (!mhac)
-        return;
+    n->mcn_Link[!dir] = c->mcn_Link[dir];
+    if (c->mcn_Link[dir])
+        c->mcn_Link[dir]->mcn_Parent = n;
+
+    c->mcn_Parent = n->mcn_Parent;
+    mhac_ReplaceChild(mhac, n->mcn_Parent, n, c);
+
+    c->mcn_Link[dir] = n;
+    n->mcn_Parent = c;
+
+    mhac_NodeUpdate(n);
+    mhac_NodeUpdate(c);
+
+    return c;
+}
+
+/* Restore balance and subtree sizes from n up to the root */
+static void mhac_Rebalance(struct MemHeaderAllocatorCtx * mhac, struct MemChunkNode * n)
+{
+    while (n)
+    {
+        LONG balance;
+
+        mhac_NodeUpdate(n);
+        balance = mhac_NodeHeight(n->mcn_Link[0]) - mhac_NodeHeight(n->mcn_Link[1]);
+
+        if (balance > 1)
+        {
+            struct MemChunkNode * l = n->mcn_Link[0];
+
+            if (mhac_NodeHeight(l->mcn_Link[0]) < mhac_NodeHeight(l->mcn_Link[1]))
+                mhac_Rotate(mhac, l, 0);
+            n = mhac_Rotate(mhac, n, 1);
+        }
+        else if (balance < -1)
+        {
+            struct MemChunkNode * r = n->mcn_Link[1];
+
+            if (mhac_NodeHeight(r->mcn_Link[1]) < mhac_NodeHeight(r->mcn_Link[0]))
+                mhac_Rotate(mhac, r, 1);
+            n = mhac_Rotate(mhac, n, 0);
+        }
+
+        n = n->mcn_Parent;
+    }
+}
+
+static void mhac_InsertNode(struct MemHeaderAllocatorCtx * mhac, struct MemChunkNode * n)
+{
+    struct MemChunkNode * parent = NULL, * p = mhac->mhac_Root;
+    LONG dir = 0;
+
+    while (p)
+    {
+        parent = p;
+        dir = (n > p) ? 1 : 0;
+        p = p->mcn_Link[dir];
+    }
+
+    n->mcn_Parent = parent;
+    n->mcn_Link[0] = NULL;
+    n->mcn_Link[1] = NULL;
+    n->mcn_Height = 1;
+    n->mcn_MaxBytes = n->mcn_Chunk.mc_Bytes;
+
+    if (parent)
+        parent->mcn_Link[dir] = n;
+    else
+        mhac->mhac_Root = n;
+
+    mhac_Rebalance(mhac, parent);
+}
+
+static void mhac_RemoveNode(struct MemHeaderAllocatorCtx * mhac, struct MemChunkNode * n)
+{
+    struct MemChunkNode * parent = n->mcn_Parent;
+
+    if (n->mcn_Link[0] && n->mcn_Link[1])
+    {
+        /* Put the next higher chunk in place of the removed one */
+        struct MemChunkNode * s = n->mcn_Link[1], * start;
+
+        while (s->mcn_Link[0])
+            s = s->mcn_Link[0];
 
-    for (i = 0; i < ALLOCATORCTXINDEXSIZE; i++)
-        mhac->mhac_PrevChunks[i] = NULL;
+        if (s->mcn_Parent == n)
+            start = s;
+        else
+        {
+            start = s->mcn_Parent;
+            start->mcn_Link[0] = s->mcn_Link[1];
+            if (s->mcn_Link[1])
+                s->mcn_Link[1]->mcn_Parent = start;
+
+            s->mcn_Link[1] = n->mcn_Link[1];
+            s->mcn_Link[1]->mcn_Parent = s;
+        }
+
+        s->mcn_Link[0] = n->mcn_Link[0];
+        s->mcn_Link[0]->mcn_Parent = s;
+        s->mcn_Parent = parent;
+        mhac_ReplaceChild(mhac, parent, n, s);
+
+        mhac_Rebalance(mhac, start);
+    }
+    else
+    {
+        struct MemChunkNode * c = n->mcn_Link[0] ? n->mcn_Link[0] : n->mcn_Link[1];
+
+        if (c)
+            c->mcn_Parent = parent;
+        mhac_ReplaceChild(mhac, parent, n, c);
+
+        mhac_Rebalance(mhac, parent);
+    }
 }
 
-static void mhac_SetupMemHeaderAllocatorCtx(struct MemHeader * mh, ULONG maxindexsize,
-        struct MemHeaderAllocatorCtx * mhac)
+static void mhac_BuildIndex(struct MemHeader * mh, struct MemHeaderAllocatorCtx * mhac)
 {
-    /* Adjust index size to space in MemHeader */
-    IPTR size = (IPTR)mh->mh_Upper - (IPTR)mh->mh_Lower;
-    LONG indexsize = 0;
+    struct MemChunk * mc;
 
-    size = size >> FIRSTPOTBIT;
-    size = size >> POTSTEP;
+    mhac->mhac_Root = NULL;
 
-    for (; size > 0; size = size >> POTSTEP) indexsize++;
+    for (mc = mh->mh_First; mc; mc = mc->mc_Next)
+    {
+        if (mc->mc_Bytes >= MCN_MINSIZE)
+            mhac_InsertNode(mhac, (struct MemChunkNode *)mc);
+    }
 
-    if (indexsize < 0) indexsize = 0;
-    if (indexsize > maxindexsize) indexsize = maxindexsize;
-    if (indexsize > ALLOCATORCTXINDEXSIZE) indexsize = ALLOCATORCTXINDEXSIZE;
+    mhac->mhac_Valid = TRUE;
+}
 
+static inline void mhac_CheckIndex(struct MemHeader * mh, struct MemHeaderAllocatorCtx * mhac)
+{
+    if (mhac && !mhac->mhac_Valid)
+        mhac_BuildIndex(mh, mhac);
+}
+
+static void mhac_SetupMemHeaderAllocatorCtx(struct MemHeader * mh, struct MemHeaderAllocatorCtx * mhac)
+{
     mhac->mhac_MemHeader = mh;
-    mhac->mhac_IndexSize = indexsize;
-    mhac_ClearIndex(mhac);
+    mhac->mhac_Data1 = NULL;
+    mhac->mhac_Root = NULL;
+    mhac->mhac_Valid = FALSE;
 }
 
 void mhac_ClearSysCtx(struct MemHeader * mh, struct ExecBase * SysBase)
@@ -223,7 +371,8 @@ void mhac_ClearSysCtx(struct MemHeader * mh, struct ExecBase * SysBase)
     {
         if (mhac->mhac_MemHeader == mh)
         {
-            mhac_ClearIndex(mhac);
+            mhac->mhac_Root = NULL;
+            mhac->mhac_Valid = FALSE;
             break;
         }
     }
@@ -241,118 +390,86 @@ struct MemHeaderAllocatorCtx * mhac_GetSysCtx(struct MemHeader * mh, struct Exec
 
     /* New context is needed */
     mhac = Allocate(mh, sizeof(struct MemHeaderAllocatorCtx));
-    mhac_SetupMemHeaderAllocatorCtx(mh, ALLOCATORCTXINDEXSIZE, mhac);
-    AddTail(&PrivExecBase(SysBase)->AllocatorCtxList, (struct Node *)mhac);
+    if (mhac)
+    {
+        mhac_SetupMemHeaderAllocatorCtx(mh, mhac);
+        AddTail(&PrivExecBase(SysBase)->AllocatorCtxList, (struct Node *)mhac);
+    }
 
     return mhac;
 }
 
 static void mhac_MemChunkClaimed(struct MemChunk * mc, struct MemHeaderAllocatorCtx * mhac)
 {
-    LONG i;
-
     if (!mhac)
         return;
 
-    for (i = 0; i < mhac->mhac_IndexSize; i++)
-    {
-        if (mhac->mhac_PrevChunks[i] != NULL &&
-                (mhac->mhac_PrevChunks[i] == mc || mhac->mhac_PrevChunks[i]->mc_Next == mc))
-        {
-            mhac->mhac_PrevChunks[i] = NULL;
-        }
-    }
-}
-
-static LONG mhac_CalcIndex(LONG size, ULONG indexsize)
-{
-    LONG r = 0;
-    size >>= FIRSTPOTBIT;
-    while (size >>= 1)
-        r++;
-
-    if (r > indexsize - 1) r = indexsize - 1;
-
-    return r;
+    if (mc->mc_Bytes >= MCN_MINSIZE)
+        mhac_RemoveNode(mhac, (struct MemChunkNode *)mc);
 }
 
-static void mhac_MemChunkCreated(struct MemChunk * mc, struct MemChunk *mcprev, struct MemHeaderAllocatorCtx * mhac)
+static void mhac_MemChunkCreated(struct MemChunk * mc, struct MemHeaderAllocatorCtx * mhac)
 {
-    LONG i, v = FIRSTPOT;
-
-    if (mc->mc_Bytes < FIRSTPOT) /* Allocation too small for index */
-        return;
-
     if (!mhac)
         return;
 
-    for (i = 0; i < mhac->mhac_IndexSize; i++, v = v << POTSTEP)
-    {
-        if (mc->mc_Bytes < v)
-            break; /* Chunk smaller than index at i. Stop */
-
-        /* If no chunk in index or given passed chunk has lower address than chunk in index */
-        if (mhac->mhac_PrevChunks[i] == NULL ||
-                (mhac->mhac_PrevChunks[i] != NULL && mhac->mhac_PrevChunks[i]->mc_Next > mc))
-        {
-            mhac->mhac_PrevChunks[i] = mcprev;
-        }
-    }
+    if (mc->mc_Bytes >= MCN_MINSIZE) /* Only chunks that can hold a node are indexed */
+        mhac_InsertNode(mhac, (struct MemChunkNode *)mc);
 }
 
-/* General idea:
- *      Function returned pointer to chunk that is prev to chunk that will allow
- *      to locate faster chunk big enough for allocation. Function never returns NULL.
- * Current implementation:
- *      Function returns pointer to chunk that is prev to first biggest chunk,
- *      not bigger than requested size
+/*
+ * Returns the chunk with the lowest address (highest with MEMF_REVERSE) that
+ * is at least size bytes large, or NULL if the index does not know any.
+ * Requests smaller than MCN_MINSIZE may still fit one of the unindexed chunks.
  */
-static struct MemChunk * mhac_GetBetterPrevMemChunk(struct MemChunk * prev, IPTR size, struct MemHeaderAllocatorCtx * mhac)
+static struct MemChunk * mhac_GetFitMemChunk(IPTR size, ULONG requirements, struct MemHeaderAllocatorCtx * mhac)
 {
-    struct MemChunk * _return = prev;
+    struct MemChunkNode * n;
+    LONG first, last;
 
-    if (size < FIRSTPOT)
-        return _return; /* Allocation too small for index */
+    if (!mhac)
+        return NULL;
 
-    if (mhac)
-    {
-        LONG i;
-        LONG ii = mhac_CalcIndex(size, mhac->mhac_IndexSize);
+    n = mhac->mhac_Root;
+    if (mhac_NodeMaxBytes(n) < size)
+        return NULL;
 
-        if (mhac->mhac_PrevChunks[ii] != NULL)
-            _return = mhac->mhac_PrevChunks[ii];
+    first = (requirements & MEMF_REVERSE) ? 1 : 0;
+    last = !first;
+
+    for (;;)
+    {
+        if (mhac_NodeMaxBytes(n->mcn_Link[first]) >= size)
+            n = n->mcn_Link[first];
+        else if (n->mcn_Chunk.mc_Bytes >= size)
+            return &n->mcn_Chunk;
         else
-        {
-            for (i = ii - 1; i >= 0; i--)
-            {
-                if (mhac->mhac_PrevChunks[i] != NULL)
-                {
-                    _return = mhac->mhac_PrevChunks[i];
-                    break;
-                }
-            }
-        }
+            n = n->mcn_Link[last];
     }
-
-    return _return;
 }
 
+/*
+ * Returns the indexed chunk closest below addr, or prev if there is none.
+ * The chunk preceding addr in the MemChunk list is found by following the
+ * list from there - only unindexed chunks can be in between.
+ */
 static struct MemChunk * mhac_GetCloserPrevMemChunk(struct MemChunk * prev, APTR addr, struct MemHeaderAllocatorCtx * mhac)
 {
     struct MemChunk * _return = prev;
 
     if (mhac)
     {
-        LONG i;
+        struct MemChunkNode * n = mhac->mhac_Root;
 
-        for (i = 0; i < mhac->mhac_IndexSize; i++)
+        while (n)
         {
-            if (mhac->mhac_PrevChunks[i] != NULL &&
-                    (APTR)mhac->mhac_PrevChunks[i]->mc_Next < addr &&
-                    mhac->mhac_PrevChunks[i]->mc_Next > _return->mc_Next)
+            if ((APTR)n < addr)
             {
-                _return = mhac->mhac_PrevChunks[i];
+                _return = &n->mcn_Chunk;
+                n = n->mcn_Link[1];
             }
+            else
+                n = n->mcn_Link[0];
         }
     }
 
@@ -366,7 +483,7 @@ void mhac_PoolMemHeaderSetup(struct MemHeader * mh, struct ProtectedPool * pool)
 {
     struct MemHeaderAllocatorCtx * mhac = Allocate(mh, sizeof(struct MemHeaderAllocatorCtx));
 
-    mhac_SetupMemHeaderAllocatorCtx(mh, 5, mhac);
+    mhac_SetupMemHeaderAllocatorCtx(mh, mhac);
 
     mhac->mhac_Data1 = pool;
     mh->mh_Node.ln_Name = (STRPTR)mhac;
@@ -377,7 +494,6 @@ void mhac_PoolMemHeaderSetup(struct MemHeader * mh, struct ProtectedPool * pool)
 
 #endif
 
-
 #ifdef NO_CONSISTENCY_CHECKS
 
 #define validateHeader(mh, op, addr, size, SysBase) TRUE
@@ -512,15 +628,47 @@ APTR stdAlloc(struct MemHeader *mh, struct MemHeaderAllocatorCtx *mhac, IPTR siz
         if (mh->mh_Free < byteSize)
             return NULL;
 
+        mhac_CheckIndex(mh, mhac);
 
         /*
          * The free memory list is only single linked, i.e. to remove
          * elements from the list I need the node's predecessor. For the
          * first element I can use mh->mh_First instead of a real predecessor.
          */
-        p1 = mhac_GetBetterPrevMemChunk((struct MemChunk *)&mh->mh_First, size, mhac);
+        p1 = (struct MemChunk *)&mh->mh_First;
         p2 = p1->mc_Next;
 
+        /*
+         * Chunks smaller than MCN_MINSIZE are not indexed, so the index alone
+         * decides only for requests which cannot fit them. Smaller requests
+         * follow the list, the first fit is then found at the latest at the
+         * first indexed chunk. With MEMF_REVERSE only the unindexed chunks
+         * behind the last indexed fit remain to be checked.
+         */
+        if (mhac && ((byteSize >= MCN_MINSIZE) || (requirements & MEMF_REVERSE)))
+        {
+            struct MemChunk *fit = mhac_GetFitMemChunk(byteSize, requirements, mhac);
+
+            if (fit != NULL)
+            {
+                /* The index found the chunk, only its predecessor is needed */
+                p1 = mhac_GetCloserPrevMemChunk(p1, fit, mhac);
+                while (p1->mc_Next != fit)
+                {
+                    if (!validateChunk(p1->mc_Next, p1, mh, MM_ALLOC, NULL, size, tp, SysBase))
+                        return NULL;
+                    p1 = p1->mc_Next;
+                }
+                mc = p1;
+
+                p1 = fit;
+                p2 = fit->mc_Next;
+            }
+
+            if (byteSize >= MCN_MINSIZE)
+                p2 = NULL;
+        }
+
         /*
          * Follow the memory list. p1 is the previous MemChunk, p2 is the current one.
          * On 1st pass p1 points to mh->mh_First, so that changing p1->mc_Next actually
@@ -567,8 +715,6 @@ APTR stdAlloc(struct MemHeader *mh, struct MemHeaderAllocatorCtx *mhac, IPTR siz
             }
             else
             {
-                struct MemChunk * pp = p1;
-
                 if (requirements & MEMF_REVERSE)
                 {
                     /* Return the last bytes. */
@@ -583,10 +729,10 @@ APTR stdAlloc(struct MemHeader *mh, struct MemHeaderAllocatorCtx *mhac, IPTR siz
                 }
 
                 p1           = p1->mc_Next;
-                    p1->mc_Next  = p2->mc_Next;
+                p1->mc_Next  = p2->mc_Next;
                 p1->mc_Bytes = p2->mc_Bytes-byteSize;
 
-                mhac_MemChunkCreated(p1, pp, mhac);
+                mhac_MemChunkCreated(p1, mhac);
             }
 
             mh->mh_Free -= byteSize;
@@ -595,18 +741,6 @@ APTR stdAlloc(struct MemHeader *mh, struct MemHeaderAllocatorCtx *mhac, IPTR siz
             if (requirements & MEMF_CLEAR)
                 memset(mc, 0, byteSize);
         }
-        else
-        {
-            if (!mhac_IsIndexEmpty(mhac))
-            {
-                /*
-                 * Since chunks created during deallocation are not returned to index,
-                 * retry with cleared index.
-                 */
-                mhac_ClearIndex(mhac);
-                mc = stdAlloc(mh, mhac, size, requirements, tp, SysBase);
-            }
-        }
 
         return mc;
     }
@@ -637,6 +771,8 @@ void stdDealloc(struct MemHeader *freeList, struct MemHeaderAllocatorCtx *mhac,
         if (!validateHeader(freeList, MM_FREE, addr, size, tp, SysBase))
             return;
 
+        mhac_CheckIndex(freeList, mhac);
+
         /* Align size to the requirements */
         byteSize = size + ((IPTR)addr & (MEMCHUNK_TOTAL - 1));
         byteSize = (byteSize + MEMCHUNK_TOTAL-1) & ~(MEMCHUNK_TOTAL - 1);
@@ -664,6 +800,7 @@ void stdDealloc(struct MemHeader *freeList, struct MemHeaderAllocatorCtx *mhac,
             p3->mc_Next = NULL;
             p1->mc_Next = p3;
             freeList->mh_Free += byteSize;
+            mhac_MemChunkCreated(p3, mhac);
             return;
         }
 
@@ -672,7 +809,7 @@ void stdDealloc(struct MemHeader *freeList, struct MemHeaderAllocatorCtx *mhac,
         p2=p1->mc_Next;
 
         /* Follow the list to find a place where to insert our memory. */
-        do
+        while (p2 != NULL)
         {
             if (!validateChunk(p2, p1, freeList, MM_FREE, addr, size, tp, SysBase))
                 return;
@@ -703,7 +840,7 @@ void stdDealloc(struct MemHeader *freeList, struct MemHeaderAllocatorCtx *mhac,
             p2 = p2->mc_Next;
 
             /* If the loop ends with p2 zero add it at the end. */
-        } while (p2 != NULL);
+        }
 
         /* If there was a previous block merge with it. */
         if (p1 != (struct MemChunk *)&freeList->mh_First)
@@ -725,10 +862,6 @@ void stdDealloc(struct MemHeader *freeList, struct MemHeaderAllocatorCtx *mhac,
             {
                 mhac_MemChunkClaimed(p1, mhac);
                 p3 = p1;
-                /*
-                 * Note: this case does not lead to mhac_MemChunkCreated, because
-                 * we don't have chunk prev to p1
-                 */
             }
             else
                 /* Not possible to merge */
@@ -755,7 +888,7 @@ void stdDealloc(struct MemHeader *freeList, struct MemHeaderAllocatorCtx *mhac,
         p3->mc_Next = p2;
         p3->mc_Bytes = p4 - (UBYTE *)p3;
         freeList->mh_Free += byteSize;
-        if (p1->mc_Next==p3) mhac_MemChunkCreated(p3, p1, mhac);
+        mhac_MemChunkCreated(p3, mhac);
     }
 }
 
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2011, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc:
 */
@@ -7,8 +7,10 @@
 #define _MEMORY_H_
 
 #include <exec/lists.h>
+#include <exec/interrupts.h>
 #include <exec/semaphores.h>
 #include <exec/memory.h>
+#include <exec/memheaderext.h>
 #include <stddef.h>
 
 #if defined(__AROSEXEC_SMP__)
@@ -29,6 +31,8 @@
 
 #define POOL_MAGIC AROS_MAKE_ID('P','o','O','l')
 
+struct PoolCache;
+
 /* Private Pool structure */
 struct Pool 
 {
@@ -36,6 +40,7 @@ struct Pool
     ULONG Requirements;
     ULONG PuddleSize;
     ULONG PoolMagic;
+    struct PoolCache *Cache;            /* Free lists of small blocks, or NULL */
 };
 
 struct ProtectedPool
@@ -44,6 +49,75 @@ struct ProtectedPool
     struct SignalSemaphore sem;
 };
 
+/*
+ * Small blocks freed to a pool are kept on free lists, one per size class
+ * and CPU (a single one for pools without MEMF_SEM_PROTECTED), and handed
+ * out again without taking the pool semaphore or searching the puddles.
+ * The lists are linked through the first word of the free blocks.
+ * Requests up to POOLCACHE_MAXSIZE are rounded up to their size class
+ * for pools with a cache, so any freed block fits its class.
+ */
+#define POOLCACHE_MAXSIZE       256
+#define POOLCACHE_CLASSES       (POOLCACHE_MAXSIZE >> 4)
+#define POOLCACHE_DEPTH         16                      /* Blocks kept per class and CPU        */
+#define POOLCACHE_BATCH         8                       /* Blocks returned to the pool at once  */
+
+#define POOLCACHE_CLASS(size)           (((size) - 1) >> 4)
+#define POOLCACHE_ROUNDSIZE(size)       AROS_ROUNDUP2((size), 16)
+
+struct PoolCacheList
+{
+    APTR  pcl_Head;
+    ULONG pcl_Count;
+};
+
+struct PoolCacheSlot
+{
+    struct PoolCacheList pcs_Class[POOLCACHE_CLASSES];
+    ULONG                pcs_FlushGen;  /* pcb_FlushGen when last flushed    */
+};
+
+struct PoolCache
+{
+    struct MinNode       pc_Node;       /* pcb_Caches linkage                */
+    APTR                 pc_PoolHeader;
+    struct Pool         *pc_Pool;
+    ULONG                pc_SlotCount;
+    struct PoolCacheSlot pc_Slot[];
+};
+
+/*
+ * All pool caches are registered with the low memory handler. It empties
+ * the lists of the CPU it runs on for the protected pools it can lock, and
+ * bumps pcb_FlushGen so every other list is emptied on its next use.
+ */
+struct PoolCacheBase
+{
+    struct MinList         pcb_Caches;
+    struct SignalSemaphore pcb_Lock;
+    struct Interrupt       pcb_LowMemHandler;
+    ULONG                  pcb_FlushGen;
+};
+
+/*
+ * Find the Pool structure of a pool. Managed pools keep a pointer to its
+ * semaphore in ln_Name, which may not point to a Pool for foreign MemHeaders.
+ */
+static inline struct Pool *GetPool(APTR poolHeader)
+{
+    struct Pool *pool;
+
+    if (IsManagedMem(poolHeader))
+    {
+        pool = (struct Pool *)(((struct MemHeader *)poolHeader)->mh_Node.ln_Name - offsetof(struct ProtectedPool, sem));
+        if (pool->PoolMagic != POOL_MAGIC)
+            return NULL;
+        return pool;
+    }
+
+    return poolHeader + MEMHEADER_TOTAL;
+}
+
 struct Block
 {
     struct MinNode Node;
@@ -92,6 +166,11 @@ IPTR nommu_AvailMem(ULONG attributes, struct ExecBase *SysBase);
 #define PME_ALLOC_INV_POOL      4
 #define PME_DEL_POOL_INV_POOL   5
 
+void PoolCacheCreate(APTR poolHeader, struct Pool *pool, struct ExecBase *SysBase);
+void PoolCacheDelete(struct Pool *pool, struct ExecBase *SysBase);
+APTR PoolCacheAlloc(struct Pool *pool, IPTR memSize, struct ExecBase *SysBase);
+APTR PoolCacheFree(struct Pool *pool, APTR memory, IPTR memSize, struct ExecBase *SysBase);
+
 void PoolManagerAlert(ULONG code, ULONG flags, IPTR memSize, APTR memory, APTR poolHeaderMH, APTR poolHeader);
 
 #define BLOCK_TOTAL \
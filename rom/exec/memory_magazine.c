@@ -0,0 +1,503 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Per-CPU magazine caches for small memory blocks.
+*/
+
+#define DEBUG 0
+
+#include <aros/debug.h>
+#include <aros/symbolsets.h>
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <exec/memheaderext.h>
+#include <proto/exec.h>
+
+#include <string.h>
+
+#include "exec_intern.h"
+
+#if defined(EXEC_MAGAZINES)
+
+#include <proto/kernel.h>
+
+#include "exec_util.h"
+#include "memory.h"
+#include "memory_magazine.h"
+
+/*
+ * The MemHeader is accessed the same way nommu_AllocMem()/nommu_FreeMem()
+ * do it. Callers must hold MEM_LOCK.
+ */
+static APTR memMagHeaderAlloc(struct MemHeader *mh, IPTR size, ULONG flags, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    if (IsManagedMem(mh))
+    {
+        struct MemHeaderExt *mhe = (struct MemHeaderExt *)mh;
+
+        if (mhe->mhe_Alloc)
+            return mhe->mhe_Alloc(mhe, size, &flags);
+        return NULL;
+    }
+    if (mh->mh_Free < size)
+        return NULL;
+    return stdAlloc(mh, mhac_GetSysCtx(mh, SysBase), size, flags, loc, SysBase);
+}
+
+static void memMagHeaderFree(struct MemHeader *mh, APTR block, IPTR size, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    if (IsManagedMem(mh))
+    {
+        struct MemHeaderExt *mhe = (struct MemHeaderExt *)mh;
+
+        if (mhe->mhe_Free)
+            mhe->mhe_Free(mhe, block, size);
+    }
+    else
+        stdDealloc(mh, mhac_GetSysCtx(mh, SysBase), block, size, loc, SysBase);
+}
+
+/* Return all blocks of a magazine to the MemHeader in one go. Caller holds MEM_LOCK */
+static IPTR memMagRelease(struct MemMagazineBase *mmb, struct MemMagazine *mag, ULONG cls, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    IPTR size = memMagClassSize(cls);
+    IPTR released;
+
+    if (!mag)
+        return 0;
+
+    released = mag->mm_Rounds * size;
+    while (mag->mm_Rounds)
+        memMagHeaderFree(mmb->mmb_Header, mag->mm_Round[--mag->mm_Rounds], size, loc, SysBase);
+
+    return released;
+}
+
+/* Get an empty magazine from the depot, or make a new one. Caller holds MEM_LOCK */
+static struct MemMagazine *memMagGetEmpty(struct MemMagazineBase *mmb, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    struct MemMagazine *mag = (struct MemMagazine *)REMHEAD(&mmb->mmb_Empty);
+
+    if (mag)
+    {
+        mmb->mmb_EmptyCount--;
+        return mag;
+    }
+
+    mag = memMagHeaderAlloc(mmb->mmb_Header, sizeof(struct MemMagazine), 0, loc, SysBase);
+    if (mag)
+        mag->mm_Rounds = 0;
+
+    return mag;
+}
+
+static void memMagPutEmpty(struct MemMagazineBase *mmb, struct MemMagazine *mag, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    if (mmb->mmb_EmptyCount < MEMMAG_EMPTYMAX)
+    {
+        ADDHEAD(&mmb->mmb_Empty, &mag->mm_Node);
+        mmb->mmb_EmptyCount++;
+    }
+    else
+        memMagHeaderFree(mmb->mmb_Header, mag, sizeof(struct MemMagazine), loc, SysBase);
+}
+
+/* Return everything a CPU has cached. Caller holds MEM_LOCK */
+static IPTR memMagFlushCPU(struct MemMagazineBase *mmb, struct MemMagCPU *cpu, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    IPTR released = 0;
+    ULONG cls;
+
+    for (cls = 0; cls < MEMMAG_CLASSES; cls++)
+    {
+        released += memMagRelease(mmb, cpu->mc_Class[cls].mcc_Loaded, cls, loc, SysBase);
+        released += memMagRelease(mmb, cpu->mc_Class[cls].mcc_Previous, cls, loc, SysBase);
+    }
+    cpu->mc_CachedBytes -= released;
+
+    return released;
+}
+
+/* Return everything the depot holds, including its empty magazines. Caller holds MEM_LOCK */
+static IPTR memMagFlushDepot(struct MemMagazineBase *mmb, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    struct MemMagazine *mag;
+    IPTR released = 0;
+    ULONG cls;
+
+    for (cls = 0; cls < MEMMAG_CLASSES; cls++)
+    {
+        while ((mag = (struct MemMagazine *)REMHEAD(&mmb->mmb_Depot[cls].md_Full)))
+        {
+            released += memMagRelease(mmb, mag, cls, loc, SysBase);
+            memMagHeaderFree(mmb->mmb_Header, mag, sizeof(struct MemMagazine), loc, SysBase);
+        }
+        mmb->mmb_Depot[cls].md_FullCount = 0;
+    }
+    mmb->mmb_DepotBytes -= released;
+
+    while ((mag = (struct MemMagazine *)REMHEAD(&mmb->mmb_Empty)))
+        memMagHeaderFree(mmb->mmb_Header, mag, sizeof(struct MemMagazine), loc, SysBase);
+    mmb->mmb_EmptyCount = 0;
+
+    return released;
+}
+
+static inline struct MemMagCPU **memMagThisCPU(struct MemMagazineBase *mmb, struct ExecBase *SysBase)
+{
+#if defined(__AROSEXEC_SMP__)
+    ULONG cpuNo = KrnGetCPUNumber();
+
+    if (cpuNo >= MEMMAG_MAXCPU)
+        return NULL;
+    return &mmb->mmb_CPU[cpuNo];
+#else
+    return &mmb->mmb_CPU[0];
+#endif
+}
+
+/*
+ * Return the caches of the CPU we are running on, creating them on first use.
+ * Must be called in Forbid() - this keeps the task on the CPU, and other tasks
+ * off its caches.
+ */
+static struct MemMagCPU *memMagGetCPU(struct MemMagazineBase *mmb, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    struct MemMagCPU **cpuPtr = memMagThisCPU(mmb, SysBase);
+    struct MemMagCPU *cpu;
+
+    if (!cpuPtr)
+        return NULL;
+
+    cpu = *cpuPtr;
+    if (!cpu)
+    {
+        MEM_LOCK;
+        cpu = memMagHeaderAlloc(mmb->mmb_Header, sizeof(struct MemMagCPU), MEMF_CLEAR, loc, SysBase);
+        MEM_UNLOCK;
+
+        if (cpu)
+        {
+            cpu->mc_FlushGen = mmb->mmb_FlushGen;
+            *cpuPtr = cpu;
+        }
+    }
+    else if (cpu->mc_FlushGen != mmb->mmb_FlushGen)
+    {
+        /* The low memory handler ran on another CPU */
+        MEM_LOCK;
+        cpu->mc_FlushGen = mmb->mmb_FlushGen;
+        memMagFlushCPU(mmb, cpu, loc, SysBase);
+        MEM_UNLOCK;
+    }
+
+    return cpu;
+}
+
+/*
+ * Both magazines are empty. Swap in a full one from the depot if there is
+ * one, otherwise fetch a batch of blocks from the MemHeader.
+ */
+static void memMagReload(struct MemMagazineBase *mmb, struct MemMagCPU *cpu, ULONG cls, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    struct MemMagClassCache *cc = &cpu->mc_Class[cls];
+    struct MemMagDepot *depot = &mmb->mmb_Depot[cls];
+    IPTR size = memMagClassSize(cls);
+    struct MemMagazine *mag;
+
+    MEM_LOCK;
+
+    mag = (struct MemMagazine *)REMHEAD(&depot->md_Full);
+    if (mag)
+    {
+        depot->md_FullCount--;
+        mmb->mmb_DepotBytes -= mag->mm_Rounds * size;
+        cpu->mc_CachedBytes += mag->mm_Rounds * size;
+
+        if (cc->mcc_Previous)
+            memMagPutEmpty(mmb, cc->mcc_Previous, loc, SysBase);
+        cc->mcc_Previous = cc->mcc_Loaded;
+        cc->mcc_Loaded = mag;
+    }
+    else
+    {
+        if (!cc->mcc_Loaded)
+            cc->mcc_Loaded = memMagGetEmpty(mmb, loc, SysBase);
+
+        mag = cc->mcc_Loaded;
+        if (mag)
+        {
+            APTR block;
+
+            while ((mag->mm_Rounds < MEMMAG_BATCH) &&
+                   (block = memMagHeaderAlloc(mmb->mmb_Header, size, 0, loc, SysBase)))
+            {
+                mag->mm_Round[mag->mm_Rounds++] = block;
+                cpu->mc_CachedBytes += size;
+            }
+        }
+    }
+
+    MEM_UNLOCK;
+}
+
+/*
+ * The loaded magazine is full, and the previous one isn't empty. Move the
+ * previous magazine to the depot - or return its blocks to the MemHeader
+ * if the depot already holds enough - and load an empty one.
+ */
+static BOOL memMagExchange(struct MemMagazineBase *mmb, struct MemMagCPU *cpu, ULONG cls, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    struct MemMagClassCache *cc = &cpu->mc_Class[cls];
+    struct MemMagDepot *depot = &mmb->mmb_Depot[cls];
+    IPTR size = memMagClassSize(cls);
+    struct MemMagazine *mag, *prev;
+
+    MEM_LOCK;
+
+    mag = memMagGetEmpty(mmb, loc, SysBase);
+    if (mag)
+    {
+        prev = cc->mcc_Previous;
+        if (prev)
+        {
+            cpu->mc_CachedBytes -= prev->mm_Rounds * size;
+            if (depot->md_FullCount < MEMMAG_DEPOTMAX)
+            {
+                ADDTAIL(&depot->md_Full, &prev->mm_Node);
+                depot->md_FullCount++;
+                mmb->mmb_DepotBytes += prev->mm_Rounds * size;
+            }
+            else
+            {
+                memMagRelease(mmb, prev, cls, loc, SysBase);
+                memMagPutEmpty(mmb, prev, loc, SysBase);
+            }
+        }
+        cc->mcc_Previous = cc->mcc_Loaded;
+        cc->mcc_Loaded = mag;
+    }
+
+    MEM_UNLOCK;
+
+    return (mag != NULL);
+}
+
+static inline BOOL memMagHeaderMatches(struct MemMagazineBase *mmb, ULONG flags)
+{
+    return !((flags & MEMF_PHYSICAL_MASK) & ~mmb->mmb_Header->mh_Attributes);
+}
+
+/*
+ * Allocate a small block from the current CPU's magazines. byteSize must
+ * already be rounded with MEMMAG_ROUNDSIZE(). Returns NULL if the request
+ * has to go to the memory list.
+ */
+APTR memMagAlloc(IPTR byteSize, ULONG flags, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    struct MemMagazineBase *mmb = PrivExecBase(SysBase)->MagazineBase;
+    struct MemMagClassCache *cc;
+    struct MemMagCPU *cpu;
+    struct MemMagazine *mag;
+    APTR res = NULL;
+    ULONG cls;
+
+    if (!mmb || (byteSize > MEMMAG_MAXSIZE) || (flags & MEMF_REVERSE) || !memMagHeaderMatches(mmb, flags))
+        return NULL;
+
+    cls = memMagClass(byteSize);
+
+    Forbid();
+
+    cpu = memMagGetCPU(mmb, loc, SysBase);
+    if (cpu)
+    {
+        cc = &cpu->mc_Class[cls];
+        if (!cc->mcc_Loaded || !cc->mcc_Loaded->mm_Rounds)
+        {
+            if (cc->mcc_Previous && cc->mcc_Previous->mm_Rounds)
+            {
+                mag = cc->mcc_Loaded;
+                cc->mcc_Loaded = cc->mcc_Previous;
+                cc->mcc_Previous = mag;
+            }
+            else
+                memMagReload(mmb, cpu, cls, loc, SysBase);
+        }
+
+        mag = cc->mcc_Loaded;
+        if (mag && mag->mm_Rounds)
+        {
+            res = mag->mm_Round[--mag->mm_Rounds];
+            cpu->mc_CachedBytes -= byteSize;
+        }
+    }
+
+    Permit();
+
+    if (res && (flags & MEMF_CLEAR))
+        memset(res, 0, byteSize);
+
+    D(bug("[MM:Mag] %s(%lu, 0x%08X) = 0x%p\n", __func__, byteSize, flags, res));
+
+    return res;
+}
+
+/*
+ * Put a small block into the current CPU's magazines. Returns FALSE if it
+ * has to be freed to its MemHeader.
+ */
+BOOL memMagFree(APTR memoryBlock, IPTR byteSize, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    struct MemMagazineBase *mmb = PrivExecBase(SysBase)->MagazineBase;
+    struct MemMagClassCache *cc;
+    struct MemMagCPU *cpu;
+    struct MemMagazine *mag;
+    BOOL cached = FALSE;
+    ULONG cls;
+
+    if (!mmb || (byteSize > MEMMAG_MAXSIZE) ||
+        (memoryBlock < mmb->mmb_Header->mh_Lower) || (memoryBlock + byteSize > mmb->mmb_Header->mh_Upper))
+        return FALSE;
+
+    cls = memMagClass(byteSize);
+
+    Forbid();
+
+    cpu = memMagGetCPU(mmb, loc, SysBase);
+    if (cpu)
+    {
+        cc = &cpu->mc_Class[cls];
+        if (!cc->mcc_Loaded || (cc->mcc_Loaded->mm_Rounds == MEMMAG_ROUNDS))
+        {
+            if (cc->mcc_Previous && !cc->mcc_Previous->mm_Rounds)
+            {
+                mag = cc->mcc_Loaded;
+                cc->mcc_Loaded = cc->mcc_Previous;
+                cc->mcc_Previous = mag;
+            }
+            else
+                memMagExchange(mmb, cpu, cls, loc, SysBase);
+        }
+
+        mag = cc->mcc_Loaded;
+        if (mag && (mag->mm_Rounds < MEMMAG_ROUNDS))
+        {
+            mag->mm_Round[mag->mm_Rounds++] = memoryBlock;
+            cpu->mc_CachedBytes += byteSize;
+            cached = TRUE;
+        }
+    }
+
+    Permit();
+
+    D(bug("[MM:Mag] %s(0x%p, %lu) cached = %d\n", __func__, memoryBlock, byteSize, cached));
+
+    return cached;
+}
+
+/* Free memory held in the caches, which AvailMem() has to count as free */
+IPTR memMagAvail(ULONG attributes, struct ExecBase *SysBase)
+{
+    struct MemMagazineBase *mmb = PrivExecBase(SysBase)->MagazineBase;
+    IPTR ret;
+    ULONG cpuNo;
+
+    if (!mmb || (attributes & (MEMF_LARGEST | MEMF_TOTAL)) || !memMagHeaderMatches(mmb, attributes))
+        return 0;
+
+    ret = mmb->mmb_DepotBytes;
+    for (cpuNo = 0; cpuNo < MEMMAG_MAXCPU; cpuNo++)
+    {
+        if (mmb->mmb_CPU[cpuNo])
+            ret += mmb->mmb_CPU[cpuNo]->mc_CachedBytes;
+    }
+
+    return ret;
+}
+
+/*
+ * Low memory handler. Returns the blocks cached by this CPU and the depot,
+ * and makes the other CPUs return theirs on their next request.
+ */
+AROS_UFH3S(LONG, memMagLowMemHandler,
+    AROS_UFHA(struct MemHandlerData *, lmhd, A0),
+    AROS_UFHA(APTR, data, A1),
+    AROS_UFHA(struct ExecBase *, SysBase, A6)
+)
+{
+    AROS_USERFUNC_INIT
+
+    struct MemMagazineBase *mmb = data;
+    struct MemMagCPU **cpuPtr;
+    IPTR released = 0;
+
+    Forbid();
+
+    mmb->mmb_FlushGen++;
+
+    MEM_LOCK;
+    cpuPtr = memMagThisCPU(mmb, SysBase);
+    if (cpuPtr && *cpuPtr)
+    {
+        (*cpuPtr)->mc_FlushGen = mmb->mmb_FlushGen;
+        released += memMagFlushCPU(mmb, *cpuPtr, NULL, SysBase);
+    }
+    released += memMagFlushDepot(mmb, NULL, SysBase);
+    MEM_UNLOCK;
+
+    Permit();
+
+    D(bug("[MM:Mag] %s: released %lu bytes\n", __func__, released));
+
+    return released ? MEM_TRY_AGAIN : MEM_DID_NOTHING;
+
+    AROS_USERFUNC_EXIT
+}
+
+static int Exec_InitMagazines(struct ExecBase *SysBase)
+{
+    struct MemMagazineBase *mmb;
+    struct MemHeader *mh, *cacheMH = NULL;
+    ULONG cls;
+
+    /* Cache the MemHeader that ordinary MEMF_PUBLIC requests are served from */
+    MEM_LOCK_SHARED;
+    ForeachNode(&SysBase->MemList, mh)
+    {
+        if (mh->mh_Attributes & MEMF_PUBLIC)
+        {
+            cacheMH = mh;
+            break;
+        }
+    }
+    MEM_UNLOCK;
+
+    if (!cacheMH)
+        return TRUE;
+
+    mmb = AllocMem(sizeof(struct MemMagazineBase), MEMF_PUBLIC | MEMF_CLEAR);
+    if (!mmb)
+        return TRUE;
+
+    mmb->mmb_Header = cacheMH;
+    NEWLIST(&mmb->mmb_Empty);
+    for (cls = 0; cls < MEMMAG_CLASSES; cls++)
+        NEWLIST(&mmb->mmb_Depot[cls].md_Full);
+
+    mmb->mmb_LowMemHandler.is_Node.ln_Name = "exec magazines";
+    mmb->mmb_LowMemHandler.is_Node.ln_Pri = 100;
+    mmb->mmb_LowMemHandler.is_Code = (VOID_FUNC)memMagLowMemHandler;
+    mmb->mmb_LowMemHandler.is_Data = mmb;
+    AddMemHandler(&mmb->mmb_LowMemHandler);
+
+    D(bug("[MM:Mag] Caching small blocks of MemHeader 0x%p (%s)\n", cacheMH, cacheMH->mh_Node.ln_Name));
+
+    PrivExecBase(SysBase)->MagazineBase = mmb;
+
+    return TRUE;
+}
+
+ADD2INITLIB(Exec_InitMagazines, 0)
+
+#endif /* EXEC_MAGAZINES */
@@ -0,0 +1,113 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Per-CPU magazine caches for small memory blocks.
+*/
+#ifndef _MEMORY_MAGAZINE_H_
+#define _MEMORY_MAGAZINE_H_
+
+#include <exec/lists.h>
+#include <exec/interrupts.h>
+#include <exec/memory.h>
+
+/*
+ * Small AllocMem()/FreeMem() requests are served from magazines - small
+ * stacks of free blocks of one size class - owned by the CPU the request
+ * runs on. A CPU only needs Forbid() to use its own magazines, so the memory
+ * list lock is only taken to swap magazines with the depot, or to move a
+ * batch of blocks between a magazine and the MemHeader.
+ *
+ * A block may be returned to the cache regardless of who allocated it, so
+ * every request up to MEMMAG_MAXSIZE is rounded up to its size class, even
+ * when it is served by the MemHeader directly. AllocAbs() only takes the
+ * rounded size when the slack is free, so an exact fit still succeeds.
+ * Blocks are only cached for one MemHeader (mmb_Header), which keeps
+ * AvailMem() exact.
+ */
+#define MEMMAG_MAXSIZE          1024
+#define MEMMAG_CLASSES          20
+#define MEMMAG_ROUNDS           15                      /* Blocks per magazine                          */
+#define MEMMAG_BATCH            8                       /* Blocks fetched from the MemHeader at once    */
+#define MEMMAG_DEPOTMAX         8                       /* Full magazines kept in the depot per class   */
+#define MEMMAG_EMPTYMAX         32                      /* Empty magazines kept in the depot            */
+#if defined(__AROSEXEC_SMP__)
+#define MEMMAG_MAXCPU           64
+#else
+#define MEMMAG_MAXCPU           1
+#endif
+
+struct MemMagazine
+{
+    struct MinNode              mm_Node;                        /* Depot list linkage                           */
+    ULONG                       mm_Rounds;                      /* Number of cached blocks                      */
+    APTR                        mm_Round[MEMMAG_ROUNDS];
+};
+
+struct MemMagClassCache
+{
+    struct MemMagazine          *mcc_Loaded;                    /* Blocks are taken from/put into this one ...  */
+    struct MemMagazine          *mcc_Previous;                  /* ... this one is full or empty                */
+};
+
+struct MemMagCPU
+{
+    struct MemMagClassCache     mc_Class[MEMMAG_CLASSES];
+    IPTR                        mc_CachedBytes;                 /* Bytes held in this CPU's magazines           */
+    ULONG                       mc_FlushGen;                    /* mmb_FlushGen when last flushed               */
+};
+
+struct MemMagDepot
+{
+    struct MinList              md_Full;                        /* Magazines holding blocks of this class       */
+    ULONG                       md_FullCount;
+};
+
+struct MemMagazineBase
+{
+    struct MemHeader            *mmb_Header;                    /* MemHeader the cached blocks belong to        */
+    struct Interrupt            mmb_LowMemHandler;              /* Flushes the caches when memory runs short    */
+    ULONG                       mmb_FlushGen;                   /* Bumped to make all CPUs flush                */
+    IPTR                        mmb_DepotBytes;                 /* Bytes held in depot magazines                */
+    struct MinList              mmb_Empty;                      /* Empty magazines of any class                 */
+    ULONG                       mmb_EmptyCount;
+    struct MemMagDepot          mmb_Depot[MEMMAG_CLASSES];
+    struct MemMagCPU            *mmb_CPU[MEMMAG_MAXCPU];
+};
+
+/*
+ * Size classes step by 16 bytes up to 128 bytes, and then in quarters of
+ * each power of two (160, 192, 224, 256, 320 ... 1024).
+ */
+static inline __attribute__((always_inline)) ULONG memMagClass(IPTR size)
+{
+    ULONG msb;
+
+    if (size <= 128)
+        return (size - 1) >> 4;
+
+    msb = 31 - __builtin_clz((ULONG)(size - 1));
+    return 8 + ((msb - 7) << 2) + (((size - 1) >> (msb - 2)) & 3);
+}
+
+static inline __attribute__((always_inline)) IPTR memMagClassSize(ULONG cls)
+{
+    ULONG group;
+
+    if (cls < 8)
+        return (cls + 1) << 4;
+
+    group = (cls - 8) >> 2;
+    return (128 << group) + ((32 << group) * (((cls - 8) & 3) + 1));
+}
+
+/* Size that small blocks are really allocated and freed with */
+#define MEMMAG_ROUNDSIZE(size) \
+    ((((size) > 0) && ((size) <= MEMMAG_MAXSIZE)) ? memMagClassSize(memMagClass(size)) : (size))
+
+struct TraceLocation;
+
+APTR memMagAlloc(IPTR byteSize, ULONG flags, struct TraceLocation *loc, struct ExecBase *SysBase);
+BOOL memMagFree(APTR memoryBlock, IPTR byteSize, struct TraceLocation *loc, struct ExecBase *SysBase);
+IPTR memMagAvail(ULONG attributes, struct ExecBase *SysBase);
+
+#endif
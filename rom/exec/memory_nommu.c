@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2018, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: System memory allocator for MMU-less systems.
           Used also as boot-time memory allocator on systems with MMU.
@@ -16,6 +16,9 @@
 #include "exec_intern.h"
 #include "exec_util.h"
 #include "memory.h"
+#if defined(EXEC_MAGAZINES)
+#include "memory_magazine.h"
+#endif
 
 APTR nommu_AllocMem(IPTR byteSize, ULONG flags, struct TraceLocation *loc, struct ExecBase *SysBase)
 {
@@ -23,6 +26,14 @@ APTR nommu_AllocMem(IPTR byteSize, ULONG flags, struct TraceLocation *loc, struc
     struct MemHeader *mh;
     ULONG requirements = flags & MEMF_PHYSICAL_MASK;
 
+#if defined(EXEC_MAGAZINES)
+    /* Small requests are served from the CPU's magazines when possible */
+    byteSize = MEMMAG_ROUNDSIZE(byteSize);
+    res = memMagAlloc(byteSize, flags, loc, SysBase);
+    if (res)
+        return res;
+#endif
+
     /* Protect memory list against other tasks */
     MEM_LOCK;
 
@@ -62,7 +73,18 @@ APTR nommu_AllocAbs(APTR location, IPTR byteSize, struct ExecBase *SysBase)
 {
     struct MemHeader *mh;
     APTR ret = NULL;
-    APTR endlocation = location + byteSize;
+    APTR endlocation;
+    IPTR allocSize = byteSize;
+
+#if defined(EXEC_MAGAZINES)
+    /*
+     * FreeMem() rounds small blocks up to their size class, so take the
+     * slack as well when it is free. AllocAbs() never goes through the
+     * magazines though, and an exact fit must not fail because of it.
+     */
+    allocSize = MEMMAG_ROUNDSIZE(byteSize);
+#endif
+    endlocation = location + byteSize;
 
     /* Protect the memory list from access by other tasks. */
     MEM_LOCK;
@@ -77,7 +99,12 @@ APTR nommu_AllocAbs(APTR location, IPTR byteSize, struct ExecBase *SysBase)
             {
                 if (mhe->mhe_AllocAbs)
                 {
-                    APTR ret = mhe->mhe_AllocAbs(mhe, byteSize, location);
+                    APTR ret = NULL;
+
+                    if (allocSize != byteSize)
+                        ret = mhe->mhe_AllocAbs(mhe, allocSize, location);
+                    if (!ret)
+                        ret = mhe->mhe_AllocAbs(mhe, byteSize, location);
 
                     MEM_UNLOCK;
 
@@ -93,18 +120,21 @@ APTR nommu_AllocAbs(APTR location, IPTR byteSize, struct ExecBase *SysBase)
     /* If no header was found which matched the requirements, just give up. */
     if (mh->mh_Node.ln_Succ)
     {
-        struct MemChunk *p1, *p2, *p3, *p4;
+        struct MemChunk *p1, *p2, *p3, *p4, *p5;
         
         /* Align size to the requirements */
         byteSize += (IPTR)location&(MEMCHUNK_TOTAL - 1);
         byteSize  = (byteSize + MEMCHUNK_TOTAL-1) & ~(MEMCHUNK_TOTAL-1);
+        allocSize += (IPTR)location&(MEMCHUNK_TOTAL - 1);
+        allocSize  = (allocSize + MEMCHUNK_TOTAL-1) & ~(MEMCHUNK_TOTAL-1);
         
         /* Align the location as well */
         location=(APTR)((IPTR)location & ~(MEMCHUNK_TOTAL-1));
         
-        /* Start and end(+1) of the block */
+        /* Start and end(+1) of the block, with and without the size class slack */
         p3=(struct MemChunk *)location;
         p4=(struct MemChunk *)((UBYTE *)p3+byteSize);
+        p5=(struct MemChunk *)((UBYTE *)p3+allocSize);
         
         /*
             The free memory list is only single linked, i.e. to remove
@@ -154,6 +184,13 @@ APTR nommu_AllocAbs(APTR location, IPTR byteSize, struct ExecBase *SysBase)
             /* Found a chunk that fits? */
             if((UBYTE *)p2+p2->mc_Bytes>=(UBYTE *)p4&&p2<=p3)
             {
+                /* Include the slack if this chunk has it */
+                if((UBYTE *)p2+p2->mc_Bytes>=(UBYTE *)p5)
+                {
+                    p4=p5;
+                    byteSize=allocSize;
+                }
+
                 /* Since AllocAbs allocations never allocate/update a ctx, they need to clear it if it exists */
                 mhac_ClearSysCtx(mh, SysBase);
 
@@ -202,6 +239,12 @@ void nommu_FreeMem(APTR memoryBlock, IPTR byteSize, struct TraceLocation *loc, s
     if (!byteSize)
         return;
 
+#if defined(EXEC_MAGAZINES)
+    byteSize = MEMMAG_ROUNDSIZE(byteSize);
+    if (memMagFree(memoryBlock, byteSize, loc, SysBase))
+        return;
+#endif
+
     blockEnd = memoryBlock + byteSize;
 
     /* Protect the memory list from access by other tasks. */
@@ -341,5 +384,10 @@ IPTR nommu_AvailMem(ULONG attributes, struct ExecBase *SysBase)
     /* All done */
     MEM_UNLOCK;
 
+#if defined(EXEC_MAGAZINES)
+    /* Blocks held in magazines are free as well */
+    ret += memMagAvail(attributes, SysBase);
+#endif
+
     return ret;
 }
@@ -0,0 +1,349 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Per-CPU free lists for small pooled blocks.
+*/
+
+#define DEBUG 0
+
+#include <aros/debug.h>
+#include <aros/symbolsets.h>
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <proto/exec.h>
+
+#include <string.h>
+
+#include "exec_intern.h"
+
+#if defined(EXEC_POOLCACHE)
+
+#include <proto/kernel.h>
+
+#include "exec_util.h"
+#include "memory.h"
+
+/*
+ * Return the free lists of the CPU we are running on. Protected pools have
+ * one set per CPU, and must be used in Forbid() so the task stays on it.
+ */
+static inline struct PoolCacheSlot *PoolCacheGetSlot(struct PoolCache *pc, struct ExecBase *SysBase)
+{
+#if defined(__AROSEXEC_SMP__)
+    ULONG cpuNo = 0;
+
+    if (pc->pc_SlotCount > 1)
+    {
+        cpuNo = KrnGetCPUNumber();
+        if (cpuNo >= pc->pc_SlotCount)
+            return NULL;
+    }
+    return &pc->pc_Slot[cpuNo];
+#else
+    return &pc->pc_Slot[0];
+#endif
+}
+
+/* Has the low memory handler asked for this slot to be emptied? */
+static inline BOOL PoolCacheStale(struct PoolCacheSlot *slot, struct ExecBase *SysBase)
+{
+    struct PoolCacheBase *pcb = PrivExecBase(SysBase)->PoolCacheBase;
+
+    return (pcb && (slot->pcs_FlushGen != pcb->pcb_FlushGen)) ? TRUE : FALSE;
+}
+
+/*
+ * Empty the free lists of a slot into heads, one chain per size class.
+ * Must be called with the slot protected like any other access to it.
+ */
+static BOOL PoolCacheDetach(struct PoolCacheSlot *slot, APTR *heads, struct ExecBase *SysBase)
+{
+    struct PoolCacheBase *pcb = PrivExecBase(SysBase)->PoolCacheBase;
+    BOOL found = FALSE;
+    ULONG cls;
+
+    for (cls = 0; cls < POOLCACHE_CLASSES; cls++)
+    {
+        heads[cls] = slot->pcs_Class[cls].pcl_Head;
+        if (heads[cls])
+            found = TRUE;
+        slot->pcs_Class[cls].pcl_Head = NULL;
+        slot->pcs_Class[cls].pcl_Count = 0;
+    }
+    if (pcb)
+        slot->pcs_FlushGen = pcb->pcb_FlushGen;
+
+    return found;
+}
+
+/* Give detached blocks back to the puddles of their pool */
+static IPTR PoolCacheRelease(struct PoolCache *pc, APTR *heads, struct ExecBase *SysBase)
+{
+    struct MemHeaderExt *mhe = pc->pc_PoolHeader;
+    struct TraceLocation tp = CURRENT_LOCATION("FreePooled");
+    IPTR released = 0;
+    APTR memory, next;
+    ULONG cls;
+
+    for (cls = 0; cls < POOLCACHE_CLASSES; cls++)
+    {
+        for (memory = heads[cls]; memory; memory = next)
+        {
+            next = *(APTR *)memory;
+            if (IsManagedMem(mhe))
+            {
+                if (mhe->mhe_Free)
+                    mhe->mhe_Free(mhe, memory, (cls + 1) << 4);
+            }
+            else
+                InternalFreePooled(pc->pc_PoolHeader, memory, (cls + 1) << 4, &tp, SysBase);
+            released += (cls + 1) << 4;
+        }
+    }
+
+    return released;
+}
+
+void PoolCacheCreate(APTR poolHeader, struct Pool *pool, struct ExecBase *SysBase)
+{
+    struct PoolCacheBase *pcb = PrivExecBase(SysBase)->PoolCacheBase;
+    ULONG slots = 1, i;
+
+    pool->Cache = NULL;
+
+    /* Mungwalled blocks carry their own size information */
+    if (PrivExecBase(SysBase)->IntFlags & EXECF_MungWall)
+        return;
+
+#if defined(__AROSEXEC_SMP__)
+    if (pool->Requirements & MEMF_SEM_PROTECTED)
+        slots = KrnGetCPUCount();
+#endif
+
+    pool->Cache = AllocMem(sizeof(struct PoolCache) + slots * sizeof(struct PoolCacheSlot), MEMF_PUBLIC | MEMF_CLEAR);
+    if (pool->Cache)
+    {
+        pool->Cache->pc_PoolHeader = poolHeader;
+        pool->Cache->pc_Pool = pool;
+        pool->Cache->pc_SlotCount = slots;
+
+        if (pcb)
+        {
+            for (i = 0; i < slots; i++)
+                pool->Cache->pc_Slot[i].pcs_FlushGen = pcb->pcb_FlushGen;
+
+            ObtainSemaphore(&pcb->pcb_Lock);
+            AddTail((struct List *)&pcb->pcb_Caches, (struct Node *)&pool->Cache->pc_Node);
+            ReleaseSemaphore(&pcb->pcb_Lock);
+        }
+    }
+
+    D(bug("[PoolCache] Pool 0x%p, cache 0x%p (%u slots)\n", pool, pool->Cache, slots));
+}
+
+/* The cached blocks belong to the puddles, which are freed together with the pool */
+void PoolCacheDelete(struct Pool *pool, struct ExecBase *SysBase)
+{
+    struct PoolCacheBase *pcb = PrivExecBase(SysBase)->PoolCacheBase;
+
+    if (pool->Cache)
+    {
+        if (pool->Cache->pc_Node.mln_Succ)
+        {
+            ObtainSemaphore(&pcb->pcb_Lock);
+            Remove((struct Node *)&pool->Cache->pc_Node);
+            ReleaseSemaphore(&pcb->pcb_Lock);
+        }
+        FreeMem(pool->Cache, sizeof(struct PoolCache) + pool->Cache->pc_SlotCount * sizeof(struct PoolCacheSlot));
+        pool->Cache = NULL;
+    }
+}
+
+/*
+ * Take a block from the free list of its size class. memSize must already
+ * be rounded with POOLCACHE_ROUNDSIZE().
+ */
+APTR PoolCacheAlloc(struct Pool *pool, IPTR memSize, struct ExecBase *SysBase)
+{
+    BOOL protected = (pool->Requirements & MEMF_SEM_PROTECTED) ? TRUE : FALSE;
+    struct PoolCacheSlot *slot;
+    struct PoolCacheList *list;
+    APTR heads[POOLCACHE_CLASSES];
+    BOOL flush = FALSE;
+    APTR ret = NULL;
+
+    if (protected)
+        Forbid();
+
+    slot = PoolCacheGetSlot(pool->Cache, SysBase);
+    if (slot)
+    {
+        if (PoolCacheStale(slot, SysBase))
+            flush = PoolCacheDetach(slot, heads, SysBase);
+
+        list = &slot->pcs_Class[POOLCACHE_CLASS(memSize)];
+        ret = list->pcl_Head;
+        if (ret)
+        {
+            list->pcl_Head = *(APTR *)ret;
+            list->pcl_Count--;
+        }
+    }
+
+    if (protected)
+        Permit();
+
+    if (flush)
+        PoolCacheRelease(pool->Cache, heads, SysBase);
+
+    if (ret && (pool->Requirements & MEMF_CLEAR))
+        memset(ret, 0, memSize);
+
+    D(bug("[PoolCache] Alloc %u bytes from pool 0x%p = 0x%p\n", memSize, pool, ret));
+
+    return ret;
+}
+
+/*
+ * Put a block on the free list of its size class. If the list is already
+ * full, or the CPU has no lists, a chain of blocks the caller has to free
+ * to the pool is returned. The chain is linked through the first word of
+ * each block and NULL terminated.
+ */
+APTR PoolCacheFree(struct Pool *pool, APTR memory, IPTR memSize, struct ExecBase *SysBase)
+{
+    BOOL protected = (pool->Requirements & MEMF_SEM_PROTECTED) ? TRUE : FALSE;
+    struct PoolCacheSlot *slot;
+    struct PoolCacheList *list;
+    APTR heads[POOLCACHE_CLASSES];
+    BOOL flush = FALSE;
+    APTR chain = memory;
+    APTR *last;
+    ULONG count;
+
+    *(APTR *)memory = NULL;
+
+    if (protected)
+        Forbid();
+
+    slot = PoolCacheGetSlot(pool->Cache, SysBase);
+    if (slot)
+    {
+        if (PoolCacheStale(slot, SysBase))
+            flush = PoolCacheDetach(slot, heads, SysBase);
+
+        list = &slot->pcs_Class[POOLCACHE_CLASS(memSize)];
+
+        *(APTR *)memory = list->pcl_Head;
+        list->pcl_Head = memory;
+        chain = NULL;
+
+        if (++list->pcl_Count > POOLCACHE_DEPTH)
+        {
+            /* Hand back the oldest blocks in one batch */
+            last = (APTR *)list->pcl_Head;
+            for (count = 1; count < POOLCACHE_DEPTH - POOLCACHE_BATCH; count++)
+                last = (APTR *)*last;
+
+            chain = *last;
+            *last = NULL;
+            list->pcl_Count = POOLCACHE_DEPTH - POOLCACHE_BATCH;
+        }
+    }
+
+    if (protected)
+        Permit();
+
+    if (flush)
+        PoolCacheRelease(pool->Cache, heads, SysBase);
+
+    D(bug("[PoolCache] Free 0x%p (%u bytes) to pool 0x%p, release 0x%p\n", memory, memSize, pool, chain));
+
+    return chain;
+}
+
+/*
+ * Low memory handler. Empties this CPU's lists of the protected pools that
+ * can be locked without waiting, and makes all other lists be emptied by
+ * their users on their next request.
+ */
+AROS_UFH3S(LONG, PoolCacheLowMemHandler,
+    AROS_UFHA(struct MemHandlerData *, lmhd, A0),
+    AROS_UFHA(APTR, data, A1),
+    AROS_UFHA(struct ExecBase *, SysBase, A6)
+)
+{
+    AROS_USERFUNC_INIT
+
+    struct PoolCacheBase *pcb = data;
+    struct PoolCache *pc;
+    struct PoolCacheSlot *slot;
+    APTR heads[POOLCACHE_CLASSES];
+    IPTR released = 0;
+    BOOL flush;
+
+    pcb->pcb_FlushGen++;
+
+    /*
+     * Never wait here - the task holding a lock may itself be waiting
+     * for the low memory handlers to finish.
+     */
+    if (AttemptSemaphore(&pcb->pcb_Lock))
+    {
+        ForeachNode(&pcb->pcb_Caches, pc)
+        {
+            struct ProtectedPool *pool = (struct ProtectedPool *)pc->pc_Pool;
+
+            /* Other pools may only be touched by the task owning them */
+            if (!(pool->pool.Requirements & MEMF_SEM_PROTECTED))
+                continue;
+            if (!AttemptSemaphore(&pool->sem))
+                continue;
+
+            flush = FALSE;
+            Forbid();
+            slot = PoolCacheGetSlot(pc, SysBase);
+            if (slot)
+                flush = PoolCacheDetach(slot, heads, SysBase);
+            Permit();
+
+            if (flush)
+                released += PoolCacheRelease(pc, heads, SysBase);
+
+            ReleaseSemaphore(&pool->sem);
+        }
+        ReleaseSemaphore(&pcb->pcb_Lock);
+    }
+
+    D(bug("[PoolCache] %s: released %lu bytes\n", __func__, released));
+
+    return released ? MEM_TRY_AGAIN : MEM_DID_NOTHING;
+
+    AROS_USERFUNC_EXIT
+}
+
+static int Exec_InitPoolCache(struct ExecBase *SysBase)
+{
+    struct PoolCacheBase *pcb;
+
+    pcb = AllocMem(sizeof(struct PoolCacheBase), MEMF_PUBLIC | MEMF_CLEAR);
+    if (!pcb)
+        return TRUE;
+
+    NEWLIST(&pcb->pcb_Caches);
+    InitSemaphore(&pcb->pcb_Lock);
+
+    pcb->pcb_LowMemHandler.is_Node.ln_Name = "exec pool caches";
+    pcb->pcb_LowMemHandler.is_Node.ln_Pri = 90;
+    pcb->pcb_LowMemHandler.is_Code = (VOID_FUNC)PoolCacheLowMemHandler;
+    pcb->pcb_LowMemHandler.is_Data = pcb;
+    AddMemHandler(&pcb->pcb_LowMemHandler);
+
+    PrivExecBase(SysBase)->PoolCacheBase = pcb;
+
+    return TRUE;
+}
+
+ADD2INITLIB(Exec_InitPoolCache, 0)
+
+#endif /* EXEC_POOLCACHE */
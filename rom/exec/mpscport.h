@@ -0,0 +1,112 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Lock-free message lists of PF_MPSC ports.
+*/
+#ifndef _MPSCPORT_H_
+#define _MPSCPORT_H_
+
+#include <exec/ports.h>
+
+/*
+ * The message list of a PF_MPSC port is an intrusive multi-producer/
+ * single-consumer queue, linked through ln_Succ. The list header itself
+ * serves as the queue's stub node, so its ln_Succ is lh_Head:
+ *
+ *   lh_TailPred - last node in the queue, swapped in by the producers.
+ *                 A producer that finds the stub there triggers the
+ *                 arrival action.
+ *   lh_Tail     - next node to be returned, only used by the consumer.
+ *
+ * lh_TailPred doesn't tell if the port is empty: the consumer puts the stub
+ * back behind the last message it saw, and a producer may have added one
+ * more in between. The port is empty when the consumer is at the stub and
+ * nothing follows it, which is what IsMsgPortEmpty() tests for PF_MPSC
+ * ports. A producer adding to an empty port always finds the stub in
+ * lh_TailPred, so the consumer can then wait for the arrival signal.
+ *
+ * Producers swap themselves in and link the previous node with interrupts
+ * disabled, so the consumer can only ever see an unlinked node while a
+ * producer on another CPU is between these two steps, and briefly spins.
+ */
+#define MPSC_STUB(port)         ((struct Node *)&(port)->mp_MsgList)
+
+#if defined(__i386__) || defined(__x86_64__)
+#define MPSC_PAUSE()            asm volatile("pause" ::: "memory")
+#else
+#define MPSC_PAUSE()            asm volatile("" ::: "memory")
+#endif
+
+/* Returns TRUE if the port was empty before */
+static inline BOOL MPSCPortPut(struct MsgPort *port, struct Node *node)
+{
+    struct Node *prev;
+
+    __atomic_store_n(&node->ln_Succ, NULL, __ATOMIC_RELAXED);
+    prev = __atomic_exchange_n(&port->mp_MsgList.lh_TailPred, node, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&prev->ln_Succ, node, __ATOMIC_RELEASE);
+
+    return (prev == MPSC_STUB(port));
+}
+
+static inline struct Node *MPSCPortNext(struct Node *node)
+{
+    struct Node *next;
+
+    while (!(next = __atomic_load_n(&node->ln_Succ, __ATOMIC_ACQUIRE)))
+        MPSC_PAUSE();
+
+    return next;
+}
+
+/*
+ * Returns NULL only if the port is empty, or if a producer is just adding
+ * the first message. That producer will trigger the arrival action.
+ */
+static inline struct Message *MPSCPortGet(struct MsgPort *port)
+{
+    struct Node *stub = MPSC_STUB(port);
+    struct Node *tail = port->mp_MsgList.lh_Tail;
+    struct Node *next = __atomic_load_n(&tail->ln_Succ, __ATOMIC_ACQUIRE);
+
+    if (tail == stub)
+    {
+        if (!next)
+            return NULL;
+
+        tail = next;
+        next = __atomic_load_n(&tail->ln_Succ, __ATOMIC_ACQUIRE);
+    }
+
+    if (!next)
+    {
+        /* tail is the last message - put the stub behind it */
+        if (tail == __atomic_load_n(&port->mp_MsgList.lh_TailPred, __ATOMIC_ACQUIRE))
+            MPSCPortPut(port, stub);
+        next = MPSCPortNext(tail);
+    }
+    port->mp_MsgList.lh_Tail = next;
+
+    return (struct Message *)tail;
+}
+
+/* Tells if the next MPSCPortGet() will return NULL. Only used by the consumer. */
+static inline BOOL MPSCPortEmpty(struct MsgPort *port)
+{
+    struct Node *tail = port->mp_MsgList.lh_Tail;
+
+    return ((tail == MPSC_STUB(port)) && !__atomic_load_n(&tail->ln_Succ, __ATOMIC_ACQUIRE));
+}
+
+/* The message the next MPSCPortGet() will return. The port must not be empty. */
+static inline struct Message *MPSCPortFirst(struct MsgPort *port)
+{
+    struct Node *tail = port->mp_MsgList.lh_Tail;
+
+    if (tail == MPSC_STUB(port))
+        tail = MPSCPortNext(tail);
+
+    return (struct Message *)tail;
+}
+
+#endif /* _MPSCPORT_H_ */
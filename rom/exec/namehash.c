@@ -0,0 +1,352 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Name hashed indexes of the public system lists.
+*/
+
+#define DEBUG 0
+
+#include <aros/debug.h>
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <proto/exec.h>
+
+#include <string.h>
+
+#include "exec_intern.h"
+
+#if defined(EXEC_NAMEHASH)
+
+static inline ULONG NameHashString(CONST_STRPTR name)
+{
+    ULONG hash = 2166136261UL;
+
+    while (*name)
+    {
+        hash ^= (UBYTE)*name++;
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+static inline ULONG NameHashNodeBucket(struct Node *node)
+{
+    return ((IPTR)node / sizeof(struct Node)) % NAMEHASH_BUCKETS;
+}
+
+static struct NameHash *NameHashForList(struct List *list, struct ExecBase *SysBase)
+{
+    struct NameHash *nh = PrivExecBase(SysBase)->SysListNames;
+    ULONG i;
+
+    for (i = 0; i < NAMEHASH_COUNT; i++)
+    {
+        if (nh[i].nh_List == list)
+            return &nh[i];
+    }
+
+    return NULL;
+}
+
+static struct NameHash *NameHashForType(UBYTE type, struct ExecBase *SysBase)
+{
+    struct NameHash *nh = PrivExecBase(SysBase)->SysListNames;
+    ULONG i;
+
+    for (i = 0; i < NAMEHASH_COUNT; i++)
+    {
+        if (nh[i].nh_Type == type)
+            return &nh[i];
+    }
+
+    return NULL;
+}
+
+/*
+ * Writers Disable(), so a lookup from an interrupt can never find the table
+ * half changed by the code it interrupted - it would wait for it forever.
+ */
+static inline void NameHashLock(struct NameHash *nh, struct ExecBase *SysBase)
+{
+    Disable();
+#if defined(__AROSEXEC_SMP__)
+    EXEC_SPINLOCK_LOCK(&nh->nh_Lock, NULL, SPINLOCK_MODE_WRITE);
+#endif
+}
+
+static inline void NameHashUnlock(struct NameHash *nh, struct ExecBase *SysBase)
+{
+#if defined(__AROSEXEC_SMP__)
+    EXEC_SPINLOCK_UNLOCK(&nh->nh_Lock);
+#endif
+    Enable();
+}
+
+/* Keeps indexed nodes from being removed, so a hit can be looked at safely */
+static inline void NameHashReadLock(struct NameHash *nh, struct ExecBase *SysBase)
+{
+    Disable();
+#if defined(__AROSEXEC_SMP__)
+    EXEC_SPINLOCK_LOCK(&nh->nh_Lock, NULL, SPINLOCK_MODE_READ);
+#endif
+}
+
+/* The table may only be changed between these two, with the lock held */
+static inline void NameHashWriteBegin(struct NameHash *nh)
+{
+    nh->nh_Sequence++;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void NameHashWriteEnd(struct NameHash *nh)
+{
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    nh->nh_Sequence++;
+}
+
+/* Only a writer on another CPU can be in progress here, see NameHashLock() */
+static inline ULONG NameHashReadBegin(struct NameHash *nh)
+{
+    ULONG seq;
+
+    while ((seq = __atomic_load_n(&nh->nh_Sequence, __ATOMIC_ACQUIRE)) & 1)
+        ;
+
+    return seq;
+}
+
+static inline BOOL NameHashReadChanged(struct NameHash *nh, ULONG seq)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return (nh->nh_Sequence != seq);
+}
+
+/* Take the entry of a node out of both chains. Called in NameHashWriteBegin/End. */
+static struct NameHashEntry *NameHashUnlink(struct NameHash *nh, struct Node *node)
+{
+    struct NameHashEntry **pnhe, *nhe = NULL;
+
+    for (pnhe = &nh->nh_NodeBucket[NameHashNodeBucket(node)]; *pnhe; pnhe = &(*pnhe)->nhe_NodeNext)
+    {
+        if ((*pnhe)->nhe_Node == node)
+        {
+            nhe = *pnhe;
+            *pnhe = nhe->nhe_NodeNext;
+            break;
+        }
+    }
+
+    if (nhe)
+    {
+        for (pnhe = &nh->nh_Bucket[nhe->nhe_Hash % NAMEHASH_BUCKETS]; *pnhe; pnhe = &(*pnhe)->nhe_Next)
+        {
+            if (*pnhe == nhe)
+            {
+                *pnhe = nhe->nhe_Next;
+                break;
+            }
+        }
+    }
+
+    return nhe;
+}
+
+void NameHashInit(struct ExecBase *SysBase)
+{
+    struct NameHash *nh = PrivExecBase(SysBase)->SysListNames;
+    ULONG i;
+
+    nh[NAMEHASH_LIBRARIES].nh_List      = &SysBase->LibList;
+    nh[NAMEHASH_LIBRARIES].nh_Type      = NT_LIBRARY;
+    nh[NAMEHASH_DEVICES].nh_List        = &SysBase->DeviceList;
+    nh[NAMEHASH_DEVICES].nh_Type        = NT_DEVICE;
+    nh[NAMEHASH_RESOURCES].nh_List      = &SysBase->ResourceList;
+    nh[NAMEHASH_RESOURCES].nh_Type      = NT_RESOURCE;
+    nh[NAMEHASH_PORTS].nh_List          = &SysBase->PortList;
+    nh[NAMEHASH_PORTS].nh_Type          = NT_MSGPORT;
+    nh[NAMEHASH_SEMAPHORES].nh_List     = &SysBase->SemaphoreList;
+    nh[NAMEHASH_SEMAPHORES].nh_Type     = NT_SIGNALSEM;
+
+    for (i = 0; i < NAMEHASH_COUNT; i++)
+    {
+        nh[i].nh_Sequence = 0;
+#if defined(__AROSEXEC_SMP__)
+        EXEC_SPINLOCK_INIT(&nh[i].nh_Lock);
+#endif
+    }
+}
+
+/*
+ * Index a node that has just been added to a system list. Must be called
+ * in Forbid(), but without holding the list lock, as it may need to allocate
+ * memory.
+ */
+void NameHashAdd(struct List *list, struct Node *node, struct ExecBase *SysBase)
+{
+    struct NameHash *nh = NameHashForList(list, SysBase);
+    struct NameHashEntry *nhe;
+    ULONG bucket;
+
+    if (!nh || !node->ln_Name)
+        return;
+
+    NameHashLock(nh, SysBase);
+    NameHashWriteBegin(nh);
+    /* A node that is added again reuses its old entry */
+    nhe = NameHashUnlink(nh, node);
+    NameHashWriteEnd(nh);
+    if (!nhe && (nhe = nh->nh_Free) != NULL)
+        nh->nh_Free = nhe->nhe_Next;
+    NameHashUnlock(nh, SysBase);
+
+    if (!nhe)
+    {
+        /* The node can still be found in the list if this fails */
+        nhe = AllocMem(sizeof(struct NameHashEntry), MEMF_PUBLIC);
+        if (!nhe)
+            return;
+    }
+
+    nhe->nhe_Node = node;
+    nhe->nhe_Hash = NameHashString(node->ln_Name);
+    bucket = nhe->nhe_Hash % NAMEHASH_BUCKETS;
+
+    NameHashLock(nh, SysBase);
+    NameHashWriteBegin(nh);
+    nhe->nhe_Next = nh->nh_Bucket[bucket];
+    nh->nh_Bucket[bucket] = nhe;
+    nhe->nhe_NodeNext = nh->nh_NodeBucket[NameHashNodeBucket(node)];
+    nh->nh_NodeBucket[NameHashNodeBucket(node)] = nhe;
+    NameHashWriteEnd(nh);
+    NameHashUnlock(nh, SysBase);
+
+    D(bug("[NameHash] Added 0x%p '%s' to list 0x%p\n", node, node->ln_Name, list));
+}
+
+/*
+ * Drop a node from the index. This is called by Remove() for every node
+ * with a type that is indexed, so nodes that are in no system list have to
+ * be rejected quickly.
+ */
+void NameHashRemove(struct Node *node, struct ExecBase *SysBase)
+{
+    struct NameHash *nh = NameHashForType(node->ln_Type, SysBase);
+    struct NameHashEntry *nhe;
+    ULONG seq;
+    BOOL indexed;
+
+    if (!nh)
+        return;
+
+    do
+    {
+        seq = NameHashReadBegin(nh);
+        indexed = FALSE;
+        for (nhe = nh->nh_NodeBucket[NameHashNodeBucket(node)]; nhe; nhe = nhe->nhe_NodeNext)
+        {
+            if (nhe->nhe_Node == node)
+            {
+                indexed = TRUE;
+                break;
+            }
+            if (nh->nh_Sequence != seq)
+                break;
+        }
+    } while (NameHashReadChanged(nh, seq));
+
+    if (!indexed)
+        return;
+
+    NameHashLock(nh, SysBase);
+    NameHashWriteBegin(nh);
+    nhe = NameHashUnlink(nh, node);
+    if (nhe)
+    {
+        nhe->nhe_Node = NULL;
+        nhe->nhe_Next = nh->nh_Free;
+        nh->nh_Free = nhe;
+    }
+    NameHashWriteEnd(nh);
+    NameHashUnlock(nh, SysBase);
+
+    D(bug("[NameHash] Removed 0x%p\n", node));
+}
+
+/*
+ * Look up a name in the index of a system list. Returns NULL if the list has
+ * no index, the name is not known or used by more than one node - the caller
+ * then has to search the list itself, so it finds the first node with the
+ * name, as FindName() does.
+ */
+struct Node *NameHashFind(struct List *list, CONST_STRPTR name, struct ExecBase *SysBase)
+{
+    struct NameHash *nh;
+    struct NameHashEntry *nhe;
+    struct Node *node, *found;
+    ULONG hash, seq, matches;
+    BOOL changed;
+
+    if (!name || !(nh = NameHashForList(list, SysBase)))
+        return NULL;
+
+    hash = NameHashString(name);
+
+    do
+    {
+        /*
+         * The chains are followed without touching the nodes, which may
+         * be gone already if the table changes under us.
+         */
+        do
+        {
+            seq = NameHashReadBegin(nh);
+            found = NULL;
+            matches = 0;
+
+            for (nhe = nh->nh_Bucket[hash % NAMEHASH_BUCKETS]; nhe; nhe = nhe->nhe_Next)
+            {
+                node = nhe->nhe_Node;
+                if (node && (nhe->nhe_Hash == hash))
+                {
+                    found = node;
+                    matches++;
+                }
+
+                if (nh->nh_Sequence != seq)
+                    break;
+            }
+        } while (NameHashReadChanged(nh, seq));
+
+        if (matches != 1)
+        {
+            found = NULL;
+            break;
+        }
+
+        /*
+         * Remove() drops the entry before it unlinks the node, so if the
+         * table is still unchanged with the lock held, the node can not go
+         * away before we are done with it.
+         */
+        NameHashReadLock(nh, SysBase);
+        changed = NameHashReadChanged(nh, seq);
+        if (!changed)
+        {
+            /* Only trust nodes that are still linked and still carry the name */
+            if ((found->ln_Type != nh->nh_Type) ||
+                !found->ln_Pred || (found->ln_Pred->ln_Succ != found) ||
+                !found->ln_Name || strcmp(found->ln_Name, name))
+            {
+                found = NULL;
+            }
+        }
+        NameHashUnlock(nh, SysBase);
+    } while (changed);
+
+    D(bug("[NameHash] '%s' in list 0x%p: 0x%p (%u)\n", name, list, found, matches));
+
+    return found;
+}
+
+#endif /* EXEC_NAMEHASH */
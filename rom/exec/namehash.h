@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Name hashed indexes of the public system lists.
+*/
+#ifndef _NAMEHASH_H_
+#define _NAMEHASH_H_
+
+#include <exec/lists.h>
+#include <exec/nodes.h>
+
+#if defined(__AROSEXEC_SMP__)
+#include <aros/types/spinlock_s.h>
+#endif
+
+/*
+ * LibList, DeviceList, ResourceList, PortList and SemaphoreList are indexed
+ * by node name, so OpenLibrary(), FindPort() and friends don't have to walk
+ * and strcmp() the whole list.
+ *
+ * The index only holds hints. A node that is found is checked to still be
+ * linked, of the right type and carry the requested name, and anything the
+ * index doesn't know about (nodes added by code that doesn't use the exec
+ * functions, duplicate names) is looked up in the list itself. This keeps
+ * the lists themselves - and the rules for using them - unchanged. Only a
+ * node added behind exec's back that has the same name as an indexed one
+ * can be shadowed by it.
+ *
+ * Lookups follow the bucket chains without a lock. Writers bump nh_Sequence
+ * before and after changing the table with interrupts disabled, and readers
+ * retry when it changed under them. Entries are never freed, only reused, so
+ * a reader can always follow the chains. The one node found is then checked
+ * holding nh_Lock for reading, which keeps it from being removed meanwhile.
+ */
+#define NAMEHASH_BUCKETS        64
+
+#define NAMEHASH_LIBRARIES      0
+#define NAMEHASH_DEVICES        1
+#define NAMEHASH_RESOURCES      2
+#define NAMEHASH_PORTS          3
+#define NAMEHASH_SEMAPHORES     4
+#define NAMEHASH_COUNT          5
+
+struct NameHashEntry
+{
+    struct NameHashEntry        *nhe_Next;                      /* Next entry in the name bucket                */
+    struct NameHashEntry        *nhe_NodeNext;                  /* Next entry in the node address bucket        */
+    struct Node                 *nhe_Node;
+    ULONG                       nhe_Hash;
+};
+
+struct NameHash
+{
+    struct List                 *nh_List;                       /* The list this table indexes                  */
+    UBYTE                       nh_Type;                        /* ln_Type of the nodes in the list             */
+    volatile ULONG              nh_Sequence;                    /* Odd while the table is being changed         */
+#if defined(__AROSEXEC_SMP__)
+    spinlock_t                  nh_Lock;                        /* Held by writers, and by readers checking a hit */
+#endif
+    struct NameHashEntry        *nh_Free;                       /* Entries not in use                           */
+    struct NameHashEntry        *nh_Bucket[NAMEHASH_BUCKETS];
+    struct NameHashEntry        *nh_NodeBucket[NAMEHASH_BUCKETS];
+};
+
+#if defined(EXEC_NAMEHASH)
+void NameHashInit(struct ExecBase *SysBase);
+void NameHashAdd(struct List *list, struct Node *node, struct ExecBase *SysBase);
+void NameHashRemove(struct Node *node, struct ExecBase *SysBase);
+struct Node *NameHashFind(struct List *list, CONST_STRPTR name, struct ExecBase *SysBase);
+#else
+#define NameHashInit(sysBase)
+#define NameHashAdd(list, node, sysBase)
+#define NameHashRemove(node, sysBase)
+#define NameHashFind(list, name, sysBase)       (NULL)
+#endif
+
+#endif
@@ -33,7 +33,7 @@ static void TaskLaunch(struct Task *parent, struct Task *task, struct Hook *plHo
     /* Add the new task to the ready list. */
 #if !defined(__AROSEXEC_SMP__)
     task->tc_State = TS_READY;
-    Enqueue(&SysBase->TaskReady, &task->tc_Node);
+    EXEC_READYTASK(task);
 #else
     task->tc_State = TS_INVALID;
     krnSysCallReschedTask(task, TS_READY);
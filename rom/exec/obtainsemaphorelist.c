@@ -75,6 +75,8 @@
 
     ForeachNode(sigSem, ss)
     {
+        SEMAPHORE_LOCK_SPIN(ss);
+
         /* QueueCount == -1 means unlocked */
         ss->ss_QueueCount++;
         if(ss->ss_QueueCount != 0)
@@ -107,6 +109,8 @@
             ss->ss_NestCount++;
             ss->ss_Owner = ThisTask;
         }
+
+        SEMAPHORE_UNLOCK_SPIN(ss);
     }
 
     if(failedObtain > 0)
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Open a device.
 */
@@ -58,6 +58,9 @@
         (EXT.W D0 + EXT.L D0) DoIO() and WaitIO() do the same.
         Many programs assume LONG return code, even some WB utilities.
 
+        Requests with a PF_MPSC reply port (see NEWMPSCPORT()) fail with
+        IOERR_OPENFAIL, as WaitIO() can't take them out of such a port.
+
     EXAMPLE
 
     BUGS
@@ -89,15 +92,31 @@
     D(bug("[exec] OpenDevice(\"%s\", %ld, 0x%p, %d) by \"%s\"\n", devName, unitNumber, iORequest,
           flags, GET_THIS_TASK->tc_Node.ln_Name));
 
-    /* Arbitrate for the device list */
-    EXEC_LOCK_LIST_READ_AND_FORBID(&SysBase->DeviceList);
+    if (iORequest->io_Message.mn_ReplyPort &&
+        (iORequest->io_Message.mn_ReplyPort->mp_Flags & PF_MPSC))
+    {
+        iORequest->io_Device = NULL;
+        iORequest->io_Error = IOERR_OPENFAIL;
+
+        return iORequest->io_Error;
+    }
+
+    Forbid();
 
     /* Look for the device in our list */
     iORequest->io_Unit   = NULL;
 
-    iORequest->io_Device = (struct Device *)FindName(&SysBase->DeviceList, devName);
+    /* Try the name index first, it needs no lock */
+    iORequest->io_Device = (struct Device *)NameHashFind(&SysBase->DeviceList, devName, SysBase);
+    if (!iORequest->io_Device)
+    {
+        /* Arbitrate for the device list */
+        EXEC_LOCK_LIST_READ(&SysBase->DeviceList);
+
+        iORequest->io_Device = (struct Device *)FindName(&SysBase->DeviceList, devName);
 
-    EXEC_UNLOCK_LIST(&SysBase->DeviceList);
+        EXEC_UNLOCK_LIST(&SysBase->DeviceList);
+    }
 
     D(bug("[OpenDevice] Found resident 0x%p\n", iORequest->io_Device));
 
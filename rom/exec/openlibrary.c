@@ -61,13 +61,20 @@
 
     DRAMLIB("OpenLibrary(\"%s\", %ld)", libName, version);
 
-    /* Arbitrate for the library list */
-    EXEC_LOCK_LIST_READ_AND_FORBID(&SysBase->LibList);
-    
-    /* Look for the library in our list */
-    library = (struct Library *) FindName (&SysBase->LibList, libName);
+    Forbid();
 
-    EXEC_UNLOCK_LIST(&SysBase->LibList);
+    /* Try the name index first, it needs no lock */
+    library = (struct Library *)NameHashFind(&SysBase->LibList, libName, SysBase);
+    if (!library)
+    {
+        /* Arbitrate for the library list */
+        EXEC_LOCK_LIST_READ(&SysBase->LibList);
+
+        /* Look for the library in our list */
+        library = (struct Library *) FindName (&SysBase->LibList, libName);
+
+        EXEC_UNLOCK_LIST(&SysBase->LibList);
+    }
 
     /* Something found ? */
     if(library!=NULL)
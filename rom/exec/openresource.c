@@ -52,6 +52,11 @@
 
     APTR resource;
 
+    /* Try the name index first, it needs no lock */
+    resource = (APTR)NameHashFind(&SysBase->ResourceList, resName, SysBase);
+    if (resource)
+        return resource;
+
     /* Arbitrate for the resource list */
     EXEC_LOCK_LIST_READ_AND_FORBID(&SysBase->ResourceList);
 
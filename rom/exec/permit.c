@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Permit() - Allow tasks switches to occur.
 */
@@ -88,6 +88,12 @@
 
     if (KernelBase && !KrnIsSuper())
     {
+#if defined(EXEC_FLUSHWAKEUPS)
+        /* Send the wakeups for other CPUs that were held back during Forbid() */
+        if (TDNESTCOUNT_GET < 0)
+            EXEC_FLUSHWAKEUPS();
+
+#endif
         if(    ( TDNESTCOUNT_GET < 0 )
             && ( IDNESTCOUNT_GET < 0 )
             && ( FLAG_SCHEDSWITCH_ISSET ) )
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2023, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Sets up the ExecBase a bit. (Mostly clearing).
 */
@@ -36,6 +36,9 @@
 #if defined(__AROSEXEC_SMP__)
 extern struct Library *ExecLock__PrepareBase(struct MemHeader *);
 #endif
+#if defined(EXEC_TRACING)
+extern struct Library *ExecTrace__PrepareBase(struct MemHeader *);
+#endif
 
 extern void *LIBFUNCTABLE[];
 
@@ -271,6 +274,9 @@ struct ExecBase *PrepareExecBase(struct MemHeader *mh, struct TagItem *msg)
 #endif
     NEWLIST(&SysBase->TaskReady);
     SysBase->TaskReady.lh_Type = NT_TASK;
+#if defined(EXEC_RUNQUEUE)
+    krnRunQueueInit(&PrivExecBase(SysBase)->TaskReadyQueue);
+#endif
 
 #if defined(__AROSEXEC_SMP__)
     EXEC_SPINLOCK_INIT(&PrivExecBase(SysBase)->TaskWaitSpinLock);
@@ -280,10 +286,13 @@ struct ExecBase *PrepareExecBase(struct MemHeader *mh, struct TagItem *msg)
 
 #if defined(__AROSEXEC_SMP__)
     EXEC_SPINLOCK_INIT(&PrivExecBase(SysBase)->SemListSpinLock);
+    EXEC_SPINLOCK_INIT(&PrivExecBase(SysBase)->SemaphoreExtLock);
 #endif
     NEWLIST(&SysBase->SemaphoreList);
     SysBase->SemaphoreList.lh_Type = NT_SEMAPHORE;
 
+    NameHashInit(SysBase);
+
     NEWLIST(&SysBase->ex_MemHandlers);
 
     for (i = 0; i < 5; i++)
@@ -363,6 +372,9 @@ struct ExecBase *PrepareExecBase(struct MemHeader *mh, struct TagItem *msg)
 #if defined(__AROSEXEC_SMP__)
     PrivExecBase(SysBase)->ExecLockBase = NULL;
     PrivExecBase(SysBase)->ExecLockBase = ExecLock__PrepareBase(mh);
+#endif
+#if defined(EXEC_TRACING)
+    ExecTrace__PrepareBase(mh);
 #endif
     PrivExecBase(SysBase)->SupervisorDeadEndCnt = 0;
 
@@ -66,7 +66,7 @@
         bidMsg->ssm_Semaphore = (struct SignalSemaphore *)GET_THIS_TASK;
 
     /* Arbitrate for the semaphore structure - following like ObtainSema() */
-    Forbid();
+    SEMAPHORE_LOCK(sigSem);
 
     sigSem->ss_QueueCount++;
     /*
@@ -124,7 +124,7 @@
         AddTail((struct List *)&sigSem->ss_WaitQueue, (struct Node *)bidMsg);
     }
     /* All done. */
-    Permit();
+    SEMAPHORE_UNLOCK(sigSem);
 
     return 0;
 
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Send a message to a port.
 */
@@ -13,6 +13,8 @@
 
 #include "exec_intern.h"
 #include "exec_util.h"
+#include "exec_trace.h"
+#include "mpscport.h"
 
 /*****************************************************************************
 
@@ -45,6 +47,9 @@
         Messages may either trigger a signal at the owner of the messageport
         or raise a software interrupt, depending on port->mp_Flags&PF_ACTION.
 
+        On PF_MPSC ports (see NEWMPSCPORT()) this only happens when the
+        port was empty.
+
     EXAMPLE
 
     BUGS
@@ -76,20 +81,38 @@ void InternalPutMsg(struct MsgPort *port, struct Message *message, struct ExecBa
      * the message list of the message port must be protected
      * with Disable() for the local core, and also a spinlock
      * on smp systems.
+     * Lock-free ports only need Disable() to keep the queue
+     * operation from being interrupted, and the port owner only
+     * has to be woken up if the port was empty.
      */
 
     D(bug("[EXEC] PutMsg: Port @ 0x%p, Msg @ 0x%p\n", port, message);)
+    EXEC_TRACE(ETF_MESSAGE, ETT_PUTMSG, port, message);
+
+    if (port->mp_Flags & PF_MPSC)
+    {
+        BOOL wasEmpty;
+
+        Disable();
+        wasEmpty = MPSCPortPut(port, &message->mn_Node);
+        Enable();
 
-    Disable();
+        if (!wasEmpty)
+            return;
+    }
+    else
+    {
+        Disable();
 #if defined(__AROSEXEC_SMP__)
-    EXEC_SPINLOCK_LOCK(&port->mp_SpinLock, NULL, SPINLOCK_MODE_WRITE);
+        EXEC_SPINLOCK_LOCK(&port->mp_SpinLock, NULL, SPINLOCK_MODE_WRITE);
 #endif
-    AddTail(&port->mp_MsgList, &message->mn_Node);
-    D(bug("[EXEC] PutMsg: Port MsgList->lh_TailPred =  0x%p\n", port->mp_MsgList.lh_TailPred);)
+        AddTail(&port->mp_MsgList, &message->mn_Node);
+        D(bug("[EXEC] PutMsg: Port MsgList->lh_TailPred =  0x%p\n", port->mp_MsgList.lh_TailPred);)
 #if defined(__AROSEXEC_SMP__)
-    EXEC_SPINLOCK_UNLOCK(&port->mp_SpinLock);
+        EXEC_SPINLOCK_UNLOCK(&port->mp_SpinLock);
 #endif
-    Enable();
+        Enable();
+    }
 
     if (port->mp_SigTask)
     {
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2015, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Release a semaphore.
 */
@@ -11,8 +11,6 @@
 #include "exec_util.h"
 #include "semaphores.h"
 
-#define CHECK_TASK      0 /* it seems to be legal to call ObtainSemaphore in one task and ReleaseSemaphore in another */
-
 /*****************************************************************************/
 #undef  Exec
 #ifdef UseExecstubs
@@ -59,147 +57,8 @@
     AROS_LIBFUNC_INIT
 
     struct TraceLocation tp = CURRENT_LOCATION("ReleaseSemaphore");
-    struct Task *ThisTask = GET_THIS_TASK;
-
-    /* We can be called from within exec's pre-init code. It's okay. */
-    if (!ThisTask)
-        return;
-
-    if (ThisTask->tc_State == TS_REMOVED)
-        return;
-
-    if (!CheckSemaphore(sigSem, &tp, SysBase))
-        return;
-
-    /* Protect the semaphore structure from multiple access. */
-    Forbid();
-
-    /* Release one on the nest count */
-    sigSem->ss_NestCount--;
-    sigSem->ss_QueueCount--;
-
-    if(sigSem->ss_NestCount == 0)
-    {
-        /*
-            There are two cases here. Either we are a shared
-            semaphore, or not. If we are not, make sure that the
-            correct Task is calling ReleaseSemaphore()
-        */
-
-#if CHECK_TASK
-        if (sigSem->ss_Owner != NULL && sigSem->ss_Owner != ThisTask)
-        {
-            /*
-                If it is not, there is a chance that the semaphore
-                is corrupt. It will be afterwards anyway :-)
-            */
-            Alert( AN_SemCorrupt );
-        }
-#endif
 
-        /*
-            Do not try and wake anything unless there are a number
-            of tasks waiting. We do both the tests, this is another
-            opportunity to throw an alert if there is an error.
-        */
-        if(
-            sigSem->ss_QueueCount >= 0
-         && sigSem->ss_WaitQueue.mlh_Head->mln_Succ != NULL
-        )
-        {
-            struct SemaphoreRequest *sr, *srn;
-
-            /*
-                Look at the first node, but only to see whether it
-                is shared or not.
-            */
-            sr = (struct SemaphoreRequest *)sigSem->ss_WaitQueue.mlh_Head;
-
-            /*
-                A node is shared if the ln_Name/sr_Waiter field is
-                odd (ie it has bit 1 set).
-
-                If the sr_Waiter field is != NULL, then this is a
-                task waiting, otherwise it is a message.
-            */
-            if( ((IPTR)sr->sr_Waiter & SM_SHARED) == SM_SHARED )
-            {
-                /* This is a shared lock, so ss_Owner == NULL */
-                sigSem->ss_Owner = NULL;
-
-                /* Go through all the nodes to find the shared ones */
-                ForeachNodeSafe( &sigSem->ss_WaitQueue, sr, srn)
-                {
-                    srn = (struct SemaphoreRequest *)sr->sr_Link.mln_Succ;
-
-                    if( ((IPTR)sr->sr_Waiter & SM_SHARED) == SM_SHARED )
-                    {
-                        Remove((struct Node *)sr);
-
-                        /* Clear the bit, and update the owner count */
-                        sr->sr_Waiter = (APTR)((IPTR)sr->sr_Waiter & ~1);
-                        sigSem->ss_NestCount++;
-
-                        if(sr->sr_Waiter != NULL)
-                        {
-                            /* This is a task, signal it */
-                            Signal(sr->sr_Waiter, SIGF_SINGLE);
-                        }
-                        else
-                        {
-                            /* This is a message, send it back to its owner */
-                            ((struct SemaphoreMessage *)sr)->ssm_Semaphore = sigSem;
-                            ReplyMsg((struct Message *)sr);
-                        }
-                    }
-                }
-            }
-
-            /*  This is an exclusive lock - awaken first node */
-            else
-            {
-                /* Save typing */
-                struct SemaphoreMessage *sm = (struct SemaphoreMessage *)sr;
-
-                /* Only awaken the first of the nodes */
-                Remove((struct Node *)sr);
-                sigSem->ss_NestCount++;
-
-                if(sr->sr_Waiter != NULL)
-                {
-                    sigSem->ss_Owner = sr->sr_Waiter;
-                    Signal(sr->sr_Waiter, SIGF_SINGLE);
-                }
-                else
-                {
-                    sigSem->ss_Owner = (struct Task *)sm->ssm_Semaphore;
-                    sm->ssm_Semaphore = sigSem;
-                    ReplyMsg((struct Message *)sr);
-                }
-            }
-        } /* there are waiters */
-
-        /*  Otherwise, there are not tasks waiting. */
-        else
-        {
-            sigSem->ss_Owner = NULL;
-            sigSem->ss_QueueCount = -1;
-
-            D(bug("ReleaseSemaphore(): No tasks - ss_NestCount == %ld\n",
-                sigSem->ss_NestCount);)
-        }
-    }
-    else if(sigSem->ss_NestCount < 0)
-    {
-        /*
-            This can't happen. It means that somebody has released
-            more times than they have obtained.
-        */
-        Alert( AN_SemCorrupt );
-    }
-
-    /* All done. */
-    Permit();
+    InternalReleaseSemaphore(sigSem, &tp, SysBase);
 
     AROS_LIBFUNC_EXIT
 } /* ReleaseSemaphore */
@@ -6,6 +6,8 @@
 
 #include <aros/debug.h>
 
+#include "exec_intern.h"
+
 /*****************************************************************************
 
     NAME */
@@ -54,6 +56,20 @@
     */
     ASSERT(node != NULL);
 
+#if defined(EXEC_NAMEHASH)
+    /* Nodes of the public system lists are also dropped from their name index */
+    switch (node->ln_Type)
+    {
+    case NT_LIBRARY:
+    case NT_DEVICE:
+    case NT_RESOURCE:
+    case NT_MSGPORT:
+    case NT_SIGNALSEM:
+        NameHashRemove(node, SysBase);
+        break;
+    }
+#endif
+
     /*
         Just bend the pointers around the node, ie. we make our
         predecessor point to our successor and vice versa
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Semaphore internal handling
 */
@@ -8,11 +8,16 @@
 
 #include <aros/atomic.h>
 #include <aros/debug.h>
+#include <exec/memory.h>
 #include <proto/exec.h>
 
+#include <string.h>
+
 #include "exec_util.h"
 #include "semaphores.h"
 
+#define CHECK_TASK      0 /* it seems to be legal to call ObtainSemaphore in one task and ReleaseSemaphore in another */
+
 BOOL CheckSemaphore(struct SignalSemaphore *sigSem, struct TraceLocation *caller, struct ExecBase *SysBase)
 {
     /* TODO: Introduce AlertContext for this */
@@ -46,33 +51,125 @@ BOOL CheckSemaphore(struct SignalSemaphore *sigSem, struct TraceLocation *caller
     return TRUE;
 }
 
-void InternalObtainSemaphore(struct SignalSemaphore *sigSem, struct Task *owner, struct TraceLocation *caller, struct ExecBase *SysBase)
+#if defined(__AROSEXEC_SMP__)
+
+/* Contention statistics are only kept for SEMF_STATS semaphores, and their totals */
+#define SEMAPHORE_STAT(sx, field, val) \
+    do { \
+        if ((sx) && ((sx)->sx_Flags & SEMF_STATS)) \
+        { \
+            __atomic_fetch_add(&PrivExecBase(SysBase)->SemaphoreStats.field, (val), __ATOMIC_RELAXED); \
+            __atomic_fetch_add(&(sx)->sx_Stats.field, (val), __ATOMIC_RELAXED); \
+        } \
+    } while (0)
+
+static inline ULONG SemaphoreExtBucket(struct SignalSemaphore *sigSem)
 {
-    struct Task *ThisTask = GET_THIS_TASK;
+    return ((IPTR)sigSem >> 4) % SEMAPHOREEXT_BUCKETS;
+}
 
-    /*
-     * If there's no ThisTask, the function is called from within memory
-     * allocator in exec's pre-init code. We are already single-threaded,
-     * just return. :)
-     */
-    if (!ThisTask)
-        return;
+struct SemaphoreExt *SemaphoreExtFind(struct SignalSemaphore *sigSem, struct ExecBase *SysBase)
+{
+    struct SemaphoreExt *sx;
 
-    /*
-     * Freeing memory during RemTask(NULL). We are already single-threaded by
-     * Forbid(), and waiting isn't possible because task context is being deallocated.
-     */
-    if (ThisTask->tc_State == TS_REMOVED)
+    sx = __atomic_load_n(&PrivExecBase(SysBase)->SemaphoreExt[SemaphoreExtBucket(sigSem)], __ATOMIC_ACQUIRE);
+    for (; sx; sx = sx->sx_Next)
+    {
+        if (__atomic_load_n(&sx->sx_Semaphore, __ATOMIC_ACQUIRE) == sigSem)
+            return sx;
+    }
+
+    return NULL;
+}
+
+/*
+ * Is the task owning a semaphore running on another CPU? Called with the
+ * semaphore locked, so the owner can't be gone yet.
+ */
+static inline BOOL SemaphoreOwnerRunning(struct Task *owner, IPTR *ownerCpu, struct ExecBase *SysBase)
+{
+    struct IntETask *iet;
+
+    if (!owner || (owner->tc_State != TS_RUN))
+        return FALSE;
+
+    iet = GetIntETask(owner);
+    if (!iet)
+        return FALSE;
+
+    *ownerCpu = iet->iet_CpuNumber;
+
+    return (*ownerCpu != KrnGetCPUNumber());
+}
+
+/*
+ * Spin until the semaphore is released, or its owner stops running. Called
+ * without the semaphore locked and outside of Forbid(), so the spinning task
+ * can still be preempted - and the owner may release the semaphore and exit
+ * at any time, so it must not be dereferenced here.
+ */
+static void SemaphoreSpin(struct SignalSemaphore *sigSem, struct Task *owner, IPTR ownerCpu, ULONG limit, struct ExecBase *SysBase)
+{
+    ULONG spins;
+#if !defined(EXEC_TASKRUNNINGON)
+    UBYTE state;
+#endif
+
+    for (spins = 0; spins < limit; spins++)
+    {
+        SEMAPHORE_SPIN_PAUSE();
+
+        if (*(volatile WORD *)&sigSem->ss_QueueCount == -1)
+            break;
+        if (*(struct Task * volatile *)&sigSem->ss_Owner != owner)
+            break;
+#if defined(EXEC_TASKRUNNINGON)
+        if (!EXEC_TASKRUNNINGON(ownerCpu, owner))
+            break;
+#else
+        /* The state read is only good if the task still owned the semaphore afterwards */
+        state = *(volatile UBYTE *)&owner->tc_State;
+        if ((*(struct Task * volatile *)&sigSem->ss_Owner != owner) || (state != TS_RUN))
+            break;
+#endif
+    }
+}
+
+/* Shorten the spin limit of a semaphore when spinning didn't pay off, and lengthen it when it did */
+static inline void SemaphoreSpinAdapt(struct SemaphoreExt *sx, BOOL acquired)
+{
+    if (!sx)
         return;
 
-    if (!CheckSemaphore(sigSem, caller, SysBase))
-        return;  /* A crude attempt to recover... */
+    if (acquired)
+    {
+        if (sx->sx_SpinLimit < SEMAPHORE_SPIN_MAX)
+            sx->sx_SpinLimit <<= 1;
+    }
+    else if (sx->sx_SpinLimit > SEMAPHORE_SPIN_MIN)
+        sx->sx_SpinLimit >>= 1;
+}
+
+#endif /* __AROSEXEC_SMP__ */
+
+/*
+ * The semaphore logic itself. 'owner' is ThisTask for exclusive obtains and
+ * NULL for shared ones. 'sx' is the SemaphoreExt of the semaphore, if it has
+ * one.
+ */
+static void SemaphoreObtain(struct SignalSemaphore *sigSem, struct Task *ThisTask, struct Task *owner, struct SemaphoreExt *sx, struct ExecBase *SysBase)
+{
+#if defined(__AROSEXEC_SMP__)
+    struct Task *spinOwner;
+    IPTR spinCpu = 0;
+    UQUAD start = 0;
+    BOOL acquired;
+#endif
 
     /*
      * Arbitrate for the semaphore structure.
-     * TODO: SMP-aware versions of this code likely need to use spinlocks here
      */
-    Forbid();
+    SEMAPHORE_LOCK(sigSem);
 
     /*
      * ss_QueueCount == -1 indicates that the semaphore is
@@ -81,11 +178,43 @@ void InternalObtainSemaphore(struct SignalSemaphore *sigSem, struct Task *owner,
      */
     sigSem->ss_QueueCount++;
 
+#if defined(__AROSEXEC_SMP__)
+    if ((sigSem->ss_QueueCount != 0) && (sigSem->ss_Owner != ThisTask) && (sigSem->ss_Owner != owner))
+    {
+        SEMAPHORE_STAT(sx, sst_Contended, 1);
+
+        /*
+         * An owner that is running on another CPU is likely to release the
+         * semaphore soon, so spin for a while instead of going to sleep right away.
+         */
+        spinOwner = sigSem->ss_Owner;
+        if (SemaphoreOwnerRunning(spinOwner, &spinCpu, SysBase))
+        {
+            sigSem->ss_QueueCount--;
+            SEMAPHORE_UNLOCK(sigSem);
+
+            start = KrnTimeStamp();
+            SemaphoreSpin(sigSem, spinOwner, spinCpu, sx ? sx->sx_SpinLimit : SEMAPHORE_SPIN_MAX, SysBase);
+            SEMAPHORE_STAT(sx, sst_SpinTime, KrnTimeStamp() - start);
+
+            SEMAPHORE_LOCK(sigSem);
+            sigSem->ss_QueueCount++;
+
+            acquired = ((sigSem->ss_QueueCount == 0) || (sigSem->ss_Owner == owner));
+            if (acquired)
+                SEMAPHORE_STAT(sx, sst_SpinAcquired, 1);
+            SemaphoreSpinAdapt(sx, acquired);
+        }
+    }
+#endif
+
     if (sigSem->ss_QueueCount == 0)
     {
         /* We now own the semaphore. This is quick. */
         sigSem->ss_Owner = owner;
         sigSem->ss_NestCount++;
+
+        SEMAPHORE_UNLOCK_SPIN(sigSem);
     }
     /*
      * The semaphore is in use.
@@ -101,6 +230,8 @@ void InternalObtainSemaphore(struct SignalSemaphore *sigSem, struct Task *owner,
     {
         /* Yes, just increase the nesting count */
         sigSem->ss_NestCount++;
+
+        SEMAPHORE_UNLOCK_SPIN(sigSem);
     }
     /* Else, some other task owns it. We have to set a waiting request here. */
     else
@@ -127,30 +258,40 @@ void InternalObtainSemaphore(struct SignalSemaphore *sigSem, struct Task *owner,
 
         AddTail((struct List *)&sigSem->ss_WaitQueue, (struct Node *)&sr);
 
+        /*
+         * Wait() breaks the Forbid(), but the spinlock has to be
+         * given up by ourselves.
+         */
+        SEMAPHORE_UNLOCK_SPIN(sigSem);
+
+#if defined(__AROSEXEC_SMP__)
+        SEMAPHORE_STAT(sx, sst_Sleeps, 1);
+        start = KrnTimeStamp();
+#endif
+
         /*
          * Finally, we simply wait, ReleaseSemaphore() will fill in
          * who owns the semaphore.
          */
         Wait(SIGF_SINGLE);
+
+#if defined(__AROSEXEC_SMP__)
+        SEMAPHORE_STAT(sx, sst_SleepTime, KrnTimeStamp() - start);
+#endif
     }
 
     /* All Done! */
     Permit();
 }
 
-ULONG InternalAttemptSemaphore(struct SignalSemaphore *sigSem, struct Task *owner, struct TraceLocation *caller, struct ExecBase *SysBase)
+static ULONG SemaphoreAttempt(struct SignalSemaphore *sigSem, struct Task *ThisTask, struct Task *owner, struct ExecBase *SysBase)
 {
-    struct Task *ThisTask = GET_THIS_TASK;
     ULONG retval = TRUE;
 
-    if (!CheckSemaphore(sigSem, caller, SysBase))
-        return FALSE;  /* A crude attempt to recover... */
-
     /*
      * Arbitrate for the semaphore structure.
-     * TODO: SMP-aware versions of this code likely need to use spinlocks here
      */
-    Forbid();
+    SEMAPHORE_LOCK(sigSem);
 
     /* Increment the queue count */
     sigSem->ss_QueueCount++;
@@ -174,7 +315,509 @@ ULONG InternalAttemptSemaphore(struct SignalSemaphore *sigSem, struct Task *owne
     }
 
     /* All done. */
-    Permit();
+    SEMAPHORE_UNLOCK(sigSem);
 
     return retval;
 }
+
+static void SemaphoreRelease(struct SignalSemaphore *sigSem, struct ExecBase *SysBase)
+{
+    /* Protect the semaphore structure from multiple access. */
+    SEMAPHORE_LOCK(sigSem);
+
+    /* Release one on the nest count */
+    sigSem->ss_NestCount--;
+    sigSem->ss_QueueCount--;
+
+    if(sigSem->ss_NestCount == 0)
+    {
+        /*
+            There are two cases here. Either we are a shared
+            semaphore, or not. If we are not, make sure that the
+            correct Task is calling ReleaseSemaphore()
+        */
+
+#if CHECK_TASK
+        if (sigSem->ss_Owner != NULL && sigSem->ss_Owner != GET_THIS_TASK)
+        {
+            /*
+                If it is not, there is a chance that the semaphore
+                is corrupt. It will be afterwards anyway :-)
+            */
+            Alert( AN_SemCorrupt );
+        }
+#endif
+
+        /*
+            Do not try and wake anything unless there are a number
+            of tasks waiting. We do both the tests, this is another
+            opportunity to throw an alert if there is an error.
+        */
+        if(
+            sigSem->ss_QueueCount >= 0
+         && sigSem->ss_WaitQueue.mlh_Head->mln_Succ != NULL
+        )
+        {
+            struct SemaphoreRequest *sr, *srn;
+
+            /*
+                Look at the first node, but only to see whether it
+                is shared or not.
+            */
+            sr = (struct SemaphoreRequest *)sigSem->ss_WaitQueue.mlh_Head;
+
+            /*
+                A node is shared if the ln_Name/sr_Waiter field is
+                odd (ie it has bit 1 set).
+
+                If the sr_Waiter field is != NULL, then this is a
+                task waiting, otherwise it is a message.
+            */
+            if( ((IPTR)sr->sr_Waiter & SM_SHARED) == SM_SHARED )
+            {
+                /* This is a shared lock, so ss_Owner == NULL */
+                sigSem->ss_Owner = NULL;
+
+                /* Go through all the nodes to find the shared ones */
+                ForeachNodeSafe( &sigSem->ss_WaitQueue, sr, srn)
+                {
+                    srn = (struct SemaphoreRequest *)sr->sr_Link.mln_Succ;
+
+                    if( ((IPTR)sr->sr_Waiter & SM_SHARED) == SM_SHARED )
+                    {
+                        Remove((struct Node *)sr);
+
+                        /* Clear the bit, and update the owner count */
+                        sr->sr_Waiter = (APTR)((IPTR)sr->sr_Waiter & ~1);
+                        sigSem->ss_NestCount++;
+
+                        if(sr->sr_Waiter != NULL)
+                        {
+                            /* This is a task, signal it */
+                            Signal(sr->sr_Waiter, SIGF_SINGLE);
+                        }
+                        else
+                        {
+                            /* This is a message, send it back to its owner */
+                            ((struct SemaphoreMessage *)sr)->ssm_Semaphore = sigSem;
+                            ReplyMsg((struct Message *)sr);
+                        }
+                    }
+                }
+            }
+
+            /*  This is an exclusive lock - awaken first node */
+            else
+            {
+                /* Save typing */
+                struct SemaphoreMessage *sm = (struct SemaphoreMessage *)sr;
+
+                /* Only awaken the first of the nodes */
+                Remove((struct Node *)sr);
+                sigSem->ss_NestCount++;
+
+                if(sr->sr_Waiter != NULL)
+                {
+                    sigSem->ss_Owner = sr->sr_Waiter;
+                    Signal(sr->sr_Waiter, SIGF_SINGLE);
+                }
+                else
+                {
+                    sigSem->ss_Owner = (struct Task *)sm->ssm_Semaphore;
+                    sm->ssm_Semaphore = sigSem;
+                    ReplyMsg((struct Message *)sr);
+                }
+            }
+        } /* there are waiters */
+
+        /*  Otherwise, there are not tasks waiting. */
+        else
+        {
+            sigSem->ss_Owner = NULL;
+            sigSem->ss_QueueCount = -1;
+
+            D(bug("ReleaseSemaphore(): No tasks - ss_NestCount == %ld\n",
+                sigSem->ss_NestCount);)
+        }
+    }
+    else if(sigSem->ss_NestCount < 0)
+    {
+        /*
+            This can't happen. It means that somebody has released
+            more times than they have obtained.
+        */
+        Alert( AN_SemCorrupt );
+    }
+
+    /* All done. */
+    SEMAPHORE_UNLOCK(sigSem);
+}
+
+#if defined(__AROSEXEC_SMP__)
+
+static inline struct SemaphoreReaders *SemaphoreReadersThisCPU(struct SemaphoreExt *sx, struct ExecBase *SysBase)
+{
+    ULONG cpuNo = KrnGetCPUNumber();
+
+    return &sx->sx_Readers[(cpuNo < sx->sx_CPUCount) ? cpuNo : 0];
+}
+
+/*
+ * The counts of single CPUs can be negative, as a shared holder may be
+ * released on another CPU than it was obtained on.
+ */
+static LONG SemaphoreReaderCount(struct SemaphoreExt *sx)
+{
+    LONG count = 0;
+    ULONG i;
+
+    for (i = 0; i < sx->sx_CPUCount; i++)
+        count += __atomic_load_n(&sx->sx_Readers[i].srd_Count, __ATOMIC_ACQUIRE);
+
+    return count;
+}
+
+/* Wake the exclusive owner once the last reader has left */
+static void SemaphoreReaderWake(struct SignalSemaphore *sigSem, struct SemaphoreExt *sx, struct ExecBase *SysBase)
+{
+    SEMAPHORE_LOCK(sigSem);
+    if (sx->sx_WaitingWriter && (SemaphoreReaderCount(sx) == 0))
+    {
+        Signal(sx->sx_WaitingWriter, SIGF_SINGLE);
+        sx->sx_WaitingWriter = NULL;
+    }
+    SEMAPHORE_UNLOCK(sigSem);
+}
+
+/* Take a shared hold on a SEMF_PERCPUREADERS semaphore, unless there is a writer */
+static BOOL SemaphoreReaderEnter(struct SignalSemaphore *sigSem, struct SemaphoreExt *sx, struct ExecBase *SysBase)
+{
+    struct SemaphoreReaders *srd;
+    BOOL entered;
+
+    /*
+     * Stay on this CPU, so backing out hits the same count - the writer
+     * could otherwise miss us in between its reads of the counts.
+     */
+    Forbid();
+    srd = SemaphoreReadersThisCPU(sx, SysBase);
+    __atomic_fetch_add(&srd->srd_Count, 1, __ATOMIC_SEQ_CST);
+    entered = (__atomic_load_n(&sx->sx_Writers, __ATOMIC_SEQ_CST) == 0);
+    if (!entered)
+        __atomic_fetch_sub(&srd->srd_Count, 1, __ATOMIC_SEQ_CST);
+    Permit();
+
+    if (!entered)
+        SemaphoreReaderWake(sigSem, sx, SysBase);
+
+    return entered;
+}
+
+static void SemaphoreReaderLeave(struct SignalSemaphore *sigSem, struct SemaphoreExt *sx, struct ExecBase *SysBase)
+{
+    __atomic_fetch_sub(&SemaphoreReadersThisCPU(sx, SysBase)->srd_Count, 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&sx->sx_Writers, __ATOMIC_SEQ_CST) != 0)
+        SemaphoreReaderWake(sigSem, sx, SysBase);
+}
+
+/* Called by the new exclusive owner of a SEMF_PERCPUREADERS semaphore */
+static void SemaphoreWaitReaders(struct SignalSemaphore *sigSem, struct SemaphoreExt *sx, struct Task *ThisTask, struct ExecBase *SysBase)
+{
+    ULONG spins, limit = sx->sx_SpinLimit;
+    UQUAD start;
+
+    if (SemaphoreReaderCount(sx) == 0)
+        return;
+
+    SEMAPHORE_STAT(sx, sst_Contended, 1);
+
+    /* Readers usually don't hold the semaphore for long */
+    start = KrnTimeStamp();
+    for (spins = 0; spins < limit; spins++)
+    {
+        SEMAPHORE_SPIN_PAUSE();
+
+        if (SemaphoreReaderCount(sx) == 0)
+            break;
+    }
+    SEMAPHORE_STAT(sx, sst_SpinTime, KrnTimeStamp() - start);
+    SemaphoreSpinAdapt(sx, spins < limit);
+
+    if (spins < limit)
+    {
+        SEMAPHORE_STAT(sx, sst_SpinAcquired, 1);
+        return;
+    }
+
+    SEMAPHORE_STAT(sx, sst_Sleeps, 1);
+    start = KrnTimeStamp();
+
+    SEMAPHORE_LOCK(sigSem);
+    while (SemaphoreReaderCount(sx) != 0)
+    {
+        AROS_ATOMIC_AND(ThisTask->tc_SigRecvd, ~SIGF_SINGLE);
+        sx->sx_WaitingWriter = ThisTask;
+
+        SEMAPHORE_UNLOCK_SPIN(sigSem);
+        Wait(SIGF_SINGLE);
+        SEMAPHORE_LOCK_SPIN(sigSem);
+    }
+    sx->sx_WaitingWriter = NULL;
+    SEMAPHORE_UNLOCK(sigSem);
+
+    SEMAPHORE_STAT(sx, sst_SleepTime, KrnTimeStamp() - start);
+}
+
+/*
+ * SEMF_PERCPUREADERS versions of SemaphoreObtain(), SemaphoreAttempt() and
+ * SemaphoreRelease(). Shared obtains nested in an exclusive hold are
+ * treated like exclusive ones, as ss_Owner is the owner's then.
+ */
+static void SemaphoreExtObtain(struct SignalSemaphore *sigSem, struct SemaphoreExt *sx, struct Task *ThisTask, struct Task *owner, struct ExecBase *SysBase)
+{
+    BOOL nested = (sigSem->ss_Owner == ThisTask);
+
+    if ((owner == NULL) && !nested)
+    {
+        if (SemaphoreReaderEnter(sigSem, sx, SysBase))
+            return;
+
+        /*
+         * A writer owns the semaphore, or is about to. Queue up behind it on
+         * the semaphore itself, and turn the shared hold into a reader count
+         * once it is granted.
+         */
+        SemaphoreObtain(sigSem, ThisTask, NULL, sx, SysBase);
+        __atomic_fetch_add(&SemaphoreReadersThisCPU(sx, SysBase)->srd_Count, 1, __ATOMIC_SEQ_CST);
+        SemaphoreRelease(sigSem, SysBase);
+
+        return;
+    }
+
+    __atomic_fetch_add(&sx->sx_Writers, 1, __ATOMIC_SEQ_CST);
+    SemaphoreObtain(sigSem, ThisTask, owner, sx, SysBase);
+    if (!nested)
+        SemaphoreWaitReaders(sigSem, sx, ThisTask, SysBase);
+}
+
+static ULONG SemaphoreExtAttempt(struct SignalSemaphore *sigSem, struct SemaphoreExt *sx, struct Task *ThisTask, struct Task *owner, struct ExecBase *SysBase)
+{
+    BOOL nested = (sigSem->ss_Owner == ThisTask);
+
+    if ((owner == NULL) && !nested)
+        return SemaphoreReaderEnter(sigSem, sx, SysBase);
+
+    __atomic_fetch_add(&sx->sx_Writers, 1, __ATOMIC_SEQ_CST);
+    if (SemaphoreAttempt(sigSem, ThisTask, owner, SysBase))
+    {
+        if (nested || (SemaphoreReaderCount(sx) == 0))
+            return TRUE;
+
+        SemaphoreRelease(sigSem, SysBase);
+    }
+    __atomic_fetch_sub(&sx->sx_Writers, 1, __ATOMIC_SEQ_CST);
+
+    return FALSE;
+}
+
+static void SemaphoreExtRelease(struct SignalSemaphore *sigSem, struct SemaphoreExt *sx, struct Task *ThisTask, struct ExecBase *SysBase)
+{
+    if (sigSem->ss_Owner == ThisTask)
+    {
+        SemaphoreRelease(sigSem, SysBase);
+        __atomic_fetch_sub(&sx->sx_Writers, 1, __ATOMIC_SEQ_CST);
+    }
+    else
+        SemaphoreReaderLeave(sigSem, sx, SysBase);
+}
+
+static void SemaphoreExtSetup(struct SemaphoreExt *sx, struct SignalSemaphore *sigSem, ULONG flags)
+{
+    ULONG i;
+
+    sx->sx_Flags = flags;
+    sx->sx_SpinLimit = SEMAPHORE_SPIN_MAX;
+    sx->sx_Writers = 0;
+    sx->sx_WaitingWriter = NULL;
+    for (i = 0; i < sx->sx_CPUCount; i++)
+        sx->sx_Readers[i].srd_Count = 0;
+    memset(&sx->sx_Stats, 0, sizeof(sx->sx_Stats));
+
+    /* Publish the record only once it is set up */
+    __atomic_store_n(&sx->sx_Semaphore, sigSem, __ATOMIC_RELEASE);
+}
+
+/*
+ * Backs SetSemaphoreFlags(). The semaphore must not be in use while its flags
+ * are changed.
+ */
+BOOL InternalSetSemaphoreFlags(struct SignalSemaphore *sigSem, ULONG flags, struct ExecBase *SysBase)
+{
+    struct SemaphoreExt **bucket = &PrivExecBase(SysBase)->SemaphoreExt[SemaphoreExtBucket(sigSem)];
+    struct SemaphoreExt *sx;
+
+    Forbid();
+    EXEC_SPINLOCK_LOCK(&PrivExecBase(SysBase)->SemaphoreExtLock, NULL, SPINLOCK_MODE_WRITE);
+
+    sx = SemaphoreExtFind(sigSem, SysBase);
+    if (sx)
+        __atomic_store_n(&sx->sx_Semaphore, NULL, __ATOMIC_RELEASE);
+    else if (flags)
+    {
+        /* Reuse an unused record of the same bucket */
+        for (sx = *bucket; sx; sx = sx->sx_Next)
+        {
+            if (!sx->sx_Semaphore)
+                break;
+        }
+    }
+
+    if (sx && flags)
+        SemaphoreExtSetup(sx, sigSem, flags);
+
+    EXEC_SPINLOCK_UNLOCK(&PrivExecBase(SysBase)->SemaphoreExtLock);
+    Permit();
+
+    D(bug("[Semaphore] 0x%p flags 0x%08x, record 0x%p\n", sigSem, flags, sx));
+
+    if (sx || !flags)
+        return TRUE;
+
+    sx = AllocMem(sizeof(struct SemaphoreExt), MEMF_PUBLIC | MEMF_CLEAR);
+    if (!sx)
+        return FALSE;
+
+    sx->sx_CPUCount = KrnGetCPUCount();
+    sx->sx_Readers = AllocMem(sx->sx_CPUCount * sizeof(struct SemaphoreReaders), MEMF_PUBLIC | MEMF_CLEAR);
+    if (!sx->sx_Readers)
+    {
+        FreeMem(sx, sizeof(struct SemaphoreExt));
+        return FALSE;
+    }
+
+    Forbid();
+    EXEC_SPINLOCK_LOCK(&PrivExecBase(SysBase)->SemaphoreExtLock, NULL, SPINLOCK_MODE_WRITE);
+
+    SemaphoreExtSetup(sx, sigSem, flags);
+    sx->sx_Next = *bucket;
+    __atomic_store_n(bucket, sx, __ATOMIC_RELEASE);
+
+    EXEC_SPINLOCK_UNLOCK(&PrivExecBase(SysBase)->SemaphoreExtLock);
+    Permit();
+
+    D(bug("[Semaphore] 0x%p got new record 0x%p\n", sigSem, sx));
+
+    return TRUE;
+}
+
+/* Backs GetSemaphoreStats(). A NULL semaphore gives the totals of all semaphores. */
+BOOL InternalGetSemaphoreStats(struct SignalSemaphore *sigSem, struct SemaphoreStats *stats, struct ExecBase *SysBase)
+{
+    struct SemaphoreStats *src = &PrivExecBase(SysBase)->SemaphoreStats;
+    struct SemaphoreExt *sx;
+
+    if (!stats)
+        return FALSE;
+
+    if (sigSem)
+    {
+        sx = SemaphoreExtFind(sigSem, SysBase);
+        if (!sx || !(sx->sx_Flags & SEMF_STATS))
+            return FALSE;
+        src = &sx->sx_Stats;
+    }
+
+    stats->sst_Contended    = __atomic_load_n(&src->sst_Contended, __ATOMIC_RELAXED);
+    stats->sst_SpinAcquired = __atomic_load_n(&src->sst_SpinAcquired, __ATOMIC_RELAXED);
+    stats->sst_SpinTime     = __atomic_load_n(&src->sst_SpinTime, __ATOMIC_RELAXED);
+    stats->sst_Sleeps       = __atomic_load_n(&src->sst_Sleeps, __ATOMIC_RELAXED);
+    stats->sst_SleepTime    = __atomic_load_n(&src->sst_SleepTime, __ATOMIC_RELAXED);
+
+    return TRUE;
+}
+
+#endif /* __AROSEXEC_SMP__ */
+
+void InternalObtainSemaphore(struct SignalSemaphore *sigSem, struct Task *owner, struct TraceLocation *caller, struct ExecBase *SysBase)
+{
+    struct Task *ThisTask = GET_THIS_TASK;
+    struct SemaphoreExt *sx = NULL;
+
+    /*
+     * If there's no ThisTask, the function is called from within memory
+     * allocator in exec's pre-init code. We are already single-threaded,
+     * just return. :)
+     */
+    if (!ThisTask)
+        return;
+
+    /*
+     * Freeing memory during RemTask(NULL). We are already single-threaded by
+     * Forbid(), and waiting isn't possible because task context is being deallocated.
+     */
+    if (ThisTask->tc_State == TS_REMOVED)
+        return;
+
+    if (!CheckSemaphore(sigSem, caller, SysBase))
+        return;  /* A crude attempt to recover... */
+
+#if defined(__AROSEXEC_SMP__)
+    sx = SemaphoreExtFind(sigSem, SysBase);
+    if (sx && (sx->sx_Flags & SEMF_PERCPUREADERS))
+    {
+        SemaphoreExtObtain(sigSem, sx, ThisTask, owner, SysBase);
+        return;
+    }
+#endif
+
+    SemaphoreObtain(sigSem, ThisTask, owner, sx, SysBase);
+}
+
+ULONG InternalAttemptSemaphore(struct SignalSemaphore *sigSem, struct Task *owner, struct TraceLocation *caller, struct ExecBase *SysBase)
+{
+    struct Task *ThisTask = GET_THIS_TASK;
+#if defined(__AROSEXEC_SMP__)
+    struct SemaphoreExt *sx;
+#endif
+
+    if (!CheckSemaphore(sigSem, caller, SysBase))
+        return FALSE;  /* A crude attempt to recover... */
+
+#if defined(__AROSEXEC_SMP__)
+    sx = SemaphoreExtFind(sigSem, SysBase);
+    if (sx && (sx->sx_Flags & SEMF_PERCPUREADERS))
+        return SemaphoreExtAttempt(sigSem, sx, ThisTask, owner, SysBase);
+#endif
+
+    return SemaphoreAttempt(sigSem, ThisTask, owner, SysBase);
+}
+
+void InternalReleaseSemaphore(struct SignalSemaphore *sigSem, struct TraceLocation *caller, struct ExecBase *SysBase)
+{
+    struct Task *ThisTask = GET_THIS_TASK;
+#if defined(__AROSEXEC_SMP__)
+    struct SemaphoreExt *sx;
+#endif
+
+    /* We can be called from within exec's pre-init code. It's okay. */
+    if (!ThisTask)
+        return;
+
+    if (ThisTask->tc_State == TS_REMOVED)
+        return;
+
+    if (!CheckSemaphore(sigSem, caller, SysBase))
+        return;
+
+#if defined(__AROSEXEC_SMP__)
+    sx = SemaphoreExtFind(sigSem, SysBase);
+    if (sx && (sx->sx_Flags & SEMF_PERCPUREADERS))
+    {
+        SemaphoreExtRelease(sigSem, sx, ThisTask, SysBase);
+        return;
+    }
+#endif
+
+    SemaphoreRelease(sigSem, SysBase);
+}
@@ -1,17 +1,98 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Private definitions of semaphore internals
 */
+#ifndef _SEMAPHORES_H_
+#define _SEMAPHORES_H_
 
 #include <aros/config.h>
+#include <exec/semaphores.h>
 
 #if defined(__AROSEXEC_SMP__)
 #include <aros/types/spinlock_s.h>
+#include <resources/execlock.h>
 #endif
 
 struct TraceLocation;
+struct SemaphoreExt;
+
+/*
+ * Forbid() only arbitrates between the tasks of one CPU, so on SMP builds the
+ * semaphore structure is additionally protected by the spinlock in its
+ * ss_MultipleLink. The _SPIN variants are for code that is already in Forbid().
+ */
+#if defined(__AROSEXEC_SMP__)
+#define SEMAPHORE_LOCK_SPIN(sigSem) \
+    EXEC_SPINLOCK_LOCK(&(sigSem)->ss_MultipleLink.sr_SpinLock, NULL, SPINLOCK_MODE_WRITE)
+#define SEMAPHORE_UNLOCK_SPIN(sigSem) \
+    EXEC_SPINLOCK_UNLOCK(&(sigSem)->ss_MultipleLink.sr_SpinLock)
+#else
+#define SEMAPHORE_LOCK_SPIN(sigSem)
+#define SEMAPHORE_UNLOCK_SPIN(sigSem)
+#endif
+#define SEMAPHORE_LOCK(sigSem) \
+    do { Forbid(); SEMAPHORE_LOCK_SPIN(sigSem); } while (0)
+#define SEMAPHORE_UNLOCK(sigSem) \
+    do { SEMAPHORE_UNLOCK_SPIN(sigSem); Permit(); } while (0)
+
+#if defined(__AROSEXEC_SMP__)
+/*
+ * A contended obtain spins instead of going to sleep as long as the task
+ * owning the semaphore is running on another CPU, for at most this many
+ * rounds. Semaphores that have a SemaphoreExt adapt their limit between
+ * SEMAPHORE_SPIN_MIN and SEMAPHORE_SPIN_MAX to how often spinning paid off.
+ */
+#define SEMAPHORE_SPIN_MIN      64
+#define SEMAPHORE_SPIN_MAX      4096
+
+#if defined(__i386__) || defined(__x86_64__)
+#define SEMAPHORE_SPIN_PAUSE()  asm volatile("pause" ::: "memory")
+#else
+#define SEMAPHORE_SPIN_PAUSE()  asm volatile("" ::: "memory")
+#endif
+
+#define SEMAPHOREEXT_BUCKETS    64
+
+/* Shared holders of a SEMF_PERCPUREADERS semaphore, one per CPU and cache line */
+struct SemaphoreReaders
+{
+    volatile LONG               srd_Count;
+} __attribute__((__aligned__(64)));
+
+/*
+ * Additional state of semaphores set up with SetSemaphoreFlags(). These are
+ * kept in a hash table of the semaphore addresses, as struct SignalSemaphore
+ * can't grow. Records are never freed, only reused, so they can be looked
+ * up without locking.
+ *
+ * In SEMF_PERCPUREADERS mode shared obtains only count themselves in
+ * sx_Readers of their CPU, as long as sx_Writers is zero. Exclusive obtains
+ * raise sx_Writers, obtain the semaphore itself, and then wait for the
+ * readers to drain. Only the exclusive owner holds the semaphore itself,
+ * which is how ReleaseSemaphore() tells both kinds of hold apart.
+ */
+struct SemaphoreExt
+{
+    struct SemaphoreExt         *sx_Next;                       /* Next record in the hash bucket               */
+    struct SignalSemaphore      *sx_Semaphore;                  /* NULL while the record is unused              */
+    ULONG                       sx_Flags;                       /* SEMF_#? flags                                */
+    ULONG                       sx_SpinLimit;                   /* Current adaptive spin limit                  */
+    volatile ULONG              sx_Writers;                     /* Exclusive holds and obtains in progress      */
+    struct Task                 *sx_WaitingWriter;              /* Owner waiting for the readers to drain       */
+    ULONG                       sx_CPUCount;
+    struct SemaphoreReaders     *sx_Readers;                    /* sx_CPUCount reader counts                    */
+    struct SemaphoreStats       sx_Stats;
+};
+
+struct SemaphoreExt *SemaphoreExtFind(struct SignalSemaphore *sigSem, struct ExecBase *SysBase);
+BOOL InternalSetSemaphoreFlags(struct SignalSemaphore *sigSem, ULONG flags, struct ExecBase *SysBase);
+BOOL InternalGetSemaphoreStats(struct SignalSemaphore *sigSem, struct SemaphoreStats *stats, struct ExecBase *SysBase);
+#endif
 
 BOOL CheckSemaphore(struct SignalSemaphore *sigSem, struct TraceLocation *caller, struct ExecBase *SysBase);
 void InternalObtainSemaphore(struct SignalSemaphore *sigSem, struct Task *owner, struct TraceLocation *caller, struct ExecBase *SysBase);
 ULONG InternalAttemptSemaphore(struct SignalSemaphore *sigSem, struct Task *owner, struct TraceLocation *caller, struct ExecBase *SysBase);
+void InternalReleaseSemaphore(struct SignalSemaphore *sigSem, struct TraceLocation *caller, struct ExecBase *SysBase);
+
+#endif /* _SEMAPHORES_H_ */
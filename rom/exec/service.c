@@ -101,7 +101,7 @@ void ServiceTask(struct ExecBase *SysBase)
                      */
 #if !defined(EXEC_REMTASK_NEEDSSWITCH)
                     task->tc_State = TS_READY;
-                    Enqueue(&SysBase->TaskReady, &task->tc_Node);
+                    EXEC_READYTASK(task);
 #else
                     krnSysCallReschedTask(task, TS_READY);
 #endif
@@ -77,6 +77,9 @@
         case TS_WAIT:
             task_listlock = &PrivExecBase(SysBase)->TaskWaitSpinLock;
             break;
+        case TS_READY:
+            /* The scheduler requeues ready tasks, and does its own locking */
+            break;
         default:
             task_listlock = &PrivExecBase(SysBase)->TaskReadySpinLock;
             break;
@@ -84,9 +87,7 @@
 #endif
     Disable();
 #if defined(__AROSEXEC_SMP__)
-    if (task->tc_State == TS_READY)
-        EXEC_LOCK_WRITE(task_listlock);
-    else
+    if (task_listlock)
         EXEC_LOCK_READ(task_listlock);
 #endif
 
@@ -102,12 +103,17 @@
         /* If it is in the ready list remove and reinsert it. */
         if (task->tc_State == TS_READY)
         {
+#if defined(__AROSEXEC_SMP__)
+            krnSysCallReschedTask(task, TS_READY);
+#else
             Remove(&task->tc_Node);
-            Enqueue(&SysBase->TaskReady, &task->tc_Node);
+            EXEC_READYTASK(task);
+#endif
         }
 
 #if defined(__AROSEXEC_SMP__)
-        EXEC_UNLOCK(task_listlock);
+        if (task_listlock)
+            EXEC_UNLOCK(task_listlock);
 
         task_listlock = NULL;
         if (IntETask(task->tc_UnionETask.tc_ETask)->iet_CpuNumber == cpunum) {
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2022, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Send some signal to a given task
 */
@@ -13,6 +13,7 @@
 
 #define __AROS_KERNEL__
 #include "exec_intern.h"
+#include "exec_trace.h"
 
 #if defined(__AROSEXEC_SMP__)
 #include <utility/hooks.h>
@@ -72,6 +73,13 @@ AROS_UFH3(IPTR, signal_hook,
     NOTES
         This function may be used from interrupts.
 
+        Wakeups are coalesced while the caller is in Forbid() or in an
+        interrupt: this CPU switches tasks at most once, when Permit() is
+        called or the interrupt exits. On SMP builds, every other CPU also
+        gets a single reschedule request for all tasks woken up on it in
+        the meantime. Code that signals another task at a high rate can
+        wrap a batch of Signal() calls in Forbid()/Permit() to benefit.
+
     EXAMPLE
 
     BUGS
@@ -165,6 +173,8 @@ AROS_UFH3(IPTR, signal_hook,
                 bug("[Exec] %s: (Called from '%s')\n", __func__, thisTask->tc_Node.ln_Name);
         )
 
+        EXEC_TRACE(ETF_SCHED, ETT_SIGNAL, task, signalSet);
+
         D(bug("[Exec] %s: Target signal flags : %08x ->", __func__, task->tc_SigRecvd);)
         /* Set the signals in the task structure. */
 #if defined(__AROSEXEC_SMP__)
@@ -228,7 +238,7 @@ AROS_UFH3(IPTR, signal_hook,
 #else
                 Remove(&task->tc_Node);
                 task->tc_State = TS_READY;
-                Enqueue(&SysBase->TaskReady, &task->tc_Node);
+                EXEC_READYTASK(task);
 #endif
             }
 
@@ -52,7 +52,7 @@
     struct SemaphoreRequest *sr = NULL;
 
     /* Arbitrate for the semaphore structure */
-    Forbid();
+    SEMAPHORE_LOCK(sigSem);
     bidMsg->ssm_Semaphore = NULL;
 
     /*
@@ -72,12 +72,13 @@
             ReplyMsg(&bidMsg->ssm_Message);
 
             /* All done */
-            Permit();
+            SEMAPHORE_UNLOCK(sigSem);
             return;
         }
     }
 
     /* No, it must have been fulfilled. Release the semaphore and done. */
+    SEMAPHORE_UNLOCK_SPIN(sigSem);
     ReleaseSemaphore(sigSem);
 
     /* All done. */
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Wait for some signal.
 */
@@ -12,6 +12,7 @@
 #include <proto/exec.h>
 
 #include "exec_intern.h"
+#include "exec_trace.h"
 #if defined(__AROSEXEC_SMP__)
 #include "etask.h"
 #endif
@@ -65,6 +66,7 @@
     ULONG rcvd;
 
     D(bug("[Exec] Wait(%08lX)\n", signalSet);)
+    EXEC_TRACE(ETF_SCHED, ETT_WAIT, signalSet, thisTask->tc_SigRecvd);
     Disable();
 
     /* If at least one of the signals is already set do not wait. */
@@ -87,8 +89,8 @@
         thisTask->tc_State = TS_WAIT;
         // nb: on smp builds switch will move us.
 #if !defined(__AROSEXEC_SMP__)
-        /* Move current task to the waiting list. */
-        Enqueue(&SysBase->TaskWait, &thisTask->tc_Node);
+        /* Move current task to the waiting list. Its order doesn't matter, so just append it. */
+        AddTail(&SysBase->TaskWait, &thisTask->tc_Node);
 #endif
 
         /* And switch to the next ready task. */
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Wait for a message on a port.
 */
@@ -8,6 +8,7 @@
 #include <aros/debug.h>
 
 #include "exec_intern.h"
+#include "mpscport.h"
 #include <exec/ports.h>
 #include <aros/libcall.h>
 #include <proto/exec.h>
@@ -59,6 +60,15 @@
     */
     D(bug("[Exec] WaitPort(0x%p)\n", port);)
 
+    if (port->mp_Flags & PF_MPSC)
+    {
+        /* Producers only signal us when the port was empty */
+        while (MPSCPortEmpty(port))
+            Wait(1<<port->mp_SigBit);
+
+        return MPSCPortFirst(port);
+    }
+
     /* Is messageport empty? */
 #if defined(__AROSEXEC_SMP__)
     Disable();
@@ -19,6 +19,9 @@
 #include "globals.h"
 
 static LONG copybackiocache(struct IOCache *ioc);
+void invalidateiocache(struct IOCache *ioc);
+static LONG flushwritebehind(void);
+static LONG checkwritebehind(BLCK block, ULONG blocks);
 
 /* Internal structures */
 
@@ -36,6 +39,8 @@ struct IOCache {
   ULONG dirty[4];        /* Set bits indicate blocks which need to be written to disk. */
   ULONG valid[4];        /* Set bits indicate blocks which contain up-to-date data. */
 
+  struct fsIORequest *fsi;  /* Used for reading ahead into this IOCache, allocated when first needed */
+
   UBYTE bits;            /* See defines below */
   UBYTE locked;          /* Indicates that lruiocache should not return this iocache */
   UWORD pad3;
@@ -51,7 +56,10 @@ struct IOCache {
 
 /* defines for IOCache bits */
 
-#define IOC_DIRTY  (1)   /* IOCache contains dirty data */
+#define IOC_DIRTY   (1)  /* IOCache contains dirty data */
+#define IOC_PENDING (2)  /* IOCache is being read ahead, use waitiocache() before touching the data */
+
+#define WRITEBEHIND_SIZE (131072)  /* Preferred size of the write-behind buffer in bytes */
 
 /*
 
@@ -80,6 +88,19 @@ mode the cache operates in.  WriteThrough caching means the
 buffers are just updated and kept in memory.  Otherwise a
 buffer is simply marked invalid.
 
+Files which are read sequentially get their following lines
+read ahead (see readahead()).  These reads are started
+asynchronously; an IOCache which is still being read is
+hashed, but marked IOC_PENDING, and findiocache() waits for
+it to complete.
+
+In copyback mode, writes which are too large for the
+IOCache are collected in a write-behind buffer as long as
+they follow each other on disk, so many of them go to the
+device in one transfer.  The buffer is written when a
+non-sequential write comes along, when anything accesses the
+blocks in it, and by flushiocache().
+
 */
 
 
@@ -116,7 +137,25 @@ static void dehash(struct IOCache *ioc) {
 
 
 
+static void waitiocache(struct IOCache *ioc) {
+
+  /* Waits for a read-ahead of this IOCache to complete.  If it failed
+     the IOCache is simply invalidated, so the data is read again (and
+     any errors are reported) when it is actually needed. */
+
+  if((ioc->bits & IOC_PENDING)!=0) {
+    ioc->bits&=~IOC_PENDING;
+
+    if(waittransfer(ioc->fsi)!=0) {
+      invalidateiocache(ioc);
+    }
+  }
+}
+
+
+
 void invalidateiocache(struct IOCache *ioc) {
+  waitiocache(ioc);
   dehash(ioc);
   ioc->blocks=0;
   ioc->block=0;
@@ -144,11 +183,25 @@ void freeIOCache(struct MinList *lruhead) {
      nothing. */
 
   if(lruhead!=0) {
+    struct IOCache *ioc=(struct IOCache *)lruhead->mlh_Head;
+
+    /* Reads ahead must all be completed first, as validateiocache()
+       swaps data buffers between IOCaches. */
+
+    while(ioc->node.mln_Succ!=0) {
+      waitiocache(ioc);
+      ioc=(struct IOCache *)(ioc->node.mln_Succ);
+    }
+
     while(lruhead->mlh_TailPred != (struct MinNode *)lruhead) {
-      struct IOCache *ioc=(struct IOCache *)lruhead->mlh_Head;
+      ioc=(struct IOCache *)lruhead->mlh_Head;
 
       removem(lruhead->mlh_Head);
 
+      if(ioc->fsi!=0) {
+        deleteiorequest(ioc->fsi);
+      }
+
       FreeVec(ioc);
     }
 
@@ -179,6 +232,8 @@ struct MinList *allocate(ULONG size, LONG n) {
       ioc->nexthash=0;
       ioc->prevhash=0;
       ioc->locked=0;
+      ioc->bits=0;
+      ioc->fsi=0;
       invalidateiocache(ioc);
 
       /* ioc->data is aligned to 16 byte boundaries. */
@@ -311,6 +366,16 @@ LONG initcachedio(UBYTE *devicename, IPTR unit, ULONG flags, struct DosEnvec *de
     /* Note: There MUST be atleast 4 IOCache_lines for cachedio to work correctly at the moment!! */
 
     if((setiocache(8, 8192, TRUE))==0) {
+
+      /* The write-behind buffer is optional */
+
+      globals->wb_blocks=0;
+      globals->wb_maxblocks=WRITEBEHIND_SIZE>>globals->shifts_block;
+      if(globals->wb_maxblocks>globals->blocks_maxtransfer) {
+        globals->wb_maxblocks=globals->blocks_maxtransfer;
+      }
+      globals->wb_data=AllocVec(globals->wb_maxblocks<<globals->shifts_block, globals->bufmemtype);
+
       return(0);
     }
   }
@@ -325,6 +390,9 @@ void cleanupcachedio(void) {
   /* Only call this if initcachedio() was succesful. */
 
   flushiocache();    /*** returns an errorcode... */
+  FreeVec(globals->wb_data);
+  globals->wb_data=0;
+  globals->wb_blocks=0;
   freeIOCache(globals->iocache_lruhead);
   globals->iocache_lruhead=0;
 
@@ -335,12 +403,11 @@ void cleanupcachedio(void) {
 
 
 
-struct IOCache *findiocache(BLCK block) {
+static struct IOCache *lookupiocache(BLCK block) {
   struct IOCache *ioc=globals->ioc_hashtable[ (block>>globals->iocache_shift) & (IOC_HASHSIZE-1) ];
 
-  /* For internal use only.  This function will find the IOCache, if available.
-     It won't move the block to the end of the LRU chain though -- use locateiocache
-     instead. */
+  /* Like findiocache, but returns IOCaches which are still being read
+     ahead without waiting for them. */
 
   while(ioc!=0) {
     if(block>=ioc->block && block<ioc->block+ioc->blocks) {
@@ -355,6 +422,26 @@ struct IOCache *findiocache(BLCK block) {
 
 
 
+struct IOCache *findiocache(BLCK block) {
+  struct IOCache *ioc;
+
+  /* For internal use only.  This function will find the IOCache, if available.
+     It won't move the block to the end of the LRU chain though -- use locateiocache
+     instead. */
+
+  if((ioc=lookupiocache(block))!=0 && (ioc->bits & IOC_PENDING)!=0) {
+    waitiocache(ioc);
+
+    if(ioc->blocks==0) {
+      return(0);
+    }
+  }
+
+  return(ioc);
+}
+
+
+
 struct IOCache *locateiocache(BLCK block) {
   struct IOCache *ioc;
 
@@ -522,7 +609,7 @@ static LONG copybackiocache(struct IOCache *ioc) {
 //    ioc->dirtylow=255;
 //    ioc->dirtyhigh=0;
 
-    ioc=findiocache(ioc->block+ioc->blocks);
+    ioc=lookupiocache(ioc->block+ioc->blocks);
   }
 
   return(errorcode);
@@ -538,6 +625,10 @@ LONG flushiocache(void) {
      later reads.  Use this to ensure data is comitted to disk
      when doing critical operations. */
 
+  if((errorcode=flushwritebehind())!=0) {
+    return(errorcode);
+  }
+
   ioc=(struct IOCache *)globals->iocache_lruhead->mlh_Head;
 
   while(ioc->node.mln_Succ!=0) {
@@ -567,6 +658,8 @@ void invalidateiocaches(void) {
      ACTION_INHIBIT(TRUE)).  Before calling this function make
      sure all pending changes have been flushed using flushiocache() */
 
+  globals->wb_blocks=0;
+
   ioc=(struct IOCache *)globals->iocache_lruhead->mlh_Head;
 
   while(ioc->node.mln_Succ!=0) {
@@ -709,7 +802,7 @@ LONG readbytes(BLCK block, UBYTE *buffer, UWORD offsetinblock, UWORD bytes) {
      This function will fall back to reading a single block if the cache
      is disabled. */
 
-  if((errorcode=readintocache(block, &ioc))==0 && (errorcode=validateiocache(ioc, block-ioc->block, 1))==0) {
+  if((errorcode=checkwritebehind(block, 1))==0 && (errorcode=readintocache(block, &ioc))==0 && (errorcode=validateiocache(ioc, block-ioc->block, 1))==0) {
     CopyMem((UBYTE *)ioc->data+((block-ioc->block)<<globals->shifts_block) + offsetinblock, buffer, bytes);
   }
 
@@ -729,7 +822,7 @@ LONG writebytes(BLCK block, UBYTE *buffer, UWORD offsetinblock, UWORD bytes) {
      This function will fall back to reading/modifying/writing a single
      block if the cache or copyback caching is disabled. */
 
-  if((errorcode=readintocache(block, &ioc))==0 && (errorcode=validateiocache(ioc, block-ioc->block, 1))==0) {
+  if((errorcode=checkwritebehind(block, 1))==0 && (errorcode=readintocache(block, &ioc))==0 && (errorcode=validateiocache(ioc, block-ioc->block, 1))==0) {
     CopyMem(buffer, (UBYTE *)ioc->data + ((block-ioc->block)<<globals->shifts_block) + offsetinblock, bytes);
     if(globals->iocache_copyback==FALSE) {
       errorcode=write(block, (UBYTE *)ioc->data+((block-ioc->block)<<globals->shifts_block), 1);
@@ -748,7 +841,7 @@ LONG writebytes(BLCK block, UBYTE *buffer, UWORD offsetinblock, UWORD bytes) {
 LONG read(BLCK block, UBYTE *buffer, ULONG blocks) {
   LONG errorcode=0;
 
-  if(blocks!=0) {
+  if(blocks!=0 && (errorcode=checkwritebehind(block, blocks))==0) {
 
     /* The readahead caching system works simple; if the data-request is lesser
        than or equal to the line-size than we first try to locate the data in
@@ -758,9 +851,12 @@ LONG read(BLCK block, UBYTE *buffer, ULONG blocks) {
        Large requests are processed seperately and don't go through the cache.
        The idea is that large requests are quite fast when loaded from the HD
        anyway.  Also, to be able to properly speed up even large requests you'd
-       also need a substantially larger cache, which isn't what we want here. */
+       also need a substantially larger cache, which isn't what we want here.
+       Large requests do however use any lines at their start which are
+       already in the cache, as those are usually lines which were read
+       ahead for a file being read sequentially. */
 
-    if(globals->iocache_lines!=0 && blocks<=globals->iocache_sizeinblocks>>1) {        // ****** // dit kan sneller, als het ondanks het te grote request toch in de cache staat!
+    if(globals->iocache_lines!=0 && blocks<=globals->iocache_sizeinblocks>>1) {
       struct IOCache *ioc;
 
       while(errorcode==0 && blocks!=0) {
@@ -790,7 +886,33 @@ LONG read(BLCK block, UBYTE *buffer, ULONG blocks) {
       }
     }
     else {
-      if((errorcode=copybackoverlappingiocaches(block, blocks))==0) {
+      struct IOCache *ioc;
+
+      while(globals->iocache_lines!=0 && blocks!=0 && (ioc=locateiocache(block))!=0) {
+        ULONG blockoffset=block-ioc->block;
+        ULONG blocklength=ioc->blocks-blockoffset;
+
+        if(blocks<blocklength) {
+          blocklength=blocks;
+        }
+
+        if(bmtsto(ioc->valid, blockoffset, blocklength)==FALSE) {
+          break;
+        }
+
+        if(((IPTR)buffer & 0x00000003) != 0) {
+          CopyMem((UBYTE *)ioc->data + (blockoffset<<globals->shifts_block), buffer, blocklength<<globals->shifts_block);
+        }
+        else {
+          CopyMemQuick((UBYTE *)ioc->data + (blockoffset<<globals->shifts_block), buffer, blocklength<<globals->shifts_block);
+        }
+
+        block+=blocklength;
+        blocks-=blocklength;
+        buffer+=blocklength<<globals->shifts_block;
+      }
+
+      if(blocks!=0 && (errorcode=copybackoverlappingiocaches(block, blocks))==0) {
         errorcode=transfer(DIO_READ, buffer, block, blocks);
       }
     }
@@ -801,13 +923,78 @@ LONG read(BLCK block, UBYTE *buffer, ULONG blocks) {
 
 
 
-void writethroughoverlappingiocaches(BLCK block, ULONG blocks, UBYTE *buffer) {
+void readahead(BLCK block, ULONG blocks) {
+  struct IOCache *ioc;
+  BLCK lastblock;
+
+  /* Starts reading the IOCache lines covering the given region, without
+     waiting for the reads to complete.  Lines which are already cached
+     are left alone.  This is only a hint: if anything goes wrong the
+     read-ahead is simply stopped, and the data will be read again when
+     it is really needed. */
+
+  if(globals->iocache_lines==0 || blocks==0 || block>=globals->blocks_total) {
+    return;
+  }
+
+  if(checkwritebehind(block, blocks)!=0) {
+    return;
+  }
+
+  lastblock=(block+blocks-1) & ~globals->iocache_mask;
+  block=block & ~globals->iocache_mask;
+
+  while(block<=lastblock && block<globals->blocks_total) {
+    if(lookupiocache(block)==0) {
+      ULONG blocklength=globals->iocache_sizeinblocks;
+
+      if(block+blocklength>globals->blocks_total) {
+        blocklength=globals->blocks_total-block;
+      }
+
+      if(lruiocache(&ioc)!=0) {
+        break;
+      }
+
+      if(ioc->fsi==0 && (ioc->fsi=createiorequest())==0) {
+        break;
+      }
+
+      if(sendtransfer(ioc->fsi, DIO_READ, ioc->data, block, blocklength)!=0) {
+        break;
+      }
+
+      _TDEBUG("readahead: reading ahead block %ld\n", block);
+
+      ioc->block=block;
+      ioc->blocks=blocklength;
+
+      ioc->valid[0]=0xFFFFFFFF;
+      ioc->valid[1]=0xFFFFFFFF;
+      ioc->valid[2]=0xFFFFFFFF;
+      ioc->valid[3]=0xFFFFFFFF;
+
+      ioc->bits|=IOC_PENDING;
+
+      hashit(ioc);
+    }
+
+    block+=globals->iocache_sizeinblocks;
+  }
+}
+
+
+
+void writethroughoverlappingiocaches(BLCK block, ULONG blocks, UBYTE *buffer, BOOL dropcovered) {
   struct IOCache *ioc;
   BLCK firstblock;
   BLCK lastblock;
 
   /* This function copies data from the buffer to any IOCaches which fall (partially)
-     in the region specified by the input parameters. */
+     in the region specified by the input parameters.
+
+     If dropcovered is set, IOCaches which are completely overwritten are
+     invalidated instead, which saves copying the data for large writes. */
 
   firstblock=block & ~globals->iocache_mask;
   lastblock=(block+blocks-1) & ~globals->iocache_mask;
@@ -847,6 +1034,12 @@ void writethroughoverlappingiocaches(BLCK block, ULONG blocks, UBYTE *buffer) {
       /* startblock and endblock (exclusive) now contain the region to be
          overwritten in this IOCache. */
 
+      if(dropcovered!=FALSE && offsetinline==0 && overlappedblocks==ioc->blocks) {
+        invalidateiocache(ioc);
+        firstblock+=globals->iocache_sizeinblocks;
+        continue;
+      }
+
       if(globals->iocache_copyback!=FALSE && (ioc->bits & IOC_DIRTY)!=0) {
 
         /* Copyback mode is active!  We need to unmark any dirty blocks
@@ -881,7 +1074,7 @@ LONG writethrough(BLCK block, UBYTE *buffer, ULONG blocks) {
      mode. */
 
   if(globals->iocache_lines!=0) {
-    writethroughoverlappingiocaches(block,blocks,buffer);
+    writethroughoverlappingiocaches(block,blocks,buffer,TRUE);
   }
 
   return(transfer(DIO_WRITE,buffer,block,blocks));
@@ -889,7 +1082,84 @@ LONG writethrough(BLCK block, UBYTE *buffer, ULONG blocks) {
 
 
 
+static LONG flushwritebehind(void) {
+  LONG errorcode=0;
+
+  /* Writes the contents of the write-behind buffer to disk. */
+
+  if(globals->wb_blocks!=0) {
+    _TDEBUG("flushwritebehind: block %ld, %ld blocks\n", globals->wb_block, globals->wb_blocks);
+
+    if((errorcode=transfer(DIO_WRITE, globals->wb_data, globals->wb_block, globals->wb_blocks))==0) {
+      globals->wb_blocks=0;
+    }
+  }
+
+  return(errorcode);
+}
+
+
+
+static LONG checkwritebehind(BLCK block, ULONG blocks) {
+
+  /* Flushes the write-behind buffer if it holds any of the given blocks,
+     so they can be read from disk or cached again.  As the blocks could
+     be read as part of an IOCache line, the whole lines are checked. */
+
+  if(globals->wb_blocks!=0) {
+    BLCK lastblock=(block+blocks-1) | globals->iocache_mask;
+
+    block&=~globals->iocache_mask;
+
+    if(block<globals->wb_block+globals->wb_blocks && lastblock>=globals->wb_block) {
+      return(flushwritebehind());
+    }
+  }
+
+  return(0);
+}
+
+
+
+static LONG writebehind(BLCK block, UBYTE *buffer, ULONG blocks) {
+  LONG errorcode;
+
+  /* Adds a write to the write-behind buffer.  The buffer is written
+     first if this write doesn't directly follow the data in it, or
+     if it doesn't fit anymore. */
+
+  if(globals->wb_blocks!=0 && (block!=globals->wb_block+globals->wb_blocks || globals->wb_blocks+blocks>globals->wb_maxblocks)) {
+    if((errorcode=flushwritebehind())!=0) {
+      return(errorcode);
+    }
+  }
+
+  writethroughoverlappingiocaches(block, blocks, buffer, TRUE);
+
+  if(globals->wb_blocks==0) {
+    globals->wb_block=block;
+  }
+
+  if(((IPTR)buffer & 0x00000003) != 0) {
+    CopyMem(buffer, globals->wb_data + (globals->wb_blocks<<globals->shifts_block), blocks<<globals->shifts_block);
+  }
+  else {
+    CopyMemQuick(buffer, globals->wb_data + (globals->wb_blocks<<globals->shifts_block), blocks<<globals->shifts_block);
+  }
+
+  globals->wb_blocks+=blocks;
+
+  return(0);
+}
+
+
+
 LONG write(BLCK block, UBYTE *buffer, ULONG blocks) {
+  LONG errorcode;
+
+  if((errorcode=checkwritebehind(block, blocks))!=0) {
+    return(errorcode);
+  }
 
   if(globals->iocache_lines!=0) {
     ULONG maxblocks=globals->iocache_sizeinblocks>>2;
@@ -901,13 +1171,12 @@ LONG write(BLCK block, UBYTE *buffer, ULONG blocks) {
     if(globals->iocache_copyback!=FALSE && blocks<=maxblocks) {
       struct IOCache *ioc;
       struct IOCache *ioc2;
-      LONG errorcode;
 
       if((errorcode=readonwriteintocache(block, &ioc))==0) {              /* a trick, which works because cachesystem consists of atleast 4 blocks. */
         if((errorcode=readonwriteintocache(block+blocks-1, &ioc2))==0) {
           WORD offsetinline=block-ioc->block;
 
-          writethroughoverlappingiocaches(block, blocks, buffer);  /* This function kills dirty blocks if needed. */
+          writethroughoverlappingiocaches(block, blocks, buffer, FALSE);  /* This function kills dirty blocks if needed. */
 
           ioc->bits|=IOC_DIRTY;
 
@@ -930,6 +1199,23 @@ LONG write(BLCK block, UBYTE *buffer, ULONG blocks) {
 
       return(errorcode);
     }
+
+    /* Larger writes bypass the IOCache.  In copyback mode they are
+       collected in the write-behind buffer, so a file written in
+       pieces goes to disk in a few large transfers.  Writes filling
+       at least half of that buffer are large enough already, so
+       unless they can be added to the data in it, they are written
+       directly from the caller's buffer instead of being copied. */
+
+    if(globals->iocache_copyback!=FALSE && globals->wb_data!=0 && blocks<=globals->wb_maxblocks) {
+      if(blocks<globals->wb_maxblocks>>1 || (globals->wb_blocks!=0 && block==globals->wb_block+globals->wb_blocks && globals->wb_blocks+blocks<=globals->wb_maxblocks)) {
+        return(writebehind(block, buffer, blocks));
+      }
+
+      if((errorcode=flushwritebehind())!=0) {
+        return(errorcode);
+      }
+    }
   }
 
   return(writethrough(block, buffer, blocks));
@@ -7,6 +7,7 @@
 
 LONG read(BLCK block, UBYTE *buffer, ULONG blocks);
 LONG write(BLCK block, UBYTE *buffer, ULONG blocks);
+void readahead(BLCK block, ULONG blocks);
 
 LONG readbytes(BLCK block, UBYTE *buffer, UWORD offsetinblock, UWORD bytes);
 LONG writebytes(BLCK block, UBYTE *buffer, UWORD offsetinblock, UWORD bytes);
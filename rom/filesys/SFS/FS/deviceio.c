@@ -331,8 +331,7 @@ void changegeometry(struct DosEnvec *de)
     _DEBUG("Start offset 0x%llu, end offset 0x%llu\n", globals->byte_low, globals->byte_high);
 }
 
-#ifdef DEBUGCODE
-static struct fsIORequest *createiorequest(void)
+struct fsIORequest *createiorequest(void)
 {
     struct fsIORequest *fsi;
 
@@ -351,7 +350,12 @@ static struct fsIORequest *createiorequest(void)
 
     return(fsi);
 }
-#endif
+
+void deleteiorequest(struct fsIORequest *fsi)
+{
+    DeleteIORequest((struct IORequest *)fsi->ioreq);
+    FreeMem(fsi, sizeof(struct fsIORequest));
+}
 
 LONG initdeviceio(UBYTE *devicename, IPTR unit, ULONG flags, struct DosEnvec *de)
 {
@@ -715,6 +719,39 @@ LONG waittransfers(void)
     return(firsterrorcode);
 }
 
+LONG sendtransfer(struct fsIORequest *fsi, UWORD action, UBYTE *buffer, ULONG blockoffset, ULONG blocklength)
+{
+    /* Starts a single transfer, and returns before it is completed.  Use
+       waittransfer() to wait for it.  Returns non-zero and doesn't start
+       anything if the transfer can't be done with a single request of the
+       passed in buffer (it's outside the partition, larger than MaxTransfer
+       or the buffer doesn't match the Mask).  Callers are expected to fall
+       back to transfer() in that case, which takes care of errors. */
+
+    if(blockoffset >= globals->blocks_total || blockoffset + blocklength > globals->blocks_total ||
+       blocklength > globals->blocks_maxtransfer || ((IPTR)buffer & ~globals->mask_mask) != 0) {
+        return(ERROR_OUTSIDE_PARTITION);
+    }
+
+    _TDEBUG("SENDTRANSFER: %ld, buf=0x%p, block=%ld, blocks=%ld\n", action, buffer, blockoffset, blocklength);
+
+    setiorequest(fsi, action, buffer, blockoffset, blocklength);
+
+    starttimeout();
+
+    SendIO((struct IORequest *)fsi->ioreq);
+
+    return(0);
+}
+
+LONG waittransfer(struct fsIORequest *fsi)
+{
+    /* Waits for a transfer started with sendtransfer().  Errors are just
+       returned, no requesters are put up and nothing is retried. */
+
+    return(WaitIO((struct IORequest *)fsi->ioreq));
+}
+
 #if 0
 static LONG asynctransfer(UWORD action, UBYTE *buffer, ULONG blockoffset, ULONG blocklength)
 {
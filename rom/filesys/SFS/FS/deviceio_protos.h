@@ -14,6 +14,13 @@ ULONG deviceapiused(void);
 
 LONG transfer(UWORD action, UBYTE *buffer, ULONG blockoffset, ULONG blocklength);
 
+struct fsIORequest;
+
+struct fsIORequest *createiorequest(void);
+void deleteiorequest(struct fsIORequest *fsi);
+LONG sendtransfer(struct fsIORequest *fsi, UWORD action, UBYTE *buffer, ULONG blockoffset, ULONG blocklength);
+LONG waittransfer(struct fsIORequest *fsi);
+
 LONG initdeviceio(UBYTE *devicename, IPTR unit, ULONG flags, struct DosEnvec *de);
 void cleanupdeviceio(void);
 
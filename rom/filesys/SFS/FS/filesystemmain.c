@@ -165,6 +165,7 @@ static LONG seek(struct ExtFileLock *lock, ULONG offset);
 LONG seektocurrent(struct ExtFileLock *lock);
 LONG seekextent(struct ExtFileLock *lock, ULONG offset, struct CacheBuffer **returned_cb, struct fsExtentBNode **returned_ebn, ULONG *returned_extentoffset);
 void seekforward(struct ExtFileLock *lock, UWORD ebn_blocks, BLCK ebn_next, ULONG bytestoseek);
+static void readaheadfile(struct ExtFileLock *lock, ULONG startoffset);
 LONG writetofile(struct ExtFileLock *lock, UBYTE *buffer, ULONG bytestowrite);
 
 static LONG extendblocksinfile(struct ExtFileLock *lock, ULONG blocks);
@@ -1952,6 +1953,7 @@ void mainloop(void) {
                                     UBYTE *buffer = (UBYTE *)globals->packet->dp_Arg2;
                                     ULONG bytesleft;
                                     UBYTE *startofbuf = buffer;
+                                    ULONG startoffset = lock->offset;
                                     LONG errorcode;
 
                                     bytesleft = globals->packet->dp_Arg3;
@@ -2019,6 +2021,7 @@ void mainloop(void) {
                                         returnpacket(-1, errorcode);
                                     } else {
                                         returnpacket(buffer - startofbuf, 0);
+                                        readaheadfile(lock, startoffset);
                                     }
                                 }
                                 break;
@@ -4233,6 +4236,57 @@ void seekforward(struct ExtFileLock *lock, UWORD ebn_blocks, BLCK ebn_next, ULON
 
 
 
+static void readaheadfile(struct ExtFileLock *lock, ULONG startoffset) {
+    struct CacheBuffer *extent_cb;
+    struct fsExtentBNode *ebn;
+
+    /* Called after a succesful read which started at /startoffset/.  If
+       the read started where the previous read of this lock ended, the
+       number of IOCache lines to read ahead is doubled (up to half the
+       IOCache), otherwise read-ahead is stopped.  The read-ahead itself
+       only covers the rest of the current extent, as the next extent is
+       usually elsewhere on the disk.  It is started after the packet was
+       returned, so the reads run while the application processes the
+       data it got. */
+
+    if(startoffset == lock->readoffset && lock->offset != startoffset) {
+        if(lock->readahead == 0) {
+            lock->readahead = 1;
+        } else if(lock->readahead < globals->iocache_lines >> 1) {
+            lock->readahead <<= 1;
+        }
+    } else {
+        lock->readahead = 0;
+    }
+
+    lock->readoffset = lock->offset;
+
+    if(lock->readahead != 0 && lock->curextent != 0 && lock->offset < lock->gh->size &&
+       findextentbnode(lock->curextent, &extent_cb, &ebn) == 0) {
+        ULONG blockoffset = lock->extentoffset >> globals->shifts_block;
+        ULONG blocks = BE2W(ebn->be_blocks);
+        ULONG maxblocks = lock->readahead * globals->iocache_sizeinblocks;
+        ULONG fileblocks = (lock->gh->size - lock->offset + globals->mask_block) >> globals->shifts_block;
+
+        if(blockoffset < blocks) {
+            blocks -= blockoffset;
+
+            if(blocks > maxblocks) {
+                blocks = maxblocks;
+            }
+            if(blocks > fileblocks) {
+                blocks = fileblocks;
+            }
+
+            _XDEBUG(DEBUG_IO, "readaheadfile: %ld lines, block %ld, blocks %ld\n", lock->readahead, BE2L(ebn->be_key) + blockoffset, blocks);
+
+            readahead(BE2L(ebn->be_key) + blockoffset, blocks);
+        }
+    }
+}
+
+
+
 LONG seektocurrent(struct ExtFileLock *lock) {
     LONG errorcode = 0;
 
@@ -192,6 +192,11 @@ struct SFSBase
     // BYTE iocache_readonwrite=TRUE;       /* Determines whether a new line is read before writing to it. */
     BYTE iocache_readonwrite;       /* Determines whether a new line is read before writing to it. */
 
+    UBYTE *wb_data;                 /* Write-behind buffer for sequential writes, 0 if there is none */
+    BLCK  wb_block;                 /* First block held by the write-behind buffer */
+    ULONG wb_blocks;                /* Number of blocks held by the write-behind buffer */
+    ULONG wb_maxblocks;             /* Size of the write-behind buffer in blocks */
+
     struct EClockVal ecv;
     
     NODE templockedobjectnode;
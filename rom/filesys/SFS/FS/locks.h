@@ -45,6 +45,13 @@ struct ExtFileLock
 
   ULONG lastextendedblock;
 
+  /* Used to detect sequential reads.  readoffset is the file-ptr after the
+     last read, readahead the number of IOCache lines to read ahead of it,
+     which grows while the file is read sequentially. */
+
+  ULONG readoffset;
+  ULONG readahead;
+
   UBYTE bits;          /* EFL_MODIFIED : if file was newly created (FINDOUTPUT or FINDUPDATE) or
                                          modified by using ACTION_WRITE or ACTION_SET_FILE_SIZE
                                          then this bit is set.
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2010-2022, The AROS Development Team. All rights reserved.
+    Copyright (C) 2010-2026, The AROS Development Team. All rights reserved.
 
     Disk cache.
  */
@@ -45,6 +45,28 @@
  * (currently once per second), and additionally whenever the free list
  * becomes empty.
  *
+ * To make use of devices that can process several requests at once, up to
+ * io_count requests are kept outstanding with SendIO(). When a range
+ * directly follows the previously requested one, the ranges after it are
+ * read ahead into blocks taken from the free list. These blocks are in the
+ * hash table, but in the BS_PENDING state and on neither list until their
+ * request has completed. Requesting such a range waits for it. Reads that
+ * fail are simply forgotten, so the range is read again synchronously
+ * (and the user is asked to retry or cancel) when it is needed.
+ *
+ * Flushing sorts the dirty list by block number, and writes runs of up to
+ * 'merge' adjacent ranges with a single request, which are copied into the
+ * request's buffer first. All writes have completed when Cache_Flush()
+ * returns, so a range is never written by two requests at once. Failed
+ * writes are repeated synchronously.
+ *
+ * Large transfers of whole blocks can bypass the cache, going directly
+ * between the disk and the client's buffer in requests of up to
+ * max_transfer bytes. Such reads take the contents of dirty ranges from the
+ * cache, as they are newer than the disk. Such writes first wait for any
+ * overlapping ranges still being read ahead, and then update the cached
+ * ranges they overlap, so the cache never holds stale data.
+ *
  */
 
 #include <dos/dos.h>
@@ -66,6 +88,19 @@
    ((struct BlockRange *)(((A) != NULL) ? \
    (((BYTE *)(A)) - (IPTR)&((struct BlockRange *)NULL)->node2) : NULL))
 
+static struct BlockRange *Cache_FindRange(struct Cache *c, ULONG blockNum);
+static VOID Cache_Prefetch(struct Cache *c, ULONG blockNum);
+static struct CacheIO *Cache_GetIO(struct Cache *c, BOOL wait);
+static VOID Cache_FinishIO(struct Cache *c, struct CacheIO *io);
+static VOID Cache_FinishWrite(struct Cache *c, struct BlockRange **ranges,
+    ULONG count, LONG td_error);
+static VOID Cache_WaitIOs(struct Cache *c);
+static VOID Cache_FreeIOs(struct Cache *c);
+static LONG Cache_AccessDirect(struct Cache *c, BOOL do_write, ULONG blockNum,
+    ULONG nblocks, UBYTE *data);
+static VOID Cache_CopyOverlap(struct Cache *c, struct BlockRange *b,
+    ULONG blockNum, ULONG nblocks, UBYTE *data, BOOL to_cache);
+
 
 APTR Cache_CreateCache(APTR priv, ULONG hash_size, ULONG block_count,
     ULONG block_size, struct ExecBase *sys_base, struct DosLibrary *dos_base)
@@ -108,20 +143,25 @@ APTR Cache_CreateCache(APTR priv, ULONG hash_size, ULONG block_count,
 
         c->blocks = AllocVec(sizeof(APTR) * block_count,
             MEMF_PUBLIC | MEMF_CLEAR);
-        if(c->blocks == NULL)
+        c->sort_buffer = AllocVec(sizeof(APTR) * block_count, MEMF_PUBLIC);
+        if(c->blocks == NULL || c->sort_buffer == NULL)
             success = FALSE;
 
         for(i = 0; i < block_count && success; i++)
         {
             b = AllocVec(sizeof(struct BlockRange)
                 + (c->block_size << RANGE_SHIFT), MEMF_PUBLIC);
-            b->use_count = 0;
-            b->state = BS_EMPTY;
-            b->num = 0;
-            b->data = (UBYTE *)b + sizeof(struct BlockRange);
 
             if(b != NULL)
+            {
+                b->use_count = 0;
+                b->state = BS_EMPTY;
+                b->prefetched = FALSE;
+                b->num = 0;
+                b->data = (UBYTE *)b + sizeof(struct BlockRange);
+                b->io = NULL;
                 c->blocks[i] = b;
+            }
             else
                 success = FALSE;
 
@@ -129,9 +169,16 @@ APTR Cache_CreateCache(APTR priv, ULONG hash_size, ULONG block_count,
                 AddTail((struct List *)&c->free_list,
                     (struct Node *)&b->node2);
         }
+
+        /* Set up asynchronous I/O with the default limits. The cache
+         * still works synchronously if this fails */
+
+        if(success)
+            Cache_SetLimits(c, CACHE_DEF_IO_COUNT, CACHE_DEF_PREFETCH,
+                CACHE_DEF_MERGE, ~0, ~0);
     }
 
-    if(!success)
+    if(!success && c != NULL)
     {
         Cache_DestroyCache(c);
         c = NULL;
@@ -146,11 +193,17 @@ VOID Cache_DestroyCache(APTR cache)
     struct Cache *c = cache;
     ULONG i;
 
-    Cache_Flush(c);
+    if(c->blocks != NULL && c->sort_buffer != NULL)
+        Cache_Flush(c);
+    Cache_FreeIOs(c);
 
-    for(i = 0; i < c->block_count; i++)
-        FreeVec(c->blocks[i]);
+    if(c->blocks != NULL)
+    {
+        for(i = 0; i < c->block_count; i++)
+            FreeVec(c->blocks[i]);
+    }
     FreeVec(c->blocks);
+    FreeVec(c->sort_buffer);
     FreeVec(c->hash_table);
     FreeVec(c);
 }
@@ -159,7 +212,7 @@ VOID Cache_DestroyCache(APTR cache)
 APTR Cache_GetBlock(APTR cache, ULONG blockNum, UBYTE **data)
 {
     struct Cache *c = cache;
-    struct BlockRange *b = NULL, *b2;
+    struct BlockRange *b = NULL;
     LONG error = 0, data_offset;
     struct MinList *l =
         &c->hash_table[(blockNum >> RANGE_SHIFT) & (c->hash_size - 1)];
@@ -171,12 +224,16 @@ APTR Cache_GetBlock(APTR cache, ULONG blockNum, UBYTE **data)
     data_offset = (blockNum - (blockNum & ~RANGE_MASK)) * c->block_size;
     blockNum &= ~RANGE_MASK;
 
-    /* Check existing valid blocks first */
+    /* Check existing valid blocks first, waiting for them if they're still
+     * being read ahead */
+
+    b = Cache_FindRange(c, blockNum);
 
-    ForeachNode(l, b2)
+    if(b != NULL && b->state == BS_PENDING)
     {
-        if(b2->num == blockNum)
-            b = b2;
+        Cache_FinishIO(c, b->io);
+        if(b->state == BS_EMPTY)
+            b = NULL;
     }
 
     if(b != NULL)
@@ -184,6 +241,13 @@ APTR Cache_GetBlock(APTR cache, ULONG blockNum, UBYTE **data)
         /* Block found, so increment its usage count and remove it from the
          * free list */
 
+        c->stats.hits++;
+        if(b->prefetched)
+        {
+            c->stats.prefetch_hits++;
+            b->prefetched = FALSE;
+        }
+
         if(b->use_count++ == 0)
         {
             if(b->state != BS_DIRTY)
@@ -194,13 +258,16 @@ APTR Cache_GetBlock(APTR cache, ULONG blockNum, UBYTE **data)
     {
         /* Get a free buffer to read block from disk */
 
+        c->stats.misses++;
+
         n = (struct MinNode *)RemHead((struct List *)&c->free_list);
         if(n == NULL)
         {
-            /* No free blocks, so flush dirty list to try and free up some
-             * more blocks, then try again */
+            /* No free blocks, so flush dirty list and complete any reads
+             * ahead to try and free up some more blocks, then try again */
 
             Cache_Flush(c);
+            Cache_WaitIOs(c);
 
             n = (struct MinNode *)RemHead((struct List *)&c->free_list);
         }
@@ -226,6 +293,7 @@ APTR Cache_GetBlock(APTR cache, ULONG blockNum, UBYTE **data)
                     AddHead((struct List *)l, (struct Node *)&b->node1);
                     b->num = blockNum;
                     b->state = BS_VALID;
+                    b->prefetched = FALSE;
                     b->use_count = 1;
                 }
                 else
@@ -246,6 +314,15 @@ APTR Cache_GetBlock(APTR cache, ULONG blockNum, UBYTE **data)
             error = ERROR_NO_FREE_STORE;
     }
 
+    /* Read ahead if this range follows the previously requested one */
+
+    if(b != NULL && blockNum != c->last_num)
+    {
+        if(blockNum == c->last_num + RANGE_SIZE && c->prefetch != 0)
+            Cache_Prefetch(c, blockNum);
+        c->last_num = blockNum;
+    }
+
     /* Set data pointer and error, and return cache block handle */
 
     *data = b ? (b->data + data_offset) : NULL;
@@ -293,37 +370,500 @@ BOOL Cache_Flush(APTR cache)
     struct Cache *c = cache;
     LONG error = 0, td_error;
     struct MinNode *n;
-    struct BlockRange *b;
+    struct BlockRange *b, **sorted = c->sort_buffer;
+    struct CacheIO *io;
+    ULONG count = 0, range_size = c->block_size << RANGE_SHIFT, i, j, k;
+
+    /* Take all ranges off the dirty list, sorted by block number */
 
     while((n = (struct MinNode *)RemHead((struct List *)&c->dirty_list))
-        != NULL && error == 0)
+        != NULL)
     {
-        /* Write dirty block range to disk */
         b = NODE2(n);
-        if (b)
+        for(j = count; j > 0 && sorted[j - 1]->num > b->num; j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = b;
+        count++;
+    }
+
+    /* Write each run of adjacent ranges with a single request */
+
+    c->write_failed = FALSE;
+    for(i = 0; i < count; i = j)
+    {
+        for(j = i + 1; j < count && j - i < c->merge
+            && sorted[j]->num == sorted[j - 1]->num + RANGE_SIZE; j++);
+
+        if(c->write_failed)
         {
-            td_error = AccessDisk(TRUE, b->num, RANGE_SIZE, c->block_size,
-                b->data, c->priv);
+            /* Put the ranges back on the dirty list after an error */
 
-            /* Transfer block range to free list if unused, or put back on dirty
-             * list upon an error */
+            for(k = i; k < j; k++)
+                AddTail((struct List *)&c->dirty_list,
+                    (struct Node *)&sorted[k]->node2);
+            continue;
+        }
 
-            if(td_error == 0)
-            {
-                b->state = BS_VALID;
-                if(b->use_count == 0)
-                    AddTail((struct List *)&c->free_list,
-                        (struct Node *)&b->node2);
-            }
-            else
+        c->stats.ranges_written += j - i;
+
+        io = Cache_GetIO(c, TRUE);
+        if(io == NULL)
+        {
+            /* No asynchronous I/O, so write each range directly */
+
+            for(k = i; k < j; k++)
             {
-                AddHead((struct List *)&c->dirty_list, (struct Node *)&b->node2);
-                error = ERROR_UNKNOWN;
+                c->stats.writes++;
+                td_error = AccessDisk(TRUE, sorted[k]->num, RANGE_SIZE,
+                    c->block_size, sorted[k]->data, c->priv);
+                Cache_FinishWrite(c, &sorted[k], 1, td_error);
             }
+            continue;
+        }
+
+        c->stats.writes++;
+
+        io->num = sorted[i]->num;
+        io->nblocks = (j - i) << RANGE_SHIFT;
+        io->range_count = j - i;
+        for(k = i; k < j; k++)
+            io->ranges[k - i] = sorted[k];
+
+        if(j - i == 1)
+            io->data = sorted[i]->data;
+        else
+        {
+            for(k = i; k < j; k++)
+                CopyMem(sorted[k]->data, io->buffer + (k - i) * range_size,
+                    range_size);
+            io->data = io->buffer;
+            c->stats.merged_writes++;
+        }
+
+        io->state = IOS_WRITE;
+        io->seq = c->io_seq++;
+        if(SendDiskIO(io->req, TRUE, io->num, io->nblocks, c->block_size,
+            io->data, c->priv) != 0)
+        {
+            /* Let AccessDisk() report the problem */
+
+            io->state = IOS_IDLE;
+            td_error = AccessDisk(TRUE, io->num, io->nblocks, c->block_size,
+                io->data, c->priv);
+            Cache_FinishWrite(c, io->ranges, io->range_count, td_error);
+        }
+    }
+
+    /* Wait for all writes to complete */
+
+    for(i = 0; i < c->io_count; i++)
+    {
+        if(c->ios[i].state == IOS_WRITE)
+            Cache_FinishIO(c, &c->ios[i]);
+    }
+
+    if(c->write_failed)
+        error = ERROR_UNKNOWN;
+
+    SetIoErr(error);
+    return error == 0;
+}
+
+
+BOOL Cache_SetLimits(APTR cache, ULONG io_count, ULONG prefetch,
+    ULONG merge, ULONG max_transfer, IPTR mask)
+{
+    struct Cache *c = cache;
+    struct CacheIO *io;
+    ULONG range_size = c->block_size << RANGE_SHIFT, i;
+    BOOL success = TRUE;
+
+    /* Changes the number of requests that may be outstanding, the number
+     * of ranges read ahead, and the number of ranges that may be merged
+     * into a single write (which must also fit into max_transfer bytes).
+     * Asynchronous I/O is disabled if the requests can't be allocated.
+     * max_transfer and mask also apply to direct transfers */
+
+    Cache_FreeIOs(c);
+
+    c->max_transfer = max_transfer;
+    c->mask = mask;
+
+    if(merge > max_transfer / range_size)
+        merge = max_transfer / range_size;
+    if(merge == 0)
+        merge = 1;
+    if(prefetch > c->block_count / 4)
+        prefetch = c->block_count / 4;
+
+    if(io_count != 0)
+    {
+        c->ios = AllocVec(sizeof(struct CacheIO) * io_count,
+            MEMF_PUBLIC | MEMF_CLEAR);
+        if(c->ios == NULL)
+            success = FALSE;
+        else
+            c->io_count = io_count;
+
+        for(i = 0; i < io_count && success; i++)
+        {
+            io = &c->ios[i];
+            io->state = IOS_IDLE;
+            io->req = CreateDiskIO(c->priv);
+            io->ranges = AllocVec(sizeof(APTR) * merge, MEMF_PUBLIC);
+            if(merge > 1)
+                io->buffer = AllocVec(range_size * merge, MEMF_PUBLIC);
+            if(io->req == NULL || io->ranges == NULL
+                || (merge > 1 && io->buffer == NULL))
+                success = FALSE;
         }
     }
 
+    if(success)
+    {
+        c->prefetch = io_count != 0 ? prefetch : 0;
+        c->merge = merge;
+    }
+    else
+    {
+        Cache_FreeIOs(c);
+        c->prefetch = 0;
+        c->merge = 1;
+    }
+
+    return success;
+}
+
+
+BOOL Cache_CanAccessDirect(APTR cache, UBYTE *data, ULONG nblocks)
+{
+    struct Cache *c = cache;
+
+    /* Check that the device can transfer directly to or from the whole
+     * buffer */
+
+    return ((IPTR)data & ~c->mask) == 0
+        && ((IPTR)(data + nblocks * c->block_size - 1) & ~c->mask) == 0;
+}
+
+
+BOOL Cache_ReadDirect(APTR cache, ULONG blockNum, ULONG nblocks, UBYTE *data)
+{
+    struct Cache *c = cache;
+    struct BlockRange *b;
+    ULONG num;
+    LONG error;
+
+    /* Read the blocks into the client's buffer, then replace the ones that
+     * have been changed in the cache but not written yet */
+
+    c->stats.direct_reads++;
+    error = Cache_AccessDirect(c, FALSE, blockNum, nblocks, data);
+
+    for(num = blockNum & ~RANGE_MASK; num < blockNum + nblocks && error == 0;
+        num += RANGE_SIZE)
+    {
+        b = Cache_FindRange(c, num);
+        if(b != NULL && b->state == BS_DIRTY)
+            Cache_CopyOverlap(c, b, blockNum, nblocks, data, FALSE);
+    }
+
+    SetIoErr(error);
+    return error == 0;
+}
+
+
+BOOL Cache_WriteDirect(APTR cache, ULONG blockNum, ULONG nblocks,
+    UBYTE *data)
+{
+    struct Cache *c = cache;
+    struct BlockRange *b;
+    ULONG num;
+    LONG error;
+
+    /* Make sure no read ahead can overwrite cached ranges with old data
+     * after they've been updated */
+
+    for(num = blockNum & ~RANGE_MASK; num < blockNum + nblocks;
+        num += RANGE_SIZE)
+    {
+        b = Cache_FindRange(c, num);
+        if(b != NULL && b->state == BS_PENDING)
+            Cache_FinishIO(c, b->io);
+    }
+
+    /* Write the client's buffer, then update the cached ranges. Dirty
+     * ranges stay dirty, as they may also contain other changed blocks */
+
+    c->stats.direct_writes++;
+    error = Cache_AccessDirect(c, TRUE, blockNum, nblocks, data);
+
+    for(num = blockNum & ~RANGE_MASK; num < blockNum + nblocks && error == 0;
+        num += RANGE_SIZE)
+    {
+        b = Cache_FindRange(c, num);
+        if(b != NULL && (b->state == BS_VALID || b->state == BS_DIRTY))
+            Cache_CopyOverlap(c, b, blockNum, nblocks, data, TRUE);
+    }
+
     SetIoErr(error);
     return error == 0;
 }
 
+
+static LONG Cache_AccessDirect(struct Cache *c, BOOL do_write, ULONG blockNum,
+    ULONG nblocks, UBYTE *data)
+{
+    ULONG max_blocks = c->max_transfer / c->block_size, count;
+
+    /* Split the transfer into requests the device accepts */
+
+    if(max_blocks == 0)
+        max_blocks = 1;
+
+    while(nblocks > 0)
+    {
+        count = nblocks < max_blocks ? nblocks : max_blocks;
+        if(AccessDisk(do_write, blockNum, count, c->block_size, data,
+            c->priv) != 0)
+            return ERROR_UNKNOWN;
+
+        blockNum += count;
+        nblocks -= count;
+        data += count * c->block_size;
+    }
+
+    return 0;
+}
+
+
+static VOID Cache_CopyOverlap(struct Cache *c, struct BlockRange *b,
+    ULONG blockNum, ULONG nblocks, UBYTE *data, BOOL to_cache)
+{
+    ULONG first, end;
+    UBYTE *range_data, *buffer_data;
+
+    /* Copy the blocks that are both in the range and in the buffer */
+
+    first = b->num > blockNum ? b->num : blockNum;
+    end = b->num + RANGE_SIZE < blockNum + nblocks ?
+        b->num + RANGE_SIZE : blockNum + nblocks;
+
+    range_data = b->data + (first - b->num) * c->block_size;
+    buffer_data = data + (first - blockNum) * c->block_size;
+
+    if(to_cache)
+        CopyMem(buffer_data, range_data, (end - first) * c->block_size);
+    else
+        CopyMem(range_data, buffer_data, (end - first) * c->block_size);
+}
+
+
+static struct BlockRange *Cache_FindRange(struct Cache *c, ULONG blockNum)
+{
+    struct MinList *l =
+        &c->hash_table[(blockNum >> RANGE_SHIFT) & (c->hash_size - 1)];
+    struct BlockRange *b;
+
+    ForeachNode(l, b)
+    {
+        if(b->num == blockNum)
+            return b;
+    }
+
+    return NULL;
+}
+
+
+static VOID Cache_Prefetch(struct Cache *c, ULONG blockNum)
+{
+    struct BlockRange *b;
+    struct CacheIO *io;
+    struct MinNode *n;
+    ULONG i, num;
+
+    /* Start reading the ranges following blockNum that aren't cached yet,
+     * as long as there are idle requests and free blocks */
+
+    for(i = 1; i <= c->prefetch; i++)
+    {
+        num = blockNum + (i << RANGE_SHIFT);
+        if(num < blockNum)
+            break;
+
+        if(Cache_FindRange(c, num) != NULL)
+            continue;
+
+        if((io = Cache_GetIO(c, FALSE)) == NULL)
+            break;
+
+        n = (struct MinNode *)RemHead((struct List *)&c->free_list);
+        if(n == NULL)
+            break;
+        b = NODE2(n);
+
+        if(SendDiskIO(io->req, FALSE, num, RANGE_SIZE, c->block_size,
+            b->data, c->priv) != 0)
+        {
+            AddHead((struct List *)&c->free_list, (struct Node *)&b->node2);
+            break;
+        }
+
+        if(b->state == BS_VALID)
+            Remove((struct Node *)b);
+        AddHead((struct List *)&c->hash_table[(num >> RANGE_SHIFT)
+            & (c->hash_size - 1)], (struct Node *)&b->node1);
+        b->num = num;
+        b->state = BS_PENDING;
+        b->prefetched = TRUE;
+        b->io = io;
+
+        io->state = IOS_READ;
+        io->seq = c->io_seq++;
+        io->num = num;
+        io->nblocks = RANGE_SIZE;
+        io->data = b->data;
+        io->range_count = 1;
+        io->ranges[0] = b;
+
+        c->stats.prefetches++;
+    }
+}
+
+
+static struct CacheIO *Cache_GetIO(struct Cache *c, BOOL wait)
+{
+    struct CacheIO *io, *oldest = NULL;
+    ULONG i;
+
+    /* Returns an idle request, after finishing any completed ones. If
+     * there is none, the oldest request is waited for if 'wait' is set */
+
+    for(i = 0; i < c->io_count; i++)
+    {
+        io = &c->ios[i];
+        if(io->state != IOS_IDLE && CheckDiskIO(io->req, c->priv))
+            Cache_FinishIO(c, io);
+        if(io->state == IOS_IDLE)
+            return io;
+        if(oldest == NULL || (LONG)(io->seq - oldest->seq) < 0)
+            oldest = io;
+    }
+
+    if(wait && oldest != NULL)
+    {
+        Cache_FinishIO(c, oldest);
+        return oldest;
+    }
+
+    return NULL;
+}
+
+
+static VOID Cache_FinishIO(struct Cache *c, struct CacheIO *io)
+{
+    struct BlockRange *b;
+    LONG td_error;
+
+    /* Wait for a request and update the state of its ranges */
+
+    td_error = WaitDiskIO(io->req, c->priv);
+    if(td_error != 0)
+        c->stats.async_errors++;
+
+    if(io->state == IOS_READ)
+    {
+        b = io->ranges[0];
+        b->io = NULL;
+        if(td_error == 0)
+        {
+            /* Put an unused block at the end of the free list */
+
+            b->state = BS_VALID;
+            AddTail((struct List *)&c->free_list, (struct Node *)&b->node2);
+        }
+        else
+        {
+            /* Forget about the range, it's read again when needed */
+
+            Remove((struct Node *)b);
+            b->state = BS_EMPTY;
+            AddHead((struct List *)&c->free_list, (struct Node *)&b->node2);
+        }
+    }
+    else if(io->state == IOS_WRITE)
+    {
+        /* Repeat a failed write synchronously, so the user can retry */
+
+        if(td_error != 0)
+            td_error = AccessDisk(TRUE, io->num, io->nblocks, c->block_size,
+                io->data, c->priv);
+        Cache_FinishWrite(c, io->ranges, io->range_count, td_error);
+    }
+
+    io->state = IOS_IDLE;
+}
+
+
+static VOID Cache_FinishWrite(struct Cache *c, struct BlockRange **ranges,
+    ULONG count, LONG td_error)
+{
+    struct BlockRange *b;
+    ULONG i;
+
+    /* Transfer written block ranges to the free list if unused, or put them
+     * back on the dirty list upon an error */
+
+    for(i = 0; i < count; i++)
+    {
+        b = ranges[i];
+        if(td_error == 0)
+        {
+            b->state = BS_VALID;
+            if(b->use_count == 0)
+                AddTail((struct List *)&c->free_list,
+                    (struct Node *)&b->node2);
+        }
+        else
+            AddHead((struct List *)&c->dirty_list, (struct Node *)&b->node2);
+    }
+
+    if(td_error != 0)
+        c->write_failed = TRUE;
+}
+
+
+static VOID Cache_WaitIOs(struct Cache *c)
+{
+    ULONG i;
+
+    for(i = 0; i < c->io_count; i++)
+    {
+        if(c->ios[i].state != IOS_IDLE)
+            Cache_FinishIO(c, &c->ios[i]);
+    }
+}
+
+
+static VOID Cache_FreeIOs(struct Cache *c)
+{
+    struct CacheIO *io;
+    ULONG i;
+
+    if(c->ios == NULL)
+        return;
+
+    Cache_WaitIOs(c);
+
+    for(i = 0; i < c->io_count; i++)
+    {
+        io = &c->ios[i];
+        if(io->req != NULL)
+            DeleteDiskIO(io->req, c->priv);
+        FreeVec(io->ranges);
+        FreeVec(io->buffer);
+    }
+    FreeVec(c->ios);
+    c->ios = NULL;
+    c->io_count = 0;
+}
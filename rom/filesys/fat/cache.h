@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2010-2015, The AROS Development Team. All rights reserved.
+    Copyright (C) 2010-2026, The AROS Development Team. All rights reserved.
 
     Disk cache.
 */
@@ -16,8 +16,41 @@ struct BlockRange
     struct MinNode node2;    /* links into free and dirty lists */
     ULONG use_count;    /* number of users of this block */
     UWORD state;
+    UWORD prefetched;    /* read ahead, and not requested since */
     ULONG num;    /* start block number */
     UBYTE *data;    /* actual block data */
+    struct CacheIO *io;    /* request reading this block, if BS_PENDING */
+};
+
+/* An asynchronous device request, with a buffer to merge ranges into */
+
+struct CacheIO
+{
+    APTR req;    /* request from CreateDiskIO() */
+    UWORD state;    /* IOS_#? */
+    ULONG seq;    /* for finding the oldest outstanding request */
+    ULONG num;    /* start block number */
+    ULONG nblocks;    /* number of blocks transferred */
+    UBYTE *data;    /* data being transferred */
+    UBYTE *buffer;    /* buffer for merged writes */
+    ULONG range_count;    /* number of ranges being read or written */
+    struct BlockRange **ranges;    /* the ranges being read or written */
+};
+
+/* Cache statistics, counted in ranges unless stated otherwise */
+
+struct CacheStats
+{
+    ULONG hits;    /* requests found in the cache */
+    ULONG misses;    /* requests read from disk synchronously */
+    ULONG prefetches;    /* ranges read ahead */
+    ULONG prefetch_hits;    /* read-ahead ranges that were requested */
+    ULONG writes;    /* write requests sent to the device */
+    ULONG merged_writes;    /* writes that combined several ranges */
+    ULONG ranges_written;    /* ranges written by all writes */
+    ULONG async_errors;    /* failed requests, that were retried synchronously */
+    ULONG direct_reads;    /* reads that bypassed the cache */
+    ULONG direct_writes;    /* writes that bypassed the cache */
 };
 
 struct Cache
@@ -32,13 +65,43 @@ struct Cache
     struct MinList *hash_table;    /* hash table of all valid cache blocks */
     struct MinList dirty_list;    /* the dirty list */
     struct MinList free_list;    /* the free list */
+    ULONG last_num;    /* range of the previous request */
+
+    /* Asynchronous I/O */
+    ULONG io_count;    /* number of requests that can be outstanding */
+    ULONG prefetch;    /* ranges to read ahead of sequential requests */
+    ULONG merge;    /* maximum ranges written by a single request */
+    ULONG io_seq;
+    BOOL write_failed;    /* a write failed during the current flush */
+    struct CacheIO *ios;    /* array of io_count requests */
+    struct BlockRange **sort_buffer;    /* for sorting the dirty list */
+
+    /* Device limits */
+    ULONG max_transfer;    /* maximum bytes per request */
+    IPTR mask;    /* addresses the device can transfer data to/from */
+
+    struct CacheStats stats;
 };
 
+/* Default limits of asynchronous I/O (see Cache_SetLimits()) */
+
+#define CACHE_DEF_IO_COUNT 4
+#define CACHE_DEF_PREFETCH 4
+#define CACHE_DEF_MERGE 8
+#define CACHE_MAX_IO_COUNT 32
+
+/* Request states */
+
+#define IOS_IDLE 0
+#define IOS_READ 1
+#define IOS_WRITE 2
+
 /* Block states */
 
 #define BS_EMPTY 0
 #define BS_VALID 1
 #define BS_DIRTY 2
+#define BS_PENDING 3    /* being read ahead */
 
 /* Prototypes */
 
@@ -49,8 +112,20 @@ APTR Cache_GetBlock(APTR cache, ULONG blockNum, UBYTE **data);
 VOID Cache_FreeBlock(APTR cache, APTR block);
 VOID Cache_MarkBlockDirty(APTR cache, APTR block);
 BOOL Cache_Flush(APTR cache);
+BOOL Cache_SetLimits(APTR cache, ULONG io_count, ULONG prefetch,
+    ULONG merge, ULONG max_transfer, IPTR mask);
+BOOL Cache_CanAccessDirect(APTR cache, UBYTE *data, ULONG nblocks);
+BOOL Cache_ReadDirect(APTR cache, ULONG blockNum, ULONG nblocks, UBYTE *data);
+BOOL Cache_WriteDirect(APTR cache, ULONG blockNum, ULONG nblocks,
+    UBYTE *data);
 
 LONG AccessDisk(BOOL do_write, ULONG num, ULONG nblocks, ULONG block_size,
     UBYTE *data, APTR priv);
+APTR CreateDiskIO(APTR priv);
+VOID DeleteDiskIO(APTR io, APTR priv);
+LONG SendDiskIO(APTR io, BOOL do_write, ULONG num, ULONG nblocks,
+    ULONG block_size, UBYTE *data, APTR priv);
+BOOL CheckDiskIO(APTR io, APTR priv);
+LONG WaitDiskIO(APTR io, APTR priv);
 
 #endif
@@ -2,7 +2,7 @@
  * fat-handler - FAT12/16/32 filesystem handler
  *
  * Copyright (C) 2006 Marek Szyprowski
- * Copyright (C) 2007-2015 The AROS Development Team
+ * Copyright (C) 2007-2026 The AROS Development Team
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the same terms as AROS itself.
@@ -134,31 +134,21 @@ void Probe64BitSupport(struct Globals *glob)
         }
 }
 
-/* N.B. returns an Exec error code, not a DOS error code! */
-LONG AccessDisk(BOOL do_write, ULONG num, ULONG nblocks, ULONG block_size,
-    UBYTE *data, APTR priv)
+/* Adjust parameters if range is partially outside boundaries, or
+ * warn user (unless quiet) and bale out if completely outside boundaries */
+static LONG ClipDiskAccess(struct Globals *glob, BOOL do_write, ULONG *pnum,
+    ULONG *pnblocks, ULONG block_size, UBYTE **pdata, BOOL quiet)
 {
-    struct Globals *glob = priv;
-    UQUAD off;
-    ULONG err;
+    ULONG num = *pnum, nblocks = *pnblocks;
+    UBYTE *data = *pdata;
     ULONG start, end;
-    BOOL retry = TRUE;
-    TEXT vol_name[100];
 
-#if DEBUG_CACHESTATS > 1
-    ErrorMessage("Accessing %lu sector(s) starting at %lu.\n"
-        "First volume sector is %lu, sector size is %lu.\n", "OK", nblocks,
-         num, glob->sb->first_device_sector, block_size);
-#endif
-
-    /* Adjust parameters if range is partially outside boundaries, or
-     * warn user and bale out if completely outside boundaries */
     if (glob->sb)
     {
         start = glob->sb->first_device_sector;
         if (num + nblocks <= glob->sb->first_device_sector)
         {
-            if (num != glob->last_num)
+            if (!quiet && num != glob->last_num)
             {
                 glob->last_num = num;
                 ErrorMessage("A handler attempted to %s %lu sector(s)\n"
@@ -182,7 +172,7 @@ LONG AccessDisk(BOOL do_write, ULONG num, ULONG nblocks, ULONG block_size,
         end = glob->sb->first_device_sector + glob->sb->total_sectors;
         if (num >= end)
         {
-            if (num != glob->last_num)
+            if (!quiet && num != glob->last_num)
             {
                 glob->last_num = num;
                 ErrorMessage("A handler attempted to %s %lu sector(s)\n"
@@ -200,17 +190,49 @@ LONG AccessDisk(BOOL do_write, ULONG num, ULONG nblocks, ULONG block_size,
             nblocks = end - num;
     }
 
-    off = ((UQUAD) num) * block_size;
+    *pnum = num;
+    *pnblocks = nblocks;
+    *pdata = data;
+
+    return 0;
+}
+
+static VOID SetupDiskIO(struct Globals *glob, struct IOExtTD *req,
+    BOOL do_write, ULONG num, ULONG nblocks, ULONG block_size, UBYTE *data)
+{
+    UQUAD off = ((UQUAD) num) * block_size;
+
+    req->iotd_Req.io_Offset = off & 0xFFFFFFFF;
+    req->iotd_Req.io_Actual = off >> 32;
+
+    req->iotd_Req.io_Length = nblocks * block_size;
+    req->iotd_Req.io_Data = data;
+    req->iotd_Req.io_Command = do_write ? glob->writecmd : glob->readcmd;
+}
+
+/* N.B. returns an Exec error code, not a DOS error code! */
+LONG AccessDisk(BOOL do_write, ULONG num, ULONG nblocks, ULONG block_size,
+    UBYTE *data, APTR priv)
+{
+    struct Globals *glob = priv;
+    ULONG err;
+    BOOL retry = TRUE;
+    TEXT vol_name[100];
+
+#if DEBUG_CACHESTATS > 1
+    ErrorMessage("Accessing %lu sector(s) starting at %lu.\n"
+        "First volume sector is %lu, sector size is %lu.\n", "OK", nblocks,
+         num, glob->sb->first_device_sector, block_size);
+#endif
+
+    if ((err = ClipDiskAccess(glob, do_write, &num, &nblocks, block_size,
+        &data, FALSE)) != 0)
+        return err;
 
     while (retry)
     {
-        glob->diskioreq->iotd_Req.io_Offset = off & 0xFFFFFFFF;
-        glob->diskioreq->iotd_Req.io_Actual = off >> 32;
-
-        glob->diskioreq->iotd_Req.io_Length = nblocks * block_size;
-        glob->diskioreq->iotd_Req.io_Data = data;
-        glob->diskioreq->iotd_Req.io_Command =
-            do_write ? glob->writecmd : glob->readcmd;
+        SetupDiskIO(glob, glob->diskioreq, do_write, num, nblocks, block_size,
+            data);
 
         err = DoIO((struct IORequest *)glob->diskioreq);
 
@@ -241,3 +263,58 @@ LONG AccessDisk(BOOL do_write, ULONG num, ULONG nblocks, ULONG block_size,
 
     return err;
 }
+
+/* Asynchronous disk access for the cache. Errors are just returned, so
+ * that the cache can repeat failed requests with AccessDisk(), which
+ * lets the user retry them */
+
+APTR CreateDiskIO(APTR priv)
+{
+    struct Globals *glob = priv;
+    struct IOExtTD *req;
+
+    if ((req = AllocVec(sizeof(struct IOExtTD), MEMF_PUBLIC)) != NULL)
+        CopyMem(glob->diskioreq, req, sizeof(struct IOExtTD));
+
+    return req;
+}
+
+VOID DeleteDiskIO(APTR io, APTR priv)
+{
+    struct Globals *glob = priv;
+
+    FreeVec(io);
+}
+
+/* N.B. returns an Exec error code, not a DOS error code! Nothing is sent
+ * if an error is returned. Requests outside the volume are refused without
+ * warning, as the cache reads ahead blindly */
+LONG SendDiskIO(APTR io, BOOL do_write, ULONG num, ULONG nblocks,
+    ULONG block_size, UBYTE *data, APTR priv)
+{
+    struct Globals *glob = priv;
+    LONG err;
+
+    if ((err = ClipDiskAccess(glob, do_write, &num, &nblocks, block_size,
+        &data, !do_write)) != 0)
+        return err;
+
+    SetupDiskIO(glob, io, do_write, num, nblocks, block_size, data);
+    SendIO((struct IORequest *)io);
+
+    return 0;
+}
+
+BOOL CheckDiskIO(APTR io, APTR priv)
+{
+    struct Globals *glob = priv;
+
+    return CheckIO((struct IORequest *)io) != NULL;
+}
+
+LONG WaitDiskIO(APTR io, APTR priv)
+{
+    struct Globals *glob = priv;
+
+    return WaitIO((struct IORequest *)io);
+}
@@ -2,7 +2,7 @@
  * fat-handler - FAT12/16/32 filesystem handler
  *
  * Copyright (C) 2006 Marek Szyprowski
- * Copyright (C) 2007-2018 The AROS Development Team
+ * Copyright (C) 2007-2026 The AROS Development Team
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the same terms as AROS itself.
@@ -26,6 +26,7 @@
 
 #include <dos/dos.h>
 #include <exec/interrupts.h>
+#include <utility/tagitem.h>
 
 #include "fat_struct.h"
 
@@ -50,6 +51,41 @@
 #define ACTION_VOLUME_ADD 16000
 #define ACTION_VOLUME_REMOVE 16001
 
+/* Handler specific packets */
+
+#define ACTION_FAT_QUERY 16002
+
+/*
+ * ACTION_FAT_QUERY
+ *
+ * arg1: (struct TagItem *); Pointer to a TagList.
+ *
+ * res1: DOSTRUE if no error occured.
+ * res2: If res1 is DOSFALSE, then this contains the errorcode.
+ *
+ * Fills the tags in the taglist with the cache limits and statistics of the
+ * current volume (see struct CacheStats for the meaning of the counters).
+ * The limits are taken from the Control field of the mount entry, e.g.
+ * Control = "IOCOUNT=8 PREFETCH=8 MERGE=16".
+ */
+
+#define FQBASE                      (TAG_USER)
+
+#define FQ_CACHE_IO_COUNT           (FQBASE + 1)
+#define FQ_CACHE_PREFETCH           (FQBASE + 2)
+#define FQ_CACHE_MERGE              (FQBASE + 3)
+
+#define FQ_CACHE_HITS               (FQBASE + 101)
+#define FQ_CACHE_MISSES             (FQBASE + 102)
+#define FQ_CACHE_PREFETCHES         (FQBASE + 103)
+#define FQ_CACHE_PREFETCH_HITS      (FQBASE + 104)
+#define FQ_CACHE_WRITES             (FQBASE + 105)
+#define FQ_CACHE_MERGED_WRITES      (FQBASE + 106)
+#define FQ_CACHE_RANGES_WRITTEN     (FQBASE + 107)
+#define FQ_CACHE_ASYNC_ERRORS       (FQBASE + 108)
+#define FQ_CACHE_DIRECT_READS       (FQBASE + 109)
+#define FQ_CACHE_DIRECT_WRITES      (FQBASE + 110)
+
 #define DEF_POOL_SIZE 65536
 #define DEF_POOL_THRESHOLD DEF_POOL_SIZE
 
@@ -263,6 +299,9 @@ struct Globals
     struct timerequest *timereq;
     struct MsgPort *timerport;
     ULONG last_num;    /* last block number that was outside boundaries */
+    ULONG cache_io_count;    /* asynchronous I/O limits of the cache */
+    ULONG cache_prefetch;
+    ULONG cache_merge;
     UWORD readcmd;
     UWORD writecmd;
     BOOL timer_active;
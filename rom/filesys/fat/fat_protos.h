@@ -70,6 +70,7 @@ void AllocCluster(struct FSSuper *sb, ULONG cluster);
 void FreeCluster(struct FSSuper *sb, ULONG cluster);
 
 /* volume.c */
+void InitCacheLimits(struct Globals *glob);
 LONG ReadFATSuper(struct FSSuper *s);
 LONG FormatFATVolume(const UBYTE *name, UWORD len, struct Globals *glob);
 LONG CompareFATSuper(struct FSSuper *s1, struct FSSuper *s2);
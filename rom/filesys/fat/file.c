@@ -2,7 +2,7 @@
  * fat-handler - FAT12/16/32 filesystem handler
  *
  * Copyright (C) 2006 Marek Szyprowski
- * Copyright (C) 2007-2015 The AROS Development Team
+ * Copyright (C) 2007-2026 The AROS Development Team
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the same terms as AROS itself.
@@ -72,6 +72,89 @@ static void HexDump(unsigned char *buf, int bufsz, struct Globals *glob)
 #define HexDump(b, c, g)
 #endif
 
+/* Runs of whole sectors at least this long are transferred directly between
+ * the disk and the caller's buffer instead of through the cache */
+#define DIRECT_MIN_SECTORS 32
+
+/*
+ * Transfers as many of the nsectors sectors starting at the handle's
+ * current sector as lie in contiguous clusters directly, if there are at
+ * least DIRECT_MIN_SECTORS of them. When writing, clusters are added to the
+ * end of the file as needed. Afterwards the handle is in the cluster that
+ * holds the last sector transferred. *ndone is set to the number of
+ * sectors transferred, which is zero if the run was too short.
+ */
+static LONG DirectTransfer(struct IOHandle *ioh, BOOL do_write,
+    ULONG nsectors, UBYTE *data, ULONG *ndone)
+{
+    struct FSSuper *sb = ioh->sb;
+    ULONG cluster = ioh->cur_cluster, next_cluster, count, clusters = 0;
+    BOOL success;
+
+    *ndone = 0;
+
+    /* Find out how far the current cluster continues contiguously */
+    count = sb->cluster_sectors - ioh->sector_offset;
+    while (count < nsectors)
+    {
+        next_cluster = GET_NEXT_CLUSTER(sb, cluster);
+
+        if (next_cluster == 0 || next_cluster >= sb->eoc_mark - 7)
+        {
+            /* Leave errors at the end of the file or a full disk for the
+             * normal path to report */
+            if (!do_write || FindFreeCluster(sb, &next_cluster) != 0)
+                break;
+
+            SET_NEXT_CLUSTER(sb, cluster, next_cluster);
+            AllocCluster(sb, next_cluster);
+
+            D(bug("[fat] allocated cluster %d\n", next_cluster));
+        }
+
+        if (next_cluster != cluster + 1)
+            break;
+
+        cluster = next_cluster;
+        clusters++;
+        count += sb->cluster_sectors;
+    }
+    if (count > nsectors)
+        count = nsectors;
+
+    if (count < DIRECT_MIN_SECTORS)
+        return 0;
+
+    D(bug("[fat] %s %ld sectors directly from sector %ld\n",
+        do_write ? "writing" : "reading", count, ioh->cur_sector));
+
+    /* The handle won't be in its current sector any more */
+    if (ioh->block != NULL)
+    {
+        Cache_FreeBlock(sb->cache, ioh->block);
+        ioh->block = NULL;
+    }
+
+    if (do_write)
+        success = Cache_WriteDirect(sb->cache,
+            sb->first_device_sector + ioh->cur_sector, count, data);
+    else
+        success = Cache_ReadDirect(sb->cache,
+            sb->first_device_sector + ioh->cur_sector, count, data);
+    if (!success)
+        return IoErr();
+
+    /* Move to the last cluster, and make the next transfer recalculate its
+     * sector */
+    ioh->cur_cluster = cluster;
+    ioh->cluster_offset += clusters;
+    ioh->sector_offset = 0xffffffff;
+
+    *ndone = count;
+
+    return 0;
+}
+
 LONG ReadFileChunk(struct IOHandle *ioh, ULONG file_pos, ULONG nwant,
     UBYTE *data, ULONG *nread)
 {
@@ -190,6 +273,40 @@ LONG ReadFileChunk(struct IOHandle *ioh, ULONG file_pos, ULONG nwant,
                     ioh->sector_offset, ioh->cur_sector));
         }
 
+        /* Transfer long runs of whole sectors without the cache */
+        if (byte_offset == 0 && ioh->first_cluster != 0
+            && (nwant >> ioh->sb->sectorsize_bits) >= DIRECT_MIN_SECTORS
+            && Cache_CanAccessDirect(ioh->sb->cache, data + pos,
+                nwant >> ioh->sb->sectorsize_bits))
+        {
+            LONG err;
+
+            err = DirectTransfer(ioh, FALSE,
+                nwant >> ioh->sb->sectorsize_bits, data + pos, &ncopy);
+            if (err != 0)
+            {
+                RESET_HANDLE(ioh);
+
+                D(bug("[fat] direct transfer failed, returning error %ld\n",
+                    err));
+
+                return err;
+            }
+
+            if (ncopy != 0)
+            {
+                ncopy <<= ioh->sb->sectorsize_bits;
+                pos += ncopy;
+                nwant -= ncopy;
+                sector_offset += ncopy >> ioh->sb->sectorsize_bits;
+
+                D(bug("[fat] read %ld bytes directly, want %ld more\n",
+                    ncopy, nwant));
+
+                continue;
+            }
+        }
+
         /* If we don't have the wanted block kicking around, we need to bring
          * it in from the cache */
         if (ioh->block == NULL || ioh->cur_sector != old_sector)
@@ -392,6 +509,38 @@ LONG WriteFileChunk(struct IOHandle *ioh, ULONG file_pos, ULONG nwant,
                     ioh->sector_offset, ioh->cur_sector));
         }
 
+        /* Transfer long runs of whole sectors without the cache */
+        if (byte_offset == 0 && ioh->first_cluster != 0
+            && (nwant >> ioh->sb->sectorsize_bits) >= DIRECT_MIN_SECTORS
+            && Cache_CanAccessDirect(ioh->sb->cache, data + pos,
+                nwant >> ioh->sb->sectorsize_bits))
+        {
+            err = DirectTransfer(ioh, TRUE,
+                nwant >> ioh->sb->sectorsize_bits, data + pos, &ncopy);
+            if (err != 0)
+            {
+                RESET_HANDLE(ioh);
+
+                D(bug("[fat] direct transfer failed, returning error %ld\n",
+                    err));
+
+                return err;
+            }
+
+            if (ncopy != 0)
+            {
+                ncopy <<= ioh->sb->sectorsize_bits;
+                pos += ncopy;
+                nwant -= ncopy;
+                sector_offset += ncopy >> ioh->sb->sectorsize_bits;
+
+                D(bug("[fat] wrote %ld bytes directly, want %ld more\n",
+                    ncopy, nwant));
+
+                continue;
+            }
+        }
+
         /* If we don't have the wanted block kicking around, we need to bring
          * it in from the cache */
         if (ioh->block == NULL || ioh->cur_sector != old_sector)
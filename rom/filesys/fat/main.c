@@ -2,7 +2,7 @@
  * fat-handler - FAT12/16/32 filesystem handler
  *
  * Copyright (C) 2006 Marek Szyprowski
- * Copyright (C) 2007-2020 The AROS Development Team
+ * Copyright (C) 2007-2026 The AROS Development Team
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the same terms as AROS itself.
@@ -80,6 +80,7 @@ static struct Globals *fat_init(struct Process *proc, struct DosPacket *dp,
                 glob->notifyport = CreateMsgPort();
 
                 glob->fssm = BADDR(dp->dp_Arg2);
+                InitCacheLimits(glob);
 
                 if ((glob->mempool = CreatePool(MEMF_PUBLIC, DEF_POOL_SIZE,
                     DEF_POOL_THRESHOLD)))
@@ -2,7 +2,7 @@
  * fat-handler - FAT12/16/32 filesystem handler
  *
  * Copyright (C) 2006 Marek Szyprowski
- * Copyright (C) 2007-2015 The AROS Development Team
+ * Copyright (C) 2007-2026 The AROS Development Team
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the same terms as AROS itself.
@@ -19,6 +19,7 @@
 
 #include <proto/exec.h>
 #include <proto/dos.h>
+#include <proto/utility.h>
 
 #include <string.h>
 
@@ -826,6 +827,71 @@ void ProcessPackets(struct Globals *glob)
                 break;
             }
 
+        case ACTION_FAT_QUERY:
+            {
+                struct TagItem *tags = (struct TagItem *)pkt->dp_Arg1;
+                struct TagItem *tag;
+                struct Cache *c;
+
+                D(bug("[fat] FAT_QUERY: tags 0x%08x\n", tags));
+
+                if (glob->sb == NULL)
+                {
+                    err = ERROR_NO_DISK;
+                    break;
+                }
+                c = glob->sb->cache;
+
+                while ((tag = NextTagItem(&tags)) != NULL)
+                {
+                    switch (tag->ti_Tag)
+                    {
+                    case FQ_CACHE_IO_COUNT:
+                        tag->ti_Data = c->io_count;
+                        break;
+                    case FQ_CACHE_PREFETCH:
+                        tag->ti_Data = c->prefetch;
+                        break;
+                    case FQ_CACHE_MERGE:
+                        tag->ti_Data = c->merge;
+                        break;
+                    case FQ_CACHE_HITS:
+                        tag->ti_Data = c->stats.hits;
+                        break;
+                    case FQ_CACHE_MISSES:
+                        tag->ti_Data = c->stats.misses;
+                        break;
+                    case FQ_CACHE_PREFETCHES:
+                        tag->ti_Data = c->stats.prefetches;
+                        break;
+                    case FQ_CACHE_PREFETCH_HITS:
+                        tag->ti_Data = c->stats.prefetch_hits;
+                        break;
+                    case FQ_CACHE_WRITES:
+                        tag->ti_Data = c->stats.writes;
+                        break;
+                    case FQ_CACHE_MERGED_WRITES:
+                        tag->ti_Data = c->stats.merged_writes;
+                        break;
+                    case FQ_CACHE_RANGES_WRITTEN:
+                        tag->ti_Data = c->stats.ranges_written;
+                        break;
+                    case FQ_CACHE_ASYNC_ERRORS:
+                        tag->ti_Data = c->stats.async_errors;
+                        break;
+                    case FQ_CACHE_DIRECT_READS:
+                        tag->ti_Data = c->stats.direct_reads;
+                        break;
+                    case FQ_CACHE_DIRECT_WRITES:
+                        tag->ti_Data = c->stats.direct_writes;
+                        break;
+                    }
+                }
+
+                res = DOSTRUE;
+                break;
+            }
+
         default:
             D(bug("[fat] got unknown packet type %ld\n", pkt->dp_Type));
 
@@ -1,7 +1,7 @@
 /*
  * fat-handler - FAT12/16/32 filesystem handler
  *
- * Copyright (C) 2007-2020 The AROS Development Team
+ * Copyright (C) 2007-2026 The AROS Development Team
  * Copyright (C) 2006 Marek Szyprowski
  *
  * This program is free software; you can redistribute it and/or modify it
@@ -19,6 +19,8 @@
 #include <devices/inputevent.h>
 #include <dos/dos.h>
 #include <dos/dosextens.h>
+#include <dos/filehandler.h>
+#include <dos/rdargs.h>
 
 #include <clib/alib_protos.h>
 
@@ -33,6 +35,8 @@
 #define DEBUG DEBUG_MISC
 #include "debug.h"
 
+#define CONTROL_TEMPLATE "IOCOUNT=IO/K/N,PREFETCH/K/N,MERGE/K/N"
+
 static const UBYTE default_oem_name[] = "MSWIN4.1";
 static const UBYTE default_filsystype[] = "FAT16   ";
 
@@ -70,6 +74,68 @@ static LONG GetVolumeIdentity(struct FSSuper *sb,
     struct VolumeIdentity *volume);
 static void FreeFATSuper(struct FSSuper *s);
 
+/* Takes the asynchronous I/O limits of the cache from the Control field of
+ * the mount entry, or uses the defaults */
+void InitCacheLimits(struct Globals *glob)
+{
+    struct DosEnvec *de =
+        glob->fssm != NULL ? BADDR(glob->fssm->fssm_Environ) : NULL;
+    struct RDArgs *rda;
+    IPTR args[3] = {0, 0, 0};
+    UBYTE *control;
+    ULONG len, i;
+
+    glob->cache_io_count = CACHE_DEF_IO_COUNT;
+    glob->cache_prefetch = CACHE_DEF_PREFETCH;
+    glob->cache_merge = CACHE_DEF_MERGE;
+
+    if (de == NULL || de->de_TableSize < DE_CONTROL
+        || (BSTR)de->de_Control == BNULL)
+        return;
+
+    len = AROS_BSTR_strlen((BSTR)de->de_Control);
+    control = AllocVec(len + 2, MEMF_ANY);
+    if (control == NULL)
+        return;
+    CopyMem(AROS_BSTR_ADDR((BSTR)de->de_Control), control, len);
+
+    /* Mount may leave the quotes around the field */
+    for (i = 0; i < len; i++)
+        if (control[i] == '"')
+            control[i] = ' ';
+    control[len] = '\n';
+    control[len + 1] = '\0';
+
+    rda = AllocDosObject(DOS_RDARGS, NULL);
+    if (rda != NULL)
+    {
+        rda->RDA_Source.CS_Buffer = control;
+        rda->RDA_Source.CS_Length = len + 1;
+        rda->RDA_Source.CS_CurChr = 0;
+        rda->RDA_Flags |= RDAF_NOPROMPT;
+
+        if (ReadArgs(CONTROL_TEMPLATE, args, rda) != NULL)
+        {
+            if (args[0] != 0)
+                glob->cache_io_count =
+                    MIN(*(ULONG *)args[0], CACHE_MAX_IO_COUNT);
+            if (args[1] != 0)
+                glob->cache_prefetch = *(ULONG *)args[1];
+            if (args[2] != 0)
+                glob->cache_merge = *(ULONG *)args[2];
+            FreeArgs(rda);
+        }
+        else
+            D(bug("[fat] Ignoring control field '%s'\n", control));
+
+        FreeDosObject(DOS_RDARGS, rda);
+    }
+    FreeVec(control);
+
+    D(bug("[fat] Cache limits: %lu requests, %lu read ahead, %lu merged\n",
+        glob->cache_io_count, glob->cache_prefetch, glob->cache_merge));
+}
+
 LONG ReadFATSuper(struct FSSuper *sb)
 {
     struct Globals *glob = sb->glob;
@@ -243,6 +309,14 @@ LONG ReadFATSuper(struct FSSuper *sb)
         return err;
     }
 
+    /* Don't merge more dirty blocks into a single write, or transfer more
+     * data directly, than the device accepts, and only transfer directly
+     * to and from memory the device can reach */
+    Cache_SetLimits(sb->cache, glob->cache_io_count, glob->cache_prefetch,
+        glob->cache_merge,
+        de->de_TableSize >= DE_MAXTRANSFER ? de->de_MaxTransfer : ~0,
+        de->de_TableSize >= DE_MASK ? de->de_Mask : ~0);
+
     if (sb->clusters_count < 4085)
     {
         D(bug("\tFAT12 filesystem detected\n"));
@@ -831,6 +905,19 @@ static void FreeFATSuper(struct FSSuper *sb)
 {
     struct Globals *glob = sb->glob;
     D(bug("\tRemoving Super Block from memory\n"));
+#if DEBUG_CACHESTATS > 0
+    {
+        struct CacheStats *stats = &((struct Cache *)sb->cache)->stats;
+
+        bug("[fat] cache: %lu hits, %lu misses, %lu read ahead"
+            " (%lu used), %lu writes (%lu merged, %lu ranges),"
+            " %lu async errors, %lu direct reads, %lu direct writes\n",
+            stats->hits, stats->misses, stats->prefetches,
+            stats->prefetch_hits, stats->writes, stats->merged_writes,
+            stats->ranges_written, stats->async_errors, stats->direct_reads,
+            stats->direct_writes);
+    }
+#endif
     Cache_DestroyCache(sb->cache);
     FreeVecPooled(glob->mempool, sb->fat_buffers);
     sb->fat_buffers = NULL;
@@ -522,7 +522,7 @@ static struct canodeblock *big_GetAnodeBlock (UWORD seqnr, globaldata *g)
 	}
 
 	/* check cache */
-	ablock = (struct canodeblock *)CheckCache (volume->anblks, HASHM_ANODE, blocknr, g);
+	ablock = (struct canodeblock *)CheckCache (&volume->anblks, blocknr, g);
 	if (ablock)
 		return ablock;
 
@@ -558,7 +558,7 @@ static struct canodeblock *big_GetAnodeBlock (UWORD seqnr, globaldata *g)
 	ablock->blocknr    = blocknr;
 	ablock->used       = FALSE;
 	ablock->changeflag = FALSE;
-	Hash (ablock, volume->anblks, HASHM_ANODE);
+	Hash (ablock, &volume->anblks);
 
 	return ablock;
 }
@@ -603,7 +603,7 @@ static struct canodeblock *big_NewAnodeBlock (UWORD seqnr, globaldata *g)
 	blok->blk.id     = ABLKID;
 	blok->blk.seqnr  = seqnr;
 	blok->changeflag = TRUE;
-	Hash(blok, volume->anblks, HASHM_ANODE);
+	Hash(blok, &volume->anblks);
 	MakeBlockDirty((struct cachedblock *)indexblock, g);
 	indexblock->used = oldlock;         // unlock block
 
@@ -490,7 +490,7 @@ struct cachedblock
 	ULONG	oldblocknr;				// the blocknr before reallocation. NULL if not reallocated.
 	UWORD	used;					// block locked if used == g->locknr
 	UBYTE	changeflag;				// dirtyflag
-	UBYTE	dummy;					// pad to make offset even
+	UBYTE	accesses;				// LRU access counter (see MakeLRU)
 	UBYTE	data[0];				// the datablock;
 };
 
@@ -104,6 +104,7 @@ static int dd_CheckCustomPacket(LONG id);
 static SIPTR dd_IsPFS2 (struct DosPacket *pkt, globaldata *g);
 static SIPTR dd_KillEmpty(struct DosPacket *pkt, globaldata * g);
 static SIPTR dd_RemoveDirEntry(struct DosPacket *pkt, globaldata * g);
+static SIPTR dd_CacheInfo(struct DosPacket *pkt, globaldata *g);
 
 #if EXTRAPACKETS
 static SIPTR dd_Sleep(struct DosPacket *pkt, globaldata * g);
@@ -994,6 +995,9 @@ static SIPTR dd_AddBuffers(struct DosPacket *pkt, globaldata * g)
 	while (!InitLRU(g, SIZEOF_RESBLOCK))
 		g->dosenvec->de_NumBuffers--;
 
+	/* all blocks have been flushed, so the hash tables can be resized */
+	SizeBlockHashes(g->currentvolume, g);
+
 	pkt->dp_Res2 = g->dosenvec->de_NumBuffers;
 	return (LONG)g->dosenvec->de_NumBuffers;
 }
@@ -2121,6 +2125,52 @@ static SIPTR dd_SetFileSize(struct DosPacket *pkt, globaldata *g)
 	return DOSFALSE;
 }
 
+/* get cache statistics */
+static SIPTR dd_CacheInfo(struct DosPacket *pkt, globaldata *g)
+{
+	// ACTION_CACHE_INFO 2223
+	// ARG1 = MODE_PFS2_DISK
+	// ARG2 = struct cacheinfo * to fill in
+	// ARG3 = size of the struct cacheinfo buffer
+	// ARG4 = TRUE to reset the counters afterwards
+	// RES1 = success
+	// RES2 = failure code / number of bytes filled in
+
+	struct cacheinfo ci;
+	struct volumedata *volume = g->currentvolume;
+
+	if (!dd_CheckCustomPacket(pkt->dp_Arg1))
+		return DOSFALSE;
+
+	if (!volume)
+	{
+		pkt->dp_Res2 = ERROR_NO_DISK;
+		return DOSFALSE;
+	}
+
+	ci.buffers = g->glob_lrudata.poolsize;
+	ci.dirhashsize = volume->dirblks.mask + 1;
+	ci.anodehashsize = volume->anblks.mask + 1;
+	ci.dirhits = volume->dirblks.hits;
+	ci.dirmisses = volume->dirblks.misses;
+	ci.anodehits = volume->anblks.hits;
+	ci.anodemisses = volume->anblks.misses;
+	ci.reused = g->glob_lrudata.reused;
+	ci.secondchances = g->glob_lrudata.secondchances;
+
+	pkt->dp_Res2 = min((ULONG)pkt->dp_Arg3, sizeof(ci));
+	CopyMem(&ci, (APTR)pkt->dp_Arg2, pkt->dp_Res2);
+
+	if (pkt->dp_Arg4)
+	{
+		volume->dirblks.hits = volume->dirblks.misses = 0;
+		volume->anblks.hits = volume->anblks.misses = 0;
+		g->glob_lrudata.reused = g->glob_lrudata.secondchances = 0;
+	}
+
+	return DOSTRUE;
+}
+
 #if defined(__MORPHOS__)
 static LONG dd_MorphOSQueryAttr(struct DosPacket *pkt, globaldata *g)
 {
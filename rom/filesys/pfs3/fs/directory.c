@@ -1726,7 +1726,7 @@ struct cdirblock *MakeDirBlock(ULONG blocknr, ULONG anodenr, ULONG rootanodenr,
 	blk->oldblocknr = 0;
 	blk->changeflag = TRUE;
 
-	Hash(blk, volume->dirblks, HASHM_DIR);
+	Hash(blk, &volume->dirblks);
 	LOCK(blk);
 	return blk;
 }
@@ -1863,7 +1863,7 @@ static BOOL DeleteDir(union objectinfo *info, SIPTR *error, globaldata * g)
 			GetAnode(&anode, anode.next, g);
 
 			/* remove dirblock from list if there */
-			dirblk = (struct cdirblock *)CheckCache(volume->dirblks, HASHM_DIR, anode.blocknr, g);
+			dirblk = (struct cdirblock *)CheckCache(&volume->dirblks, anode.blocknr, g);
 			if (dirblk)
 			{
 				MinRemove(dirblk);
@@ -3487,7 +3487,7 @@ struct cdirblock *LoadDirBlock(ULONG blocknr, globaldata * g)
 
 	DB(Trace(1, "LoadDirBlock", "loading block %lx\n", blocknr));
 	// -I- check if already in cache
-	if (!(dirblk = (struct cdirblock *)CheckCache(volume->dirblks, HASHM_DIR, blocknr, g)))
+	if (!(dirblk = (struct cdirblock *)CheckCache(&volume->dirblks, blocknr, g)))
 	{
 		// -II- not in cache -> put it in
 		dirblk = (struct cdirblock *)AllocLRU(g);
@@ -3501,7 +3501,7 @@ struct cdirblock *LoadDirBlock(ULONG blocknr, globaldata * g)
 				dirblk->blocknr = blocknr;
 				dirblk->used = FALSE;
 				dirblk->changeflag = FALSE;
-				Hash(dirblk, volume->dirblks, HASHM_DIR);
+				Hash(dirblk, &volume->dirblks);
 				UpdateReference(blocknr, dirblk, g);    // %10
 			}
 			else
@@ -303,6 +303,10 @@ void NormalCommands(struct DosPacket *action, globaldata *g)
 			action->dp_Res1 = dd_SetFileSize(action, g);
 			break;
 
+		case ACTION_CACHE_INFO:
+			action->dp_Res1 = dd_CacheInfo(action, g);
+			break;
+
 #if EXTENDED_PACKETS_OS4
 		case ACTION_CHANGE_FILE_POSITION64:
 			dd_ChangeFilePosition64(action, g);
@@ -411,6 +415,7 @@ void InhibitedCommands(struct DosPacket *action, globaldata *g)
 			break;
 
 		case ACTION_SET_FNSIZE:
+		case ACTION_CACHE_INFO:
 		case ACTION_FINDINPUT:      // Open(.., MODE_OLDFILE)
 		case ACTION_FINDOUTPUT:     // Open(.., MODE_NEWFILE)
 		case ACTION_FINDUPDATE:     // Open(.., MODE_READWRITE)
@@ -92,14 +92,19 @@
  */
 
 #define MIN_BUFFERS 10
-#define MAX_BUFFERS 600
+#define MAX_BUFFERS 8192
+#define DEFAULT_BUFFERS 150
 #define NEW_LRU_ENTRIES 5
 
+static ULONG DefaultBuffers(globaldata *g);
+static ULONG MaxBuffers(UWORD reserved_blksize, globaldata *g);
+static BOOL ResizeBlockHash(struct blockhash *hash, UWORD mask, globaldata *g);
+
 /* Allocate LRU queue
 */
 BOOL InitLRU (globaldata *g, UWORD reserved_blksize)
 {
-  int i, j;
+  int i, j, maxbuffers;
   BOOL warned = FALSE;
   UBYTE *array;
 
@@ -117,12 +122,14 @@ BOOL InitLRU (globaldata *g, UWORD reserved_blksize)
 
 	i = g->dosenvec->de_NumBuffers;
 
-	/* sanity checks. If HDToolbox default of 30, then 150,
-	 * otherwise round in range 70 -- 600
+	/* sanity checks. If HDToolbox default of 30, then a number that
+	 * grows with the partition size, otherwise round in range
+	 * MIN_BUFFERS -- what the available memory allows
 	 */
-	if (i==30) i=150;
+	maxbuffers = MaxBuffers(reserved_blksize, g);
+	if (i==30) i = DefaultBuffers(g);
 	if (i<MIN_BUFFERS) i = MIN_BUFFERS;
-	if (i>MAX_BUFFERS) i = MAX_BUFFERS;
+	if (i>maxbuffers) i = maxbuffers;
 	g->dosenvec->de_NumBuffers = g->glob_lrudata.poolsize = i;
 	g->uip = FALSE;
 	g->locknr = 1;
@@ -162,18 +169,56 @@ void DeallocLRU(globaldata *g)
 	g->glob_lrudata.LRUarray = NULL;
 }
 
+/* Default number of buffers: DEFAULT_BUFFERS, doubled for every
+ * fourfold of the partition size above 1GB
+ */
+static ULONG DefaultBuffers(globaldata *g)
+{
+  ULONG buffers = DEFAULT_BUFFERS;
+  ULONG size;
+
+	size = g->geom->dg_TotalSectors / ((1024*1024*1024UL) / g->geom->dg_SectorSize);
+	while (size >= 4 && buffers < MAX_BUFFERS)
+	{
+		buffers <<= 1;
+		size >>= 2;
+	}
+
+	return buffers;
+}
+
+/* Maximum number of buffers: no more than 1/8 of the free buffer memory
+ */
+static ULONG MaxBuffers(UWORD reserved_blksize, globaldata *g)
+{
+  ULONG buffers;
+
+	buffers = AvailMem(g->dosenvec->de_BufMemType & ~MEMF_CLEAR) / 8 /
+		(sizeof(struct lru_cachedblock) + reserved_blksize);
+
+	if (buffers < MIN_BUFFERS)
+		return MIN_BUFFERS;
+	if (buffers > MAX_BUFFERS)
+		return MAX_BUFFERS;
+	return buffers;
+}
+
 
 /* Allocate a block from the LRU chain and make
 ** it current LRU.
+** Blocks that were used again since they were loaded or last looked
+** at (see MakeLRU) get another round with their access count halved,
+** so blocks that are only used once (scans) are reused first.
 ** Returns NULL if none available
 */
 struct cachedblock *AllocLRU (globaldata *g)
 {
-  struct lru_cachedblock *lrunode;
+  struct lru_cachedblock *lrunode, *prevnode;
   struct lru_cachedblock **nlru;
   ULONG error;
   int retries = 0;
   int j;
+  BOOL unlocked;
 
 	ENTER("AllocLRU");
 
@@ -186,29 +231,51 @@ struct cachedblock *AllocLRU (globaldata *g)
 retry:
 	if (IsMinListEmpty(&g->glob_lrudata.LRUpool))
 	{
-		for (lrunode = (struct lru_cachedblock *)g->glob_lrudata.LRUqueue.mlh_TailPred; lrunode->prev; lrunode = lrunode->prev)
+		/* Walk again while unlocked blocks were only given a second
+		** chance. Their access counts halve on every walk, so one of
+		** them is flushed in the end. Only if all blocks are locked
+		** the pool has to grow. */
+		do
 		{
-			/* skip locked blocks */
-			if (ISLOCKED(&lrunode->cblk))
-				continue;
-
-			if (lrunode->cblk.changeflag)
+			unlocked = FALSE;
+			for (lrunode = (struct lru_cachedblock *)g->glob_lrudata.LRUqueue.mlh_TailPred; lrunode->prev; lrunode = prevnode)
 			{
-				DB(Trace(1,"AllocLRU","ResToBeFreed %lx\n",&lrunode->cblk));
-				ResToBeFreed(lrunode->cblk.oldblocknr, g);
-				UpdateDatestamp(&lrunode->cblk, g);
-				error = RawWrite ((UBYTE *)&lrunode->cblk.data, RESCLUSTER, lrunode->cblk.blocknr, g);
-				if (error) {
-					ULONG args[2];
-					args[0] = lrunode->cblk.blocknr;
-					args[1] = error;
-					ErrorMsg (AFS_ERROR_LRU_UPDATE_FAIL, args, g);
+				prevnode = lrunode->prev;
+
+				/* skip locked blocks */
+				if (ISLOCKED(&lrunode->cblk))
+					continue;
+				unlocked = TRUE;
+
+				/* second chance for blocks that have been used */
+				if (lrunode->cblk.accesses)
+				{
+					lrunode->cblk.accesses >>= 1;
+					MinRemove(lrunode);
+					MinAddHead(&g->glob_lrudata.LRUqueue, lrunode);
+					g->glob_lrudata.secondchances++;
+					continue;
 				}
-			}
 
-			FlushBlock(&lrunode->cblk, g);
-			goto ready;
-		}
+				if (lrunode->cblk.changeflag)
+				{
+					DB(Trace(1,"AllocLRU","ResToBeFreed %lx\n",&lrunode->cblk));
+					ResToBeFreed(lrunode->cblk.oldblocknr, g);
+					UpdateDatestamp(&lrunode->cblk, g);
+					error = RawWrite ((UBYTE *)&lrunode->cblk.data, RESCLUSTER, lrunode->cblk.blocknr, g);
+					if (error) {
+						ULONG args[2];
+						args[0] = lrunode->cblk.blocknr;
+						args[1] = error;
+						ErrorMsg (AFS_ERROR_LRU_UPDATE_FAIL, args, g);
+					}
+				}
+
+				FlushBlock(&lrunode->cblk, g);
+				g->glob_lrudata.reused++;
+				goto ready;
+			}
+		} while (unlocked);
 	}
 	else
 	{
@@ -445,19 +512,102 @@ void UpdateLE_exa (lockentry_t *le, globaldata *g)
  * The 'mask' is used as a fast modulo operator for the hash table size.
  */
 
-struct cachedblock *CheckCache (struct MinList *list, UWORD mask, ULONG blocknr, globaldata *g)
+struct cachedblock *CheckCache (struct blockhash *hash, ULONG blocknr, globaldata *g)
 {
   struct cachedblock *block;
 
-	for (block = HeadOf(&list[(blocknr/2)&mask]); block->next; block=block->next)
+	for (block = HeadOf(&hash->table[(blocknr/2)&hash->mask]); block->next; block=block->next)
 	{
 		if (block->blocknr == blocknr)
 		{
+			hash->hits++;
 			MakeLRU(block);
 			return block;
 		}
 	}
 
+	hash->misses++;
 	return NULL;
 }
 
+/*
+ * Hash table sizing ..
+ * The dir and anode block hash tables start at HASHM_DIR and HASHM_ANODE
+ * and grow with the number of LRU buffers, aiming at about two dir blocks
+ * per hash chain. A volume can't hold more dir and anode blocks than it
+ * has reserved blocks, so that limits the size too.
+ */
+
+static UWORD HashMask(ULONG entries, UWORD mask, ULONG limit)
+{
+	if (entries > limit)
+		entries = limit;
+
+	while (mask + 1 < entries && mask < HASHM_MAX)
+		mask = (mask << 1) | 1;
+
+	return mask;
+}
+
+/* Moves all blocks to a new table of size mask+1. Keeps the old
+ * table if there is no memory for the new one.
+ */
+static BOOL ResizeBlockHash(struct blockhash *hash, UWORD mask, globaldata *g)
+{
+  struct MinList *table;
+  struct cachedblock *block;
+  ULONG i;
+
+	if (hash->table && hash->mask == mask)
+		return TRUE;
+
+	if (!(table = AllocMemP(sizeof(struct MinList) * (mask + 1), g)))
+		return hash->table != NULL;
+
+	for (i = 0; i <= mask; i++)
+		NewList((struct List *)&table[i]);
+
+	if (hash->table)
+	{
+		for (i = 0; i <= hash->mask; i++)
+		{
+			while (!IsMinListEmpty(&hash->table[i]))
+			{
+				block = HeadOf(&hash->table[i]);
+				MinRemove(block);
+				MinAddHead(&table[(block->blocknr/2)&mask], block);
+			}
+		}
+		FreeMemP(hash->table, g);
+	}
+
+	DB(Trace(1, "ResizeBlockHash", "hash %lx size %lu -> %lu\n", hash,
+		hash->table ? hash->mask + 1 : 0, mask + 1));
+	hash->table = table;
+	hash->mask = mask;
+	return TRUE;
+}
+
+/* Size the hash tables of a volume to the cache. Must not be called
+ * while blocks of the hash tables are being walked.
+ */
+void SizeBlockHashes(struct volumedata *volume, globaldata *g)
+{
+  ULONG reserved;
+
+	if (!volume)
+		return;
+
+	reserved = (volume->rootblk->lastreserved - volume->rootblk->firstreserved + 1) /
+		volume->rescluster;
+	ResizeBlockHash(&volume->dirblks, HashMask(g->glob_lrudata.poolsize / 2, HASHM_DIR, reserved), g);
+	ResizeBlockHash(&volume->anblks, HashMask(g->glob_lrudata.poolsize / 8, HASHM_ANODE, reserved), g);
+}
+
+void FreeBlockHashes(struct volumedata *volume, globaldata *g)
+{
+	FreeMemP(volume->anblks.table, g);
+	FreeMemP(volume->dirblks.table, g);
+	volume->anblks.table = volume->dirblks.table = NULL;
+}
+
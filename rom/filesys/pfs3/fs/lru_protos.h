@@ -15,6 +15,9 @@ void UpdateLE(listentry_t * , globaldata * );
 
 void UpdateLE_exa(lockentry_t * , globaldata * );
 
-struct cachedblock * CheckCache(struct MinList * , UWORD , ULONG , globaldata * );
+struct cachedblock * CheckCache(struct blockhash * , ULONG , globaldata * );
+
+void SizeBlockHashes(struct volumedata * , globaldata * );
+void FreeBlockHashes(struct volumedata * , globaldata * );
 
 void ResToBeFreed(ULONG blocknr, globaldata *g);
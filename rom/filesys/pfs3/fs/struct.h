@@ -243,8 +243,23 @@ int stcu_d(char *out, unsigned int val);
 #define ACTION_ADD_IDLE_SIGNAL 2220
 #define ACTION_SET_DELDIR 2221
 #define ACTION_SET_FNSIZE 2222
+#define ACTION_CACHE_INFO 2223
 //#endif
 
+/* used by ACTION_CACHE_INFO */
+struct cacheinfo
+{
+	ULONG buffers;              /* number of LRU buffers                */
+	ULONG dirhashsize;          /* dir block hash table size            */
+	ULONG anodehashsize;        /* anode block hash table size          */
+	ULONG dirhits;              /* dir blocks found in cache            */
+	ULONG dirmisses;            /* dir blocks not found in cache        */
+	ULONG anodehits;            /* anode blocks found in cache          */
+	ULONG anodemisses;          /* anode blocks not found in cache      */
+	ULONG reused;               /* buffers reused for another block     */
+	ULONG secondchances;        /* buffers kept because they were used  */
+};
+
 /****************************************************************************/
 /* muFS related defines                                                     */
 /****************************************************************************/
@@ -270,9 +285,17 @@ int stcu_d(char *out, unsigned int val);
 #define UNLOCKALL() (g->locknr++)
 #define ISLOCKED(blk) ((blk)->used == g->locknr)
 
-/* Cache hashing table mask values for dir and anode */
+/* Cache hashing table mask values for dir and anode. These are the
+ * minimum sizes, the tables grow with the cache (see SizeBlockHashes())
+ */
 #define HASHM_DIR 0x1f
 #define HASHM_ANODE 0x7
+#define HASHM_MAX 0xfff
+
+/* LRU access counter limit. Blocks used since they were last looked at
+ * get another round in the LRU before they are reused
+ */
+#define LRU_MAXACCESSES 15
 
 
 /****************************************************************************/
@@ -445,6 +468,8 @@ struct lru_data_s
 	ULONG poolsize;
 	struct lru_cachedblock **LRUarray;
 	UWORD reserved_blksize;
+	ULONG reused;                       /* statistics, see struct cacheinfo */
+	ULONG secondchances;
 };
 
 
@@ -661,6 +686,15 @@ typedef struct globaldata globaldata;
 /* volumedata                                                                */
 /*****************************************************************************/
 
+/* cached block hash table. Size is mask+1, a power of two */
+struct blockhash
+{
+	struct MinList *table;
+	UWORD mask;
+	ULONG hits;                         /* CheckCache() statistics  */
+	ULONG misses;
+};
+
 struct volumedata
 {
 	struct volumedata   *next;          /* volumechain                          */
@@ -673,15 +707,15 @@ struct volumedata
 #endif
 
 	struct MinList fileentries;         /* all locks and open files             */
-	struct MinList anblks[HASHM_ANODE+1];   /* anode block hash table           */
-	struct MinList dirblks[HASHM_DIR+1];    /* dir block hash table             */
-	struct MinList indexblks;               /* cached index blocks              */
+	struct MinList indexblks;           /* cached index blocks                  */
 	struct MinList bmblks;              /* cached bitmap blocks                 */
 	struct MinList superblks;			/* cached super blocks					*/
 	struct MinList deldirblks;			/* cached deldirblocks					*/
 	struct MinList bmindexblks;         /* cached bitmap index blocks           */
 	struct MinList anodechainlist;      /* list of cached anodechains           */
 	struct MinList notifylist;          /* list of notifications                */
+	struct blockhash anblks;            /* anode block hash table               */
+	struct blockhash dirblks;           /* dir block hash table                 */
 
 	BOOL    rootblockchangeflag;        /* indicates if rootblock dirty         */
 	WORD    numsofterrors;              /* number of soft errors on this disk   */
@@ -729,9 +763,6 @@ struct idlehandle
  */
 #define LRU_CHAIN(b) \
  ((struct lru_cachedblock *)(((UBYTE *)(b))-offsetof(struct lru_cachedblock, cblk)))
-#define LRU_CANODEBLOCK(blk) ((struct lru_canodeblock *)((ULONG *)blk - 2))
-#define LRU_CDIRBLOCK(blk) ((struct lru_cdirblock *)((ULONG *)blk - 2))
-#define LRU_NODE(blk) ((struct MinNode *)((ULONG *)blk - 2))
 
 /* Make a block the most recently used one. The block
  * should already be in the chain!
@@ -739,6 +770,8 @@ struct idlehandle
  */ 
 #define MakeLRU(blk)                                    \
 {                                                       \
+	if (((struct cachedblock *)(blk))->accesses < LRU_MAXACCESSES) \
+		((struct cachedblock *)(blk))->accesses++;      \
 	MinRemove(LRU_CHAIN(blk));                          \
 	MinAddHead(&g->glob_lrudata.LRUqueue, LRU_CHAIN(blk));           \
 }
@@ -757,14 +790,14 @@ struct idlehandle
 /*
  * Hashing macros
  */
-#define ReHash(blk, list, mask)                         \
+#define ReHash(blk, hash)                               \
 {                                                       \
 	MinRemove(blk);                                     \
-	MinAddHead(&list[(blk->blocknr/2)&mask], blk);      \
+	MinAddHead(&(hash)->table[(blk->blocknr/2)&(hash)->mask], blk); \
 }
 
-#define Hash(blk, list, mask)                           \
-	MinAddHead(&list[(blk->blocknr/2)&mask], blk)
+#define Hash(blk, hash)                                 \
+	MinAddHead(&(hash)->table[(blk->blocknr/2)&(hash)->mask], blk)
 
 
 /*****************************************************************************/
@@ -218,10 +218,10 @@ BOOL UpdateDisk (globaldata *g)
 		RemoveEmptySBlocks(volume, g);
 
 		/* update anode, dir, index and superblocks (not changed by UpdateFreeList) */
-		for (i=0; i<=HASHM_DIR; i++)
-			updateok &= UpdateList ((struct cachedblock *)HeadOf(&volume->dirblks[i]), g);
-		for (i=0; i<=HASHM_ANODE; i++)
-			updateok &= UpdateList ((struct cachedblock *)HeadOf(&volume->anblks[i]), g);
+		for (i=0; i<=volume->dirblks.mask; i++)
+			updateok &= UpdateList ((struct cachedblock *)HeadOf(&volume->dirblks.table[i]), g);
+		for (i=0; i<=volume->anblks.mask; i++)
+			updateok &= UpdateList ((struct cachedblock *)HeadOf(&volume->anblks.table[i]), g);
 		updateok &= UpdateList ((struct cachedblock *)HeadOf(&volume->indexblks), g);
 		updateok &= UpdateList ((struct cachedblock *)HeadOf(&volume->superblks), g);
 #if DELDIR
@@ -301,9 +301,9 @@ static void RemoveEmptyDBlocks(struct volumedata *volume, globaldata *g)
   struct canode anode;
   ULONG previous, i;
 
-	for (i=0; i<=HASHM_DIR; i++)
+	for (i=0; i<=volume->dirblks.mask; i++)
 	{
-		for (blk = HeadOf(&volume->dirblks[i]); (next=blk->next); blk=next)
+		for (blk = HeadOf(&volume->dirblks.table[i]); (next=blk->next); blk=next)
 		{
 			if (IsEmptyDBlk(blk) && !IsFirstDBlk(blk, g) && !ISLOCKED(blk) )
 			{
@@ -387,9 +387,9 @@ static void RemoveEmptyABlocks(struct volumedata *volume, globaldata *g)
   ULONG indexblknr, indexoffset, i;
   struct cindexblock *index;
 
-	for (i=0; i<=HASHM_ANODE; i++)
+	for (i=0; i<=volume->anblks.mask; i++)
 	{
-		for (blk = HeadOf(&volume->anblks[i]); (next=blk->next); blk=next)
+		for (blk = HeadOf(&volume->anblks.table[i]); (next=blk->next); blk=next)
 		{
 			if (blk->changeflag && !IsFirstABlk(blk) && IsEmptyABlk(blk, g) && !ISLOCKED(blk) )
 			{
@@ -658,7 +658,7 @@ static void UpdateDBLK (struct cachedblock *blk, ULONG newblocknr, globaldata *g
 	anode.blocknr = newblocknr;
 	SaveAnode(&anode, anode.nr, g);
 
-	ReHash(blk, g->currentvolume->dirblks, HASHM_DIR);
+	ReHash(blk, &g->currentvolume->dirblks);
 }
 
 static void UpdateABLK (struct cachedblock *blk, ULONG newblocknr, globaldata *g)
@@ -678,7 +678,7 @@ static void UpdateABLK (struct cachedblock *blk, ULONG newblocknr, globaldata *g
 
 	index->blk.index[indexoffset] = newblocknr;
 	MakeBlockDirty ((struct cachedblock *)index, g);
-	ReHash(blk, g->currentvolume->anblks, HASHM_ANODE);
+	ReHash(blk, &g->currentvolume->anblks);
 }
 
 static void UpdateIBLK(struct cachedblock *blk, ULONG newblocknr, globaldata *g)
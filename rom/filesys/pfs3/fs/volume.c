@@ -246,6 +246,7 @@ static BOOL SameDiskDL(struct rootblock *, struct DeviceList *);
 static void TakeOverLocks(struct FileLock *, globaldata *);
 static void DiskInsertSequence(struct rootblock *rootblock, globaldata *g);
 static void DiskRemoveSequence(globaldata *g);
+static void FreeBlockList(struct MinList *list, globaldata *g);
 
 void NewVolume (BOOL FORCE, globaldata *g)
 {
@@ -582,6 +583,7 @@ struct volumedata *MakeVolumeData (struct rootblock *rootblock, globaldata *g)
 {
   struct volumedata *volume;
   struct MinList *list;
+  int i;
 
 	ENTER("MakeVolumeData");
 
@@ -594,6 +596,16 @@ struct volumedata *MakeVolumeData (struct rootblock *rootblock, globaldata *g)
 	for (list = &volume->fileentries; list <= &volume->notifylist; list++)
 		NewList((struct List *)list);
 
+	/* block hash tables, minimum size. SizeBlockHashes() enlarges them */
+	volume->anblks.table = AllocMemPR (sizeof(struct MinList) * (HASHM_ANODE+1), g);
+	volume->anblks.mask = HASHM_ANODE;
+	for (i=0; i<=HASHM_ANODE; i++)
+		NewList((struct List *)&volume->anblks.table[i]);
+	volume->dirblks.table = AllocMemPR (sizeof(struct MinList) * (HASHM_DIR+1), g);
+	volume->dirblks.mask = HASHM_DIR;
+	for (i=0; i<=HASHM_DIR; i++)
+		NewList((struct List *)&volume->dirblks.table[i]);
+
 	/* andere gegevens invullen */
 	volume->numsofterrors   = 0;
 	volume->diskstate       = ID_VALIDATED;
@@ -602,6 +614,7 @@ struct volumedata *MakeVolumeData (struct rootblock *rootblock, globaldata *g)
 	volume->numblocks       = g->geom->dg_TotalSectors;
 	volume->bytesperblock   = g->geom->dg_SectorSize;
 	volume->rescluster      = rootblock->reserved_blksize / volume->bytesperblock;
+	SizeBlockHashes(volume, g);
 
 	/* Calculate minimum fake block size that keeps total block count less than 16M.
 	 * Workaround for programs (including WB) that calculate free space using
@@ -691,6 +704,7 @@ void FreeVolumeResources(struct volumedata *volume, globaldata *g)
 	//		FreeBufmem (volume->deldir, g);
 #endif
 		FreeBufmem (volume->rootblk, g);
+		FreeBlockHashes (volume, g);
 		FreeMemP (volume, g);
 	}
 
@@ -700,7 +714,7 @@ void FreeVolumeResources(struct volumedata *volume, globaldata *g)
 void FreeUnusedResources(struct volumedata *volume, globaldata *g)
 {
   struct MinList *list;
-  struct MinNode *node, *next;
+  ULONG i;
 
 	ENTER("FreeUnusedResources");
 
@@ -708,16 +722,25 @@ void FreeUnusedResources(struct volumedata *volume, globaldata *g)
 	if (!volume)
 		return;
 
-	/* start with anblks!, fileentries are to be kept! */
-	for (list = volume->anblks; list<=&volume->bmindexblks; list++)
+	/* start with the hash tables, fileentries are to be kept! */
+	for (i=0; i<=volume->anblks.mask; i++)
+		FreeBlockList(&volume->anblks.table[i], g);
+	for (i=0; i<=volume->dirblks.mask; i++)
+		FreeBlockList(&volume->dirblks.table[i], g);
+	for (list = &volume->indexblks; list<=&volume->bmindexblks; list++)
+		FreeBlockList(list, g);
+}
+
+static void FreeBlockList(struct MinList *list, globaldata *g)
+{
+  struct MinNode *node, *next;
+
+	node = (struct MinNode *)HeadOf(list);
+	while ((next = node->mln_Succ))
 	{
-		node = (struct MinNode *)HeadOf(list);
-		while ((next = node->mln_Succ))
-		{
-			FlushBlock((struct cachedblock *)node, g);
-			FreeLRU((struct cachedblock *)node);
-			node = next;
-		}
+		FlushBlock((struct cachedblock *)node, g);
+		FreeLRU((struct cachedblock *)node);
+		node = next;
 	}
 }
 
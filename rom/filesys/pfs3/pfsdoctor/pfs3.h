@@ -32,6 +32,21 @@
 #define ACTION_ADD_IDLE_SIGNAL 2220
 #define ACTION_SET_DELDIR 2221
 #define ACTION_SET_FNSIZE 2222
+#define ACTION_CACHE_INFO 2223
+
+/* used by ACTION_CACHE_INFO */
+struct cacheinfo
+{
+    ULONG buffers;          /* number of LRU buffers */
+    ULONG dirhashsize;      /* dir block hash table size */
+    ULONG anodehashsize;    /* anode block hash table size */
+    ULONG dirhits;          /* dir blocks found in cache */
+    ULONG dirmisses;        /* dir blocks not found in cache */
+    ULONG anodehits;        /* anode blocks found in cache */
+    ULONG anodemisses;      /* anode blocks not found in cache */
+    ULONG reused;           /* buffers reused for another block */
+    ULONG secondchances;    /* buffers kept because they were used */
+};
 
 /****************************************************************************/
 /* PFS3 blocks                                                              */
@@ -2,7 +2,7 @@
 
 File: commands.c
 Author: Neil Cafferkey
-Copyright (C) 2008-2023 The AROS Dev Team
+Copyright (C) 2008-2026 The AROS Dev Team
 Copyright (C) 2001-2008 Neil Cafferkey
 
 This file is free software; you can redistribute it and/or modify it
@@ -678,9 +678,8 @@ UPINT CmdWrite(struct Handler *handler, struct Opening *opening,
 
 UPINT CmdSeek(struct Handler *handler, struct Opening *opening, PINT offset, LONG mode)
 {
-   struct Block *block;
    struct Object *file;
-   UPINT block_pos, block_length, remainder, old_pos, new_pos;
+   UPINT old_pos, new_pos;
 
    /* Get starting point */
 
@@ -688,22 +687,11 @@ UPINT CmdSeek(struct Handler *handler, struct Opening *opening, PINT offset, LON
    old_pos = opening->pos;
 
    if(mode == OFFSET_BEGINNING)
-   {
-      block = (APTR)file->elements.mlh_Head;
-      new_pos = block_pos = 0;
-   }
+      new_pos = 0;
    else if(mode == OFFSET_CURRENT)
-   {
-      block = opening->block;
-      block_pos = opening->block_pos;
       new_pos = old_pos;
-   }
    else
-   {
-      block = (APTR)file->elements.mlh_TailPred;
-      block_pos = file->end_length;
       new_pos = file->length;
-   }
 
    /* Check new position is within file */
 
@@ -714,41 +702,9 @@ UPINT CmdSeek(struct Handler *handler, struct Opening *opening, PINT offset, LON
       return -1;
    }
 
-   if(offset >= 0)
-   {
-      /* Go forwards */
-
-      block_length = GetBlockLength(file, block);
-      remainder = offset + block_pos;
-      while(remainder > block_length)
-      {
-         remainder -= block_length;
-         block = (APTR)((struct MinNode *)block)->mln_Succ;
-         block_length = GetBlockLength(file, block);
-      }
-
-      block_pos = remainder;
-   }
-   else
-   {
-      /* Go backwards */
-
-      block_length = block_pos;
-      remainder = -offset;
-      while(remainder >= block_length && remainder > 0)
-      {
-         remainder -= block_length;
-         block = (APTR)((struct MinNode *)block)->mln_Pred;
-         block_length = GetBlockLength(file, block);
-      }
-
-      block_pos = block_length - remainder;
-   }
-
    /* Record new position for next access */
 
-   opening->block = block;
-   opening->block_pos = block_pos;
+   opening->block = FindBlock(file, new_pos, &opening->block_pos);
    opening->pos = new_pos;
 
    /* Return old position */
@@ -1842,8 +1798,12 @@ BOOL CmdRenameObject(struct Handler *handler, struct Lock *old_lock,
 
    if(error == 0)
    {
+      UnhashObject(handler, object);
       if(!SetName(handler, object, FilePart(new_name)))
+      {
          error = IoErr();
+         HashObject(handler, object);
+      }
    }
 
    if(error == 0)
@@ -1857,6 +1817,7 @@ BOOL CmdRenameObject(struct Handler *handler, struct Lock *old_lock,
          object->parent = parent;
          AdjustExaminations(handler, object);
       }
+      HashObject(handler, object);
 
       if(object != duplicate)
       {
@@ -2,6 +2,7 @@
 
 File: filesystem.c
 Author: Neil Cafferkey
+Copyright (C) 2026 The AROS Dev Team
 Copyright (C) 2001-2008 Neil Cafferkey
 
 This file is free software; you can redistribute it and/or modify it
@@ -27,9 +28,15 @@ MA 02111-1307, USA.
 
 static struct Block *AddDataBlock(struct Handler *handler,
    struct Object *file, UPINT length);
+static BOOL AppendDataBlock(struct Handler *handler, struct Object *file,
+   struct Block *block);
+static struct Block *RemDataBlock(struct Object *file);
 static VOID FreeDataBlock(struct Handler *handler, struct Object *file,
    struct Block *block);
 static struct Block *GetLastBlock(struct Object *file);
+static ULONG HashName(struct Handler *handler, const TEXT *name);
+static BOOL ResizeHashTable(struct Handler *handler, struct Object *dir,
+   UPINT size);
 
 
 
@@ -190,6 +197,7 @@ struct Object *CreateObject(struct Handler *handler, const TEXT *name,
       if(parent != NULL)
       {
          AddTail((struct List *)&parent->elements, (struct Node *)object);
+         HashObject(handler, object);
          CopyMem(&object->date, &parent->date, sizeof(struct DateStamp));
       }
    }
@@ -329,7 +337,10 @@ VOID DeleteObject(struct Handler *handler, struct Object *object)
       /* Remove the object from its directory */
 
       if(object->parent != NULL)
+      {
+         UnhashObject(handler, object);
          Remove((struct Node *)object);
+      }
 
       /* Delete a hard link */
 
@@ -384,7 +395,9 @@ VOID DeleteObject(struct Handler *handler, struct Object *object)
 
          /* Prepare to destroy "heir" link */
 
+         UnhashObject(handler, heir);
          Remove((APTR)heir);
+         HashObject(handler, object);
          object = heir;
       }
 
@@ -401,10 +414,18 @@ VOID DeleteObject(struct Handler *handler, struct Object *object)
                FreePooled(handler->muddy_pool, block,
                   sizeof(struct Block) + block->length);
          }
+
+         if(object->block_map != NULL)
+            FreePooled(handler->muddy_pool, object->block_map,
+               object->map_size * sizeof(struct BlockMapEntry));
       }
 
       /* Free object's memory */
 
+      if(object->name_table != NULL)
+         FreePooled(handler->clear_pool, object->name_table,
+            object->table_size * sizeof(struct Object *));
+
       SetString(handler, (TEXT **)&((struct Node *)object)->ln_Name, NULL);
       SetString(handler, &object->comment, NULL);
       handler->block_count -= object->block_count;
@@ -537,8 +558,7 @@ struct Object *GetObject(struct Handler *handler, struct Lock *lock,
          {
             old_object = object;
             object = GetRealObject(object);
-            object = (struct Object *)
-               FindNameNoCase(handler, (struct List *)&object->elements, buffer);
+            object = FindObject(handler, object, buffer);
             if(object != NULL)
             {
                /* Check for and handle a soft link */
@@ -622,7 +642,7 @@ PINT ChangeFileSize(struct Handler *handler, struct Opening *opening,
    PINT offset, LONG mode)
 {
    PINT length, new_length, remainder, end_length, full_length;
-   UPINT diff, old_pos, block_count;
+   UPINT diff, old_pos, block_count, map_count;
    struct Block *block, *end_block;
    struct Object *file;
    LONG error = 0;
@@ -670,7 +690,8 @@ PINT ChangeFileSize(struct Handler *handler, struct Opening *opening,
       /* Add the required number of data bytes */
 
       remainder = new_length - full_length;
-      end_length -= remainder;
+      end_length = block->length + remainder;
+      map_count = file->map_count;
 
       while(remainder > 0)
       {
@@ -690,7 +711,8 @@ PINT ChangeFileSize(struct Handler *handler, struct Opening *opening,
       {
          new_length = -1;
          error = IoErr();
-         ChangeFileSize(handler, opening, length, OFFSET_BEGINNING);
+         while(file->map_count > map_count)
+            FreeDataBlock(handler, file, RemDataBlock(file));
       }
       else
          file->end_length = end_length;
@@ -703,7 +725,7 @@ PINT ChangeFileSize(struct Handler *handler, struct Opening *opening,
       while(full_length > new_length)
       {
          FreeDataBlock(handler, file, block);
-         block = (APTR)RemTail((APTR)&file->elements);
+         block = RemDataBlock(file);
          full_length -= block->length;
       }
       end_block = (APTR)file->elements.mlh_TailPred;
@@ -722,7 +744,7 @@ PINT ChangeFileSize(struct Handler *handler, struct Opening *opening,
          FreeDataBlock(handler, file, block);
       }
       else
-         AddTail((struct List *)&file->elements, (APTR)block);
+         AppendDataBlock(handler, file, block);
    }
 
    /* Store new file size */
@@ -1243,6 +1265,341 @@ BOOL SetName(struct Handler *handler, struct Object *object,
 
 
 
+/****i* ram.handler/HashObject *********************************************
+*
+*   NAME
+*	HashObject -- Add an object to its directory's name index.
+*
+*   SYNOPSIS
+*	HashObject(handler, object)
+*
+*	VOID HashObject(struct Handler *, struct Object *);
+*
+*   FUNCTION
+*	Counts an object that has been added to its parent's list of
+*	elements, or has been given a new name, and adds it to the parent's
+*	hash index. The index is created once a directory has
+*	MIN_HASH_ENTRIES objects, and is enlarged when there are more
+*	objects than buckets.
+*
+*   INPUTS
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*	If memory for the index can't be found, lookups go on with the old
+*	index or by walking the list of elements, so this can't fail. The
+*	order of the list, which ExNext() and ExAll() follow, isn't changed.
+*
+*   BUGS
+*
+*   SEE ALSO
+*	UnhashObject()
+*
+****************************************************************************
+*
+*/
+
+VOID HashObject(struct Handler *handler, struct Object *object)
+{
+   struct Object *dir, **bucket;
+
+   dir = object->parent;
+   if(dir == NULL)
+      return;
+
+   object->name_hash = HashName(handler, ((struct Node *)object)->ln_Name);
+   dir->entry_count++;
+
+   if(dir->name_table != NULL)
+   {
+      if(dir->entry_count > dir->table_size)
+         ResizeHashTable(handler, dir, dir->table_size * 2);
+
+      bucket = &dir->name_table[object->name_hash & (dir->table_size - 1)];
+      object->hash_next = *bucket;
+      *bucket = object;
+   }
+   else if(dir->entry_count >= MIN_HASH_ENTRIES)
+   {
+      /* Index all elements, including the new object */
+
+      ResizeHashTable(handler, dir, MIN_HASH_SIZE);
+   }
+
+   return;
+}
+
+
+
+/****i* ram.handler/UnhashObject *******************************************
+*
+*   NAME
+*	UnhashObject -- Remove an object from its directory's name index.
+*
+*   SYNOPSIS
+*	UnhashObject(handler, object)
+*
+*	VOID UnhashObject(struct Handler *, struct Object *);
+*
+*   FUNCTION
+*	Must be called before an object is removed from its parent's list of
+*	elements or renamed. The index is freed when the directory becomes
+*	empty.
+*
+*   INPUTS
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*
+*   BUGS
+*
+*   SEE ALSO
+*	HashObject()
+*
+****************************************************************************
+*
+*/
+
+VOID UnhashObject(struct Handler *handler, struct Object *object)
+{
+   struct Object *dir, **link;
+   UPINT size;
+
+   dir = object->parent;
+   if(dir == NULL)
+      return;
+
+   dir->entry_count--;
+
+   if(dir->name_table != NULL)
+   {
+      link = &dir->name_table[object->name_hash & (dir->table_size - 1)];
+      while(*link != object)
+         link = &(*link)->hash_next;
+      *link = object->hash_next;
+      object->hash_next = NULL;
+
+      if(dir->entry_count == 0)
+      {
+         size = dir->table_size * sizeof(struct Object *);
+         FreePooled(handler->clear_pool, dir->name_table, size);
+         dir->block_count -= MEMBLOCKS(size);
+         handler->block_count -= MEMBLOCKS(size);
+         dir->name_table = NULL;
+         dir->table_size = 0;
+      }
+   }
+
+   return;
+}
+
+
+
+/****i* ram.handler/FindObject *********************************************
+*
+*   NAME
+*	FindObject -- Find an object in a directory by name.
+*
+*   SYNOPSIS
+*	object = FindObject(handler, dir, name)
+*
+*	struct Object *FindObject(struct Handler *, struct Object *,
+*	   const TEXT *);
+*
+*   FUNCTION
+*	Looks up a name in a directory's hash index, or walks its list of
+*	elements if it doesn't have one. Case is ignored.
+*
+*   INPUTS
+*
+*   RESULT
+*	object - the object, or NULL if there's no such name.
+*
+*   EXAMPLE
+*
+*   NOTES
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+struct Object *FindObject(struct Handler *handler, struct Object *dir,
+   const TEXT *name)
+{
+   struct Object *object;
+   TEXT *object_name;
+   ULONG hash;
+
+   if(dir->name_table == NULL)
+      return (APTR)FindNameNoCase(handler, (struct List *)&dir->elements,
+         name);
+
+   hash = HashName(handler, name);
+   object = dir->name_table[hash & (dir->table_size - 1)];
+
+   while(object != NULL)
+   {
+      object_name = ((struct Node *)object)->ln_Name;
+      if(object->name_hash == hash && object_name != NULL
+         && Stricmp(name, object_name) == 0)
+         break;
+      object = object->hash_next;
+   }
+
+   return object;
+}
+
+
+
+/****i* ram.handler/HashName ***********************************************
+*
+*   NAME
+*	HashName -- Calculate the hash of an object name.
+*
+*   SYNOPSIS
+*	hash = HashName(handler, name)
+*
+*	ULONG HashName(struct Handler *, const TEXT *);
+*
+*   FUNCTION
+*
+*   INPUTS
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*	Characters are converted with ToLower(), like Stricmp() does, so
+*	that names that differ only in case get the same hash.
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+static ULONG HashName(struct Handler *handler, const TEXT *name)
+{
+   ULONG hash = 0;
+   TEXT ch;
+
+   if(name != NULL)
+   {
+      while((ch = *name++) != '\0')
+         hash = hash * 31 + (UBYTE)ToLower(ch);
+   }
+
+   return hash;
+}
+
+
+
+/****i* ram.handler/ResizeHashTable ****************************************
+*
+*   NAME
+*	ResizeHashTable --
+*
+*   SYNOPSIS
+*	success = ResizeHashTable(handler, dir, size)
+*
+*	BOOL ResizeHashTable(struct Handler *, struct Object *, UPINT);
+*
+*   FUNCTION
+*	Allocates a new hash index for a directory. The objects in the old
+*	index are moved to the new one. If there was no index, all of the
+*	directory's elements are added to it.
+*
+*   INPUTS
+*	size - the number of buckets, a power of two.
+*
+*   RESULT
+*	success - FALSE if there wasn't enough memory, in which case the
+*	    old index is kept.
+*
+*   EXAMPLE
+*
+*   NOTES
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+static BOOL ResizeHashTable(struct Handler *handler, struct Object *dir,
+   UPINT size)
+{
+   struct Object **table, **bucket, *object, *next_object, *tail;
+   UPINT i;
+
+   table = AllocPooled(handler->clear_pool, size * sizeof(struct Object *));
+   if(table == NULL)
+      return FALSE;
+   dir->block_count += MEMBLOCKS(size * sizeof(struct Object *));
+   handler->block_count += MEMBLOCKS(size * sizeof(struct Object *));
+
+   if(dir->name_table != NULL)
+   {
+      /* Move the old index's objects over */
+
+      for(i = 0; i < dir->table_size; i++)
+      {
+         for(object = dir->name_table[i]; object != NULL;
+            object = next_object)
+         {
+            next_object = object->hash_next;
+            bucket = &table[object->name_hash & (size - 1)];
+            object->hash_next = *bucket;
+            *bucket = object;
+         }
+      }
+
+      FreePooled(handler->clear_pool, dir->name_table,
+         dir->table_size * sizeof(struct Object *));
+      dir->block_count -= MEMBLOCKS(dir->table_size * sizeof(struct Object *));
+      handler->block_count -=
+         MEMBLOCKS(dir->table_size * sizeof(struct Object *));
+   }
+   else
+   {
+      /* Index all of the directory's elements */
+
+      object = (APTR)dir->elements.mlh_Head;
+      tail = (APTR)&dir->elements.mlh_Tail;
+      while(object != tail)
+      {
+         object->name_hash =
+            HashName(handler, ((struct Node *)object)->ln_Name);
+         bucket = &table[object->name_hash & (size - 1)];
+         object->hash_next = *bucket;
+         *bucket = object;
+         object = (APTR)((struct Node *)object)->ln_Succ;
+      }
+   }
+
+   dir->name_table = table;
+   dir->table_size = size;
+
+   return TRUE;
+}
+
+
+
 /****i* ram.handler/AddDataBlock *******************************************
 *
 *   NAME
@@ -1280,9 +1637,14 @@ static struct Block *AddDataBlock(struct Handler *handler,
    UPINT alloc_size;
    ULONG limit;
 
-   /* Ensure block size is within limits */
+   /* Let blocks grow along with the file, so that a large file is made of
+      a moderate number of large blocks however small its writes are */
 
    alloc_size = sizeof(struct Block) + length;
+   if(alloc_size < file->length >> BLOCK_GROWTH_SHIFT)
+      alloc_size = file->length >> BLOCK_GROWTH_SHIFT;
+
+   /* Ensure block size is within limits */
 
    limit = handler->max_block_size;
    if(alloc_size > limit)
@@ -1307,11 +1669,16 @@ static struct Block *AddDataBlock(struct Handler *handler,
 
    if(block != NULL)
    {
-      AddTail((struct List *)&file->elements, (struct Node *)block);
       block->length = alloc_size - sizeof(struct Block);
       file->block_count += alloc_size >> MEM_BLOCKSHIFT;
+      if(!AppendDataBlock(handler, file, block))
+      {
+         FreeDataBlock(handler, file, block);
+         block = NULL;
+      }
    }
-   else
+
+   if(block == NULL)
       SetIoErr(ERROR_DISK_FULL);
 
    /* Return the new block */
@@ -1321,6 +1688,133 @@ static struct Block *AddDataBlock(struct Handler *handler,
 
 
 
+/****i* ram.handler/AppendDataBlock ****************************************
+*
+*   NAME
+*	AppendDataBlock --
+*
+*   SYNOPSIS
+*	success = AppendDataBlock(handler, file, block)
+*
+*	BOOL AppendDataBlock(struct Handler *, struct Object *,
+*	   struct Block *);
+*
+*   FUNCTION
+*	Adds a block to the end of a file's block list and block map. The
+*	map is enlarged if necessary.
+*
+*   INPUTS
+*
+*   RESULT
+*	success - FALSE if the block map couldn't be enlarged.
+*
+*   EXAMPLE
+*
+*   NOTES
+*	The block map holds the file position of each block's first byte,
+*	which stays valid because blocks are only ever added and removed at
+*	the end of a file.
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+static BOOL AppendDataBlock(struct Handler *handler, struct Object *file,
+   struct Block *block)
+{
+   struct BlockMapEntry *map, *last;
+   UPINT map_size;
+
+   /* Double the size of the block map when it is full */
+
+   if(file->map_count == file->map_size)
+   {
+      map_size = file->map_size * 2;
+      if(map_size < MIN_BLOCK_MAP_SIZE)
+         map_size = MIN_BLOCK_MAP_SIZE;
+
+      map = AllocPooled(handler->muddy_pool,
+         map_size * sizeof(struct BlockMapEntry));
+      if(map == NULL)
+         return FALSE;
+      file->block_count += MEMBLOCKS(map_size * sizeof(struct BlockMapEntry));
+
+      if(file->block_map != NULL)
+      {
+         CopyMem(file->block_map, map,
+            file->map_count * sizeof(struct BlockMapEntry));
+         FreePooled(handler->muddy_pool, file->block_map,
+            file->map_size * sizeof(struct BlockMapEntry));
+         file->block_count -=
+            MEMBLOCKS(file->map_size * sizeof(struct BlockMapEntry));
+      }
+      file->block_map = map;
+      file->map_size = map_size;
+   }
+
+   /* All blocks before the new one are full */
+
+   map = &file->block_map[file->map_count];
+   if(file->map_count != 0)
+   {
+      last = map - 1;
+      map->offset = last->offset + last->block->length;
+   }
+   else
+      map->offset = 0;
+   map->block = block;
+   file->map_count++;
+
+   AddTail((struct List *)&file->elements, (struct Node *)block);
+
+   return TRUE;
+}
+
+
+
+/****i* ram.handler/RemDataBlock *******************************************
+*
+*   NAME
+*	RemDataBlock --
+*
+*   SYNOPSIS
+*	block = RemDataBlock(file)
+*
+*	struct Block *RemDataBlock(struct Object *);
+*
+*   FUNCTION
+*	Removes the last data block from a file's block list and block map.
+*	The block isn't freed.
+*
+*   INPUTS
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+static struct Block *RemDataBlock(struct Object *file)
+{
+   file->map_count--;
+
+   return (APTR)RemTail((struct List *)&file->elements);
+}
+
+
+
 /****i* ram.handler/FreeDataBlock ******************************************
 *
 *   NAME
@@ -1461,6 +1955,69 @@ UPINT GetBlockLength(struct Object *file, struct Block *block)
 
 
 
+/****i* ram.handler/FindBlock **********************************************
+*
+*   NAME
+*	FindBlock -- Find the block that holds a file position.
+*
+*   SYNOPSIS
+*	block = FindBlock(file, pos, block_pos)
+*
+*	struct Block *FindBlock(struct Object *, UPINT, UPINT *);
+*
+*   FUNCTION
+*	Does a binary search of the file's block map for the last block that
+*	starts before the given position, so that a position at a block
+*	boundary is located at the end of the previous block. Position zero
+*	is at the start of the empty start block.
+*
+*   INPUTS
+*	file - the file.
+*	pos - a position no greater than the file's length.
+*	block_pos - the offset of the position within the block is stored
+*	    here.
+*
+*   RESULT
+*	block - the block holding the position.
+*
+*   EXAMPLE
+*
+*   NOTES
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+struct Block *FindBlock(struct Object *file, UPINT pos, UPINT *block_pos)
+{
+   struct BlockMapEntry *map = file->block_map;
+   UPINT low = 0, high = file->map_count, middle;
+
+   if(pos == 0 || high == 0)
+   {
+      *block_pos = 0;
+      return &file->start_block;
+   }
+
+   while(high - low > 1)
+   {
+      middle = (low + high) >> 1;
+      if(map[middle].offset < pos)
+         low = middle;
+      else
+         high = middle;
+   }
+
+   *block_pos = pos - map[low].offset;
+   return map[low].block;
+}
+
+
+
 /****i* ram.handler/GetLastBlock *******************************************
 *
 *   NAME
@@ -2,6 +2,7 @@
 
 File: handler.h
 Author: Neil Cafferkey
+Copyright (C) 2026 The AROS Dev Team
 Copyright (C) 2001-2008 Neil Cafferkey
 
 This file is free software; you can redistribute it and/or modify it
@@ -66,7 +67,11 @@ typedef LONG PINT;
 
 #define MAX_NAME_SIZE (sizeof(((struct FileInfoBlock *)NULL)->fib_FileName))
 #define MIN_BLOCK_SIZE 64
-#define MAX_BLOCK_SIZE 0x8000
+#define MAX_BLOCK_SIZE 0x100000
+#define BLOCK_GROWTH_SHIFT 3
+#define MIN_BLOCK_MAP_SIZE 8
+#define MIN_HASH_ENTRIES 32
+#define MIN_HASH_SIZE 64
 #define CLEAR_PUDDLE_SIZE (8 * 1024)
 #define CLEAR_PUDDLE_THRESH (4 * 1024)
 #define MUDDY_PUDDLE_SIZE (16 * 1024)
@@ -81,7 +86,14 @@ typedef LONG PINT;
 struct Block
 {
    struct MinNode node;
-   UWORD length;            /* number of data bytes */
+   UPINT length;            /* number of data bytes */
+};
+
+
+struct BlockMapEntry
+{
+   UPINT offset;            /* file position of the block's first byte */
+   struct Block *block;
 };
 
 
@@ -97,10 +109,18 @@ struct Lock
 struct Object
 {
    struct Node node;
-   UWORD end_length;        /* number of valid bytes in last data block */
+   UPINT end_length;        /* number of valid bytes in last data block */
    struct MinList elements;
    UPINT length;            /* logical length in bytes for a file */
    UPINT block_count;       /* number of memory blocks */
+   struct BlockMapEntry *block_map;   /* a file's data blocks in order */
+   UPINT map_count;         /* number of used block map entries */
+   UPINT map_size;          /* number of allocated block map entries */
+   struct Object **name_table;   /* a directory's name hash index */
+   UPINT table_size;        /* number of hash buckets (a power of two) */
+   UPINT entry_count;       /* number of objects in a directory */
+   struct Object *hash_next;     /* next object in the same hash bucket */
+   ULONG name_hash;
    struct Lock *lock;
    struct Object *parent;
    struct DateStamp date;
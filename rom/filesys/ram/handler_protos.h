@@ -2,6 +2,7 @@
 
 File: handler_protos.h
 Author: Neil Cafferkey
+Copyright (C) 2026 The AROS Dev Team
 Copyright (C) 2001-2008 Neil Cafferkey
 
 This file is free software; you can redistribute it and/or modify it
@@ -112,7 +113,12 @@ BOOL ExamineObject(struct Handler *handler, struct Object *object,
 VOID AdjustExaminations(struct Handler *handler, struct Object *object);
 BOOL SetName(struct Handler *handler, struct Object *object,
    const TEXT *name);
+VOID HashObject(struct Handler *handler, struct Object *object);
+VOID UnhashObject(struct Handler *handler, struct Object *object);
+struct Object *FindObject(struct Handler *handler, struct Object *dir,
+   const TEXT *name);
 UPINT GetBlockLength(struct Object *file, struct Block *block);
+struct Block *FindBlock(struct Object *file, UPINT pos, UPINT *block_pos);
 struct Object *GetRealObject(struct Object *object);
 
 VOID MatchNotifyRequests(struct Handler *handler);
@@ -0,0 +1,149 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: NEON color conversion routines, used by the ARM and AArch64 code.
+          Needs rgbconv_vector.h.
+*/
+
+#include <arm_neon.h>
+
+static inline uint32x4_t rgbconv_terms_neon(uint32x4_t v, const int32x4_t *shift,
+    const uint32x4_t *mask, UBYTE count)
+{
+    uint32x4_t d = vdupq_n_u32(0);
+
+    /* vshlq_u32() shifts to the right for negative counts */
+#define TERM(i) d = vorrq_u32(d, vandq_u32(vshlq_u32(v, shift[i]), mask[i]))
+    switch (count)
+    {
+    case 4: TERM(3);
+    case 3: TERM(2);
+    case 2: TERM(1);
+    default: TERM(0);
+    }
+#undef TERM
+
+    return d;
+}
+
+/* Converts the first width & ~7 pixels of a row. Always inlined, so the
+   compiler makes a separate loop for each pixel size */
+static inline __attribute__((always_inline)) void rgbconv_row_neon(UBYTE *s, UBYTE *d, ULONG width,
+    UBYTE srcbpp, UBYTE dstbpp, const int32x4_t *shift, const uint32x4_t *mask, UBYTE count)
+{
+    ULONG x;
+
+    for (x = 0; x + 8 <= width; x += 8)
+    {
+        uint32x4_t lo, hi;
+
+        if (srcbpp == 2)
+        {
+            uint16x8_t w = vld1q_u16((const uint16_t *)s);
+
+            lo = vmovl_u16(vget_low_u16(w));
+            hi = vmovl_u16(vget_high_u16(w));
+        }
+        else if (srcbpp == 3)
+        {
+            uint8x8x3_t p = vld3_u8(s);
+            uint16x8_t w = vorrq_u16(vmovl_u8(p.val[0]), vshll_n_u8(p.val[1], 8));
+            uint16x8_t b = vmovl_u8(p.val[2]);
+
+            lo = vorrq_u32(vmovl_u16(vget_low_u16(w)), vshll_n_u16(vget_low_u16(b), 16));
+            hi = vorrq_u32(vmovl_u16(vget_high_u16(w)), vshll_n_u16(vget_high_u16(b), 16));
+        }
+        else
+        {
+            lo = vld1q_u32((const uint32_t *)s);
+            hi = vld1q_u32((const uint32_t *)(s + 16));
+        }
+
+        lo = rgbconv_terms_neon(lo, shift, mask, count);
+        hi = rgbconv_terms_neon(hi, shift, mask, count);
+
+        if (dstbpp == 2)
+        {
+            vst1q_u16((uint16_t *)d, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+        }
+        else if (dstbpp == 3)
+        {
+            uint16x8_t w = vcombine_u16(vmovn_u32(lo), vmovn_u32(hi));
+            uint16x8_t b = vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16));
+            uint8x8x3_t p;
+
+            p.val[0] = vmovn_u16(w);
+            p.val[1] = vshrn_n_u16(w, 8);
+            p.val[2] = vmovn_u16(b);
+            vst3_u8(d, p);
+        }
+        else
+        {
+            vst1q_u32((uint32_t *)d, lo);
+            vst1q_u32((uint32_t *)(d + 16), hi);
+        }
+
+        s += 8 * srcbpp;
+        d += 8 * dstbpp;
+    }
+}
+
+static ULONG convert_terms_neon(APTR srcPixels, ULONG srcMod, HIDDT_StdPixFmt srcPixFmt,
+    APTR dstPixels, ULONG dstMod, HIDDT_StdPixFmt dstPixFmt,
+    UWORD width, UWORD height)
+{
+    const struct RGBConvTerms *t = RGBCONV_TERMS(srcPixFmt, dstPixFmt);
+    int32x4_t shift[RGBCONV_MAXTERMS];
+    uint32x4_t mask[RGBCONV_MAXTERMS];
+    UBYTE *src = srcPixels, *dst = dstPixels;
+    ULONG y, done = width & ~7;
+    UBYTE i;
+
+    if (t->count == 0)
+        return 0;
+
+    for (i = 0; i < t->count; i++)
+    {
+        shift[i] = vdupq_n_s32(t->shift[i]);
+        mask[i] = vdupq_n_u32(t->mask[i]);
+    }
+
+    for (y = 0; y < height; y++)
+    {
+#define ROW(sbpp, dbpp) \
+        case (sbpp << 4) | dbpp: \
+            rgbconv_row_neon(src, dst, width, sbpp, dbpp, shift, mask, t->count); \
+            break;
+
+        switch ((t->srcbpp << 4) | t->dstbpp)
+        {
+        ROW(2, 2) ROW(2, 3) ROW(2, 4)
+        ROW(3, 2) ROW(3, 3) ROW(3, 4)
+        ROW(4, 2) ROW(4, 3) ROW(4, 4)
+        }
+#undef ROW
+        rgbconv_convertrow(t, src + done * t->srcbpp, dst + done * t->dstbpp, width - done);
+
+        src += srcMod;
+        dst += dstMod;
+    }
+
+    return 1;
+}
+
+/* Replaces every conversion that can be described by terms */
+static void SetNEONRGBConversionFunctions(HIDDT_RGBConversionFunction rgbconvertfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT])
+{
+    HIDDT_StdPixFmt src, dst;
+
+    for (src = FIRST_RGB_STDPIXFMT; src <= LAST_RGB_STDPIXFMT; src++)
+    {
+        for (dst = FIRST_RGB_STDPIXFMT; dst <= LAST_RGB_STDPIXFMT; dst++)
+        {
+            HIDDT_RGBConversionFunction *f = &rgbconvertfuncs[src - FIRST_RGB_STDPIXFMT][dst - FIRST_RGB_STDPIXFMT];
+
+            if (rgbconv_getterms(*f, src, dst))
+                *f = convert_terms_neon;
+        }
+    }
+}
@@ -0,0 +1,174 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Common code for the vector unit color conversion routines.
+*/
+
+/* Every generic conversion routine moves each bit of a source pixel to a
+   fixed bit of the destination pixel. So a conversion can be described by
+   a few terms, each one shifting the whole source pixel and masking the
+   bits that end up in the right place:
+
+       dst = ((src << shift[0]) & mask[0]) | ((src << shift[1]) & mask[1]) | ...
+
+   A negative shift is a shift to the right. No conversion needs more than
+   RGBCONV_MAXTERMS terms. The terms are derived from the generic routines
+   when the vector routines are installed, so both produce exactly the same
+   pixels, including what goes into the unused byte of the 0RGB32 etc.
+   formats.
+
+   Pixels are handled as values of 2, 3 or 4 bytes, with the first byte of a
+   24 bit pixel in the least significant byte. The vector routines only work
+   on little endian machines, where that matches how 16 and 32 bit pixels
+   are loaded. */
+
+#define RGBCONV_MAXTERMS    4
+
+struct RGBConvTerms
+{
+    UBYTE srcbpp;
+    UBYTE dstbpp;
+    UBYTE count;                        /* 0 if the terms are not known */
+    BYTE  shift[RGBCONV_MAXTERMS];
+    ULONG mask[RGBCONV_MAXTERMS];
+};
+
+static struct RGBConvTerms rgbconv_terms[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT];
+
+#define RGBCONV_TERMS(srcfmt, dstfmt) \
+    (&rgbconv_terms[(srcfmt) - FIRST_RGB_STDPIXFMT][(dstfmt) - FIRST_RGB_STDPIXFMT])
+
+static inline UBYTE rgbconv_bpp(HIDDT_StdPixFmt fmt)
+{
+    if (fmt <= vHidd_StdPixFmt_BGR24)
+        return 3;
+    if (fmt <= vHidd_StdPixFmt_BGR15_LE)
+        return 2;
+    return 4;
+}
+
+static inline ULONG rgbconv_getpixel(UBYTE *p, UBYTE bpp)
+{
+    switch (bpp)
+    {
+    case 2:
+        return *(UWORD *)p;
+    case 3:
+        return p[0] | (p[1] << 8) | (p[2] << 16);
+    default:
+        return *(ULONG *)p;
+    }
+}
+
+static inline void rgbconv_putpixel(UBYTE *p, UBYTE bpp, ULONG pixel)
+{
+    switch (bpp)
+    {
+    case 2:
+        *(UWORD *)p = pixel;
+        break;
+    case 3:
+        p[0] = pixel;
+        p[1] = pixel >> 8;
+        p[2] = pixel >> 16;
+        break;
+    default:
+        *(ULONG *)p = pixel;
+        break;
+    }
+}
+
+static inline ULONG rgbconv_apply(const struct RGBConvTerms *t, ULONG pixel)
+{
+    ULONG dst = 0;
+    UBYTE i;
+
+    for (i = 0; i < t->count; i++)
+    {
+        if (t->shift[i] >= 0)
+            dst |= (pixel << t->shift[i]) & t->mask[i];
+        else
+            dst |= (pixel >> -t->shift[i]) & t->mask[i];
+    }
+
+    return dst;
+}
+
+/* Converts the pixels of a row that the vector code left over */
+static inline void rgbconv_convertrow(const struct RGBConvTerms *t, UBYTE *src, UBYTE *dst, ULONG width)
+{
+    for (; width > 0; width--)
+    {
+        rgbconv_putpixel(dst, t->dstbpp, rgbconv_apply(t, rgbconv_getpixel(src, t->srcbpp)));
+        src += t->srcbpp;
+        dst += t->dstbpp;
+    }
+}
+
+static ULONG rgbconv_convertone(HIDDT_RGBConversionFunction f, HIDDT_StdPixFmt srcfmt,
+    HIDDT_StdPixFmt dstfmt, ULONG pixel)
+{
+    UBYTE src[4] = { 0 }, dst[4] = { 0 };
+
+    rgbconv_putpixel(src, rgbconv_bpp(srcfmt), pixel);
+    f(src, 0, srcfmt, dst, 0, dstfmt, 1, 1);
+
+    return rgbconv_getpixel(dst, rgbconv_bpp(dstfmt));
+}
+
+/* Derives the terms of a conversion by feeding the routine single bits,
+   then checks them with some random pixels */
+static BOOL rgbconv_getterms(HIDDT_RGBConversionFunction f, HIDDT_StdPixFmt srcfmt, HIDDT_StdPixFmt dstfmt)
+{
+    struct RGBConvTerms *t = RGBCONV_TERMS(srcfmt, dstfmt);
+    ULONG srcmask, dst, pixel, seed = 0x2545F491;
+    WORD bit, dstbit, shift;
+    UBYTE i;
+
+    t->srcbpp = rgbconv_bpp(srcfmt);
+    t->dstbpp = rgbconv_bpp(dstfmt);
+    t->count = 0;
+
+    if (f == NULL || rgbconv_convertone(f, srcfmt, dstfmt, 0) != 0)
+        return FALSE;
+
+    for (bit = 0; bit < t->srcbpp * 8; bit++)
+    {
+        dst = rgbconv_convertone(f, srcfmt, dstfmt, 1UL << bit);
+
+        for (dstbit = 0; dstbit < t->dstbpp * 8; dstbit++)
+        {
+            if (!(dst & (1UL << dstbit)))
+                continue;
+
+            shift = dstbit - bit;
+            for (i = 0; i < t->count && t->shift[i] != shift; i++);
+            if (i == t->count)
+            {
+                if (i == RGBCONV_MAXTERMS)
+                {
+                    t->count = 0;
+                    return FALSE;
+                }
+                t->shift[i] = shift;
+                t->mask[i] = 0;
+                t->count++;
+            }
+            t->mask[i] |= 1UL << dstbit;
+        }
+    }
+
+    srcmask = (t->srcbpp == 4) ? 0xFFFFFFFF : (1UL << (t->srcbpp * 8)) - 1;
+    for (i = 0; i < 16; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        pixel = (seed ^ (seed >> 16) ^ (seed << 13)) & srcmask;
+        if (rgbconv_convertone(f, srcfmt, dstfmt, pixel) != rgbconv_apply(t, pixel))
+        {
+            t->count = 0;
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
@@ -0,0 +1,439 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Alpha blending of pixel spans, used by PutAlphaImage and PutAlphaTemplate.
+*/
+
+/* The source is always an ARGB32 array with straight (not premultiplied)
+   alpha, which is blended over the destination with
+
+       d = (s * a + d * (255 - a)) / 255
+
+   rounded to the nearest value. The alpha or pad byte of 32 bit
+   destinations and the unused bit of 15 bit ones are left as they are.
+
+   The vector routines use the generic vector types of the compiler, which
+   become SSE2 or NEON code on little endian machines, and blend 4 pixels of
+   32 bits or 8 pixels of 16 bits at a time. The plain routines do the rest
+   of each row, and everything on other machines. Both give the same
+   results. */
+
+#include <exec/types.h>
+#include <hidd/gfx.h>
+
+#include "gfx_intern.h"
+#include "gfx_debug.h"
+#include "gfx_bitmapmemblit_vector.h"
+
+#if defined(MEMBLIT_VECTOR) && !AROS_BIG_ENDIAN
+#define ALPHABLEND_VECTOR
+#endif
+
+/****************************************************************************************/
+
+/* Byte order of 32 bit formats, relative to ARGB32 */
+#define ORDER_ARGB      0
+#define ORDER_BGRA      1
+#define ORDER_RGBA      2
+#define ORDER_ABGR      3
+
+struct AlphaBlendFormat
+{
+    UBYTE bpp;          /* 2 or 4, 0 if the format isn't handled here */
+    UBYTE order;        /* 32 bit: byte order */
+    UBYTE pad;          /* 32 bit: offset of the alpha or pad byte */
+    UBYTE red;          /* 32 bit: byte offsets, 16 bit: bit positions */
+    UBYTE green;
+    UBYTE blue;
+    UBYTE redbits;      /* 16 bit: sizes of the color components */
+    UBYTE greenbits;
+    UBYTE bluebits;
+    UBYTE bigendian;    /* 16 bit: pixels are stored in big endian order */
+};
+
+#define FMT32(order, pad, r, g, b)      { 4, order, pad, r, g, b, 0, 0, 0, 0 }
+#define FMT16(r, g, b, rb, gb, bb, be)  { 2, 0, 0, r, g, b, rb, gb, bb, be }
+
+/* In the order of the vHidd_StdPixFmt enum */
+static const struct AlphaBlendFormat alphablend_formats[NUM_RGB_STDPIXFMT] =
+{
+    { 0 },                                      /* RGB24    */
+    { 0 },                                      /* BGR24    */
+    FMT16(11,  5,  0, 5, 6, 5, 1),              /* RGB16    */
+    FMT16(11,  5,  0, 5, 6, 5, 0),              /* RGB16_LE */
+    FMT16( 0,  5, 11, 5, 6, 5, 1),              /* BGR16    */
+    FMT16( 0,  5, 11, 5, 6, 5, 0),              /* BGR16_LE */
+    FMT16(10,  5,  0, 5, 5, 5, 1),              /* RGB15    */
+    FMT16(10,  5,  0, 5, 5, 5, 0),              /* RGB15_LE */
+    FMT16( 0,  5, 10, 5, 5, 5, 1),              /* BGR15    */
+    FMT16( 0,  5, 10, 5, 5, 5, 0),              /* BGR15_LE */
+    FMT32(ORDER_ARGB, 0, 1, 2, 3),              /* ARGB32   */
+    FMT32(ORDER_BGRA, 3, 2, 1, 0),              /* BGRA32   */
+    FMT32(ORDER_RGBA, 3, 0, 1, 2),              /* RGBA32   */
+    FMT32(ORDER_ABGR, 0, 3, 2, 1),              /* ABGR32   */
+    FMT32(ORDER_ARGB, 0, 1, 2, 3),              /* 0RGB32   */
+    FMT32(ORDER_BGRA, 3, 2, 1, 0),              /* BGR032   */
+    FMT32(ORDER_RGBA, 3, 0, 1, 2),              /* RGB032   */
+    FMT32(ORDER_ABGR, 0, 3, 2, 1)               /* 0BGR32   */
+};
+
+#undef FMT32
+#undef FMT16
+
+static const struct AlphaBlendFormat *alphablend_getformat(HIDDT_StdPixFmt stdpf)
+{
+    const struct AlphaBlendFormat *f;
+
+    if (stdpf < FIRST_RGB_STDPIXFMT || stdpf > LAST_RGB_STDPIXFMT)
+        return NULL;
+
+    f = &alphablend_formats[stdpf - FIRST_RGB_STDPIXFMT];
+
+    return f->bpp ? f : NULL;
+}
+
+/****************************************************************************************/
+
+static inline UBYTE alphablend_channel(UBYTE s, UBYTE d, UBYTE a)
+{
+    ULONG x = s * a + d * (255 - a) + 128;
+
+    return (x + (x >> 8)) >> 8;
+}
+
+/* Widens a color component to 8 bits, repeating its upper bits at the bottom */
+static inline UBYTE alphablend_expand(UWORD pix, UBYTE shift, UBYTE bits)
+{
+    UBYTE c = (pix >> shift) & ((1 << bits) - 1);
+
+    return (c << (8 - bits)) | (c >> (2 * bits - 8));
+}
+
+static inline UWORD alphablend_pack(UBYTE c, UBYTE shift, UBYTE bits)
+{
+    return (c >> (8 - bits)) << shift;
+}
+
+static inline UWORD alphablend_unused16(const struct AlphaBlendFormat *f)
+{
+    return ~((((1 << f->redbits) - 1) << f->red) |
+             (((1 << f->greenbits) - 1) << f->green) |
+             (((1 << f->bluebits) - 1) << f->blue));
+}
+
+static void alphablend_row32(UBYTE *d, const UBYTE *s, ULONG width, const struct AlphaBlendFormat *f)
+{
+    for (; width; width--, s += 4, d += 4)
+    {
+        UBYTE a = s[0];
+
+        if (a == 0)
+            continue;
+
+        d[f->red]   = alphablend_channel(s[1], d[f->red], a);
+        d[f->green] = alphablend_channel(s[2], d[f->green], a);
+        d[f->blue]  = alphablend_channel(s[3], d[f->blue], a);
+    }
+}
+
+static void alphablend_row16(UBYTE *d, const UBYTE *s, ULONG width, const struct AlphaBlendFormat *f)
+{
+    UWORD unused = alphablend_unused16(f);
+
+    for (; width; width--, s += 4, d += 2)
+    {
+        UBYTE a = s[0];
+        UWORD pix;
+
+        if (a == 0)
+            continue;
+
+        pix = f->bigendian ? (d[0] << 8) | d[1] : d[0] | (d[1] << 8);
+
+        pix = (pix & unused) |
+              alphablend_pack(alphablend_channel(s[1], alphablend_expand(pix, f->red, f->redbits), a),
+                              f->red, f->redbits) |
+              alphablend_pack(alphablend_channel(s[2], alphablend_expand(pix, f->green, f->greenbits), a),
+                              f->green, f->greenbits) |
+              alphablend_pack(alphablend_channel(s[3], alphablend_expand(pix, f->blue, f->bluebits), a),
+                              f->blue, f->bluebits);
+
+        if (f->bigendian)
+        {
+            d[0] = pix >> 8;
+            d[1] = pix;
+        }
+        else
+        {
+            d[0] = pix;
+            d[1] = pix >> 8;
+        }
+    }
+}
+
+/****************************************************************************************/
+
+#ifdef ALPHABLEND_VECTOR
+
+/* Blends 4 pixels, which are in the same byte order. alpha holds the alpha
+   value of each pixel in both of its 16 bit halves */
+static inline memblit_v4ul alphablend_vector(memblit_v4ul s, memblit_v4ul d, memblit_v4ul alpha)
+{
+    const memblit_v4ul mask = { 0x00FF00FF, 0x00FF00FF, 0x00FF00FF, 0x00FF00FF };
+    memblit_v8uw a = (memblit_v8uw)alpha, na = (memblit_v8uw)(mask - alpha);
+    memblit_v8uw lo, hi;
+
+    lo = (memblit_v8uw)(s & mask) * a + (memblit_v8uw)(d & mask) * na + 128;
+    hi = (memblit_v8uw)((s >> 8) & mask) * a + (memblit_v8uw)((d >> 8) & mask) * na + 128;
+
+    lo = (lo + (lo >> 8)) >> 8;
+    hi = (hi + (hi >> 8)) >> 8;
+
+    return (memblit_v4ul)lo | ((memblit_v4ul)hi << 8);
+}
+
+/* Puts ARGB32 pixels into the byte order of the destination */
+static inline __attribute__((always_inline)) memblit_v4ul alphablend_reorder(memblit_v4ul v, UBYTE order)
+{
+    switch (order)
+    {
+    case ORDER_BGRA:
+        return (v << 24) | ((v << 8) & 0x00FF0000) | ((v >> 8) & 0x0000FF00) | (v >> 24);
+
+    case ORDER_RGBA:
+        return (v >> 8) | (v << 24);
+
+    case ORDER_ABGR:
+        return (v & 0x00FF00FF) | ((v << 16) & 0xFF000000) | ((v >> 16) & 0x0000FF00);
+
+    default:
+        return v;
+    }
+}
+
+/* Blends the first width & ~3 pixels of a row. Always inlined, so the
+   compiler makes a separate loop for each byte order */
+static inline __attribute__((always_inline)) ULONG alphablend_row32_vector(UBYTE *d, const UBYTE *s, ULONG width,
+    UBYTE order, UBYTE pad)
+{
+    memblit_v4ul keep = { 0 };
+    ULONG x;
+
+    keep += (ULONG)0xFF << (pad * 8);
+
+    for (x = 0; x + 4 <= width; x += 4, s += 16, d += 16)
+    {
+        memblit_v4ul sv = *(memblit_v4ul_u *)s;
+        memblit_v4ul a = sv & 0xFF;
+        memblit_v4ul_u *dv = (memblit_v4ul_u *)d;
+
+        if ((a[0] | a[1] | a[2] | a[3]) == 0)
+            continue;
+
+        if ((a[0] & a[1] & a[2] & a[3]) == 0xFF)
+            *dv = (alphablend_reorder(sv, order) & ~keep) | (*dv & keep);
+        else
+            *dv = (alphablend_vector(alphablend_reorder(sv, order), *dv, a | (a << 16)) & ~keep) | (*dv & keep);
+    }
+
+    return x;
+}
+
+/* Blends the first width & ~7 pixels of a row, through 32 bit pixels in
+   ARGB32 order */
+static ULONG alphablend_row16_vector(UBYTE *d, const UBYTE *s, ULONG width, const struct AlphaBlendFormat *f)
+{
+    const memblit_v8uw lo4 = { 0, 8, 1, 9, 2, 10, 3, 11 };
+    const memblit_v8uw hi4 = { 4, 12, 5, 13, 6, 14, 7, 15 };
+    const memblit_v8uw even = { 0, 2, 4, 6, 8, 10, 12, 14 };
+    const memblit_v8uw odd = { 1, 3, 5, 7, 9, 11, 13, 15 };
+    UBYTE swap = f->bigendian != AROS_BIG_ENDIAN;
+    UWORD unused = alphablend_unused16(f);
+    UWORD rmask = (1 << f->redbits) - 1, gmask = (1 << f->greenbits) - 1, bmask = (1 << f->bluebits) - 1;
+    ULONG x;
+
+    for (x = 0; x + 8 <= width; x += 8, s += 32, d += 16)
+    {
+        memblit_v4ul s0 = ((memblit_v4ul_u *)s)[0];
+        memblit_v4ul s1 = ((memblit_v4ul_u *)s)[1];
+        memblit_v4ul a0 = s0 & 0xFF, a1 = s1 & 0xFF, any = a0 | a1;
+        memblit_v8uw pix, r, g, b, rg, gb;
+        memblit_v4ul d0, d1;
+
+        if ((any[0] | any[1] | any[2] | any[3]) == 0)
+            continue;
+
+        pix = *(memblit_v8uw_u *)d;
+        if (swap)
+            pix = (pix << 8) | (pix >> 8);
+
+        r = (pix >> f->red) & rmask;
+        g = (pix >> f->green) & gmask;
+        b = (pix >> f->blue) & bmask;
+        r = (r << (8 - f->redbits)) | (r >> (2 * f->redbits - 8));
+        g = (g << (8 - f->greenbits)) | (g >> (2 * f->greenbits - 8));
+        b = (b << (8 - f->bluebits)) | (b >> (2 * f->bluebits - 8));
+
+        /* ARGB32 pixels are R << 8 | A in their lower and B << 8 | G in
+           their upper half */
+        rg = r << 8;
+        gb = (b << 8) | g;
+        d0 = (memblit_v4ul)__builtin_shuffle(rg, gb, lo4);
+        d1 = (memblit_v4ul)__builtin_shuffle(rg, gb, hi4);
+
+        d0 = alphablend_vector(s0, d0, a0 | (a0 << 16));
+        d1 = alphablend_vector(s1, d1, a1 | (a1 << 16));
+
+        rg = __builtin_shuffle((memblit_v8uw)d0, (memblit_v8uw)d1, even);
+        gb = __builtin_shuffle((memblit_v8uw)d0, (memblit_v8uw)d1, odd);
+
+        pix = (pix & unused) |
+              ((rg >> (16 - f->redbits)) << f->red) |
+              (((gb & 0xFF) >> (8 - f->greenbits)) << f->green) |
+              ((gb >> (16 - f->bluebits)) << f->blue);
+
+        if (swap)
+            pix = (pix << 8) | (pix >> 8);
+        *(memblit_v8uw_u *)d = pix;
+    }
+
+    return x;
+}
+
+#endif
+
+/****************************************************************************************/
+
+static void alphablend_row(UBYTE *d, const UBYTE *s, ULONG width, const struct AlphaBlendFormat *f)
+{
+    ULONG done = 0;
+
+    if (f->bpp == 2)
+    {
+#ifdef ALPHABLEND_VECTOR
+        done = alphablend_row16_vector(d, s, width, f);
+#endif
+        alphablend_row16(d + done * 2, s + done * 4, width - done, f);
+    }
+    else
+    {
+#ifdef ALPHABLEND_VECTOR
+        switch (f->order)
+        {
+        case ORDER_BGRA:
+            done = alphablend_row32_vector(d, s, width, ORDER_BGRA, f->pad);
+            break;
+
+        case ORDER_RGBA:
+            done = alphablend_row32_vector(d, s, width, ORDER_RGBA, f->pad);
+            break;
+
+        case ORDER_ABGR:
+            done = alphablend_row32_vector(d, s, width, ORDER_ABGR, f->pad);
+            break;
+
+        default:
+            done = alphablend_row32_vector(d, s, width, ORDER_ARGB, f->pad);
+            break;
+        }
+#endif
+        alphablend_row32(d + done * 4, s + done * 4, width - done, f);
+    }
+}
+
+/****************************************************************************************/
+
+/* Blends an ARGB32 pixel array over a buffer of pixels in the given format.
+   Returns FALSE without touching anything if the format isn't supported */
+BOOL AlphaBlendImage(UBYTE *dst, ULONG dstMod, HIDDT_StdPixFmt dstPixFmt,
+                     UBYTE *src, ULONG srcMod, UWORD width, UWORD height)
+{
+    const struct AlphaBlendFormat *f = alphablend_getformat(dstPixFmt);
+    UWORD y;
+
+    if (!f)
+        return FALSE;
+
+    D(bug("[GFX] AlphaBlendImage(%d x %d, format %d)\n", width, height, dstPixFmt));
+
+    for (y = 0; y < height; y++)
+    {
+        alphablend_row(dst, src, width, f);
+
+        dst += dstMod;
+        src += srcMod;
+    }
+
+    return TRUE;
+}
+
+/* Pixels blended at a time by AlphaBlendTemplate(). Keeps the buffers on
+   the stack small */
+#define TEMPLATE_CHUNK 64
+
+static void alphablend_fillcolor(UBYTE *buf, HIDDT_Color *col, ULONG width)
+{
+    ULONG x;
+
+    for (x = 0; x < width * 4; x += 4)
+    {
+        buf[x]     = 0xFF;
+        buf[x + 1] = col->red >> 8;
+        buf[x + 2] = col->green >> 8;
+        buf[x + 3] = col->blue >> 8;
+    }
+}
+
+/* Blends the foreground color over a buffer of pixels in the given format,
+   with an 8 bit alpha mask. If bg isn't NULL the foreground is blended over
+   the background color instead, and the result replaces the pixels.
+   Returns FALSE without touching anything if the format isn't supported */
+BOOL AlphaBlendTemplate(UBYTE *dst, ULONG dstMod, HIDDT_StdPixFmt dstPixFmt,
+                        UBYTE *alpha, ULONG alphaMod, UWORD width, UWORD height,
+                        HIDDT_Color *fg, HIDDT_Color *bg, BOOL invertalpha)
+{
+    const struct AlphaBlendFormat *f = alphablend_getformat(dstPixFmt);
+    const struct AlphaBlendFormat *argb32 = &alphablend_formats[vHidd_StdPixFmt_ARGB32 - FIRST_RGB_STDPIXFMT];
+    ULONG color[TEMPLATE_CHUNK], opaque[TEMPLATE_CHUNK];
+    UBYTE invert = invertalpha ? 0xFF : 0;
+    UWORD x, y;
+
+    if (!f)
+        return FALSE;
+
+    D(bug("[GFX] AlphaBlendTemplate(%d x %d, format %d, %s)\n", width, height, dstPixFmt,
+          bg ? "JAM2" : "JAM1"));
+
+    alphablend_fillcolor((UBYTE *)color, fg, TEMPLATE_CHUNK);
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < width; x += TEMPLATE_CHUNK)
+        {
+            UWORD n = (width - x < TEMPLATE_CHUNK) ? width - x : TEMPLATE_CHUNK;
+            UBYTE *c = (UBYTE *)color;
+            UWORD i;
+
+            /* The foreground color with the alpha of each pixel */
+            for (i = 0; i < n; i++)
+                c[i * 4] = alpha[x + i] ^ invert;
+
+            if (bg)
+            {
+                /* Mix the colors first, and put the opaque result */
+                alphablend_fillcolor((UBYTE *)opaque, bg, n);
+                alphablend_row((UBYTE *)opaque, c, n, argb32);
+                alphablend_row(dst + x * f->bpp, (UBYTE *)opaque, n, f);
+            }
+            else
+            {
+                alphablend_row(dst + x * f->bpp, c, n, f);
+            }
+        }
+
+        dst += dstMod;
+        alpha += alphaMod;
+    }
+
+    return TRUE;
+}
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2022, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Gfx BitMap class implementation.
 */
@@ -2942,38 +2942,20 @@ __attribute__((always_inline, const)) do_alpha(int a, int f, int b)
 
 #if AROS_BIG_ENDIAN
 
-#define RGB32_DECOMPOSE(red, green, blue, pix) \
-    red   = ((pix) & 0x00FF0000) >> 16;        \
-    green = ((pix) & 0x0000FF00) >> 8;         \
-    blue  = ((pix) & 0x000000FF);
-
-#define ARGB32_ALPHA(pix) ((pix) & 0xFF000000)
-
 #define ARGB32_DECOMPOSE(alpha, red, green, blue, pix) \
     alpha = ((pix) & 0xFF000000) >> 24;                \
     red   = ((pix) & 0x00FF0000) >> 16;                \
     green = ((pix) & 0x0000FF00) >> 8;                 \
     blue  = ((pix) & 0x000000FF);
 
-#define ARGB32_COMPOSE(red, green, blue, old) (((old) & 0xFF000000) + ((red) << 16) + ((green) << 8) + (blue))
-
 #else
 
-#define RGB32_DECOMPOSE(red, green, blue, pix) \
-    red   = (pix & 0x0000FF00) >> 8;           \
-    green = (pix & 0x00FF0000) >> 16;          \
-    blue  = (pix & 0xFF000000) >> 24
-
-#define ARGB32_ALPHA(pix) ((pix) & 0x000000FF)
-
 #define ARGB32_DECOMPOSE(alpha, red, green, blue, pix) \
     alpha = (pix & 0x000000FF);                        \
     red   = (pix & 0x0000FF00) >> 8;                   \
     green = (pix & 0x00FF0000) >> 16;                  \
     blue  = (pix & 0xFF000000) >> 24
 
-#define ARGB32_COMPOSE(red, green, blue, old) (((blue) << 24) + ((green) << 16) + ((red) << 8) + ((old) & 0x000000FF))
-
 #endif
 
 /*****************************************************************************************
@@ -3039,43 +3021,10 @@ struct paib_data
 
 static void PutAlphaImageBuffered(ULONG *xbuf, UWORD starty, UWORD width, UWORD height, struct paib_data *data)
 {
-    UWORD x, y;
-
-    for (y = 0; y < height; y++)
-    {
-        ULONG *pixarray = data->pixels;
-
-        for (x = 0; x < width; x++)
-        {
-            ULONG destpix;
-            ULONG srcpix;
-            ULONG src_red, src_green, src_blue, src_alpha;
-            ULONG dst_red, dst_green, dst_blue;
+    AlphaBlendImage((UBYTE *)xbuf, width * sizeof(ULONG), vHidd_StdPixFmt_ARGB32,
+                    data->pixels, data->modulo, width, height);
 
-            srcpix = *pixarray++;
-
-            if (ARGB32_ALPHA(srcpix) == ARGB32_ALPHA(0xFFFFFFFF))
-            {
-                xbuf[x] = srcpix;
-            }
-            else if (ARGB32_ALPHA(srcpix) != 0)
-            {
-                ARGB32_DECOMPOSE(src_alpha, src_red, src_green, src_blue, srcpix);
-
-                destpix = xbuf[x];
-                RGB32_DECOMPOSE(dst_red, dst_green, dst_blue, destpix);
-
-                dst_red   += do_alpha(src_alpha, src_red, dst_red);
-                dst_green += do_alpha(src_alpha, src_green, dst_green);
-                dst_blue  += do_alpha(src_alpha, src_blue, dst_blue);
-
-                xbuf[x] = ARGB32_COMPOSE(dst_red, dst_green, dst_blue, destpix);
-            }
-        }
-
-        xbuf += width;
-        data->pixels += data->modulo;
-    }
+    data->pixels += data->modulo * height;
 }
 
 VOID BM__Hidd_BitMap__PutAlphaImage(OOP_Class *cl, OOP_Object *o,
@@ -3378,38 +3327,18 @@ VOID BM__Hidd_BitMap__PutTemplate(OOP_Class *cl, OOP_Object *o, struct pHidd_Bit
 
 struct patb_data
 {
-    UBYTE *pixarray;
-    ULONG  modulo;
-    LONG   a_red, a_green, a_blue;
-    LONG   b_red, b_green, b_blue;
-    UBYTE  invert;
+    UBYTE      *pixarray;
+    ULONG       modulo;
+    HIDDT_Color fg, bg;
+    UBYTE       invert;
 };
 
 static void JAM1AlphaTemplateBuffered(ULONG *xbuf, UWORD starty, UWORD width, UWORD height, struct patb_data *data)
 {
-    UWORD x, y;
-
-    for (y = 0; y < height; y++)
-    {
-        UBYTE *pixarray = data->pixarray;
+    AlphaBlendTemplate((UBYTE *)xbuf, width * sizeof(ULONG), vHidd_StdPixFmt_ARGB32,
+                       data->pixarray, data->modulo, width, height, &data->fg, NULL, data->invert);
 
-        for (x = 0; x < width; x++)
-        {
-            LONG dst_red, dst_green, dst_blue, alpha;
-
-            alpha = (*pixarray++) ^ data->invert;
-            RGB32_DECOMPOSE(dst_red, dst_green, dst_blue, xbuf[x]);
-
-            dst_red   += do_alpha(alpha, data->a_red, dst_red);
-            dst_green += do_alpha(alpha, data->a_green, dst_green);
-            dst_blue  += do_alpha(alpha, data->a_blue, dst_blue);
-
-            xbuf[x] = ARGB32_COMPOSE(dst_red, dst_green, dst_blue, 0);
-        }
-
-        xbuf += width;
-        data->pixarray += data->modulo;
-    }
+    data->pixarray += data->modulo * height;
 }
 
 static void ComplementAlphaTemplateBuffered(ULONG *xbuf, UWORD starty, UWORD width, UWORD height, struct patb_data *data)
@@ -3435,28 +3364,13 @@ static void ComplementAlphaTemplateBuffered(ULONG *xbuf, UWORD starty, UWORD wid
 
 static void JAM2AlphaTemplateBuffered(ULONG *xbuf, UWORD starty, UWORD width, UWORD height, struct patb_data *data)
 {
-    UWORD x, y;
-
-    for (y = 0; y < height; y++)
-    {
-        UBYTE *pixarray = data->pixarray;
+    /* The buffer wasn't filled, clear the alpha bytes */
+    memset(xbuf, 0, width * height * sizeof(ULONG));
 
-        for (x = 0; x < width; x++)
-        {
-            LONG dst_red, dst_green, dst_blue, alpha;
+    AlphaBlendTemplate((UBYTE *)xbuf, width * sizeof(ULONG), vHidd_StdPixFmt_ARGB32,
+                       data->pixarray, data->modulo, width, height, &data->fg, &data->bg, data->invert);
 
-            alpha = (*pixarray++) ^ data->invert;
-
-            dst_red   = data->b_red   + ((data->a_red   - data->b_red)   * alpha) / 256;
-            dst_green = data->b_green + ((data->a_green - data->b_green) * alpha) / 256;
-            dst_blue  = data->b_blue  + ((data->a_blue  - data->b_blue)  * alpha) / 256;
-
-            xbuf[x] = ARGB32_COMPOSE(dst_red, dst_green, dst_blue, 0);
-        }
-
-        xbuf += width;
-        data->pixarray += data->modulo;
-    }
+    data->pixarray += data->modulo * height;
 }
 
 VOID BM__Hidd_BitMap__PutAlphaTemplate(OOP_Class *cl, OOP_Object *o,
@@ -3466,7 +3380,6 @@ VOID BM__Hidd_BitMap__PutAlphaTemplate(OOP_Class *cl, OOP_Object *o,
     BOOL get = TRUE;
     void (*op)(ULONG *, UWORD, UWORD, UWORD, struct patb_data *);
     struct patb_data data;
-    HIDDT_Color color;
 
     EnterFunc(bug("BitMap::PutAlphaTemplate(x=%d, y=%d, width=%d, height=%d)\n"
                 , msg->x, msg->y, msg->width, msg->height));
@@ -3474,10 +3387,7 @@ VOID BM__Hidd_BitMap__PutAlphaTemplate(OOP_Class *cl, OOP_Object *o,
     if (msg->width <= 0 || msg->height <= 0)
         return;
 
-    UNMAPPIXEL(cl, o, GC_FG(gc), &color);
-    data.a_red   = color.red   >> 8;
-    data.a_green = color.green >> 8;
-    data.a_blue  = color.blue  >> 8;
+    UNMAPPIXEL(cl, o, GC_FG(gc), &data.fg);
 
     if (GC_COLEXP(gc) == vHidd_GC_ColExp_Transparent)
     {
@@ -3492,10 +3402,7 @@ VOID BM__Hidd_BitMap__PutAlphaTemplate(OOP_Class *cl, OOP_Object *o,
         op  = JAM2AlphaTemplateBuffered;
         get = FALSE;
 
-        UNMAPPIXEL(cl, o, GC_BG(gc), &color);
-        data.b_red   = color.red   >> 8;
-        data.b_green = color.green >> 8;
-        data.b_blue  = color.blue  >> 8;
+        UNMAPPIXEL(cl, o, GC_BG(gc), &data.bg);
     }
 
     data.pixarray = msg->alpha;
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <string.h>
@@ -8,6 +8,7 @@
 
 #include "gfx_intern.h"
 #include "gfx_debug.h"
+#include "gfx_bitmapmemblit_vector.h"
 
 /****************************************************************************************/
 
@@ -71,6 +72,20 @@ VOID BM__Hidd_BitMap__FillMemRect16(OOP_Class *cl, OOP_Object *o, struct pHidd_B
     height = msg->maxY - msg->minY + 1;
     start_add = msg->dstMod - width * 2;
         
+#ifdef MEMBLIT_VECTOR
+    {
+        union MemBlitPattern pat;
+
+        memblit_makepattern(&pat, 2, msg->fill);
+        while(height--)
+        {
+            memblit_fillrow(start, width * 2, &pat);
+            start += msg->dstMod;
+        }
+        return;
+    }
+#endif
+
     if ((phase = (IPTR)start & 1L))
     {
         phase = 2 - phase;
@@ -120,6 +135,20 @@ VOID BM__Hidd_BitMap__FillMemRect24(OOP_Class *cl, OOP_Object *o, struct pHidd_B
     height = msg->maxY - msg->minY + 1;
     start_add = msg->dstMod - width * 3;
 
+#ifdef MEMBLIT_VECTOR
+    {
+        union MemBlitPattern pat;
+
+        memblit_makepattern(&pat, 3, msg->fill);
+        while(height--)
+        {
+            memblit_fillrow(start, width * 3, &pat);
+            start += msg->dstMod;
+        }
+        return;
+    }
+#endif
+
 #if AROS_BIG_ENDIAN
     fill1 = (msg->fill >> 16) & 0xFF;
     fill2 = (msg->fill >> 8) & 0xFF;
@@ -159,6 +188,20 @@ VOID BM__Hidd_BitMap__FillMemRect32(OOP_Class *cl, OOP_Object *o, struct pHidd_B
     height = msg->maxY - msg->minY + 1;
     start_add = msg->dstMod - width * 4;
         
+#ifdef MEMBLIT_VECTOR
+    {
+        union MemBlitPattern pat;
+
+        memblit_makepattern(&pat, 4, msg->fill);
+        while(height--)
+        {
+            memblit_fillrow(start, width * 4, &pat);
+            start += msg->dstMod;
+        }
+        return;
+    }
+#endif
+
     fill32 = msg->fill;
         
     while(height--)
@@ -359,6 +402,24 @@ VOID BM__Hidd_BitMap__CopyMemBox16(OOP_Class *cl, OOP_Object *o, struct pHidd_Bi
         descending = TRUE;
     }
  
+#ifdef MEMBLIT_VECTOR
+    while(height--)
+    {
+        memblit_copyrow(dst_start, src_start, msg->width * 2, descending);
+        if (!descending)
+        {
+            src_start += msg->srcMod;
+            dst_start += msg->dstMod;
+        }
+        else
+        {
+            src_start -= msg->srcMod;
+            dst_start -= msg->dstMod;
+        }
+    }
+    return;
+#endif
+
     if (!descending)
     {
         while(height--)
@@ -445,6 +506,24 @@ VOID BM__Hidd_BitMap__CopyMemBox24(OOP_Class *cl, OOP_Object *o, struct pHidd_Bi
         descending = TRUE;
     }
  
+#ifdef MEMBLIT_VECTOR
+    while(height--)
+    {
+        memblit_copyrow(dst_start, src_start, msg->width * 3, descending);
+        if (!descending)
+        {
+            src_start += msg->srcMod;
+            dst_start += msg->dstMod;
+        }
+        else
+        {
+            src_start -= msg->srcMod;
+            dst_start -= msg->dstMod;
+        }
+    }
+    return;
+#endif
+
     if (!descending)
     {
         while(height--)
@@ -512,6 +591,24 @@ VOID BM__Hidd_BitMap__CopyMemBox32(OOP_Class *cl, OOP_Object *o, struct pHidd_Bi
         descending = TRUE;
     }
  
+#ifdef MEMBLIT_VECTOR
+    while(height--)
+    {
+        memblit_copyrow(dst_start, src_start, msg->width * 4, descending);
+        if (!descending)
+        {
+            src_start += msg->srcMod;
+            dst_start += msg->dstMod;
+        }
+        else
+        {
+            src_start -= msg->srcMod;
+            dst_start -= msg->dstMod;
+        }
+    }
+    return;
+#endif
+
     if (!descending)
     {
         while(height--)
@@ -1045,6 +1142,24 @@ VOID BM__Hidd_BitMap__PutMemTemplate16(OOP_Class *cl, OOP_Object *o, struct pHid
     
     buf = msg->dst + msg->y * msg->dstMod + msg->x * 2;
 
+#ifdef MEMBLIT_VECTOR
+    {
+        union MemBlitPattern fgpat, bgpat;
+
+        memblit_makepattern(&fgpat, 2, fg);
+        memblit_makepattern(&bgpat, 2, bg);
+
+        for(y = 0; y < msg->height; y++)
+        {
+            memblit_expandrow(buf, 2, msg->width, type, bitarray, msg->srcx & 0xF, 0, 0,
+                              NULL, 0, &fgpat, &bgpat);
+            buf += msg->dstMod;
+            bitarray += msg->modulo;
+        }
+        return;
+    }
+#endif
+
     for(y = 0; y < msg->height; y++)
     {
         ULONG  mask = bitmask;
@@ -1210,6 +1325,24 @@ VOID BM__Hidd_BitMap__PutMemTemplate24(OOP_Class *cl, OOP_Object *o, struct pHid
     bitmask = 0x8000 >> (msg->srcx & 0xF);
     
     buf = msg->dst + msg->y * msg->dstMod + msg->x * 3;
+
+#ifdef MEMBLIT_VECTOR
+    {
+        union MemBlitPattern fgpat, bgpat;
+
+        memblit_makepattern(&fgpat, 3, fg);
+        memblit_makepattern(&bgpat, 3, bg);
+
+        for(y = 0; y < msg->height; y++)
+        {
+            memblit_expandrow(buf, 3, msg->width, type, bitarray, msg->srcx & 0xF, 0, 0,
+                              NULL, 0, &fgpat, &bgpat);
+            buf += msg->dstMod;
+            bitarray += msg->modulo;
+        }
+        return;
+    }
+#endif
     
     for(y = 0; y < msg->height; y++)
     {
@@ -1398,6 +1531,24 @@ VOID BM__Hidd_BitMap__PutMemTemplate32(OOP_Class *cl, OOP_Object *o, struct pHid
     bitmask = 0x8000 >> (msg->srcx & 0xF);
     
     buf = msg->dst + msg->y * msg->dstMod + msg->x * 4;
+
+#ifdef MEMBLIT_VECTOR
+    {
+        union MemBlitPattern fgpat, bgpat;
+
+        memblit_makepattern(&fgpat, 4, fg);
+        memblit_makepattern(&bgpat, 4, bg);
+
+        for(y = 0; y < msg->height; y++)
+        {
+            memblit_expandrow(buf, 4, msg->width, type, bitarray, msg->srcx & 0xF, 0, 0,
+                              NULL, 0, &fgpat, &bgpat);
+            buf += msg->dstMod;
+            bitarray += msg->modulo;
+        }
+        return;
+    }
+#endif
     
     for(y = 0; y < msg->height; y++)
     {
@@ -1819,6 +1970,27 @@ VOID BM__Hidd_BitMap__PutMemPattern16(OOP_Class *cl, OOP_Object *o, struct pHidd
     }
         
     buf = msg->dst + msg->y * msg->dstMod + msg->x * 2;
+
+#ifdef MEMBLIT_VECTOR
+    if (type != 6)
+    {
+        union MemBlitPattern fgpat, bgpat;
+
+        memblit_makepattern(&fgpat, 2, fg);
+        memblit_makepattern(&bgpat, 2, bg);
+
+        for(y = 0; y < msg->height; y++)
+        {
+            UWORD *parray = ((UWORD *)patarray) + ((y + msg->patternsrcy) % msg->patternheight);
+
+            memblit_expandrow(buf, 2, msg->width, type, NULL, 0, AROS_BE2WORD(*parray), msg->patternsrcx & 0xF,
+                              maskarray, msg->masksrcx & 0xF, &fgpat, &bgpat);
+            buf += msg->dstMod;
+            if (maskarray) maskarray += msg->maskmodulo;
+        }
+        return;
+    }
+#endif
     
     for(y = 0; y < msg->height; y++)
     {
@@ -2100,6 +2272,27 @@ VOID BM__Hidd_BitMap__PutMemPattern24(OOP_Class *cl, OOP_Object *o, struct pHidd
     }
         
     buf = msg->dst + msg->y * msg->dstMod + msg->x * 3;
+
+#ifdef MEMBLIT_VECTOR
+    if (type != 6)
+    {
+        union MemBlitPattern fgpat, bgpat;
+
+        memblit_makepattern(&fgpat, 3, fg);
+        memblit_makepattern(&bgpat, 3, bg);
+
+        for(y = 0; y < msg->height; y++)
+        {
+            UWORD *parray = ((UWORD *)patarray) + ((y + msg->patternsrcy) % msg->patternheight);
+
+            memblit_expandrow(buf, 3, msg->width, type, NULL, 0, AROS_BE2WORD(*parray), msg->patternsrcx & 0xF,
+                              maskarray, msg->masksrcx & 0xF, &fgpat, &bgpat);
+            buf += msg->dstMod;
+            if (maskarray) maskarray += msg->maskmodulo;
+        }
+        return;
+    }
+#endif
     
     for(y = 0; y < msg->height; y++)
     {
@@ -2415,6 +2608,27 @@ VOID BM__Hidd_BitMap__PutMemPattern32(OOP_Class *cl, OOP_Object *o, struct pHidd
     }
         
     buf = msg->dst + msg->y * msg->dstMod + msg->x * 4;
+
+#ifdef MEMBLIT_VECTOR
+    if (type != 6)
+    {
+        union MemBlitPattern fgpat, bgpat;
+
+        memblit_makepattern(&fgpat, 4, fg);
+        memblit_makepattern(&bgpat, 4, bg);
+
+        for(y = 0; y < msg->height; y++)
+        {
+            UWORD *parray = ((UWORD *)patarray) + ((y + msg->patternsrcy) % msg->patternheight);
+
+            memblit_expandrow(buf, 4, msg->width, type, NULL, 0, AROS_BE2WORD(*parray), msg->patternsrcx & 0xF,
+                              maskarray, msg->masksrcx & 0xF, &fgpat, &bgpat);
+            buf += msg->dstMod;
+            if (maskarray) maskarray += msg->maskmodulo;
+        }
+        return;
+    }
+#endif
     
     for(y = 0; y < msg->height; y++)
     {
@@ -0,0 +1,420 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Vector versions of the 16, 24 and 32 bit memory blit routines.
+*/
+
+/* The routines use the generic vector types of the compiler, which become
+   SSE2 or NEON code. Elsewhere MEMBLIT_VECTOR stays undefined and only the
+   plain routines are used.
+
+   Templates and patterns are handled 8 pixels at a time. For each group
+   two bytes are collected first: which pixels are written, and which of
+   them get the foreground color. Groups that are written completely use
+   vector stores; groups that are written partly are done pixel by pixel,
+   so pixels outside the template or mask are never touched, just like in
+   the plain routines. Nothing is read from the destination except for
+   COMPLEMENT, so the routines are safe on video memory too. */
+
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#define MEMBLIT_VECTOR
+
+typedef UBYTE memblit_v16ub __attribute__((vector_size(16)));
+typedef UWORD memblit_v8uw  __attribute__((vector_size(16)));
+typedef ULONG memblit_v4ul  __attribute__((vector_size(16)));
+
+/* For loads and stores at any address */
+typedef UBYTE memblit_v16ub_u __attribute__((vector_size(16), aligned(1), may_alias));
+typedef UWORD memblit_v8uw_u  __attribute__((vector_size(16), aligned(1), may_alias));
+typedef ULONG memblit_v4ul_u  __attribute__((vector_size(16), aligned(1), may_alias));
+
+/* Pixels handled by one call of the expansion routines */
+#define MEMBLIT_CHUNK       256
+
+struct MemBlitBits
+{
+    UBYTE write[MEMBLIT_CHUNK / 8];     /* pixels to write, MSB first */
+    UBYTE fg[MEMBLIT_CHUNK / 8];        /* pixels that get the foreground color */
+};
+
+/* 48 bytes of a repeated pixel, which is a whole number of 16, 24 and 32
+   bit pixels */
+union MemBlitPattern
+{
+    memblit_v16ub v[3];
+    ULONG         l[12];
+    UWORD         w[24];
+    UBYTE         b[48];
+};
+
+static inline void memblit_makepattern(union MemBlitPattern *pat, UBYTE bpp, ULONG pixel)
+{
+    UBYTE i;
+
+    switch (bpp)
+    {
+    case 2:
+        for (i = 0; i < 24; i++)
+            pat->w[i] = pixel;
+        break;
+
+    case 3:
+        for (i = 0; i < 48; i += 3)
+        {
+#if AROS_BIG_ENDIAN
+            pat->b[i]     = (pixel >> 16) & 0xFF;
+            pat->b[i + 1] = (pixel >> 8) & 0xFF;
+            pat->b[i + 2] =  pixel & 0xFF;
+#else
+            pat->b[i]     =  pixel & 0xFF;
+            pat->b[i + 1] = (pixel >> 8) & 0xFF;
+            pat->b[i + 2] = (pixel >> 16) & 0xFF;
+#endif
+        }
+        break;
+
+    default:
+        for (i = 0; i < 12; i++)
+            pat->l[i] = pixel;
+        break;
+    }
+}
+
+/****************************************************************************************/
+
+/* Fills bytes with a pattern made by memblit_makepattern() */
+static inline void memblit_fillrow(UBYTE *buf, ULONG bytes, const union MemBlitPattern *pat)
+{
+    ULONG i;
+
+    for (; bytes >= 48; bytes -= 48, buf += 48)
+    {
+        ((memblit_v16ub_u *)buf)[0] = pat->v[0];
+        ((memblit_v16ub_u *)buf)[1] = pat->v[1];
+        ((memblit_v16ub_u *)buf)[2] = pat->v[2];
+    }
+
+    for (i = 0; bytes >= 16; i++, bytes -= 16, buf += 16)
+        *(memblit_v16ub_u *)buf = pat->v[i];
+
+    for (i *= 16; bytes > 0; bytes--)
+        *buf++ = pat->b[i++];
+}
+
+/* Copies a row that may overlap with its destination. When descending,
+   src and dst point behind the row */
+static inline void memblit_copyrow(UBYTE *dst, UBYTE *src, ULONG bytes, BOOL descending)
+{
+    memblit_v16ub a, b, c, d;
+
+    if (!descending)
+    {
+        /* Everything is loaded before it is stored, so a destination in
+           front of the source is fine */
+        for (; bytes >= 64; bytes -= 64, src += 64, dst += 64)
+        {
+            a = ((memblit_v16ub_u *)src)[0];
+            b = ((memblit_v16ub_u *)src)[1];
+            c = ((memblit_v16ub_u *)src)[2];
+            d = ((memblit_v16ub_u *)src)[3];
+            ((memblit_v16ub_u *)dst)[0] = a;
+            ((memblit_v16ub_u *)dst)[1] = b;
+            ((memblit_v16ub_u *)dst)[2] = c;
+            ((memblit_v16ub_u *)dst)[3] = d;
+        }
+        for (; bytes >= 16; bytes -= 16, src += 16, dst += 16)
+            *(memblit_v16ub_u *)dst = *(memblit_v16ub_u *)src;
+        while (bytes--)
+            *dst++ = *src++;
+    }
+    else
+    {
+        for (; bytes >= 64; bytes -= 64)
+        {
+            src -= 64; dst -= 64;
+            a = ((memblit_v16ub_u *)src)[0];
+            b = ((memblit_v16ub_u *)src)[1];
+            c = ((memblit_v16ub_u *)src)[2];
+            d = ((memblit_v16ub_u *)src)[3];
+            ((memblit_v16ub_u *)dst)[3] = d;
+            ((memblit_v16ub_u *)dst)[2] = c;
+            ((memblit_v16ub_u *)dst)[1] = b;
+            ((memblit_v16ub_u *)dst)[0] = a;
+        }
+        for (; bytes >= 16; bytes -= 16)
+        {
+            src -= 16; dst -= 16;
+            *(memblit_v16ub_u *)dst = *(memblit_v16ub_u *)src;
+        }
+        while (bytes--)
+            *--dst = *--src;
+    }
+}
+
+/****************************************************************************************/
+
+/* Returns n (1 to 8) bits of a big endian bit array, starting at bit pos, in
+   the upper bits of the result. Bytes beyond those bits are not read. */
+static inline UBYTE memblit_getbits(const UBYTE *array, ULONG pos, UBYTE n)
+{
+    const UBYTE *p = array + (pos >> 3);
+    UBYTE shift = pos & 7;
+    UWORD bits = p[0] << 8;
+
+    if (shift + n > 8)
+        bits |= p[1];
+
+    return ((bits << shift) >> 8) & (0xFF00 >> n);
+}
+
+/* Collects the bits for up to MEMBLIT_CHUNK pixels of a row. If tmpl is
+   NULL, the pixels come from the 16 pixel wide patword instead. mask is
+   optional. type is as in the plain routines (0 to 5) */
+static inline void memblit_getrowbits(struct MemBlitBits *bits, LONG width, WORD type,
+    const UBYTE *tmpl, ULONG tmplpos, UWORD patword, ULONG patpos,
+    const UBYTE *mask, ULONG maskpos)
+{
+    LONG i;
+
+    for (i = 0; width > 0; i++, width -= 8)
+    {
+        UBYTE n = (width < 8) ? width : 8;
+        UBYTE valid = 0xFF00 >> n;
+        UBYTE pix, wr;
+
+        if (tmpl)
+        {
+            pix = memblit_getbits(tmpl, tmplpos + i * 8, n);
+        }
+        else
+        {
+            UBYTE shift = (patpos + i * 8) & 0xF;
+
+            pix = ((((ULONG)patword << shift) | ((ULONG)patword >> (16 - shift))) >> 8) & valid;
+        }
+        wr = mask ? memblit_getbits(mask, maskpos + i * 8, n) : valid;
+
+        if (type & 1) pix = ~pix & valid;
+
+        if (type < 4)
+        {
+            /* JAM1 and COMPLEMENT write the set pixels only */
+            bits->write[i] = pix & wr;
+            bits->fg[i] = 0xFF;
+        }
+        else
+        {
+            bits->write[i] = wr;
+            bits->fg[i] = pix;
+        }
+    }
+}
+
+/****************************************************************************************/
+
+/* Writes the pixels of a group that is not written completely */
+static inline void memblit_putgroup(UBYTE *buf, UBYTE bpp, UBYTE write, UBYTE fgbits, BOOL invert,
+    const union MemBlitPattern *fg, const union MemBlitPattern *bg)
+{
+    UBYTE i;
+
+    for (i = 0; write; i++, write <<= 1, fgbits <<= 1, buf += bpp)
+    {
+        if (!(write & 0x80))
+            continue;
+
+        switch (bpp)
+        {
+        case 2:
+            *(UWORD *)buf = invert ? ~*(UWORD *)buf : (fgbits & 0x80) ? fg->w[0] : bg->w[0];
+            break;
+
+        case 3:
+            if (invert)
+            {
+                buf[0] = ~buf[0];
+                buf[1] = ~buf[1];
+                buf[2] = ~buf[2];
+            }
+            else
+            {
+                const UBYTE *pix = (fgbits & 0x80) ? fg->b : bg->b;
+
+                buf[0] = pix[0];
+                buf[1] = pix[1];
+                buf[2] = pix[2];
+            }
+            break;
+
+        default:
+            *(ULONG *)buf = invert ? ~*(ULONG *)buf : (fgbits & 0x80) ? fg->l[0] : bg->l[0];
+            break;
+        }
+    }
+}
+
+static inline void memblit_expand16(UBYTE *buf, const struct MemBlitBits *bits, LONG width, BOOL invert,
+    const union MemBlitPattern *fg, const union MemBlitPattern *bg)
+{
+    const memblit_v8uw select = { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 };
+    memblit_v8uw fgv = (memblit_v8uw)fg->v[0], bgv = (memblit_v8uw)bg->v[0];
+    LONG i;
+
+    for (i = 0; i < (width + 7) / 8; i++, buf += 16)
+    {
+        UBYTE write = bits->write[i];
+
+        if (write == 0xFF)
+        {
+            memblit_v8uw_u *v = (memblit_v8uw_u *)buf;
+
+            if (invert)
+            {
+                *v = ~*v;
+            }
+            else
+            {
+                memblit_v8uw s = { 0 }, m;
+
+                s += bits->fg[i];
+                m = (memblit_v8uw)((s & select) != 0);
+                *v = (fgv & m) | (bgv & ~m);
+            }
+        }
+        else if (write)
+        {
+            memblit_putgroup(buf, 2, write, bits->fg[i], invert, fg, bg);
+        }
+    }
+}
+
+static inline void memblit_expand24(UBYTE *buf, const struct MemBlitBits *bits, LONG width, BOOL invert,
+    const union MemBlitPattern *fg, const union MemBlitPattern *bg)
+{
+    /* The bit of the pixel each byte of 16 pixels belongs to. The first
+       8 pixels take their bits from the first group, the others from the
+       second one */
+    static const memblit_v16ub select[3] =
+    {
+        { 0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x20, 0x20, 0x20, 0x10, 0x10, 0x10, 0x08, 0x08, 0x08, 0x04 },
+        { 0x04, 0x04, 0x02, 0x02, 0x02, 0x01, 0x01, 0x01, 0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x20, 0x20 },
+        { 0x20, 0x10, 0x10, 0x10, 0x08, 0x08, 0x08, 0x04, 0x04, 0x04, 0x02, 0x02, 0x02, 0x01, 0x01, 0x01 }
+    };
+    static const memblit_v16ub first = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0, 0, 0, 0, 0 };
+    LONG i, groups = (width + 7) / 8;
+
+    for (i = 0; i < groups; i++, buf += 24)
+    {
+        UBYTE write = bits->write[i];
+
+        if (write == 0xFF && i + 1 < groups && bits->write[i + 1] == 0xFF)
+        {
+            memblit_v16ub_u *v = (memblit_v16ub_u *)buf;
+
+            if (invert)
+            {
+                v[0] = ~v[0];
+                v[1] = ~v[1];
+                v[2] = ~v[2];
+            }
+            else
+            {
+                memblit_v16ub s0 = { 0 }, s2 = { 0 }, s1, m;
+
+                s0 += bits->fg[i];
+                s2 += bits->fg[i + 1];
+                s1 = (s0 & first) | (s2 & ~first);
+
+                m = (memblit_v16ub)((s0 & select[0]) != 0);
+                v[0] = (fg->v[0] & m) | (bg->v[0] & ~m);
+                m = (memblit_v16ub)((s1 & select[1]) != 0);
+                v[1] = (fg->v[1] & m) | (bg->v[1] & ~m);
+                m = (memblit_v16ub)((s2 & select[2]) != 0);
+                v[2] = (fg->v[2] & m) | (bg->v[2] & ~m);
+            }
+
+            i++;
+            buf += 24;
+        }
+        else if (write)
+        {
+            memblit_putgroup(buf, 3, write, bits->fg[i], invert, fg, bg);
+        }
+    }
+}
+
+static inline void memblit_expand32(UBYTE *buf, const struct MemBlitBits *bits, LONG width, BOOL invert,
+    const union MemBlitPattern *fg, const union MemBlitPattern *bg)
+{
+    const memblit_v4ul select0 = { 0x80, 0x40, 0x20, 0x10 };
+    const memblit_v4ul select1 = { 0x08, 0x04, 0x02, 0x01 };
+    memblit_v4ul fgv = (memblit_v4ul)fg->v[0], bgv = (memblit_v4ul)bg->v[0];
+    LONG i;
+
+    for (i = 0; i < (width + 7) / 8; i++, buf += 32)
+    {
+        UBYTE write = bits->write[i];
+
+        if (write == 0xFF)
+        {
+            memblit_v4ul_u *v = (memblit_v4ul_u *)buf;
+
+            if (invert)
+            {
+                v[0] = ~v[0];
+                v[1] = ~v[1];
+            }
+            else
+            {
+                memblit_v4ul s = { 0 }, m;
+
+                s += bits->fg[i];
+                m = (memblit_v4ul)((s & select0) != 0);
+                v[0] = (fgv & m) | (bgv & ~m);
+                m = (memblit_v4ul)((s & select1) != 0);
+                v[1] = (fgv & m) | (bgv & ~m);
+            }
+        }
+        else if (write)
+        {
+            memblit_putgroup(buf, 4, write, bits->fg[i], invert, fg, bg);
+        }
+    }
+}
+
+/****************************************************************************************/
+
+/* Draws one row of a template (tmpl != NULL) or a single plane pattern,
+   see memblit_getrowbits(). type must be 0 to 5 */
+static inline void memblit_expandrow(UBYTE *buf, UBYTE bpp, LONG width, WORD type,
+    const UBYTE *tmpl, ULONG tmplpos, UWORD patword, ULONG patpos,
+    const UBYTE *mask, ULONG maskpos, const union MemBlitPattern *fg, const union MemBlitPattern *bg)
+{
+    struct MemBlitBits bits;
+    BOOL invert = (type == 2 || type == 3);
+    LONG x, n;
+
+    for (x = 0; x < width; x += MEMBLIT_CHUNK)
+    {
+        n = width - x;
+        if (n > MEMBLIT_CHUNK) n = MEMBLIT_CHUNK;
+
+        memblit_getrowbits(&bits, n, type, tmpl, tmplpos + x, patword, patpos + x, mask, maskpos + x);
+
+        switch (bpp)
+        {
+        case 2:
+            memblit_expand16(buf + x * 2, &bits, n, invert, fg, bg);
+            break;
+        case 3:
+            memblit_expand24(buf + x * 3, &bits, n, invert, fg, bg);
+            break;
+        default:
+            memblit_expand32(buf + x * 4, &bits, n, invert, fg, bg);
+            break;
+        }
+    }
+}
+
+#endif
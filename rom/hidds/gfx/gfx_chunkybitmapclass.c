@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Gfx chunky bitmap class implementation.
 */
@@ -423,127 +423,20 @@ VOID CBM__Hidd_BitMap__PutImage(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMa
 
 /**************************************************************************/
 
-int static inline
-__attribute__((always_inline, const)) do_alpha(int a, int v)
-{
-    int tmp = a * v;
-    return (tmp + (tmp >> 8) + 0x80) >> 8;
-}
-
 VOID CBM__Hidd_BitMap__PutAlphaImage(OOP_Class *cl, OOP_Object *o,
     struct pHidd_BitMap_PutAlphaImage *msg)
 {
     struct chunkybm_data *data = OOP_INST_DATA(cl, o);
-    HIDDT_StdPixFmt pixFmt = BM_PIXFMT(o)->stdpixfmt;
-    WORD x, y, src_step, dst_step;
-    UBYTE *p, *q;
-    UBYTE src_red, src_green, src_blue, src_alpha;
-    UBYTE dst_red, dst_green, dst_blue;
 
-    switch(pixFmt)
-    {
-        case vHidd_StdPixFmt_BGR032:
+    if (msg->width <= 0 || msg->height <= 0)
+        return;
 
-            p = msg->pixels;
-            q = data->buffer + msg->y * data->bytesperrow
-                + msg->x * data->bytesperpixel;
-            src_step = msg->modulo - msg->width * 4;
-            dst_step = data->bytesperrow - data->bytesperpixel * msg->width;
-
-            for(y = 0; y < msg->height; y++)
-            {
-                for(x = 0; x < msg->width; x++)
-                {
-                    src_alpha = *p++;
-                    src_red   = *p++;
-                    src_green = *p++;
-                    src_blue  = *p++;
-
-                    switch(src_alpha)
-                    {
-                    case 0:
-                        q += 4;
-                        break;
-
-                    case 0xff:
-                        *q++ = src_blue;
-                        *q++ = src_green;
-                        *q++ = src_red;
-                        *q++ = 0;
-                        break;
-
-                    default:
-                        dst_blue = *q;
-                        dst_blue += do_alpha(src_alpha, src_blue - dst_blue);
-                        *q++ = dst_blue;
-
-                        dst_green = *q;
-                        dst_green += do_alpha(src_alpha, src_green - dst_green);
-                        *q++ = dst_green;
-
-                        dst_red = *q;
-                        dst_red  += do_alpha(src_alpha, src_red - dst_red);
-                        *q++ = dst_red;
-
-                        *q++ = 0;
-                    }
-                }
-                p += src_step;
-                q += dst_step;
-            }
-            break;
-
-        case vHidd_StdPixFmt_RGB16_LE:
-
-            p = msg->pixels;
-            q = data->buffer + msg->y * data->bytesperrow
-                + msg->x * data->bytesperpixel;
-            src_step = msg->modulo - msg->width * 4;
-            dst_step = data->bytesperrow - data->bytesperpixel * msg->width;
-
-            for(y = 0; y < msg->height; y++)
-            {
-                for(x = 0; x < msg->width; x++)
-                {
-                    src_alpha = *p++;
-                    src_red   = *p++;
-                    src_green = *p++;
-                    src_blue  = *p++;
-
-                    switch(src_alpha)
-                    {
-                    case 0:
-                        q += 2;
-                        break;
-
-                    case 0xff:
-                        *q++ = (src_green << 3) & 0xe0 | src_blue >> 3;
-                        *q++ = src_red & 0xf8 | src_green >> 5;
-                        break;
-
-                    default:
-                        dst_blue = *q;
-                        dst_red = *(q + 1);
-                        dst_green = dst_red << 5 | dst_blue >> 3 & 0x1c;
-                        dst_blue <<= 3;
-                        dst_red &= 0xf8;
-
-                        dst_blue += do_alpha(src_alpha, src_blue - dst_blue);
-                        dst_green += do_alpha(src_alpha, src_green - dst_green);
-                        dst_red  += do_alpha(src_alpha, src_red - dst_red);
-
-                        *q++ = (dst_green << 3) & 0xe0 | dst_blue >> 3;
-                        *q++ = dst_red & 0xf8 | dst_green >> 5;
-                    }
-                }
-                p += src_step;
-                q += dst_step;
-            }
-            break;
-
-        default:
-            OOP_DoSuperMethod(cl, o, (OOP_Msg)msg);
-            break;
+    /* Formats that AlphaBlendImage() doesn't handle are left to the base class */
+    if (!AlphaBlendImage(data->buffer + msg->y * data->bytesperrow + msg->x * data->bytesperpixel,
+                         data->bytesperrow, BM_PIXFMT(o)->stdpixfmt,
+                         msg->pixels, msg->modulo, msg->width, msg->height))
+    {
+        OOP_DoSuperMethod(cl, o, (OOP_Msg)msg);
     }
 }
 
@@ -827,6 +720,43 @@ VOID CBM__Hidd_BitMap__PutTemplate(OOP_Class *cl, OOP_Object *o, struct pHidd_Bi
 
 /****************************************************************************************/
 
+VOID CBM__Hidd_BitMap__PutAlphaTemplate(OOP_Class *cl, OOP_Object *o,
+    struct pHidd_BitMap_PutAlphaTemplate *msg)
+{
+    struct chunkybm_data *data = OOP_INST_DATA(cl, o);
+    OOP_Object *gc = msg->gc;
+    HIDDT_Color fg, bg;
+    BOOL jam2 = FALSE;
+
+    if (msg->width <= 0 || msg->height <= 0)
+        return;
+
+    /* Inverting, and formats that AlphaBlendTemplate() doesn't handle, are
+       left to the base class */
+    if (GC_COLEXP(gc) != vHidd_GC_ColExp_Transparent)
+    {
+        if (GC_DRMD(gc) == vHidd_GC_DrawMode_Invert)
+        {
+            OOP_DoSuperMethod(cl, o, (OOP_Msg)msg);
+            return;
+        }
+
+        UNMAPPIXEL(cl, o, GC_BG(gc), &bg);
+        jam2 = TRUE;
+    }
+    UNMAPPIXEL(cl, o, GC_FG(gc), &fg);
+
+    if (!AlphaBlendTemplate(data->buffer + msg->y * data->bytesperrow + msg->x * data->bytesperpixel,
+                            data->bytesperrow, BM_PIXFMT(o)->stdpixfmt,
+                            msg->alpha, msg->modulo, msg->width, msg->height,
+                            &fg, jam2 ? &bg : NULL, msg->invertalpha))
+    {
+        OOP_DoSuperMethod(cl, o, (OOP_Msg)msg);
+    }
+}
+
+/****************************************************************************************/
+
 VOID CBM__Hidd_BitMap__PutPattern(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutPattern *msg)
 {
     struct chunkybm_data *data = OOP_INST_DATA(cl, o);
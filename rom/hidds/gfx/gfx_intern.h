@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #ifndef GFX_HIDD_INTERN_H
@@ -382,6 +382,13 @@ struct IntHIDDGraphicsBase
 
 BOOL parse_pixfmt_tags(struct TagItem *tags, HIDDT_PixelFormat *pf, ULONG attrcheck, struct class_static_data *csd);
 
+/* Alpha blending of pixel spans, in gfx_alphablend.c */
+BOOL AlphaBlendImage(UBYTE *dst, ULONG dstMod, HIDDT_StdPixFmt dstPixFmt,
+                     UBYTE *src, ULONG srcMod, UWORD width, UWORD height);
+BOOL AlphaBlendTemplate(UBYTE *dst, ULONG dstMod, HIDDT_StdPixFmt dstPixFmt,
+                        UBYTE *alpha, ULONG alphaMod, UWORD width, UWORD height,
+                        HIDDT_Color *fg, HIDDT_Color *bg, BOOL invertalpha);
+
 static inline ULONG color_distance(UWORD a1, UWORD r1, UWORD g1, UWORD b1, UWORD a2, UWORD r2, UWORD g2, UWORD b2)
 {
     /* NOTE: The use of 'WORD' here and the 'UWORD' casts below are
@@ -0,0 +1,172 @@
+#ifndef KERNEL_RUNQUEUE_H
+#define KERNEL_RUNQUEUE_H
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: O(1) priority run queue for ready tasks.
+*/
+
+#include <exec/lists.h>
+#include <exec/nodes.h>
+#include <exec/tasks.h>
+
+/*
+ * Every task priority (-128 .. 127) has its own FIFO list, and a bitmap
+ * records which of the lists hold tasks, so adding a task and finding the
+ * best ready task take constant time - unlike Enqueue(), which has to walk
+ * the priority ordered list.
+ *
+ * Code that doesn't know about the run queue may still Remove() a task from
+ * its level list (e.g. RemTask()). The bitmap is therefore only a hint that
+ * a level *may* hold tasks, and stale bits are dropped when they are found.
+ */
+#define KRNRQ_LEVELS            256
+#define KRNRQ_WORDS             (KRNRQ_LEVELS >> 5)
+#define KRNRQ_NOLEVEL           (-1)
+#define KRNRQ_NOTASKPRI         (-129)
+
+#define KRNRQ_LEVEL(pri)        ((LONG)(BYTE)(pri) + 128)
+#define KRNRQ_PRI(level)        ((level) - 128)
+
+struct KrnRunQueue
+{
+    ULONG               rq_Summary;                     /* Bit set for each non-zero rq_Map word        */
+    ULONG               rq_Map[KRNRQ_WORDS];            /* Bit set for each level that may hold tasks   */
+    struct MinList      rq_Level[KRNRQ_LEVELS];         /* FIFO of ready tasks for each priority        */
+};
+
+static inline __attribute__((always_inline)) LONG krnRunQueueMSB(ULONG bits)
+{
+    return 31 - __builtin_clz(bits);
+}
+
+static inline __attribute__((always_inline)) struct List *krnRunQueueList(struct KrnRunQueue *rq, LONG level)
+{
+    return (struct List *)&rq->rq_Level[level];
+}
+
+static inline __attribute__((always_inline)) void krnRunQueueClrLevel(struct KrnRunQueue *rq, LONG level)
+{
+    LONG word = level >> 5;
+
+    rq->rq_Map[word] &= ~(1UL << (level & 31));
+    if (!rq->rq_Map[word])
+        rq->rq_Summary &= ~(1UL << word);
+}
+
+static inline void krnRunQueueInit(struct KrnRunQueue *rq)
+{
+    LONG level;
+
+    rq->rq_Summary = 0;
+    for (level = 0; level < KRNRQ_WORDS; level++)
+        rq->rq_Map[level] = 0;
+    for (level = 0; level < KRNRQ_LEVELS; level++)
+        NEWLIST(krnRunQueueList(rq, level));
+}
+
+/* Add a task behind any others of the same priority */
+static inline void krnRunQueueAdd(struct KrnRunQueue *rq, struct Task *task)
+{
+    LONG level = KRNRQ_LEVEL(task->tc_Node.ln_Pri);
+
+    ADDTAIL(krnRunQueueList(rq, level), &task->tc_Node);
+    rq->rq_Map[level >> 5] |= (1UL << (level & 31));
+    rq->rq_Summary |= (1UL << (level >> 5));
+}
+
+/* Remove a task, and forget its level if it is now empty */
+static inline void krnRunQueueRemove(struct KrnRunQueue *rq, struct Task *task)
+{
+    LONG level = KRNRQ_LEVEL(task->tc_Node.ln_Pri);
+
+    REMOVE(&task->tc_Node);
+    /*
+     * The priority may have been changed while queued, in which case
+     * the tasks real level keeps its bit until it is found to be stale.
+     */
+    if (IsListEmpty(krnRunQueueList(rq, level)))
+        krnRunQueueClrLevel(rq, level);
+}
+
+/* Return the highest level below 'below' that holds tasks, or KRNRQ_NOLEVEL */
+static inline LONG krnRunQueueNextLevel(struct KrnRunQueue *rq, LONG below)
+{
+    LONG level = below - 1;
+    LONG word;
+    ULONG bits;
+
+    while (level >= 0)
+    {
+        word = level >> 5;
+        bits = rq->rq_Map[word] & (0xFFFFFFFFUL >> (31 - (level & 31)));
+        if (bits)
+        {
+            level = (word << 5) + krnRunQueueMSB(bits);
+            if (!IsListEmpty(krnRunQueueList(rq, level)))
+                return level;
+
+            /* Emptied behind our back - drop the stale bit and keep looking */
+            krnRunQueueClrLevel(rq, level);
+            level--;
+        }
+        else
+        {
+            bits = rq->rq_Summary & ((1UL << word) - 1);
+            if (!bits)
+                break;
+            level = (krnRunQueueMSB(bits) << 5) + 31;
+        }
+    }
+
+    return KRNRQ_NOLEVEL;
+}
+
+static inline __attribute__((always_inline)) LONG krnRunQueueBestLevel(struct KrnRunQueue *rq)
+{
+    return krnRunQueueNextLevel(rq, KRNRQ_LEVELS);
+}
+
+/* Priority of the best queued task, or KRNRQ_NOTASKPRI if there are none */
+static inline LONG krnRunQueueBestPri(struct KrnRunQueue *rq)
+{
+    LONG level = krnRunQueueBestLevel(rq);
+
+    if (level == KRNRQ_NOLEVEL)
+        return KRNRQ_NOTASKPRI;
+    return KRNRQ_PRI(level);
+}
+
+/* Remove and return the best queued task */
+static inline struct Task *krnRunQueueRemHead(struct KrnRunQueue *rq)
+{
+    LONG level = krnRunQueueBestLevel(rq);
+    struct Task *task;
+
+    if (level == KRNRQ_NOLEVEL)
+        return NULL;
+
+    task = (struct Task *)REMHEAD(krnRunQueueList(rq, level));
+    if (IsListEmpty(krnRunQueueList(rq, level)))
+        krnRunQueueClrLevel(rq, level);
+
+    return task;
+}
+
+/*
+ * Compatibility adapter for code that iterates the ready tasks as lists.
+ * Calls func on each non-empty level, best priority first, until it
+ * returns a task.
+ */
+static inline struct Task *krnRunQueueWalk(struct KrnRunQueue *rq, struct Task *(*func)(struct List *, APTR), APTR data)
+{
+    struct Task *task = NULL;
+    LONG level = KRNRQ_LEVELS;
+
+    while ((!task) && ((level = krnRunQueueNextLevel(rq, level)) != KRNRQ_NOLEVEL))
+        task = func(krnRunQueueList(rq, level), data);
+
+    return task;
+}
+
+#endif /* !KERNEL_RUNQUEUE_H */
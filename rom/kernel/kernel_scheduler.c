@@ -9,14 +9,39 @@
 #include <proto/exec.h>
 
 #include <kernel_base.h>
-#include <kernel_debug.h>
-#include <kernel_scheduler.h>
 
 #define AROS_NO_ATOMIC_OPERATIONS
 #include "exec_platform.h"
 
+#define __AROS_KERNEL__
+#include "exec_intern.h"
+
+#include <kernel_debug.h>
+#include <kernel_scheduler.h>
+
 #define D(x)
 
+#if defined(EXEC_RUNQUEUE)
+/*
+ * Ready tasks are taken from exec's run queue, but somebody may still have
+ * Enqueue()'d a task onto SysBase->TaskReady directly, so look at both.
+ * Returns the task list head to use, or NULL for the run queue.
+ */
+static struct Task *core_ReadyListHead(LONG *bestpri)
+{
+    struct Task *head = (struct Task *)GetHead(&SysBase->TaskReady);
+    LONG pri = krnRunQueueBestPri(&PrivExecBase(SysBase)->TaskReadyQueue);
+
+    if (head && (head->tc_Node.ln_Pri >= pri))
+    {
+        *bestpri = head->tc_Node.ln_Pri;
+        return head;
+    }
+    *bestpri = pri;
+    return NULL;
+}
+#endif
+
 /*
  * Schedule the currently running task away. Put it into the TaskReady list
  * in some smart way. This function is subject of change and it will be probably replaced
@@ -36,15 +61,25 @@ BOOL core_Schedule(void)
     /* If task has pending exception, reschedule it so that the dispatcher may handle the exception */
     if (!(task->tc_Flags & TF_EXCEPT))
     {
+#if defined(EXEC_RUNQUEUE)
+        LONG pri;
+
+        /* Are there no other ready tasks? If yes, then the running task is the only one. Let it work */
+        core_ReadyListHead(&pri);
+        if (pri == KRNRQ_NOTASKPRI)
+            return FALSE;
+#else
         BYTE pri;
 
         /* Is the TaskReady empty? If yes, then the running task is the only one. Let it work */
         if (IsListEmpty(&SysBase->TaskReady))
             return FALSE;
 
-        /* Does the TaskReady list contain tasks with priority equal to or lower than current task?
-         * If so, then check further... */
         pri = ((struct Task*)GetHead(&SysBase->TaskReady))->tc_Node.ln_Pri;
+#endif
+
+        /* Are the ready tasks of priority equal to or lower than current task?
+         * If so, then check further... */
         if (pri <= task->tc_Node.ln_Pri)
         {
             /* If the running task did not used it's whole quantum yet, let it work */
@@ -96,12 +131,13 @@ void core_Switch(void)
     {
         if (task->tc_Flags & TF_SWITCH)
             AROS_UFC1NR(void, task->tc_Switch, AROS_UFCA(struct ExecBase *, SysBase, A6));
-        Enqueue(&SysBase->TaskReady, &task->tc_Node);
+        EXEC_READYTASK(task);
     }
     else if (task->tc_State != TS_REMOVED)
     {
         D(bug("[KRN] Setting '%s' @ 0x%p to wait\n", task->tc_Node.ln_Name, task));
-        Enqueue(&SysBase->TaskWait, &task->tc_Node);
+        /* TaskWait isn't kept in priority order, so don't pay for Enqueue() */
+        AddTail(&SysBase->TaskWait, &task->tc_Node);
     }
     if (showAlert)
         Alert(showAlert);
@@ -114,10 +150,20 @@ void core_Switch(void)
 struct Task *core_Dispatch(void)
 {
     struct Task *task;
+#if defined(EXEC_RUNQUEUE)
+    LONG pri;
+#endif
 
     D(bug("[KRN] core_Dispatch()\n"));
 
+#if defined(EXEC_RUNQUEUE)
+    if ((task = core_ReadyListHead(&pri)) != NULL)
+        REMOVE(&task->tc_Node);
+    else
+        task = krnRunQueueRemHead(&PrivExecBase(SysBase)->TaskReadyQueue);
+#else
     task = (struct Task *)REMHEAD(&SysBase->TaskReady);
+#endif
     if (!task)
     {
         /* Is the list of ready tasks empty? Well, go idle. */
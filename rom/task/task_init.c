@@ -19,6 +19,32 @@
 extern APTR AROS_SLIB_ENTRY(NewAddTask, Task, 176)();
 extern void AROS_SLIB_ENTRY(RemTask, Task, 48)();
 
+#if defined(TASKRES_ENABLE) && defined(EXEC_WALKREADYQUEUES)
+/* Add the tasks queued on one of the schedulers per-cpu ready queues */
+static struct Task *taskres_AddReadyQueue(struct List *readyList, APTR data)
+{
+    struct TaskResBase *TaskResBase = (struct TaskResBase *)data;
+    struct TaskListEntry *taskEntry;
+    struct Task *curTask;
+
+    ForeachNode(readyList, curTask)
+    {
+        if ((taskEntry = AllocMem(sizeof(struct TaskListEntry), MEMF_CLEAR)) != NULL)
+        {
+            D(bug("[TaskRes] 0x%p [-R-] -- %s\n", curTask, curTask->tc_Node.ln_Name));
+            NEWLIST(&taskEntry->tle_HookTypes);
+            taskEntry->tle_Task = curTask;
+            AddTail(&TaskResBase->trb_TaskList, &taskEntry->tle_Node);
+        }
+        else
+        {
+            bug("[TaskRes] Failed to allocate storage for task @  0x%p!!\n", curTask);
+        }
+    }
+    return NULL;
+}
+#endif
+
 static LONG taskres_Init(struct TaskResBase *TaskResBase)
 {
 #ifdef TASKRES_ENABLE
@@ -174,6 +200,9 @@ static LONG taskres_Init(struct TaskResBase *TaskResBase)
             bug("[TaskRes] Invalid Task State %08x for task @ 0x%p\n", curTask->tc_State, curTask);
         }
     }
+#if defined(EXEC_WALKREADYQUEUES)
+    EXEC_WALKREADYQUEUES(taskres_AddReadyQueue, TaskResBase);
+#endif
 #if defined(__AROSEXEC_SMP__)
     ReleaseSystemLock(&SysBase->TaskReady, LOCKF_DISABLE);
 
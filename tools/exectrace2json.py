@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+
+# script for converting C:ExecTrace dumps to the JSON trace event format,
+# which Chrome's about://tracing and Perfetto (ui.perfetto.dev) can show
+#
+# usage: exectrace2json.py <dump> [<output.json>]
+
+import json, struct, sys
+
+ETT_NAMES = {
+    1: "Dispatch",
+    2: "Wait",
+    3: "Signal",
+    4: "AllocMem",
+    5: "FreeMem",
+    6: "PutMsg",
+    7: "GetMsg",
+}
+ETT_DISPATCH = 1
+ETT_SIGNAL = 3
+
+# what the two arguments of each record type are
+ETT_ARGS = {
+    1: ("task", "previous"),
+    2: ("signalSet", "received"),
+    3: ("target", "signalSet"),
+    4: ("size", "memory"),
+    5: ("memory", "size"),
+    6: ("port", "message"),
+    7: ("port", "message"),
+}
+ETT_CATEGORIES = {
+    1: "sched", 2: "sched", 3: "sched",
+    4: "memory", 5: "memory",
+    6: "message", 7: "message",
+}
+
+def loaddump(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[0:4] == b"ETRC":
+        endian = ">"
+    elif data[0:4] == b"CRTE":
+        endian = "<"
+    else:
+        sys.exit("%s is not an ExecTrace dump" % path)
+
+    header = endian + "4sHHIIQII"
+    (magic, version, ptrsize, recsize, cpucount, tickrate, reccount, namecount) = \
+        struct.unpack_from(header, data, 0)
+    if version != 1:
+        sys.exit("unsupported dump version %d" % version)
+
+    ptr = "I" if ptrsize == 4 else "Q"
+    record = endian + "QIHH" + ptr * 3
+    offset = struct.calcsize(header)
+
+    records = []
+    for i in range(reccount):
+        (time, seq, type, cpu, task, arg0, arg1) = struct.unpack_from(record, data, offset)
+        records.append((time, cpu, seq, type, task, arg0, arg1))
+        offset += recsize
+
+    names = {}
+    for i in range(namecount):
+        (task, length) = struct.unpack_from(endian + ptr + "H", data, offset)
+        offset += ptrsize + 2
+        names[task] = data[offset:offset + length].decode("latin-1")
+        offset += length
+
+    return cpucount, tickrate, records, names
+
+def taskname(names, task):
+    if task == 0:
+        return "<idle>"
+    return names.get(task, "Task 0x%x" % task)
+
+def convert(cpucount, tickrate, records, names):
+    if tickrate == 0:
+        sys.stderr.write("warning: unknown timestamp rate, times are in timestamp ticks\n")
+        tickrate = 1000000
+
+    # Gaps in the sequence numbers of a CPU are events that were overwritten
+    # before they were dumped
+    lost = 0
+    lastseq = {}
+    for (time, cpu, seq, type, task, arg0, arg1) in sorted(records, key=lambda r: (r[1], r[2])):
+        if cpu in lastseq:
+            lost += (seq - lastseq[cpu] - 1) & 0xffffffff
+        lastseq[cpu] = seq
+
+    records.sort()
+    start = records[0][0] if records else 0
+
+    def us(time):
+        return (time - start) * 1000000.0 / tickrate
+
+    events = [{"name": "process_name", "ph": "M", "pid": 0, "args": {"name": "AROS"}}]
+    for cpu in range(cpucount):
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": cpu,
+                       "args": {"name": "CPU %d" % cpu}})
+
+    # Each dispatch starts a slice of the task on its CPU, that lasts until
+    # the next dispatch there - or the last event seen on that CPU
+    running = {}
+    lasttime = {}
+    for (time, cpu, seq, type, task, arg0, arg1) in records:
+        lasttime[cpu] = time
+
+        if type == ETT_DISPATCH:
+            if cpu in running:
+                (since, runtask) = running[cpu]
+                events.append({"name": taskname(names, runtask), "cat": "sched", "ph": "X",
+                               "pid": 0, "tid": cpu, "ts": us(since), "dur": us(time) - us(since),
+                               "args": {"task": "0x%x" % runtask}})
+            running[cpu] = (time, arg0)
+            continue
+
+        argnames = ETT_ARGS.get(type, ("arg0", "arg1"))
+        args = {"task": taskname(names, task),
+                argnames[0]: "0x%x" % arg0,
+                argnames[1]: "0x%x" % arg1}
+        if type == ETT_SIGNAL:
+            args["target"] = taskname(names, arg0)
+        events.append({"name": ETT_NAMES.get(type, "Type %d" % type),
+                       "cat": ETT_CATEGORIES.get(type, "other"), "ph": "i", "s": "t",
+                       "pid": 0, "tid": cpu, "ts": us(time), "args": args})
+
+    for cpu, (since, runtask) in running.items():
+        events.append({"name": taskname(names, runtask), "cat": "sched", "ph": "X",
+                       "pid": 0, "tid": cpu, "ts": us(since), "dur": us(lasttime[cpu]) - us(since),
+                       "args": {"task": "0x%x" % runtask}})
+
+    if lost:
+        sys.stderr.write("warning: %d events were lost\n" % lost)
+
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        sys.exit("usage: %s <dump> [<output.json>]" % sys.argv[0])
+
+    trace = convert(*loaddump(sys.argv[1]))
+
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
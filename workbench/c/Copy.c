@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2001-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 2001-2026, The AROS Development Team. All rights reserved.
 
     Desc: Copy CLI command
 */
@@ -295,6 +295,8 @@
 #define USE_ALWAYSVERBOSE               1
 #define USE_BOGUSEOFWORKAROUND          0
 
+#define COPY_BUFFERS                    4   /* CopyFH() reads ahead into 3 of them while writing */
+
 #include <aros/asmcall.h>
 #include <exec/devices.h>
 #include <exec/io.h>
@@ -2120,7 +2122,7 @@ void DoWork(STRPTR name, struct CopyData *cd)
 LONG CopyFile(BPTR from, BPTR to, ULONG bufsize, struct CopyData *cd)
 {
     STRPTR buffer;
-    LONG s, err = 0;
+    LONG err = 0;
 
     if (cd->CopyBuf)
     {
@@ -2153,6 +2155,7 @@ LONG CopyFile(BPTR from, BPTR to, ULONG bufsize, struct CopyData *cd)
         {
 #warning "****** WARNING: No largefile support! ******"
             ULONG filesize = fib->fib_Size, copied = 0;
+            LONG s;
 
             /*Printf("filesize: %lu\n", filesize);*/
 
@@ -2186,24 +2189,17 @@ LONG CopyFile(BPTR from, BPTR to, ULONG bufsize, struct CopyData *cd)
         else
 #endif /* USE_BOGUSEOFWORKAROUND */
         {
-            /* Stream or so, copy until EOF or error */
-            do
+            /* Stream or so, copy until EOF or error. The next parts of the
+             * file are read while the previous ones are written.
+             */
+            if (!CopyFH(from, to, buffer, bufsize, COPY_BUFFERS))
             {
-                ULONG brk = CTRL_C;
-                /* AROS: This flush appears to be required if reading from '*'
-                 * Maybe a bug in Read(), or AROS buffering?
-                 */
-                Flush(from);
-                if (brk || (s = Read(from, buffer, bufsize)) == -1 || Write(to, buffer, s) != s)
+                if (IoErr() == ERROR_BREAK)
                 {
-                    if (brk)
-                    {
-                        cd->IoErr = ERROR_BREAK;
-                    }
-                    err = RETURN_FAIL;
-                    break;
+                    cd->IoErr = ERROR_BREAK;
                 }
-            } while (s > 0);
+                err = RETURN_FAIL;
+            }
         }
 
         /* Freed at exit to avoid fragmentation */
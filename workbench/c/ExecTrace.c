@@ -0,0 +1,334 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Control exec's event tracing and dump the trace buffers.
+*/
+
+/******************************************************************************
+
+
+    NAME
+
+        ExecTrace
+
+    SYNOPSIS
+
+        SCHED/S,MEMORY/S,MESSAGE/S,ALL/S,OFF/S,SECONDS/N,TO/K
+
+    LOCATION
+
+        C:
+
+    FUNCTION
+
+        Switches the tracing of exec events on or off, and writes the
+        events recorded in exec's per-CPU trace buffers to a file.
+
+    INPUTS
+
+        SCHED    --  Trace task dispatches, Wait() and Signal().
+        MEMORY   --  Trace AllocMem() and FreeMem().
+        MESSAGE  --  Trace PutMsg() and GetMsg().
+        ALL      --  Trace all of the above.
+        OFF      --  Stop tracing.
+        SECONDS  --  Only trace the given categories for this many seconds,
+                     then restore the previous setting. Can be stopped
+                     early with Ctrl-C.
+        TO       --  File to write the trace buffers to.
+
+        Without any arguments the categories being traced are printed.
+
+    RESULT
+
+    NOTES
+
+        The trace buffers are rings that only hold the latest events of
+        each CPU. The file holds the events in binary form, together with
+        the names of the tasks that exist while it is written and the rate
+        of the timestamps. tools/exectrace2json.py converts it to
+        JSON that Chrome's about://tracing and Perfetto can show.
+
+        Only platforms with a usable KrnTimeStamp() support tracing.
+
+    EXAMPLE
+
+        ExecTrace SCHED MESSAGE SECONDS 5 TO RAM:trace.bin
+
+    BUGS
+
+    SEE ALSO
+
+    INTERNALS
+
+    HISTORY
+
+******************************************************************************/
+
+#include <aros/macros.h>
+#include <exec/memory.h>
+#include <exec/tasks.h>
+#include <devices/timer.h>
+#include <dos/dos.h>
+#include <resources/exectrace.h>
+#include <resources/task.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/exectrace.h>
+#include <proto/kernel.h>
+#include <proto/task.h>
+#include <proto/timer.h>
+
+#include <string.h>
+
+const TEXT version[] = "$VER: ExecTrace 1.0 (17.10.2026)\n";
+
+#define ARG_TEMPLATE "SCHED/S,MEMORY/S,MESSAGE/S,ALL/S,OFF/S,SECONDS/N,TO/K"
+#define ARG_SCHED       0
+#define ARG_MEMORY      1
+#define ARG_MESSAGE     2
+#define ARG_ALL         3
+#define ARG_OFF         4
+#define ARG_SECONDS     5
+#define ARG_TO          6
+#define NUM_ARGS        7
+
+#define EXECTRACE_MAGIC         AROS_MAKE_ID('E','T','R','C')
+#define EXECTRACE_VERSION       1
+#define EXECTRACE_MAXNAMES      1024
+#define EXECTRACE_NAMELEN       64
+
+/*
+ * Layout of the dump file, all in the byte order of the machine that wrote it:
+ * this header, etf_RecordCount struct ExecTraceRecords, then etf_NameCount
+ * task names - each one an IPTR task address, a UWORD length and the name.
+ */
+struct ExecTraceFile
+{
+    ULONG       etf_Magic;
+    UWORD       etf_Version;
+    UWORD       etf_PtrSize;            /* sizeof(IPTR)                         */
+    ULONG       etf_RecordSize;         /* sizeof(struct ExecTraceRecord)       */
+    ULONG       etf_CPUCount;
+    UQUAD       etf_TicksPerSecond;     /* KrnTimeStamp() rate, 0 if unknown    */
+    ULONG       etf_RecordCount;
+    ULONG       etf_NameCount;
+};
+
+struct TaskName
+{
+    IPTR        tn_Task;
+    char        tn_Name[EXECTRACE_NAMELEN];
+};
+
+struct Library *ExecTraceBase;
+APTR KernelBase;
+APTR TaskResBase;
+struct Device *TimerBase;
+
+static void PrintFlags(ULONG flags)
+{
+    if (!flags)
+        PutStr("Tracing is off\n");
+    else
+        Printf("Tracing:%s%s%s\n",
+            (flags & ETF_SCHED) ? " SCHED" : "",
+            (flags & ETF_MEMORY) ? " MEMORY" : "",
+            (flags & ETF_MESSAGE) ? " MESSAGE" : "");
+}
+
+/* Measures the KrnTimeStamp() rate against timer.device */
+static UQUAD TicksPerSecond(void)
+{
+    struct timerequest tr;
+    struct timeval start, end;
+    UQUAD startTicks, endTicks, usecs;
+
+    memset(&tr, 0, sizeof(tr));
+    if (OpenDevice(TIMERNAME, UNIT_MICROHZ, &tr.tr_node, 0))
+        return 0;
+    TimerBase = tr.tr_node.io_Device;
+
+    GetSysTime(&start);
+    startTicks = KrnTimeStamp();
+    Delay(10);
+    GetSysTime(&end);
+    endTicks = KrnTimeStamp();
+
+    CloseDevice(&tr.tr_node);
+
+    usecs = (UQUAD)(end.tv_secs - start.tv_secs) * 1000000 + end.tv_micro - start.tv_micro;
+    if (!usecs || (endTicks <= startTicks))
+        return 0;
+
+    return ((endTicks - startTicks) * 1000000) / usecs;
+}
+
+static ULONG GetTaskNames(struct TaskName *names)
+{
+    struct TaskList *taskList;
+    struct Task *task;
+    ULONG count = 0;
+
+    if (!TaskResBase)
+        return 0;
+
+    taskList = LockTaskList(LTF_ALL);
+    while ((task = NextTaskEntry(taskList, LTF_ALL)) != NULL)
+    {
+        if (count == EXECTRACE_MAXNAMES)
+            break;
+        if (!task->tc_Node.ln_Name)
+            continue;
+
+        names[count].tn_Task = (IPTR)task;
+        strncpy(names[count].tn_Name, task->tc_Node.ln_Name, EXECTRACE_NAMELEN - 1);
+        names[count].tn_Name[EXECTRACE_NAMELEN - 1] = '\0';
+        count++;
+    }
+    UnLockTaskList(taskList, LTF_ALL);
+
+    return count;
+}
+
+static LONG DumpTrace(CONST_STRPTR fileName)
+{
+    struct ExecTraceFile etf;
+    struct ExecTraceRecord *records;
+    struct TaskName *names;
+    ULONG cpuCount, perCPU, cpu, position, i;
+    LONG error = 0;
+    BPTR file;
+
+    cpuCount = GetTraceAttr(ETA_CPUCount);
+    perCPU = GetTraceAttr(ETA_Records);
+    if (!cpuCount)
+    {
+        PutStr("ExecTrace: Nothing has been traced yet\n");
+        return 0;
+    }
+
+    records = AllocVec(cpuCount * perCPU * sizeof(struct ExecTraceRecord), MEMF_ANY);
+    names = AllocVec(EXECTRACE_MAXNAMES * sizeof(struct TaskName), MEMF_ANY);
+    if (!records || !names)
+    {
+        FreeVec(names);
+        FreeVec(records);
+        return ERROR_NO_FREE_STORE;
+    }
+
+    etf.etf_Magic = EXECTRACE_MAGIC;
+    etf.etf_Version = EXECTRACE_VERSION;
+    etf.etf_PtrSize = sizeof(IPTR);
+    etf.etf_RecordSize = sizeof(struct ExecTraceRecord);
+    etf.etf_CPUCount = cpuCount;
+    etf.etf_RecordCount = 0;
+
+    for (cpu = 0; cpu < cpuCount; cpu++)
+    {
+        position = 0;
+        etf.etf_RecordCount += ReadTrace(cpu, &position, &records[etf.etf_RecordCount], perCPU);
+    }
+    etf.etf_NameCount = GetTaskNames(names);
+    etf.etf_TicksPerSecond = TicksPerSecond();
+
+    file = Open(fileName, MODE_NEWFILE);
+    if (file)
+    {
+        if ((Write(file, &etf, sizeof(etf)) != sizeof(etf)) ||
+            (Write(file, records, etf.etf_RecordCount * sizeof(struct ExecTraceRecord)) !=
+                etf.etf_RecordCount * sizeof(struct ExecTraceRecord)))
+            error = IoErr();
+
+        for (i = 0; (i < etf.etf_NameCount) && !error; i++)
+        {
+            UWORD len = strlen(names[i].tn_Name);
+
+            if ((Write(file, &names[i].tn_Task, sizeof(IPTR)) != sizeof(IPTR)) ||
+                (Write(file, &len, sizeof(len)) != sizeof(len)) ||
+                (Write(file, names[i].tn_Name, len) != len))
+                error = IoErr();
+        }
+        Close(file);
+    }
+    else
+        error = IoErr();
+
+    if (!error)
+        Printf("%lu events of %lu CPUs written to %s\n", etf.etf_RecordCount, cpuCount, fileName);
+
+    FreeVec(names);
+    FreeVec(records);
+
+    return error;
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    ULONG flags = 0, oldFlags, seconds = 0, i;
+    LONG error = 0;
+
+    rda = ReadArgs(ARG_TEMPLATE, args, NULL);
+    if (!rda)
+    {
+        PrintFault(IoErr(), "ExecTrace");
+        return RETURN_FAIL;
+    }
+
+    ExecTraceBase = OpenResource(EXECTRACENAME);
+    KernelBase = OpenResource("kernel.resource");
+    TaskResBase = OpenResource("task.resource");
+    if (!ExecTraceBase || !KernelBase)
+    {
+        PutStr("ExecTrace: Tracing is not supported on this system\n");
+        FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+
+    if (args[ARG_SCHED])
+        flags |= ETF_SCHED;
+    if (args[ARG_MEMORY])
+        flags |= ETF_MEMORY;
+    if (args[ARG_MESSAGE])
+        flags |= ETF_MESSAGE;
+    if (args[ARG_ALL])
+        flags |= ETF_ALL;
+    if (args[ARG_SECONDS])
+        seconds = *(LONG *)args[ARG_SECONDS];
+
+    if (args[ARG_OFF])
+        SetTraceFlags(0, ETF_ALL);
+    else if (flags)
+    {
+        oldFlags = SetTraceFlags(flags, ETF_ALL);
+        if (!GetTraceAttr(ETA_Flags))
+            error = ERROR_NO_FREE_STORE;
+        else if (seconds)
+        {
+            /* Wait in short steps, so Ctrl-C works */
+            for (i = 0; i < seconds * 10; i++)
+            {
+                if (CheckSignal(SIGBREAKF_CTRL_C))
+                    break;
+                Delay(5);
+            }
+            SetTraceFlags(oldFlags, ETF_ALL);
+        }
+    }
+    else if (!args[ARG_TO])
+        PrintFlags(GetTraceAttr(ETA_Flags));
+
+    if (!error && args[ARG_TO])
+        error = DumpTrace((CONST_STRPTR)args[ARG_TO]);
+
+    FreeArgs(rda);
+
+    if (error)
+    {
+        PrintFault(error, "ExecTrace");
+        return RETURN_FAIL;
+    }
+
+    return RETURN_OK;
+}
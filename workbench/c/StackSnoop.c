@@ -49,6 +49,8 @@
 #include <proto/exec.h>
 #include <proto/dos.h>
 #include <proto/debug.h>
+#include <proto/task.h>
+#include <resources/task.h>
 #include <proto/alib.h>
 
 #include <string.h>
@@ -142,32 +144,56 @@ static void CheckTaskStack(struct Task *task)
 
 static void Action(void)
 {
-    struct Task *task;
+    APTR TaskResBase = OpenResource("task.resource");
+    struct TaskList *tasklist = NULL;
+    struct Task *task, *me = FindTask(NULL);
     WORD i;
-    
-    Disable();
+
+    /*
+     * Ready tasks may be kept in the schedulers run queues rather than
+     * SysBase->TaskReady, so ask task.resource for the tasks if we can.
+     */
+    if (TaskResBase)
+        tasklist = LockTaskList(LTF_ALL);
+
+    if (!tasklist)
+        Disable();
 
     out("\n------------------------------------------------------------------------------\n\n");
-    
-    task = (struct Task *)SysBase->TaskReady.lh_Head;
-    for(i = 0; i < 2;i++)
+
+    if (tasklist)
+    {
+        while ((task = NextTaskEntry(tasklist, LTF_ALL)) != NULL)
+        {
+            if (task != me)
+                CheckTaskStack(task);
+        }
+    }
+    else
     {
-        while(task->tc_Node.ln_Succ)
+        task = (struct Task *)SysBase->TaskReady.lh_Head;
+        for(i = 0; i < 2;i++)
         {
-            CheckTaskStack(task);
-            
-            task = (struct Task *)task->tc_Node.ln_Succ;
-        } /* while(task->tc_Node.ln_Succ) */
-        
-        task = (struct Task *)SysBase->TaskWait.lh_Head;
-        
-    } /* for(i = 0; i < 2;i++) */
+            while(task->tc_Node.ln_Succ)
+            {
+                CheckTaskStack(task);
+
+                task = (struct Task *)task->tc_Node.ln_Succ;
+            } /* while(task->tc_Node.ln_Succ) */
+
+            task = (struct Task *)SysBase->TaskWait.lh_Head;
+
+        } /* for(i = 0; i < 2;i++) */
+    }
     out("\n");
-    CheckTaskStack(FindTask(NULL));
+    CheckTaskStack(me);
     out("\n------------------------------------------------------------------------------\n\n");
-    
-    Enable();
-    
+
+    if (tasklist)
+        UnLockTaskList(tasklist, LTF_ALL);
+    else
+        Enable();
+
     PutStr(outbuffer);
 }
 
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2010-2022, The AROS Development Team. All rights reserved.
+    Copyright (C) 2010-2026, The AROS Development Team. All rights reserved.
 */
 
 #define DEBUG 0
@@ -11,6 +11,7 @@
 #define DREDRAWSCR(x) x
 #define DSTACK(x) x
 #define DUPDATE(x) x
+#define DSTATS(x) x
 #else
 #define DTOGGLE(x)
 #define DMOVE(x)
@@ -19,6 +20,7 @@
 #define DREDRAWSCR(x)
 #define DSTACK(x)
 #define DUPDATE(x)
+#define DSTATS(x)
 #endif
 
 #include <aros/debug.h>
@@ -31,7 +33,9 @@
 #include <proto/oop.h>
 #include <proto/utility.h>
 
+#include <exec/tasks.h>
 #include <graphics/view.h>
+#include <hardware/intbits.h>
 #include <hidd/gfx.h>
 
 #include "compositor_intern.h"
@@ -41,6 +45,9 @@
 
 #define CAPABILITY_FLAGS (COMPF_ABOVE|COMPF_BELOW|COMPF_LEFT|COMPF_RIGHT|COMPF_ALPHA)
 
+#define COMPOSITOR_FLUSHSIG     SIGBREAKF_CTRL_F
+#define COMPOSITOR_FLUSHPRI     10
+
 enum
 {
     ARG_ABOVE = 0,
@@ -66,20 +73,6 @@ enum
 #define MAX(a,b) a > b ? a : b
 #define MIN(a,b) a < b ? a : b
 
-BOOL isRectInRegion(struct Region *region, struct Rectangle *rect)
-{
-    struct RegionRectangle *rrect = region->RegionRectangle;
-
-    while (rrect)
-    {
-        if (AndRectRect(&rrect->bounds, rect, NULL))
-            return TRUE;
-
-        rrect = rrect->Next;
-    }
-    return FALSE;
-}
-
 static struct StackBitMapNode * HIDDCompositorFindBitMapStackNode(struct HIDDCompositorData * compdata, OOP_Object * bm)
 {
     struct StackBitMapNode * n = NULL;
@@ -144,6 +137,18 @@ static VOID HIDDCompositorValidateBitMapPositionChange(OOP_Object * bm, SIPTR *n
         *(newyoffset) = neglimit;
 }
 
+static VOID HIDDCompositorDiscardDamage(struct HIDDCompositorData *compdata)
+{
+    struct StackBitMapNode *n;
+
+    ForeachNode(&compdata->bitmapstack, n)
+    {
+        if (n->damage)
+            ClearRegion(n->damage);
+    }
+    compdata->flags &= ~COMPSTATEF_DAMAGED;
+}
+
 static VOID HIDDCompositorRecalculateVisibleRegions(struct HIDDCompositorData *compdata)
 {
     struct StackBitMapNode      *n = NULL, *tmpn;
@@ -291,6 +296,8 @@ static inline void HIDDCompositorRedrawBitmap(struct HIDDCompositorData *compdat
 
     if (renderTarget)
     {
+        compdata->pixelcount += blitwidth * blitheight;
+
         if (!(n->sbmflags & COMPF_ALPHA))
         {
             DREDRAWBM(bug("[Compositor] %s: Blitting %dx%d [from %d, %d]\n", __func__, blitwidth, blitheight,
@@ -414,8 +421,9 @@ static VOID HIDDCompositorRedrawVisibleRegions(struct HIDDCompositorData *compda
 
     if (!(drawrect))
     {
-        /* Recalculate visible regions */
+        /* Recalculate visible regions. Everything is redrawn, so pending damage can go */
         HIDDCompositorRecalculateVisibleRegions(compdata);
+        HIDDCompositorDiscardDamage(compdata);
     }
 
     if ((compdata->flags & COMPSTATEF_HASALPHA) && (compdata->intermedbitmap))
@@ -484,6 +492,8 @@ static VOID HIDDCompositorRedrawVisibleRegions(struct HIDDCompositorData *compda
             {
                 DREDRAWSCR(bug("[Compositor] %s: Render Display Void Region [%d, %d - %d, %d]\n", __func__, _RECT(tmprect)));
 
+                compdata->pixelcount += (tmprect.MaxX - tmprect.MinX + 1) * (tmprect.MaxY - tmprect.MinY + 1);
+
                 if (clearbm)
                 {
                     clearmsg.bounds = &tmprect;
@@ -542,6 +552,114 @@ static VOID HIDDCompositorRedrawVisibleRegions(struct HIDDCompositorData *compda
     }
 }
 
+/*
+ * Composites the damage of all screens. The damage of a screen is clipped to its
+ * visible region first, then the damage of all screens is merged, so that every
+ * damaged pixel is composited once, however often it changed since the last flush.
+ */
+static VOID HIDDCompositorFlushDamage(struct HIDDCompositorData *compdata)
+{
+    struct StackBitMapNode *n;
+    struct Region *damage;
+    struct RegionRectangle *drrect;
+    struct Rectangle tmprect;
+
+    if (!compdata->displaybitmap)
+    {
+        HIDDCompositorDiscardDamage(compdata);
+        return;
+    }
+
+    if ((damage = NewRegion()) == NULL)
+    {
+        DUPDATE(bug("[Compositor] %s: Failed to create Damage Region, redrawing everything\n", __func__));
+        HIDDCompositorRedrawVisibleRegions(compdata, NULL);
+        return;
+    }
+
+    compdata->flags &= ~COMPSTATEF_DAMAGED;
+
+    ForeachNode(&compdata->bitmapstack, n)
+    {
+        if (n->damage && n->damage->RegionRectangle)
+        {
+            if ((n->sbmflags & STACKNODEF_VISIBLE) && (n->screenregion))
+            {
+                AndRegionRegion(n->screenregion, n->damage);
+                OrRegionRegion(n->damage, damage);
+            }
+            ClearRegion(n->damage);
+        }
+    }
+
+    DUPDATE(bug("[Compositor] %s: Damage [%d, %d - %d, %d]\n", __func__, _RECT(damage->bounds)));
+
+    for (drrect = damage->RegionRectangle; drrect; drrect = drrect->Next)
+    {
+        tmprect.MinX = drrect->bounds.MinX + damage->bounds.MinX;
+        tmprect.MinY = drrect->bounds.MinY + damage->bounds.MinY;
+        tmprect.MaxX = drrect->bounds.MaxX + damage->bounds.MinX;
+        tmprect.MaxY = drrect->bounds.MaxY + damage->bounds.MinY;
+
+        HIDDCompositorRedrawVisibleRegions(compdata, &tmprect);
+    }
+
+    DisposeRegion(damage);
+}
+
+static VOID HIDDCompositorUpdateStats(struct HIDDCompositorData *compdata)
+{
+    ULONG elapsed = compdata->vblankcount - compdata->statsvblank;
+
+    if (elapsed >= SysBase->VBlankFrequency)
+    {
+        compdata->pixelrate = (ULONG)((UQUAD)compdata->pixelcount * SysBase->VBlankFrequency / elapsed);
+        compdata->pixelcount = 0;
+        compdata->statsvblank += elapsed;
+
+        DSTATS(if (compdata->pixelrate) bug("[Compositor] %s: %u pixels/s\n", __func__, compdata->pixelrate));
+    }
+}
+
+static AROS_INTH1(CompositorVBlank, struct HIDDCompositorData *, compdata)
+{
+    AROS_INTFUNC_INIT
+
+    compdata->vblankcount++;
+
+    /* Wake up the flush task for new damage, and once a second while the statistics change */
+    if ((compdata->flags & COMPSTATEF_DAMAGED) ||
+        ((compdata->pixelcount || compdata->pixelrate) &&
+         (compdata->vblankcount - compdata->statsvblank >= SysBase->VBlankFrequency)))
+    {
+        Signal(compdata->flushtask, COMPOSITOR_FLUSHSIG);
+    }
+
+    return 0;
+
+    AROS_INTFUNC_EXIT
+}
+
+static void CompositorFlushTask(struct HIDDCompositorData *compdata)
+{
+    D(bug("[Compositor] %s: HIDDCompositorData @ 0x%p\n", __func__, compdata));
+
+    while (!(Wait(COMPOSITOR_FLUSHSIG | SIGBREAKF_CTRL_C) & SIGBREAKF_CTRL_C))
+    {
+        LOCK_COMPOSITOR_WRITE
+
+        if (compdata->flags & COMPSTATEF_DAMAGED)
+            HIDDCompositorFlushDamage(compdata);
+        HIDDCompositorUpdateStats(compdata);
+
+        UNLOCK_COMPOSITOR
+    }
+
+    /* The task is gone once the owner runs again */
+    Forbid();
+    Signal(compdata->flushowner, SIGF_SINGLE);
+}
+
 /*
 
 There are several cases that needs to be handled in this code. They are documented
@@ -820,11 +938,14 @@ static VOID HIDDCompositorPurgeBitMapStack(struct HIDDCompositorData * compdata)
     {
         if (curr->screenregion)
             DisposeRegion(curr->screenregion);
+        if (curr->damage)
+            DisposeRegion(curr->damage);
 
         FreeMem(curr, sizeof(struct StackBitMapNode));
     }
 
     NEWLIST(&compdata->bitmapstack);
+    compdata->flags &= ~COMPSTATEF_DAMAGED;
 }
 
 static void HIDDCompositorShowSingle(struct HIDDCompositorData *compdata, OOP_Object *bm)
@@ -1000,7 +1121,29 @@ OOP_Object *METHOD(Compositor, Root, New)
             D(bug("[Compositor] %s: Compositor GC @ %p\n", __func__, compdata->gc));
 
             if ((compdata->gfx) && (compdata->gc))
-                    return o;
+            {
+                /*
+                 * Changes are composited by a task of our own, once per vertical blank.
+                 * If it can't be created, they are composited right away.
+                 */
+                compdata->flushtask = NewCreateTask(TASKTAG_NAME,   "Compositor",
+                                                    TASKTAG_PC,     CompositorFlushTask,
+                                                    TASKTAG_PRI,    COMPOSITOR_FLUSHPRI,
+                                                    TASKTAG_ARG1,   compdata,
+                                                    TAG_DONE);
+                if (compdata->flushtask)
+                {
+                    compdata->vblankint.is_Code         = (APTR)CompositorVBlank;
+                    compdata->vblankint.is_Data         = compdata;
+                    compdata->vblankint.is_Node.ln_Name = "Compositor VBlank server";
+                    compdata->vblankint.is_Node.ln_Pri  = 0;
+                    compdata->vblankint.is_Node.ln_Type = NT_INTERRUPT;
+                    AddIntServer(INTB_VERTB, &compdata->vblankint);
+                }
+                D(bug("[Compositor] %s: Flush Task @ 0x%p\n", __func__, compdata->flushtask));
+
+                return o;
+            }
         }
 
         /* Creation failed */
@@ -1013,11 +1156,20 @@ OOP_Object *METHOD(Compositor, Root, New)
 
 void METHOD(Compositor, Root, Dispose)
 {
+    struct HIDDCompositorData *compdata = OOP_INST_DATA(cl, o);
 
-    D(
-        struct HIDDCompositorData *compdata = OOP_INST_DATA(cl, o);
-        bug("[Compositor] %s: HIDDCompositorData @ 0x%p\n", __func__, compdata);
-      )
+    D(bug("[Compositor] %s: HIDDCompositorData @ 0x%p\n", __func__, compdata));
+
+    if (compdata->flushtask)
+    {
+        RemIntServer(INTB_VERTB, &compdata->vblankint);
+
+        compdata->flushowner = FindTask(NULL);
+        SetSignal(0, SIGF_SINGLE);
+        Signal(compdata->flushtask, SIGBREAKF_CTRL_C);
+        Wait(SIGF_SINGLE);
+        compdata->flushtask = NULL;
+    }
 
     OOP_DoSuperMethod(cl, o, &msg->mID);
 }
@@ -1050,6 +1202,11 @@ VOID METHOD(Compositor, Root, Get)
                 *msg->storage = (IPTR)compdata->backfillhook;
                 return;
             }
+            case aoHidd_Compositor_PixelRate:
+            {
+                *msg->storage = (IPTR)compdata->pixelrate;
+                return;
+            }
         }
     }
     OOP_DoSuperMethod(cl, o, &msg->mID);
@@ -1252,84 +1409,46 @@ OOP_Object *METHOD(Compositor, Hidd_Compositor, BitMapStackChanged)
 VOID METHOD(Compositor, Hidd_Compositor, BitMapRectChanged)
 {
     struct HIDDCompositorData *compdata = OOP_INST_DATA(cl, o);
-    OOP_Object                *renderTarget = compdata->displaybitmap;
 
     if (compdata->displaybitmap)
     {
-        /* Composition is active, handle redraw if the bitmap is on screen */
+        /* Composition is active, remember the damage if the bitmap is on screen */
         struct StackBitMapNode *n;
 
         DUPDATE(bug("[Compositor] %s: Bitmap 0x%p\n", __func__, msg->bm));
 
-        LOCK_COMPOSITOR_READ
-
-        if (compdata->intermedbitmap)
-            renderTarget = compdata->intermedbitmap;
+        LOCK_COMPOSITOR_WRITE
 
         n = HIDDCompositorFindBitMapStackNode(compdata, msg->bm);
         if (n && (n->sbmflags & STACKNODEF_VISIBLE))
         {
-            struct Rectangle dstandvisrect;
-                struct Rectangle srcrect;
+            struct Rectangle srcrect;
 
             srcrect.MinX = n->leftedge + msg->x;
             srcrect.MinY = n->topedge + msg->y;
             srcrect.MaxX = srcrect.MinX + msg->width - 1;
             srcrect.MaxY = srcrect.MinY + msg->height - 1;
-                DUPDATE(bug("[Compositor] %s: Bitmap rect [%d, %d -> %d, %d]\n", __func__, msg->x, msg->y, msg->x + msg->width - 1, msg->y + msg->height - 1));
+            DUPDATE(bug("[Compositor] %s: Bitmap rect [%d, %d -> %d, %d]\n", __func__, msg->x, msg->y, msg->x + msg->width - 1, msg->y + msg->height - 1));
 
             DUPDATE(bug("[Compositor] %s: Screen-relative rect [%d, %d -> %d, %d]\n", __func__, _RECT(srcrect)));
 
-            struct RegionRectangle * srrect = n->screenregion->RegionRectangle;
-            while (srrect)
-            {
-                BOOL updateAlphaBmps = FALSE;
-
-                dstandvisrect.MinX = srrect->bounds.MinX + n->screenregion->bounds.MinX;
-                dstandvisrect.MinY = srrect->bounds.MinY + n->screenregion->bounds.MinY;
-                dstandvisrect.MaxX = srrect->bounds.MaxX + n->screenregion->bounds.MinX;
-                dstandvisrect.MaxY = srrect->bounds.MaxY + n->screenregion->bounds.MinY;
-
-                if (AndRectRect(&srcrect, &dstandvisrect, &dstandvisrect))
-                {
-                    /* Intersection is valid. Blit. */
-                    DUPDATE(bug("[Compositor] %s: Clipped rect (%d, %d) - (%d, %d)\n", __func__, _RECT(dstandvisrect)));
-
-                    if (!(n->sbmflags & COMPF_ALPHA))
-                    {
-                        if ((compdata->alpharegion) && (isRectInRegion(compdata->alpharegion, &dstandvisrect)))
-                        {
-                            DUPDATE(bug("[Compositor] %s: ** BitMap in Alpha Region!\n", __func__));
-                            updateAlphaBmps = TRUE;
-                        }
-                        HIDDCompositorRedrawBitmap(compdata, renderTarget, n, &dstandvisrect);
-                    }
-                    else
-                    {
-                        HIDDCompositorRedrawVisibleRegions(compdata, &dstandvisrect);
-                    }
+            if (!n->damage)
+                n->damage = NewRegion();
 
-                    if (updateAlphaBmps)
-                        HIDDCompositorRedrawAlphaRegions(compdata, &dstandvisrect);
+            if ((n->damage) && (OrRectRegion(n->damage, &srcrect)))
+            {
+                compdata->flags |= COMPSTATEF_DAMAGED;
 
-                    if (renderTarget != compdata->displaybitmap)
-                    {
-                        HIDD_Gfx_CopyBox(compdata->gfx, renderTarget,
-                                dstandvisrect.MinX, dstandvisrect.MinY,
-                                compdata->displaybitmap,
-                                dstandvisrect.MinX, dstandvisrect.MinY,
-                                dstandvisrect.MaxX - dstandvisrect.MinX + 1,
-                                dstandvisrect.MaxY - dstandvisrect.MinY + 1,
-                                compdata->gc);
-                    }
-                }
-                srrect = srrect->Next;
+                /* Without the flush task, composite it right away */
+                if (!compdata->flushtask)
+                    HIDDCompositorFlushDamage(compdata);
             }
-            HIDD_BM_UpdateRect(compdata->displaybitmap,
-                   srcrect.MinX, srcrect.MinY,
-                   srcrect.MaxX - srcrect.MinX + 1,
-                   srcrect.MaxY - srcrect.MinY + 1);
-         }
+            else if (AndRectRect(&srcrect, &compdata->displayrect, &srcrect))
+            {
+                DUPDATE(bug("[Compositor] %s: Failed to add damage, redrawing (%d, %d) - (%d, %d)\n", __func__, _RECT(srcrect)));
+                HIDDCompositorRedrawVisibleRegions(compdata, &srcrect);
+            }
+        }
 
         UNLOCK_COMPOSITOR
 
@@ -2,12 +2,13 @@
 #define _COMPOSITOR_INTERN_H
 
 /*
-    Copyright  2010-2013, The AROS Development Team. All rights reserved.
+    Copyright  2010-2026, The AROS Development Team. All rights reserved.
     $Id$
 */
 
 #include "compositor.h"
 
+#include <exec/interrupts.h>
 #include <exec/nodes.h>
 #include <exec/lists.h>
 #include <exec/semaphores.h>
@@ -18,6 +19,7 @@ struct StackBitMapNode
     struct MinNode  n;
     OOP_Object      *bm;
     struct Region   *screenregion;
+    struct Region   *damage;        /* Changed since the last flush, in display coordinates */
     SIPTR           leftedge;        /* Offset */
     SIPTR           topedge;
     IPTR            sbmflags;
@@ -68,12 +70,23 @@ struct HIDDCompositorData
 
     struct Hook                 defaultbackfill;
     BOOL                        modeschanged;   /* TRUE if new top bitmap has different mode than current displaymode */
+
+    /* Damaged rectangles are composited by flushtask, at most once per vertical blank */
+    struct Task                 *flushtask;
+    struct Task                 *flushowner;    /* Waits for flushtask to end                   */
+    struct Interrupt            vblankint;
+    ULONG                       vblankcount;    /* Vertical blanks seen by vblankint            */
+    ULONG                       statsvblank;    /* vblankcount when pixelcount was last reset   */
+    ULONG                       pixelcount;     /* Pixels composited since then                 */
+    ULONG                       pixelrate;      /* Pixels composited per second                 */
 };
 
 #define COMPSTATEB_HASALPHA     0
 #define COMPSTATEF_HASALPHA     (1 << COMPSTATEB_HASALPHA)
 #define COMPSTATEB_DEEPLUT       1
 #define COMPSTATEF_DEEPLUT      (1 << COMPSTATEB_DEEPLUT)
+#define COMPSTATEB_DAMAGED      2
+#define COMPSTATEF_DAMAGED      (1 << COMPSTATEB_DAMAGED)
 
 #define METHOD(base, id, name) \
   base ## __ ## id ## __ ## name (OOP_Class *cl, OOP_Object *o, struct p ## id ## _ ## name *msg)
@@ -20,7 +20,7 @@ OOP_AttrBase HiddBitMapAttrBase;
 OOP_AttrBase HiddGCAttrBase;
 OOP_AttrBase HiddCompositorAttrBase;
 
-const TEXT version[] = "$VER: Compositor 41.2 (22.06.2019)\n";
+const TEXT version[] = "$VER: Compositor 41.3 (17.10.2026)\n";
 
 static OOP_Class *InitClass(void)
 {
@@ -1,7 +1,7 @@
 #ifndef HIDD_COMPOSITOR_H
 #define HIDD_COMPOSITOR_H
 /*
-    Copyright  2010-2017, The AROS Development Team. All rights reserved.
+    Copyright  2010-2026, The AROS Development Team. All rights reserved.
     $Id$
 */
 
@@ -56,6 +56,7 @@ enum
     aoHidd_Compositor_State,        /* [ISG] Currently used capabilities                              */
     aoHidd_Compositor_BackFillHook, /* [ISG] Rendering hook for void space                            */
     aoHidd_Compositor_FrameBuffer,  /* [I..] Driver's framebuffer bitmap                              */
+    aoHidd_Compositor_PixelRate,    /* [..G] Pixels composited per second, over the last second       */
 
     num_Hidd_Compositor_Attrs
 };
@@ -66,6 +67,7 @@ enum
 #define aHidd_Compositor_State         (HiddCompositorAttrBase + aoHidd_Compositor_State)
 #define aHidd_Compositor_BackFillHook  (HiddCompositorAttrBase + aoHidd_Compositor_BackFillHook)
 #define aHidd_Compositor_FrameBuffer   (HiddCompositorAttrBase + aoHidd_Compositor_FrameBuffer)
+#define aHidd_Compositor_PixelRate     (HiddCompositorAttrBase + aoHidd_Compositor_PixelRate)
 
 #define IS_COMPOSITOR_ATTR(attr, idx) \
     (((idx) = (attr) - HiddCompositorAttrBase) < num_Hidd_Compositor_Attrs)
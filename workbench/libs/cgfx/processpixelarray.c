@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2013, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc:
 */
@@ -43,7 +43,9 @@
         sizeX, sizeY - size of the affected area.
         operation - one of the following transformation types:
             POP_TINT - tint the rectangle with an ARGB32 color ('value' input).
-            POP_BLUR - blur the rectangle.
+            POP_BLUR - blur the rectangle. The 'value' input is the radius
+                of the blur, in the range 1 to 64. Smaller values are taken
+                as 1. The result comes close to a gaussian blur.
             POP_BRIGHTEN - brighten the rectangle. The amount of brightening
                 to be done is defined by the 'value' input, which must be in
                 the range 0 to 255.
@@ -71,7 +73,7 @@
     EXAMPLE
 
     BUGS
-        This function is not implemented.
+        Only POP_BRIGHTEN, POP_DARKEN and POP_BLUR are implemented.
 
     SEE ALSO
 
@@ -106,7 +108,7 @@
         ProcessPixelArrayTintFunc(rp, &opRect, value, CyberGfxBase);
         break;
     case POP_BLUR:
-        ProcessPixelArrayBlurFunc(rp, &opRect, CyberGfxBase);
+        ProcessPixelArrayBlurFunc(rp, &opRect, value, CyberGfxBase);
         break;
     case POP_COLOR2GREY:
         ProcessPixelArrayColor2GreyFunc(rp, &opRect, CyberGfxBase);
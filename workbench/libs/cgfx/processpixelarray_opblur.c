@@ -1,19 +1,417 @@
 /*
-    Copyright (C) 2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 2017-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <aros/debug.h>
 
 #include <proto/cybergraphics.h>
+#include <proto/exec.h>
+#include <proto/processor.h>
 
 #include <hidd/gfx.h>
 #include <cybergraphx/cybergraphics.h>
+#include <exec/memory.h>
+#include <exec/tasks.h>
 #include <exec/types.h>
+#include <resources/processor.h>
 
 #include "cybergraphics_intern.h"
+#include "processpixelarray_ops.h"
 
-void ProcessPixelArrayBlurFunc(struct RastPort *opRast, struct Rectangle *opRect, struct Library *CyberGfxBase)
+/* The blur is done with three box blurs in a row, which comes close to a
+   gaussian blur. Each box blur is separable, so it is done along the rows
+   first and then along the columns, with running sums that don't depend
+   on the radius. Pixels beyond the edges of the rectangle count as copies
+   of the edge pixels.
+
+   Large rectangles are split into bands of rows, which are blurred by
+   separate tasks, so they can run on all CPUs. A band blurs the rows it
+   needs from the bands next to it itself, so the tasks never wait for
+   each other. */
+
+#define BLUR_PASSES     3
+#define BLUR_MAXRADIUS  64
+#define BLUR_MINPIXELS  65536   /* smaller rectangles are done by the caller alone */
+#define BLUR_MINROWS    32      /* rows per band at least */
+
+struct BlurBand
+{
+    struct Message  bb_Msg;         /* replied when a task is done with the band */
+    UBYTE          *bb_Src;         /* whole rectangle, ARGB32 */
+    UBYTE          *bb_Dst;
+    UBYTE          *bb_Rows[2];     /* band and the rows around it, blurred so far */
+    UBYTE          *bb_Line;        /* one row */
+    ULONG          *bb_Sums;        /* column sums of one row */
+    ULONG           bb_RowsSize;
+    LONG            bb_Width;
+    LONG            bb_Height;
+    LONG            bb_MinY;        /* rows of the band */
+    LONG            bb_MaxY;
+    LONG            bb_Radius;
+};
+
+/****************************************************************************************/
+
+static inline LONG BlurClamp(LONG v, LONG min, LONG max)
+{
+    return (v < min) ? min : (v > max) ? max : v;
+}
+
+/* Sums of 2 * radius + 1 values are divided by multiplying with mul and
+   shifting right by 24 bits */
+static inline UBYTE BlurDivide(ULONG sum, ULONG mul)
+{
+    return (sum * mul + (1 << 23)) >> 24;
+}
+
+/* Box blurs a row of pixels */
+static void BlurRow(UBYTE *dst, const UBYTE *src, LONG width, LONG radius, ULONG mul)
 {
-    bug ("[Cgfx] %s()\n", __PRETTY_FUNCTION__);
-    bug ("[Cgfx] %s: Blur operator not implemented\n", __PRETTY_FUNCTION__);
+    ULONG sum[4];
+    LONG x, i;
+    UBYTE c;
+
+    for (c = 0; c < 4; c++)
+        sum[c] = (radius + 1) * src[c];
+
+    for (i = 1; i <= radius; i++)
+    {
+        const UBYTE *p = src + BlurClamp(i, 0, width - 1) * 4;
+
+        for (c = 0; c < 4; c++)
+            sum[c] += p[c];
+    }
+
+    for (x = 0; x < width; x++)
+    {
+        const UBYTE *add = src + BlurClamp(x + radius + 1, 0, width - 1) * 4;
+        const UBYTE *sub = src + BlurClamp(x - radius, 0, width - 1) * 4;
+
+        for (c = 0; c < 4; c++)
+        {
+            dst[x * 4 + c] = BlurDivide(sum[c], mul);
+            sum[c] += add[c] - sub[c];
+        }
+    }
+}
+
+/* Outputs a row from the column sums, then moves the sums down by one row */
+static void BlurColumnStep(UBYTE *dst, ULONG *sums, const UBYTE *add, const UBYTE *sub, ULONG bytes, ULONG mul)
+{
+    ULONG i = 0;
+
+#ifdef PPA_VECTOR
+    const ppa_v16ub zero = { 0 };
+    const ppa_v16ub lobytes = { 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23 };
+    const ppa_v16ub hibytes = { 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31 };
+    const ppa_v8uw lowords = { 0, 8, 1, 9, 2, 10, 3, 11 };
+    const ppa_v8uw hiwords = { 4, 12, 5, 13, 6, 14, 7, 15 };
+    const ppa_v8uw evenwords = { 0, 2, 4, 6, 8, 10, 12, 14 };
+    const ppa_v16ub evenbytes = { 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30 };
+    ppa_v4ul vmul = { 0 }, half = { 0 };
+
+    vmul += mul;
+    half += 1 << 23;
+
+    for (; i + 16 <= bytes; i += 16)
+    {
+        ppa_v4ul_u *s = (ppa_v4ul_u *)(sums + i);
+        ppa_v16ub a = *(ppa_v16ub_u *)(add + i), b = *(ppa_v16ub_u *)(sub + i);
+        ppa_v8uw a0, a1, b0, b1, w0, w1;
+        ppa_v4ul o[4], d[4];
+        UBYTE j;
+
+        for (j = 0; j < 4; j++)
+            o[j] = (s[j] * vmul + half) >> 24;
+
+        w0 = (ppa_v8uw)__builtin_shuffle((ppa_v8uw)o[0], (ppa_v8uw)o[1], evenwords);
+        w1 = (ppa_v8uw)__builtin_shuffle((ppa_v8uw)o[2], (ppa_v8uw)o[3], evenwords);
+        *(ppa_v16ub_u *)(dst + i) = __builtin_shuffle((ppa_v16ub)w0, (ppa_v16ub)w1, evenbytes);
+
+        /* Widen the bytes to 32 bits */
+        a0 = (ppa_v8uw)__builtin_shuffle(a, zero, lobytes);
+        a1 = (ppa_v8uw)__builtin_shuffle(a, zero, hibytes);
+        b0 = (ppa_v8uw)__builtin_shuffle(b, zero, lobytes);
+        b1 = (ppa_v8uw)__builtin_shuffle(b, zero, hibytes);
+
+        d[0] = (ppa_v4ul)__builtin_shuffle(a0, (ppa_v8uw)zero, lowords) - (ppa_v4ul)__builtin_shuffle(b0, (ppa_v8uw)zero, lowords);
+        d[1] = (ppa_v4ul)__builtin_shuffle(a0, (ppa_v8uw)zero, hiwords) - (ppa_v4ul)__builtin_shuffle(b0, (ppa_v8uw)zero, hiwords);
+        d[2] = (ppa_v4ul)__builtin_shuffle(a1, (ppa_v8uw)zero, lowords) - (ppa_v4ul)__builtin_shuffle(b1, (ppa_v8uw)zero, lowords);
+        d[3] = (ppa_v4ul)__builtin_shuffle(a1, (ppa_v8uw)zero, hiwords) - (ppa_v4ul)__builtin_shuffle(b1, (ppa_v8uw)zero, hiwords);
+
+        for (j = 0; j < 4; j++)
+            s[j] += d[j];
+    }
+#endif
+
+    for (; i < bytes; i++)
+    {
+        dst[i] = BlurDivide(sums[i], mul);
+        sums[i] += add[i] - sub[i];
+    }
+}
+
+/* Box blurs the rows outmin to outmax along the columns. src holds the rows
+   from max(outmin - radius, 0) to min(outmax + radius, height - 1) */
+static void BlurColumns(UBYTE *dst, const UBYTE *src, LONG outmin, LONG outmax, LONG height,
+    LONG radius, ULONG mul, ULONG bytes, ULONG *sums)
+{
+    LONG inmin = BlurClamp(outmin - radius, 0, height - 1);
+    LONG inmax = BlurClamp(outmax + radius, 0, height - 1);
+    LONG y;
+    ULONG i;
+
+#define ROW(y) (src + (BlurClamp(y, inmin, inmax) - inmin) * bytes)
+
+    for (i = 0; i < bytes; i++)
+        sums[i] = 0;
+
+    for (y = outmin - radius; y <= outmin + radius; y++)
+    {
+        const UBYTE *p = ROW(y);
+
+        for (i = 0; i < bytes; i++)
+            sums[i] += p[i];
+    }
+
+    for (y = outmin; y <= outmax; y++)
+    {
+        BlurColumnStep(dst, sums, ROW(y + radius + 1), ROW(y - radius), bytes, mul);
+        dst += bytes;
+    }
+
+#undef ROW
+}
+
+static void BlurBand(struct BlurBand *band)
+{
+    LONG radius = band->bb_Radius, height = band->bb_Height;
+    ULONG bytes = band->bb_Width * 4;
+    ULONG mul = ((1 << 24) + 2 * radius) / (2 * radius + 1);
+    LONG min = BlurClamp(band->bb_MinY - BLUR_PASSES * radius, 0, height - 1);
+    LONG max = BlurClamp(band->bb_MaxY + BLUR_PASSES * radius, 0, height - 1);
+    UBYTE *rows = band->bb_Rows[0], *other = band->bb_Rows[1];
+    LONG y, pass;
+
+    D(bug("[Cgfx] %s: rows %d - %d\n", __PRETTY_FUNCTION__, band->bb_MinY, band->bb_MaxY));
+
+    /* Every pass along the rows, for all the rows that the passes along the
+       columns will need */
+    for (y = min; y <= max; y++)
+    {
+        UBYTE *row = rows + (y - min) * bytes;
+        const UBYTE *in = band->bb_Src + y * bytes;
+
+        /* Alternate between the row and the line buffer, ending in the row */
+        for (pass = 0; pass < BLUR_PASSES; pass++)
+        {
+            UBYTE *out = ((BLUR_PASSES - pass) & 1) ? row : band->bb_Line;
+
+            BlurRow(out, in, band->bb_Width, radius, mul);
+            in = out;
+        }
+    }
+
+    /* Each pass along the columns needs radius rows less on both sides */
+    for (pass = BLUR_PASSES - 1; pass >= 0; pass--)
+    {
+        LONG outmin = BlurClamp(band->bb_MinY - pass * radius, 0, height - 1);
+        LONG outmax = BlurClamp(band->bb_MaxY + pass * radius, 0, height - 1);
+        UBYTE *out = pass ? other + (outmin - min) * bytes : band->bb_Dst + outmin * bytes;
+        UBYTE *tmp;
+
+        BlurColumns(out, rows + (BlurClamp(outmin - radius, 0, height - 1) - min) * bytes,
+                    outmin, outmax, height, radius, mul, bytes, band->bb_Sums);
+
+        tmp = rows;
+        rows = other;
+        other = tmp;
+    }
+}
+
+static void BlurTask(struct BlurBand *band)
+{
+    BlurBand(band);
+    ReplyMsg(&band->bb_Msg);
+}
+
+/****************************************************************************************/
+
+static ULONG BlurCPUs(void)
+{
+    APTR ProcessorBase = OpenResource(PROCESSORNAME);
+    ULONG count = 1;
+
+    if (ProcessorBase)
+        GetCPUInfoTags(GCIT_NumberOfProcessors, &count, TAG_DONE);
+
+    return count ? count : 1;
+}
+
+static void FreeBlurBands(struct BlurBand *bands, ULONG count)
+{
+    ULONG i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (bands[i].bb_Sums)
+            FreeMem(bands[i].bb_Sums, bands[i].bb_Width * 4 * sizeof(ULONG));
+        if (bands[i].bb_Line)
+            FreeMem(bands[i].bb_Line, bands[i].bb_Width * 4);
+        if (bands[i].bb_Rows[1])
+            FreeMem(bands[i].bb_Rows[1], bands[i].bb_RowsSize);
+        if (bands[i].bb_Rows[0])
+            FreeMem(bands[i].bb_Rows[0], bands[i].bb_RowsSize);
+    }
+    FreeMem(bands, count * sizeof(struct BlurBand));
+}
+
+static struct BlurBand *AllocBlurBands(UBYTE *src, UBYTE *dst, LONG width, LONG height, LONG radius, ULONG count)
+{
+    struct BlurBand *bands = AllocMem(count * sizeof(struct BlurBand), MEMF_ANY | MEMF_CLEAR);
+    ULONG i;
+
+    if (!bands)
+        return NULL;
+
+    for (i = 0; i < count; i++)
+    {
+        struct BlurBand *band = &bands[i];
+        LONG rows;
+
+        band->bb_Src    = src;
+        band->bb_Dst    = dst;
+        band->bb_Width  = width;
+        band->bb_Height = height;
+        band->bb_MinY   = height * i / count;
+        band->bb_MaxY   = height * (i + 1) / count - 1;
+        band->bb_Radius = radius;
+
+        rows = BlurClamp(band->bb_MaxY + BLUR_PASSES * radius, 0, height - 1) -
+               BlurClamp(band->bb_MinY - BLUR_PASSES * radius, 0, height - 1) + 1;
+        band->bb_RowsSize = rows * width * 4;
+
+        band->bb_Rows[0] = AllocMem(band->bb_RowsSize, MEMF_ANY);
+        band->bb_Rows[1] = AllocMem(band->bb_RowsSize, MEMF_ANY);
+        band->bb_Line    = AllocMem(width * 4, MEMF_ANY);
+        band->bb_Sums    = AllocMem(width * 4 * sizeof(ULONG), MEMF_ANY);
+
+        if (!band->bb_Rows[0] || !band->bb_Rows[1] || !band->bb_Line || !band->bb_Sums)
+        {
+            FreeBlurBands(bands, count);
+            return NULL;
+        }
+    }
+
+    return bands;
+}
+
+/* Blurs the bands, all but the first one in tasks of their own */
+static void BlurBands(struct BlurBand *bands, ULONG count)
+{
+    struct MsgPort *port = NULL;
+    ULONG i, started = 0;
+
+    if (count > 1)
+        port = CreateMsgPort();
+
+    if (port)
+    {
+        BYTE pri = FindTask(NULL)->tc_Node.ln_Pri;
+
+        for (i = 1; i < count; i++)
+        {
+            bands[i].bb_Msg.mn_ReplyPort = port;
+            bands[i].bb_Msg.mn_Length = sizeof(struct BlurBand);
+
+            /* New tasks stay on the CPU that created them, unless told otherwise */
+            if (NewCreateTask(TASKTAG_NAME, "ProcessPixelArray Blur",
+                              TASKTAG_PC, BlurTask,
+                              TASKTAG_PRI, pri,
+#if defined(__AROSEXEC_SMP__)
+                              TASKTAG_AFFINITY, TASKAFFINITY_ANY,
+#endif
+                              TASKTAG_ARG1, &bands[i],
+                              TAG_DONE))
+            {
+                started++;
+            }
+            else
+            {
+                /* Done below */
+                bands[i].bb_Msg.mn_ReplyPort = NULL;
+            }
+        }
+    }
+
+    D(bug("[Cgfx] %s: %d bands, %d tasks\n", __PRETTY_FUNCTION__, count, started));
+
+    for (i = 0; i < count; i++)
+    {
+        if (i == 0 || !bands[i].bb_Msg.mn_ReplyPort)
+            BlurBand(&bands[i]);
+    }
+
+    while (started)
+    {
+        WaitPort(port);
+        while (GetMsg(port))
+            started--;
+    }
+
+    if (port)
+        DeleteMsgPort(port);
+}
+
+void ProcessPixelArrayBlurFunc(struct RastPort *opRast, struct Rectangle *opRect, LONG radius, struct Library *CyberGfxBase)
+{
+    struct BlurBand *bands;
+    LONG width, height;
+    ULONG size, count;
+    UBYTE *src, *dst;
+
+    D(bug("[Cgfx] %s(%d)\n", __PRETTY_FUNCTION__, radius));
+
+    if (GetBitMapAttr(opRast->BitMap, BMA_DEPTH) < 15)
+    {
+        bug("[Cgfx] %s not possible for bitmap depth < 15\n", __PRETTY_FUNCTION__);
+        return;
+    }
+
+    radius = BlurClamp(radius, 1, BLUR_MAXRADIUS);
+    width  = opRect->MaxX - opRect->MinX + 1;
+    height = opRect->MaxY - opRect->MinY + 1;
+    size   = width * height * 4;
+
+    count = 1;
+    if (width * height >= BLUR_MINPIXELS)
+    {
+        count = BlurCPUs();
+        if (count > height / BLUR_MINROWS)
+            count = height / BLUR_MINROWS;
+        if (count < 1)
+            count = 1;
+    }
+
+    src = AllocMem(size, MEMF_ANY);
+    dst = AllocMem(size, MEMF_ANY);
+    bands = (src && dst) ? AllocBlurBands(src, dst, width, height, radius, count) : NULL;
+
+    if (bands)
+    {
+        ReadPixelArray(src, 0, 0, width * 4, opRast, opRect->MinX, opRect->MinY, width, height, RECTFMT_ARGB);
+        BlurBands(bands, count);
+        WritePixelArray(dst, 0, 0, width * 4, opRast, opRect->MinX, opRect->MinY, width, height, RECTFMT_ARGB);
+
+        FreeBlurBands(bands, count);
+    }
+    else
+    {
+        D(bug("[Cgfx] %s: Out of memory\n", __PRETTY_FUNCTION__));
+    }
+
+    if (dst)
+        FreeMem(dst, size);
+    if (src)
+        FreeMem(src, size);
 }
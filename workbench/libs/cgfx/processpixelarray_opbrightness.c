@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2013-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 2013-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <proto/cybergraphics.h>
@@ -9,20 +9,60 @@
 #include <exec/types.h>
 
 #include "cybergraphics_intern.h"
+#include "processpixelarray_ops.h"
 
 //#define DEBUG 1
 #include <aros/debug.h>
 
+/* Adds value to the color components, saturating at 0 and 255. Alpha is kept */
+static void AdjustBrightness(UBYTE *buffer, ULONG size, LONG value)
+{
+    ULONG i = 0;
+
+#ifdef PPA_VECTOR
+    const ppa_v16ub alpha = { 0xFF, 0, 0, 0, 0xFF, 0, 0, 0, 0xFF, 0, 0, 0, 0xFF, 0, 0, 0 };
+    ppa_v16ub add = { 0 }, sub = { 0 };
+
+    if (value > 0)
+        add += (UBYTE)value;
+    else
+        sub += (UBYTE)-value;
+
+    for (; i + 16 <= size; i += 16)
+    {
+        ppa_v16ub_u *p = (ppa_v16ub_u *)(buffer + i);
+        ppa_v16ub old = *p, up, down;
+
+        /* Wrapped around bytes compare lower than before */
+        up = old + add;
+        up |= (ppa_v16ub)(up < old);
+        down = up - sub;
+        down &= ~(ppa_v16ub)(down > up);
+
+        *p = (down & ~alpha) | (old & alpha);
+    }
+#endif
+
+    for (; i < size; i += 4)
+    {
+        UBYTE c;
+
+        for (c = 1; c < 4; c++)
+        {
+            LONG v = buffer[i + c] + value;
+
+            buffer[i + c] = (v > 255) ? 255 : (v < 0) ? 0 : v;
+        }
+    }
+}
+
 // function is used for both brighen and darken
 void ProcessPixelArrayBrightnessFunc(struct RastPort *opRast, struct Rectangle *opRect, LONG value, struct Library *CyberGfxBase)
 {
     D(bug("[Cgfx] %s(%d)\n", __PRETTY_FUNCTION__, value));
 
-    LONG x, y;
-    ULONG color;
-    LONG alpha, red, green, blue;
     LONG width, height;
-    ULONG * buffer, *ptr;
+    UBYTE *buffer;
 
     if (GetBitMapAttr(opRast->BitMap, BMA_DEPTH) < 15)
     {
@@ -33,48 +73,17 @@ void ProcessPixelArrayBrightnessFunc(struct RastPort *opRast, struct Rectangle *
     width  = opRect->MaxX - opRect->MinX + 1;
     height = opRect->MaxY - opRect->MinY + 1;
 
-    ptr = buffer = AllocMem(width * height * 4, MEMF_ANY);
-    ReadPixelArray(buffer, 0, 0, width * 4, opRast, opRect->MinX, opRect->MinY, width, height, RECTFMT_ARGB);
+    buffer = AllocMem(width * height * 4, MEMF_ANY);
+    if (!buffer)
+        return;
 
-    for (y = 0; y < height; y++)
-    {
-        for(x = 0; x < width; x++)
-        {
-            color = *ptr;
-
-            alpha = (color & 0xff);
-            red   = (color & 0xff00) >> 8;
-            green = (color & 0xff0000) >> 16;
-            blue  = (color & 0xff000000) >> 24;
-
-            D(bug("[Cgfx] %s x %d y %d old: alpha %d red %d green %d blue %d", __PRETTY_FUNCTION__, x, y, alpha, red, green, blue));
-
-            red += value;
-            green += value;
-            blue += value;
-
-            if (red > 255)
-                red = 255;
-            else if (red < 0)
-                red = 0;
-            if (green > 255)
-                green = 255;
-            else if (green < 0)
-                green = 0;
-            if (blue > 255)
-                blue = 255;
-            else if (blue < 0)
-                blue = 0;
-
-            D(bug(" new: alpha %d red %d green %d blue %d\n", alpha, red, green, blue));
-
-            color = alpha | (red << 8) | (green << 16) | (blue << 24);
-
-            *ptr = color;
-            ptr++;
-        }
-    }
+    if (value > 255)
+        value = 255;
+    else if (value < -255)
+        value = -255;
 
+    ReadPixelArray(buffer, 0, 0, width * 4, opRast, opRect->MinX, opRect->MinY, width, height, RECTFMT_ARGB);
+    AdjustBrightness(buffer, width * height * 4, value);
     WritePixelArray(buffer, 0, 0, width * 4, opRast, opRect->MinX, opRect->MinY, width, height, RECTFMT_ARGB);
     FreeMem(buffer, width * height * 4);
 }
@@ -1,10 +1,25 @@
 
 #include <exec/types.h>
 
+/* The operators work on buffers of ARGB32 pixels. Where the generic vector
+   types of the compiler become SSE2 or NEON code, they handle 16 bytes at
+   a time */
+#if (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)) && !AROS_BIG_ENDIAN
+#define PPA_VECTOR
+
+typedef UBYTE ppa_v16ub __attribute__((vector_size(16)));
+typedef UWORD ppa_v8uw  __attribute__((vector_size(16)));
+typedef ULONG ppa_v4ul  __attribute__((vector_size(16)));
+
+/* For loads and stores at any address */
+typedef UBYTE ppa_v16ub_u __attribute__((vector_size(16), aligned(1), may_alias));
+typedef ULONG ppa_v4ul_u  __attribute__((vector_size(16), aligned(1), may_alias));
+#endif
+
 void ProcessPixelArrayBrightnessFunc(struct RastPort *, struct Rectangle *, LONG,struct Library *);
 void ProcessPixelArrayAlphaFunc(struct RastPort *, struct Rectangle *, UBYTE, struct Library *);
 void ProcessPixelArrayTintFunc(struct RastPort *, struct Rectangle *, ULONG, struct Library *);
-void ProcessPixelArrayBlurFunc(struct RastPort *, struct Rectangle *, struct Library *);
+void ProcessPixelArrayBlurFunc(struct RastPort *, struct Rectangle *, LONG, struct Library *);
 void ProcessPixelArrayColor2GreyFunc(struct RastPort *, struct Rectangle *, struct Library *);
 void ProcessPixelArrayNegativeFunc(struct RastPort *, struct Rectangle *, struct Library *);
 void ProcessPixelArrayNegativeFadeFunc(struct RastPort *, struct Rectangle *, struct Library *);
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2007, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Rexx stub for AllocMem system function
 */
@@ -7,12 +7,14 @@
 #include <proto/exec.h>
 #include <proto/dos.h>
 #include <proto/rexxsyslib.h>
+#include <proto/task.h>
 #include <exec/types.h>
 #include <exec/memory.h>
 #include <dos/dos.h>
 #include <dos/dosextens.h>
 #include <rexx/storage.h>
 #include <rexx/errors.h>
+#include <resources/task.h>
 
 #include <ctype.h>
 #include <string.h>
@@ -30,6 +32,33 @@
 #include <resources/execlock.h>
 #endif
 
+/* Appends name to the delim separated list in string, growing it if needed */
+static UBYTE *AppendName(UBYTE *string, ULONG *ssize, CONST_STRPTR name, char delim)
+{
+    ULONG slen, totlen;
+
+    slen = strlen(string);
+    totlen = slen + strlen(name) + 2;
+    if (totlen > *ssize)
+    {
+        ULONG oldsize = *ssize;
+        UBYTE *oldstring = string;
+
+        *ssize = ((totlen/1024)+1)*1024;
+        string = AllocMem(*ssize, MEMF_ANY);
+        strcpy(string, oldstring);
+        FreeMem(oldstring, oldsize);
+    }
+    if (slen > 0)
+    {
+        string[slen] = delim;
+        string[slen+1] = 0;
+    }
+    strcat(string, name);
+
+    return string;
+}
+
 LONG rxsupp_showlist(struct Library *RexxSupportBase, struct RexxMsg *msg, UBYTE **argstring)
 {
     UBYTE argc = msg->rm_Action & RXARGMASK;
@@ -37,6 +66,9 @@ LONG rxsupp_showlist(struct Library *RexxSupportBase, struct RexxMsg *msg, UBYTE
     char delim = 0;
     struct List *execl = NULL;
     ULONG dosflags = 0L;
+    ULONG taskflags = 0L;
+    APTR TaskResBase = NULL;
+    struct TaskList *tasklist = NULL;
     UBYTE *string, *name = NULL;
     ULONG ssize;
 
@@ -99,6 +131,7 @@ LONG rxsupp_showlist(struct Library *RexxSupportBase, struct RexxMsg *msg, UBYTE
     case 't':
         isexec = TRUE;
         execl = &SysBase->TaskReady;
+        taskflags = LTF_READY;
         break;
         
     case 'v':
@@ -109,6 +142,7 @@ LONG rxsupp_showlist(struct Library *RexxSupportBase, struct RexxMsg *msg, UBYTE
     case 'w':
         isexec = TRUE;
         execl = &SysBase->TaskWait;
+        taskflags = LTF_WAITING;
         break;
         
     default:
@@ -126,15 +160,31 @@ LONG rxsupp_showlist(struct Library *RexxSupportBase, struct RexxMsg *msg, UBYTE
     else
         delim = RXARG(msg, 3)[0];
 
+    /*
+     * Ready tasks may be kept in the schedulers run queues rather than
+     * SysBase->TaskReady, so ask task.resource for the tasks if we can.
+     */
+    if (taskflags && (TaskResBase = OpenResource("task.resource")) != NULL)
+        tasklist = LockTaskList(taskflags);
+
     if (name == NULL)
     {
         ssize = 1024;
         string = AllocMem(ssize, MEMF_ANY);
         string[0] = 0;
-        if (isexec)
+        if (tasklist)
+        {
+            struct Task *task;
+
+            while ((task = NextTaskEntry(tasklist, taskflags)) != NULL)
+            {
+                if (task->tc_Node.ln_Name)
+                    string = AppendName(string, &ssize, task->tc_Node.ln_Name, delim);
+            }
+        }
+        else if (isexec)
         {
             struct Node *n;
-            ULONG slen, totlen;
 
 #if defined(__AROSPLATFORM_SMP__)
                 if (ExecLockBase)
@@ -146,24 +196,7 @@ LONG rxsupp_showlist(struct Library *RexxSupportBase, struct RexxMsg *msg, UBYTE
 #endif
             ForeachNode(execl, n)
             {
-                slen = strlen(string);
-                totlen = slen + strlen(n->ln_Name) + 2;
-                if (totlen > ssize)
-                {
-                    ULONG oldsize = ssize;
-                    UBYTE *oldstring = string;
-                    
-                    ssize = ((totlen/1024)+1)*1024;
-                    string = AllocMem(ssize, MEMF_ANY);
-                    strcpy(string, oldstring);
-                    FreeMem(oldstring, oldsize);
-                }
-                if (slen > 0)
-                {
-                    string[slen] = delim;
-                    string[slen+1] = 0;
-                }
-                strcat(string, n->ln_Name);
+                string = AppendName(string, &ssize, n->ln_Name, delim);
             }
 #if defined(__AROSPLATFORM_SMP__)
                 if (ExecLockBase)
@@ -211,7 +244,14 @@ LONG rxsupp_showlist(struct Library *RexxSupportBase, struct RexxMsg *msg, UBYTE
     {
         BOOL found = FALSE;
         
-        if (isexec)
+        if (tasklist)
+        {
+            struct Task *task;
+
+            while (!found && (task = NextTaskEntry(tasklist, taskflags)) != NULL)
+                found = (task->tc_Node.ln_Name) && (strcmp(name, task->tc_Node.ln_Name) == 0);
+        }
+        else if (isexec)
         {
             struct Node *n;
 
@@ -252,6 +292,9 @@ LONG rxsupp_showlist(struct Library *RexxSupportBase, struct RexxMsg *msg, UBYTE
         else
             *argstring = CreateArgstring("0",1);
     }
-    
+
+    if (tasklist)
+        UnLockTaskList(tasklist, taskflags);
+
     return RC_OK;
 }
@@ -1,6 +1,8 @@
 #include <dos/dos.h>
 #include <exec/execbase.h>
 #include <proto/exec.h>
+#include <proto/task.h>
+#include <resources/task.h>
 #include <signal.h>
 #include <sys/types.h>
 #include <errno.h>
@@ -16,6 +18,9 @@ static BOOL CheckTask(struct List *tl, pid_t pid)
 
 int kill(pid_t pid, int sigs)
 {
+    APTR TaskResBase = OpenResource("task.resource");
+    struct TaskList *tasklist = NULL;
+    struct Task *task;
     ULONG exec_sigs;
     int task_valid;
 
@@ -36,12 +41,20 @@ int kill(pid_t pid, int sigs)
     /*
      * The task can be:
      * a) Current one
-     * b) In the TaskReady list
-     * c) In the TaskWait list
+     * b) In task.resource's task list. Ready tasks may be kept in the
+     *    schedulers run queues rather than the TaskReady list
+     * c) Without task.resource, in the TaskReady or TaskWait list
      */
-    task_valid = ((pid == (pid_t)FindTask(NULL)) ||
-    		  CheckTask(&SysBase->TaskReady, pid) ||
-    		  CheckTask(&SysBase->TaskWait, pid));
+    task_valid = (pid == (pid_t)FindTask(NULL));
+    if (!task_valid && TaskResBase)
+	tasklist = LockTaskList(LTF_ALL);
+    if (tasklist) {
+	while (!task_valid && (task = NextTaskEntry(tasklist, LTF_ALL)) != NULL)
+	    task_valid = ((pid_t)task == pid);
+	UnLockTaskList(tasklist, LTF_ALL);
+    } else if (!task_valid)
+	task_valid = (CheckTask(&SysBase->TaskReady, pid) ||
+		      CheckTask(&SysBase->TaskWait, pid));
 
     if (task_valid && exec_sigs)
 	Signal((struct Task *)pid, exec_sigs);